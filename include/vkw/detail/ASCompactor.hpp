@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/BottomLevelAS.hpp"
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/DeferredDeletionQueue.hpp"
+#include "vkw/detail/Device.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace vkw
+{
+class CommandBuffer;
+
+/// Compacts bottom level acceleration structures once they are built.
+///
+/// Compaction is done in two passes:
+///   - recordSizeQueries() writes the compacted size of each structure in a query pool, right after the
+///     structures are built with VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR.
+///   - once this work completed, recordCompaction() creates right-sized structures, copies the original ones
+///     in them and swaps them in place. The original storage is retired in a deferred deletion queue.
+///
+/// Structures are given a new device address by the compaction, TLAS referencing them must be rebuilt.
+/// Compacted structures can only be refit afterwards, see BottomLevelAccelerationStructure::compacted().
+class AccelerationStructureCompactor
+{
+  public:
+    AccelerationStructureCompactor() {}
+    explicit AccelerationStructureCompactor(const Device& device, const uint32_t maxStructureCount);
+
+    AccelerationStructureCompactor(const AccelerationStructureCompactor&) = delete;
+    AccelerationStructureCompactor(AccelerationStructureCompactor&& rhs);
+
+    AccelerationStructureCompactor& operator=(const AccelerationStructureCompactor&) = delete;
+    AccelerationStructureCompactor& operator=(AccelerationStructureCompactor&& rhs);
+
+    ~AccelerationStructureCompactor();
+
+    bool init(const Device& device, const uint32_t maxStructureCount);
+
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    uint32_t maxStructureCount() const { return maxStructureCount_; }
+
+    /// Total size of the structures before and after the last compaction.
+    VkDeviceSize originalBytes() const { return originalBytes_; }
+    VkDeviceSize compactedBytes() const { return compactedBytes_; }
+
+    /// Waits for the build to complete and writes the compacted size of each structure.
+    bool recordSizeQueries(
+        const CommandBuffer& cmdBuffer,
+        const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList);
+
+    /// Reads the sizes back, the work recorded by recordSizeQueries() must be complete. The original storage
+    /// is retired in deletionQueue, tagged with the timeline value signaled once cmdBuffer completes.
+    bool recordCompaction(
+        const CommandBuffer& cmdBuffer,
+        const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList,
+        DeferredDeletionQueue& deletionQueue, const uint64_t timelineValue);
+
+  private:
+    const Device* device_{nullptr};
+
+    VkQueryPool queryPool_{VK_NULL_HANDLE};
+    uint32_t maxStructureCount_{0};
+
+    std::vector<VkAccelerationStructureKHR> queriedStructures_{};
+    std::vector<VkDeviceSize> compactedSizes_{};
+
+    VkDeviceSize originalBytes_{0};
+    VkDeviceSize compactedBytes_{0};
+
+    bool initialized_{false};
+};
+} // namespace vkw
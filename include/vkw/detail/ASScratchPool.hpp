@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/BottomLevelAS.hpp"
+#include "vkw/detail/Buffer.hpp"
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/Device.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace vkw
+{
+/// Linear allocator of acceleration structure scratch memory.
+///
+/// All the scratch regions used by a batched build are sub-allocated from a single device buffer, each region
+/// being aligned on minAccelerationStructureScratchOffsetAlignment. Regions are never freed individually: the
+/// pool is reset once the GPU work using them is complete.
+class AccelerationStructureScratchPool
+{
+  public:
+    using ScratchBuffer = DeviceBuffer<
+        uint8_t, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT>;
+
+    AccelerationStructureScratchPool() {}
+    explicit AccelerationStructureScratchPool(const Device& device, const VkDeviceSize sizeBytes = 0);
+
+    AccelerationStructureScratchPool(const AccelerationStructureScratchPool&) = delete;
+    AccelerationStructureScratchPool(AccelerationStructureScratchPool&& rhs);
+
+    AccelerationStructureScratchPool& operator=(const AccelerationStructureScratchPool&) = delete;
+    AccelerationStructureScratchPool& operator=(AccelerationStructureScratchPool&& rhs);
+
+    ~AccelerationStructureScratchPool();
+
+    bool init(const Device& device, const VkDeviceSize sizeBytes = 0);
+
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    const auto& buffer() const { return buffer_; }
+
+    VkDeviceSize alignment() const { return alignment_; }
+    VkDeviceSize capacity() const { return buffer_.initialized() ? buffer_.sizeBytes() : 0; }
+    VkDeviceSize usedBytes() const { return offset_; }
+    VkDeviceSize availableBytes() const { return capacity() - offset_; }
+
+    /// Size taken in the pool by a region of the given size, alignment padding included.
+    VkDeviceSize alignedSize(const VkDeviceSize sizeBytes) const;
+
+    /// Total size needed to build or update all the given structures at once. When updating, structures
+    /// needing a rebuild account for their build scratch size.
+    VkDeviceSize requiredSize(
+        const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList,
+        const bool update = false) const;
+
+    /// Grows the pool so that it can hold at least sizeBytes. Growing reallocates the buffer and drops all
+    /// the current regions, it must not be called while the GPU may still use them.
+    bool reserve(const VkDeviceSize sizeBytes);
+
+    /// Returns the device address of a new region, or 0 if the pool is exhausted.
+    VkDeviceAddress allocate(const VkDeviceSize sizeBytes);
+
+    /// Releases all the regions, the GPU work using them must be complete.
+    void reset() { offset_ = 0; }
+
+  private:
+    const Device* device_{nullptr};
+
+    ScratchBuffer buffer_{};
+    VkDeviceAddress baseAddress_{0};
+    VkDeviceSize alignment_{1};
+    VkDeviceSize offset_{0};
+
+    bool initialized_{false};
+};
+} // namespace vkw
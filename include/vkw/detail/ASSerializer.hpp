@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/BottomLevelAS.hpp"
+#include "vkw/detail/Buffer.hpp"
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/DeferredDeletionQueue.hpp"
+#include "vkw/detail/Device.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace vkw
+{
+class CommandBuffer;
+
+/// Saves bottom level acceleration structures to files and loads them back, so that the builds are only
+/// done once.
+///
+/// Saving is done in three passes, the work recorded by each pass must be complete before the next one:
+///   - recordSizeQueries() writes the serialization size of each built structure in a query pool,
+///   - recordSerialization() reads the sizes back and records the serialization of all the structures in a
+///     host readable buffer,
+///   - save() writes one of the serialized structures to a file.
+///
+/// recordLoad() maps the file and records the deserialization of the structure straight from the mapping
+/// when VK_EXT_external_memory_host is enabled, from a copy of it otherwise. Files written by another driver
+/// or device are rejected, the structure must then be built again.
+///
+/// Files start with a FileHeader padded to fileDataOffset bytes, followed by the serialized structure.
+class AccelerationStructureSerializer
+{
+  public:
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t type; ///< VkAccelerationStructureTypeKHR
+        uint32_t reserved;
+        uint64_t dataSize; ///< Size of the serialized structure
+    };
+
+    static constexpr uint32_t fileMagic = 0x53414B56; ///< "VKAS"
+    static constexpr uint32_t fileVersion = 1;
+    static constexpr size_t fileDataOffset = 256; ///< Serialized data must be aligned on 256 bytes
+
+    AccelerationStructureSerializer() {}
+    explicit AccelerationStructureSerializer(const Device& device, const uint32_t maxStructureCount);
+
+    AccelerationStructureSerializer(const AccelerationStructureSerializer&) = delete;
+    AccelerationStructureSerializer(AccelerationStructureSerializer&& rhs);
+
+    AccelerationStructureSerializer& operator=(const AccelerationStructureSerializer&) = delete;
+    AccelerationStructureSerializer& operator=(AccelerationStructureSerializer&& rhs);
+
+    ~AccelerationStructureSerializer();
+
+    bool init(const Device& device, const uint32_t maxStructureCount);
+
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    uint32_t maxStructureCount() const { return maxStructureCount_; }
+
+    // -------------------------------------------------------------------------------------------------------
+    // ------------------------------------------ Save -------------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    /// Waits for the build to complete and writes the serialization size of each structure.
+    bool recordSizeQueries(
+        const CommandBuffer& cmdBuffer,
+        const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList);
+
+    /// Reads the sizes back and records the serialization of the queried structures.
+    bool recordSerialization(
+        const CommandBuffer& cmdBuffer,
+        const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList);
+
+    /// Number of structures serialized by the last recordSerialization() and their total size.
+    size_t serializedCount() const { return serializedSizes_.size(); }
+    VkDeviceSize serializedBytes() const;
+
+    /// Writes the structure at the given index of the serialized list to a file.
+    bool save(const size_t index, const std::string& filename) const;
+
+    // -------------------------------------------------------------------------------------------------------
+    // ------------------------------------------ Load -------------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    /// Creates the structure with the size stored in the file and records its deserialization, blas must not
+    /// have been created yet. The file mapping is retired in deletionQueue, tagged with the timeline value
+    /// signaled once cmdBuffer completes. The structure must be synchronized before use like after a build.
+    bool recordLoad(
+        const CommandBuffer& cmdBuffer, BottomLevelAccelerationStructure& blas, const std::string& filename,
+        DeferredDeletionQueue& deletionQueue, const uint64_t timelineValue);
+
+  private:
+    using SerializationBuffer = DeviceToHostBuffer<uint8_t>;
+
+    const Device* device_{nullptr};
+
+    VkQueryPool queryPool_{VK_NULL_HANDLE};
+    uint32_t maxStructureCount_{0};
+
+    std::vector<VkAccelerationStructureKHR> queriedStructures_{};
+
+    SerializationBuffer serializationBuffer_{};
+    std::vector<VkDeviceSize> serializedOffsets_{};
+    std::vector<VkDeviceSize> serializedSizes_{};
+
+    bool initialized_{false};
+};
+} // namespace vkw
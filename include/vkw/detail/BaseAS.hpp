@@ -29,6 +29,8 @@
 
 namespace vkw
 {
+class CommandBuffer;
+
 class BaseAccelerationStructure
 {
   public:
@@ -65,6 +67,28 @@ class BaseAccelerationStructure
 
     virtual VkAccelerationStructureTypeKHR type() const = 0;
 
+    // -------------------------------------------------------------------------------------------------------
+    // ---------------------------------------- Serialization ------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    /// Records the serialization of the built structure at dst + offset, the address must be aligned on 256
+    /// bytes and the buffer must hold the serialization size of the structure, as given by a
+    /// VK_QUERY_TYPE_ACCELERATION_STRUCTURE_SERIALIZATION_SIZE_KHR query.
+    void serialize(
+        const CommandBuffer& cmdBuffer, const BaseBuffer& dst, const VkDeviceSize offset = 0) const;
+
+    /// Records the copy of serialized data at src + offset to the structure. The structure must have been
+    /// created with at least deserializedSize() bytes and the data must be compatible() with the device.
+    void deserialize(
+        const CommandBuffer& cmdBuffer, const BaseBuffer& src, const VkDeviceSize offset = 0) const;
+
+    /// Checks the driver and compatibility UUIDs at the start of serialized data against the device.
+    static bool compatible(const Device& device, const void* serializedData);
+
+    /// Sizes stored in the header of serialized data.
+    static VkDeviceSize serializedSize(const void* serializedData);
+    static VkDeviceSize deserializedSize(const void* serializedData);
+
   protected:
     const Device* device_{nullptr};
 
@@ -79,6 +103,28 @@ class BaseAccelerationStructure
 
     BaseAccelerationStructure() = default;
 
+    /// Allocates the storage buffer and creates a structure of the given size in it.
+    bool createStorage(const VkDeviceSize sizeBytes)
+    {
+        VKW_CHECK_BOOL_RETURN_FALSE(storageBuffer_.init(
+            *device_, static_cast<size_t>(sizeBytes),
+            VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR
+                | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT));
+
+        VkAccelerationStructureCreateInfoKHR createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
+        createInfo.pNext = nullptr;
+        createInfo.createFlags = 0; // Other flags are not supported for now
+        createInfo.buffer = storageBuffer_.getHandle();
+        createInfo.size = sizeBytes;
+        createInfo.type = type();
+        createInfo.deviceAddress = 0;
+        VKW_CHECK_VK_RETURN_FALSE(device_->vk().vkCreateAccelerationStructureKHR(
+            device_->getHandle(), &createInfo, nullptr, &accelerationStructure_));
+
+        return true;
+    }
+
     virtual void clear()
     {
         buildOnHost_ = false;
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/ASGeometryData.hpp"
+#include "vkw/detail/BottomLevelAS.hpp"
+#include "vkw/detail/Buffer.hpp"
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/DeferredDeletionQueue.hpp"
+#include "vkw/detail/Device.hpp"
+#include "vkw/detail/TopLevelAS.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace vkw
+{
+class CommandBuffer;
+
+/// Packs many small static meshes into a few multi-geometry bottom level acceleration structures.
+///
+/// Meshes are sorted along a Morton curve of their world space centroid, consecutive meshes are then grouped
+/// until a batch reaches the target primitive or geometry count, so that each structure covers a compact
+/// region of the scene. All the batches share a single vertex, index and transform buffer: each mesh is a
+/// geometry of its structure, addressed by the firstVertex, primitiveOffset and transformOffset of its build
+/// range. Mesh transforms are applied by the builds and the structures are instanced with the identity.
+///
+/// Typical usage:
+///   - addMesh() for each static mesh, its data is copied,
+///   - create() groups the meshes, fills the geometry buffers and creates the structures,
+///   - recordUpload() if needsUpload(), then CommandBuffer::buildAccelerationStructures() with blasList(),
+///   - addInstances() adds one TLAS instance per structure.
+class BlasBatcher
+{
+  public:
+    struct MeshDesc
+    {
+        const float* positions{nullptr}; ///< 3 floats per vertex
+        uint32_t vertexCount{0};
+        uint32_t vertexStride{3 * sizeof(float)}; ///< In bytes
+        const uint32_t* indices{nullptr};
+        uint32_t indexCount{0};
+        VkTransformMatrixKHR transform{asIdentityMatrix};
+        VkGeometryFlagsKHR flags{VK_GEOMETRY_OPAQUE_BIT_KHR};
+    };
+
+    /// Where a mesh ended up: gl_InstanceCustomIndexEXT and gl_GeometryIndexEXT in the hit shaders.
+    struct MeshLocation
+    {
+        uint32_t blasIndex;
+        uint32_t geometryIndex;
+    };
+
+    BlasBatcher() {}
+    explicit BlasBatcher(const Device& device);
+
+    BlasBatcher(const BlasBatcher&) = delete;
+    BlasBatcher(BlasBatcher&& rhs) { *this = std::move(rhs); }
+
+    BlasBatcher& operator=(const BlasBatcher&) = delete;
+    BlasBatcher& operator=(BlasBatcher&& rhs);
+
+    ~BlasBatcher() { this->clear(); }
+
+    bool init(const Device& device);
+
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    // -------------------------------------------------------------------------------------------------------
+    // ---------------------------------------- Meshes -------------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    /// A batch is closed once adding the next mesh would exceed one of these limits, a mesh larger than the
+    /// primitive target gets a structure of its own. create() clamps them to the maxPrimitiveCount and
+    /// maxGeometryCount of the device.
+    BlasBatcher& setTargetPrimitiveCount(const uint32_t primitiveCount)
+    {
+        targetPrimitiveCount_ = primitiveCount;
+        return *this;
+    }
+    BlasBatcher& setMaxGeometryCount(const uint32_t geometryCount)
+    {
+        maxGeometryCount_ = geometryCount;
+        return *this;
+    }
+
+    /// Returns the index of the mesh, meshes must be added before create().
+    uint32_t addMesh(const MeshDesc& mesh);
+
+    uint32_t meshCount() const { return static_cast<uint32_t>(meshes_.size()); }
+
+    // -------------------------------------------------------------------------------------------------------
+    // -------------------------------------- Structures -----------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    /// The structures must then be built with the same flags. On failure nothing is kept, meshes can still
+    /// be added before trying again.
+    bool create(const VkBuildAccelerationStructureFlagBitsKHR buildFlags = {});
+
+    bool created() const { return !structures_.empty(); }
+
+    /// True when the geometry buffers are not host visible and must be uploaded before the builds.
+    bool needsUpload() const { return uploadPending_; }
+
+    /// Copies the geometry to the device and makes it visible to the builds. The staging buffers are retired
+    /// in deletionQueue, tagged with the timeline value signaled once cmdBuffer completes.
+    void recordUpload(
+        const CommandBuffer& cmdBuffer, DeferredDeletionQueue& deletionQueue, const uint64_t timelineValue);
+
+    uint32_t blasCount() const { return static_cast<uint32_t>(structures_.size()); }
+    auto& blas(const uint32_t index) { return structures_[index]; }
+    const auto& blas(const uint32_t index) const { return structures_[index]; }
+
+    std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>> blasList();
+
+    const MeshLocation& meshLocation(const uint32_t meshIndex) const { return meshLocations_[meshIndex]; }
+
+    /// Adds an instance of each structure, with the identity transform and the structure index as custom
+    /// index. The structures must have been built.
+    void addInstances(
+        TopLevelAccelerationStructure& tlas, const uint32_t mask = 0xFF,
+        const VkGeometryInstanceFlagsKHR flags = {}, const uint32_t hitBindingIndex = 0) const;
+
+  private:
+    template <typename T>
+    using GeometryBuffer = HostDeviceBuffer<
+        T, VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+               | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR
+               | VK_BUFFER_USAGE_TRANSFER_DST_BIT>;
+
+    struct MeshInfo
+    {
+        uint32_t firstVertex;
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        VkGeometryFlagsKHR flags;
+        float centroid[3];
+    };
+
+    const Device* device_{nullptr};
+
+    uint32_t targetPrimitiveCount_{1u << 16};
+    uint32_t maxGeometryCount_{1024};
+
+    std::vector<MeshInfo> meshes_{};
+    std::vector<float> positions_{};
+    std::vector<uint32_t> indices_{};
+    std::vector<VkTransformMatrixKHR> transforms_{};
+
+    GeometryBuffer<float> vertexBuffer_{};
+    GeometryBuffer<uint32_t> indexBuffer_{};
+    GeometryBuffer<VkTransformMatrixKHR> transformBuffer_{};
+
+    HostStagingBuffer<float> vertexStagingBuffer_{};
+    HostStagingBuffer<uint32_t> indexStagingBuffer_{};
+    HostStagingBuffer<VkTransformMatrixKHR> transformStagingBuffer_{};
+    bool uploadPending_{false};
+
+    std::vector<BottomLevelAccelerationStructure> structures_{};
+    std::vector<MeshLocation> meshLocations_{};
+
+    bool initialized_{false};
+
+    // Mesh indices of each batch, in Morton order of their centroids
+    std::vector<std::vector<uint32_t>> createBatches() const;
+    bool createGeometryBuffers();
+    bool createStructures(const VkBuildAccelerationStructureFlagBitsKHR buildFlags);
+    void clearStructures();
+};
+} // namespace vkw
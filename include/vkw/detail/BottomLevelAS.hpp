@@ -24,6 +24,10 @@
 
 #include "vkw/detail/BaseAS.hpp"
 #include "vkw/detail/Common.hpp"
+#include "vkw/detail/DeferredHostOperation.hpp"
+#include "vkw/detail/ThreadPool.hpp"
+
+#include <future>
 
 namespace vkw
 {
@@ -45,9 +49,12 @@ class BottomLevelAccelerationStructure final : public BaseAccelerationStructure
 
     bool init(const Device& device, const bool buildOnHost = false);
 
-    ///@todo: Consider adding create() that takes a size as input parameter
     bool create(const VkBuildAccelerationStructureFlagBitsKHR buildFlags = {});
 
+    /// Creates an empty structure of the given size, to be filled by a copy or a deserialization. It has no
+    /// geometry and can't be built or updated.
+    bool createEmpty(const VkDeviceSize sizeBytes);
+
     void clear() override;
 
     inline VkAccelerationStructureTypeKHR type() const override
@@ -79,20 +86,73 @@ class BottomLevelAccelerationStructure final : public BaseAccelerationStructure
 
     // -------------------------------------------------------------------------------------------------------
 
+    /// Host builds, compacted structures can't be built again. When deferred is true the build is split
+    /// across the threads of utils::ThreadPool::instance() and the call waits for it to complete. It must
+    /// then not be called from a task of this pool.
     bool build(
         void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags = {},
         const bool deferred = false);
 
+    /// Refits the structure in place, rebuilds it once needsRebuild() is true.
+    bool update(
+        void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags = {},
+        const bool deferred = false);
+
+    /// Asynchronous host builds, joined by the pool workers. The scratch memory and the geometry data must
+    /// stay valid until the returned future is ready. A new host build first waits for the pending one, it
+    /// must then not be called from a task of the pool.
+    std::shared_future<VkResult> buildDeferred(
+        void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags = {},
+        utils::ThreadPool& pool = utils::ThreadPool::instance());
+    std::shared_future<VkResult> updateDeferred(
+        void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags = {},
+        utils::ThreadPool& pool = utils::ThreadPool::instance());
+
+    /// Refits degrade the structure quality over time, updates are turned into full rebuilds once this count
+    /// of consecutive refits is reached. 0 never forces a rebuild.
+    BottomLevelAccelerationStructure& setMaxRefitCount(const uint32_t maxRefitCount)
+    {
+        maxRefitCount_ = maxRefitCount;
+        return *this;
+    }
+    uint32_t maxRefitCount() const { return maxRefitCount_; }
+
+    /// Number of refits since the last full build done through an update or a batched build.
+    uint32_t refitCount() const { return refitCount_; }
+
+    /// Always false once the structure is compacted(), updates then keep refitting it.
+    bool needsRebuild() const
+    {
+        return !compacted() && (maxRefitCount_ > 0) && (refitCount_ >= maxRefitCount_);
+    }
+
+    /// A compacted structure only keeps the storage it needs, a full build would not fit in it: it can only
+    /// be refit. accelerationStructureSize() and the scratch sizes still give the original build sizes.
+    bool compacted() const { return compactedSize_ > 0; }
+    VkDeviceSize compactedSize() const { return compactedSize_; }
+
     ///@todo Not implemented yet
     bool copy();
 
   private:
+    friend class AccelerationStructureCompactor;
     friend class CommandBuffer;
 
     std::vector<uint32_t> primitiveCounts_{};
     std::vector<VkAccelerationStructureGeometryKHR> geometryData_{};
     std::vector<std::vector<VkAccelerationStructureBuildRangeInfoKHR>> buildRanges_{};
 
+    uint32_t refitCount_{0};
+    uint32_t maxRefitCount_{0};
+
+    VkDeviceSize compactedSize_{0};
+
+    DeferredHostOperation deferredOperation_{};
+
     bool initialized_{false};
+
+    std::shared_future<VkResult> hostBuild(
+        void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags, const bool refit,
+        utils::ThreadPool* pool);
 };
 } // namespace vkw
@@ -24,9 +24,14 @@
 
 #include "vkw/detail/Common.hpp"
 #include "vkw/detail/Device.hpp"
+#include "vkw/detail/MappedFile.hpp"
 #include "vkw/detail/MemoryCommon.hpp"
+#include "vkw/detail/ThreadPool.hpp"
 #include "vkw/detail/utils.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 namespace vkw
 {
 class BaseBuffer
@@ -88,6 +93,20 @@ class Buffer : public BaseBuffer
         VKW_CHECK_BOOL_FAIL(this->init(device, createInfo, alignment, pName), "Error creating buffer");
     }
 
+    explicit Buffer(
+        const Device& device, T* hostPtr, const size_t size, const VkBufferUsageFlags usage = {},
+        const char* pName = nullptr)
+    {
+        VKW_CHECK_BOOL_FAIL(this->init(device, hostPtr, size, usage, pName), "Error importing host memory");
+    }
+
+    explicit Buffer(
+        const Device& device, const MappedFile& file, const VkBufferUsageFlags usage = {},
+        const char* pName = nullptr)
+    {
+        VKW_CHECK_BOOL_FAIL(this->init(device, file, usage, pName), "Error importing mapped file");
+    }
+
     Buffer(const Buffer&) = delete;
     Buffer(Buffer&& rhs) { *this = std::move(rhs); }
 
@@ -103,6 +122,7 @@ class Buffer : public BaseBuffer
 
         std::swap(allocInfo_, rhs.allocInfo_);
         std::swap(memAllocation_, rhs.memAllocation_);
+        std::swap(importedMemory_, rhs.importedMemory_);
 
         std::swap(hostPtr_, rhs.hostPtr_);
 
@@ -161,34 +181,33 @@ class Buffer : public BaseBuffer
             &memAllocation_, &allocInfo_));
         hostPtr_ = reinterpret_cast<T*>(allocInfo_.pMappedData);
 
-        if(pName != nullptr)
-        {
-            VkDebugUtilsObjectNameInfoEXT bufferNameInfo = {};
-            bufferNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
-            bufferNameInfo.pNext = nullptr;
-            bufferNameInfo.objectType = VK_OBJECT_TYPE_BUFFER;
-            bufferNameInfo.pObjectName = pName;
-            bufferNameInfo.objectHandle = reinterpret_cast<uint64_t>(buffer_);
-
-            static auto SetDebugUtilsObjectNameEXT = (PFN_vkSetDebugUtilsObjectNameEXT) vkGetInstanceProcAddr(
-                device_->instance().getHandle(), "vkSetDebugUtilsObjectNameEXT");
-            if(SetDebugUtilsObjectNameEXT != nullptr)
-            {
-                VKW_INIT_CHECK_VK(SetDebugUtilsObjectNameEXT(device_->getHandle(), &bufferNameInfo));
-            }
-        }
-
-        utils::Log::Verbose("vkw", "Buffer %s:", (pName != nullptr) ? pName : "");
-        utils::Log::Verbose("vkw", "  deviceLocal:  %s", deviceLocal() ? "True" : "False");
-        utils::Log::Verbose("vkw", "  hostVisible:  %s", hostVisible() ? "True" : "False");
-        utils::Log::Verbose("vkw", "  hostCoherent: %s", hostCoherent() ? "True" : "False");
-        utils::Log::Verbose("vkw", "  hostCached:   %s", hostCached() ? "True" : "False");
+        VKW_INIT_CHECK_BOOL(this->setObjectName(pName));
 
         initialized_ = true;
 
         return true;
     }
 
+    /// Imports existing host memory with VK_EXT_external_memory_host, the buffer directly uses this memory
+    /// and no copy is made. The pointer and the size in bytes must be multiples of
+    /// Device::minImportedHostPointerAlignment() and the memory must outlive the buffer.
+    bool init(
+        const Device& device, T* hostPtr, const size_t size, const VkBufferUsageFlags usage = {},
+        const char* pName = nullptr)
+    {
+        return this->importHostMemory(device, hostPtr, size * sizeof(T), usage, pName);
+    }
+
+    /// Imports a mapped file region. The buffer covers the whole aligned mapped range, the requested file
+    /// region starts at file.dataOffset() bytes in the buffer.
+    bool init(
+        const Device& device, const MappedFile& file, const VkBufferUsageFlags usage = {},
+        const char* pName = nullptr)
+    {
+        VKW_ASSERT(file.initialized());
+        return this->importHostMemory(device, file.mappedData(), file.mappedSize(), usage, pName);
+    }
+
     void clear()
     {
         if(buffer_ != VK_NULL_HANDLE)
@@ -197,7 +216,9 @@ class Buffer : public BaseBuffer
             buffer_ = VK_NULL_HANDLE;
             memAllocation_ = VK_NULL_HANDLE;
         }
+        VKW_FREE_VK(Memory, importedMemory_);
 
+        hostPtr_ = nullptr;
         size_ = 0;
         usage_ = {};
         allocInfo_ = {};
@@ -207,8 +228,12 @@ class Buffer : public BaseBuffer
     }
 
     const Device& device() const final override { return *device_; };
+
+    /// @note: Returns VK_NULL_HANDLE for buffers created from imported host memory.
     VmaAllocation memory() const final override { return memAllocation_; }
 
+    bool importedMemory() const { return importedMemory_ != VK_NULL_HANDLE; }
+
     size_t size() const final override { return size_; }
     size_t sizeBytes() const final override { return size_ * sizeof(T); }
     size_t stride() const final override { return sizeof(T); }
@@ -248,7 +273,6 @@ class Buffer : public BaseBuffer
     VkDeviceAddress deviceAddress() const final override
     {
         VKW_ASSERT(this->initialized());
-        VKW_ASSERT(this->hostVisible());
         VKW_ASSERT(device_->bufferMemoryAddressEnabled());
         VKW_ASSERT((usage_ & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) != 0);
 
@@ -362,6 +386,11 @@ class Buffer : public BaseBuffer
         VKW_ASSERT(this->initialized());
         VKW_ASSERT(this->hostVisible());
         VKW_ASSERT(this->sizeBytes() >= count * sizeof(T));
+        if(importedMemory_ != VK_NULL_HANDLE)
+        {
+            memcpy(hostPtr_, src, count * sizeof(T));
+            return true;
+        }
         VKW_CHECK_VK_RETURN_FALSE(
             vmaCopyMemoryToAllocation(device_->allocator(), src, memAllocation_, 0, count * sizeof(T)));
         return true;
@@ -372,14 +401,85 @@ class Buffer : public BaseBuffer
         VKW_ASSERT(this->hostVisible());
         VKW_ASSERT(this->sizeBytes() >= offset * sizeof(T));
         VKW_ASSERT(this->sizeBytes() >= (offset + count) * sizeof(T));
-        VKW_CHECK_VK_RETURN_FALSE(
-            vmaCopyMemoryToAllocation(device_->allocator(), src, memAllocation_, offset, count * sizeof(T)));
+        if(importedMemory_ != VK_NULL_HANDLE)
+        {
+            memcpy(hostPtr_ + offset, src, count * sizeof(T));
+            return true;
+        }
+        VKW_CHECK_VK_RETURN_FALSE(vmaCopyMemoryToAllocation(
+            device_->allocator(), src, memAllocation_, offset * sizeof(T), count * sizeof(T)));
         return true;
     }
+
+    /// Same as copyFromHost() but splits large copies in chunks copied by the pool worker threads. Buffers
+    /// allocated in write-combined memory (TransferHostDevice and HostStaging) are written with streaming
+    /// stores, and non coherent memory is flushed once all the chunks are copied.
+    bool copyFromHostParallel(
+        utils::ThreadPool& threadPool, const void* src, const size_t offset, const size_t count,
+        const size_t chunkSizeBytes = 4 * 1024 * 1024)
+    {
+        VKW_ASSERT(this->initialized());
+        VKW_ASSERT(this->hostVisible());
+        VKW_ASSERT(this->sizeBytes() >= (offset + count) * sizeof(T));
+        VKW_ASSERT(chunkSizeBytes > 0);
+
+        static constexpr bool useStreamingStores
+            = (memType == MemoryType::TransferHostDevice) || (memType == MemoryType::HostStaging);
+
+        const size_t byteOffset = offset * sizeof(T);
+        const size_t sizeBytes = count * sizeof(T);
+        if(sizeBytes <= chunkSizeBytes) { return this->copyFromHost(src, offset, count); }
+
+        uint8_t* mappedPtr = reinterpret_cast<uint8_t*>(hostPtr_);
+        if(mappedPtr == nullptr)
+        {
+            VKW_CHECK_VK_RETURN_FALSE(
+                vmaMapMemory(device_->allocator(), memAllocation_, reinterpret_cast<void**>(&mappedPtr)));
+        }
+
+        const auto* srcPtr = reinterpret_cast<const uint8_t*>(src);
+        auto* dstPtr = mappedPtr + byteOffset;
+        const size_t chunkCount = (sizeBytes + chunkSizeBytes - 1) / chunkSizeBytes;
+        threadPool.parallelFor(chunkCount, [&](const size_t chunk) {
+            const size_t chunkOffset = chunk * chunkSizeBytes;
+            const size_t chunkSize = std::min(chunkSizeBytes, sizeBytes - chunkOffset);
+            if constexpr(useStreamingStores)
+            {
+                utils::streamingCopy(dstPtr + chunkOffset, srcPtr + chunkOffset, chunkSize);
+            }
+            else
+            {
+                memcpy(dstPtr + chunkOffset, srcPtr + chunkOffset, chunkSize);
+            }
+        });
+
+        if(memAllocation_ != VK_NULL_HANDLE)
+        {
+            // Single flush for the whole range, this is a no-op for coherent memory
+            const VkDeviceSize flushOffset = byteOffset;
+            const VkDeviceSize flushSize = sizeBytes;
+            VKW_CHECK_VK_RETURN_FALSE(
+                vmaFlushAllocations(device_->allocator(), 1, &memAllocation_, &flushOffset, &flushSize));
+        }
+
+        if(hostPtr_ == nullptr) { vmaUnmapMemory(device_->allocator(), memAllocation_); }
+
+        return true;
+    }
+    bool copyFromHostParallel(const void* src, const size_t offset, const size_t count)
+    {
+        return this->copyFromHostParallel(utils::ThreadPool::instance(), src, offset, count);
+    }
+
     bool copyToHost(void* dst, const size_t count) const
     {
         VKW_ASSERT(this->initialized());
         VKW_ASSERT(this->hostVisible());
+        if(importedMemory_ != VK_NULL_HANDLE)
+        {
+            memcpy(dst, hostPtr_, count * sizeof(T));
+            return true;
+        }
         VKW_CHECK_VK_RETURN_FALSE(
             vmaCopyAllocationToMemory(device_->allocator(), memAllocation_, 0, dst, count * sizeof(T)));
         return true;
@@ -388,8 +488,13 @@ class Buffer : public BaseBuffer
     {
         VKW_ASSERT(this->initialized());
         VKW_ASSERT(this->hostVisible());
-        VKW_CHECK_VK_RETURN_FALSE(
-            vmaCopyAllocationToMemory(device_->allocator(), memAllocation_, offset, dst, count * sizeof(T)));
+        if(importedMemory_ != VK_NULL_HANDLE)
+        {
+            memcpy(dst, hostPtr_ + offset, count * sizeof(T));
+            return true;
+        }
+        VKW_CHECK_VK_RETURN_FALSE(vmaCopyAllocationToMemory(
+            device_->allocator(), memAllocation_, offset * sizeof(T), dst, count * sizeof(T)));
         return true;
     }
 
@@ -470,10 +575,144 @@ class Buffer : public BaseBuffer
 
     VmaAllocationInfo allocInfo_{};
     VmaAllocation memAllocation_{VK_NULL_HANDLE};
+    VkDeviceMemory importedMemory_{VK_NULL_HANDLE};
 
     T* hostPtr_{nullptr};
 
     bool initialized_{false};
+
+    bool importHostMemory(
+        const Device& device, void* hostPtr, const size_t sizeBytes, const VkBufferUsageFlags usage,
+        const char* pName)
+    {
+        VKW_ASSERT(this->initialized() == false);
+
+        this->device_ = &device;
+
+        if(!device_->externalMemoryHostEnabled())
+        {
+            utils::Log::Error("vkw", "VK_EXT_external_memory_host must be enabled to import host memory");
+            this->clear();
+            return false;
+        }
+
+        const VkDeviceSize importAlignment = device_->minImportedHostPointerAlignment();
+        if((reinterpret_cast<uintptr_t>(hostPtr) % importAlignment != 0)
+           || (sizeBytes % importAlignment != 0))
+        {
+            utils::Log::Error(
+                "vkw", "Imported host pointer and size must be aligned on %llu bytes",
+                static_cast<unsigned long long>(importAlignment));
+            this->clear();
+            return false;
+        }
+
+        this->size_ = sizeBytes / sizeof(T);
+        this->usage_ = usage | additionalFlags;
+
+        VkExternalMemoryBufferCreateInfo externalCreateInfo = {};
+        externalCreateInfo.sType = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO;
+        externalCreateInfo.pNext = nullptr;
+        externalCreateInfo.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+
+        VkBufferCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext = &externalCreateInfo;
+        createInfo.flags = 0;
+        createInfo.usage = this->usage_;
+        createInfo.size = sizeBytes;
+        createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount = 0;
+        createInfo.pQueueFamilyIndices = nullptr;
+        VKW_INIT_CHECK_VK(device_->vk().vkCreateBuffer(device_->getHandle(), &createInfo, nullptr, &buffer_));
+
+        VkMemoryHostPointerPropertiesEXT hostPointerProperties = {};
+        hostPointerProperties.sType = VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT;
+        hostPointerProperties.pNext = nullptr;
+        VKW_INIT_CHECK_VK(device_->vk().vkGetMemoryHostPointerPropertiesEXT(
+            device_->getHandle(), VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT, hostPtr,
+            &hostPointerProperties));
+
+        VkMemoryRequirements requirements = {};
+        device_->vk().vkGetBufferMemoryRequirements(device_->getHandle(), buffer_, &requirements);
+        requirements.memoryTypeBits &= hostPointerProperties.memoryTypeBits;
+
+        const uint32_t memoryTypeIndex = utils::findMemoryType(
+            device_->getPhysicalDevice(), 0,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 0, requirements);
+        if(memoryTypeIndex == ~uint32_t(0))
+        {
+            utils::Log::Error("vkw", "No memory type compatible with the imported host pointer");
+            this->clear();
+            return false;
+        }
+
+        VkMemoryAllocateFlagsInfo allocateFlagsInfo = {};
+        allocateFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+        allocateFlagsInfo.pNext = nullptr;
+        allocateFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+        allocateFlagsInfo.deviceMask = 0;
+
+        VkImportMemoryHostPointerInfoEXT importInfo = {};
+        importInfo.sType = VK_STRUCTURE_TYPE_IMPORT_MEMORY_HOST_POINTER_INFO_EXT;
+        importInfo.pNext = ((this->usage_ & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) != 0)
+                               ? &allocateFlagsInfo
+                               : nullptr;
+        importInfo.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+        importInfo.pHostPointer = hostPtr;
+
+        VkMemoryAllocateInfo allocateInfo = {};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocateInfo.pNext = &importInfo;
+        allocateInfo.allocationSize = sizeBytes;
+        allocateInfo.memoryTypeIndex = memoryTypeIndex;
+        VKW_INIT_CHECK_VK(
+            device_->vk().vkAllocateMemory(device_->getHandle(), &allocateInfo, nullptr, &importedMemory_));
+        VKW_INIT_CHECK_VK(
+            device_->vk().vkBindBufferMemory(device_->getHandle(), buffer_, importedMemory_, 0));
+
+        allocInfo_ = {};
+        allocInfo_.memoryType = memoryTypeIndex;
+        allocInfo_.deviceMemory = importedMemory_;
+        allocInfo_.offset = 0;
+        allocInfo_.size = sizeBytes;
+        allocInfo_.pMappedData = hostPtr;
+        hostPtr_ = reinterpret_cast<T*>(hostPtr);
+
+        VKW_INIT_CHECK_BOOL(this->setObjectName(pName));
+
+        initialized_ = true;
+
+        return true;
+    }
+
+    bool setObjectName(const char* pName)
+    {
+        if(pName != nullptr)
+        {
+            VkDebugUtilsObjectNameInfoEXT bufferNameInfo = {};
+            bufferNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+            bufferNameInfo.pNext = nullptr;
+            bufferNameInfo.objectType = VK_OBJECT_TYPE_BUFFER;
+            bufferNameInfo.pObjectName = pName;
+            bufferNameInfo.objectHandle = reinterpret_cast<uint64_t>(buffer_);
+
+            static auto SetDebugUtilsObjectNameEXT = (PFN_vkSetDebugUtilsObjectNameEXT) vkGetInstanceProcAddr(
+                device_->instance().getHandle(), "vkSetDebugUtilsObjectNameEXT");
+            if(SetDebugUtilsObjectNameEXT != nullptr)
+            {
+                VKW_CHECK_VK_RETURN_FALSE(SetDebugUtilsObjectNameEXT(device_->getHandle(), &bufferNameInfo));
+            }
+        }
+
+        utils::Log::Verbose("vkw", "Buffer %s:", (pName != nullptr) ? pName : "");
+        utils::Log::Verbose("vkw", "  deviceLocal:  %s", deviceLocal() ? "True" : "False");
+        utils::Log::Verbose("vkw", "  hostVisible:  %s", hostVisible() ? "True" : "False");
+        utils::Log::Verbose("vkw", "  hostCoherent: %s", hostCoherent() ? "True" : "False");
+        utils::Log::Verbose("vkw", "  hostCached:   %s", hostCached() ? "True" : "False");
+
+        return true;
+    }
 }; // namespace vkw
 
 // -----------------------------------------------------------------------------------------------------------
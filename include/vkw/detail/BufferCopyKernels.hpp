@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Buffer.hpp"
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/ComputePipeline.hpp"
+#include "vkw/detail/DescriptorSetLayout.hpp"
+#include "vkw/detail/Device.hpp"
+#include "vkw/detail/PipelineLayout.hpp"
+
+#include <cstdint>
+
+namespace vkw
+{
+class CommandBuffer;
+
+/// Compute kernels used by CommandBuffer::gatherBuffer(), scatterBuffer() and transposeAoSToSoA().
+///
+/// Records are moved as 32 bit words, the record stride must be a multiple of 4 bytes. Buffers are bound
+/// with push descriptors, the source and index buffers need VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, as well as
+/// the destination buffer. Accesses to the buffers must be synchronized with the compute shader stage.
+class BufferCopyKernels
+{
+  public:
+    BufferCopyKernels() {}
+    explicit BufferCopyKernels(const Device& device);
+
+    BufferCopyKernels(const BufferCopyKernels&) = delete;
+    BufferCopyKernels(BufferCopyKernels&& rhs) { *this = std::move(rhs); }
+
+    BufferCopyKernels& operator=(const BufferCopyKernels&) = delete;
+    BufferCopyKernels& operator=(BufferCopyKernels&& rhs);
+
+    ~BufferCopyKernels() { this->clear(); }
+
+    bool init(const Device& device);
+
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    /// dst[i] = src[indices[i]] for the count first records of dst.
+    bool recordGather(
+        const CommandBuffer& cmdBuffer, const BaseBuffer& src, const BaseBuffer& dst,
+        const BaseBuffer& indexBuffer, const uint32_t stride, const uint32_t count) const;
+
+    /// dst[indices[i]] = src[i] for the count first records of src. Indices must be unique.
+    bool recordScatter(
+        const CommandBuffer& cmdBuffer, const BaseBuffer& src, const BaseBuffer& dst,
+        const BaseBuffer& indexBuffer, const uint32_t stride, const uint32_t count) const;
+
+    /// Splits count records of stride bytes in stride / 4 arrays of count 32 bit words.
+    bool recordTransposeAoSToSoA(
+        const CommandBuffer& cmdBuffer, const BaseBuffer& src, const BaseBuffer& dst, const uint32_t stride,
+        const uint32_t count) const;
+
+  private:
+    struct PushConstants
+    {
+        uint32_t recordCount;
+        uint32_t recordWords;
+        uint32_t rowInvocations;
+    };
+
+    const Device* device_{nullptr};
+
+    DescriptorSetLayout descriptorSetLayout_{};
+    PipelineLayout pipelineLayout_{};
+    ComputePipeline gatherPipeline_{};
+    ComputePipeline scatterPipeline_{};
+    ComputePipeline transposePipeline_{};
+
+    bool initialized_{false};
+
+    bool record(
+        const CommandBuffer& cmdBuffer, const ComputePipeline& pipeline, const BaseBuffer& src,
+        const BaseBuffer& dst, const BaseBuffer* indexBuffer, const uint32_t stride,
+        const uint32_t count) const;
+};
+} // namespace vkw
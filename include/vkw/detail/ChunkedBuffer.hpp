@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Buffer.hpp"
+#include "vkw/detail/CommandBuffer.hpp"
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/DescriptorSet.hpp"
+#include "vkw/detail/Device.hpp"
+#include "vkw/detail/MemoryCommon.hpp"
+#include "vkw/detail/utils.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace vkw
+{
+/// Array spanning several buffers, for sizes exceeding the device limits of a single buffer.
+///
+/// The array is split in chunks of chunkSize() elements, each chunk being a separate buffer. The chunk size
+/// respects maxMemoryAllocationSize, maxBufferSize and, depending on the usage, maxStorageBufferRange or
+/// maxUniformBufferRange, so that each chunk can be bound as a whole. Element i lives in chunk
+/// i / chunkSize() at index i % chunkSize().
+///
+/// Shaders can access the chunks either through a descriptor array (bindStorageBuffers()) or, with
+/// VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, through the device address table listing the address of each
+/// chunk.
+template <typename T, MemoryType memType = MemoryType::Device, VkBufferUsageFlags additionalFlags = 0>
+class ChunkedBuffer
+{
+  public:
+    using value_type = T;
+    using BufferType = Buffer<T, memType, additionalFlags>;
+    using AddressTableType = HostStagingBuffer<VkDeviceAddress>;
+
+    constexpr ChunkedBuffer() {}
+
+    /// A non zero maxChunkBytes further limits the size of the chunks.
+    explicit ChunkedBuffer(
+        const Device& device, const size_t size, const VkBufferUsageFlags usage = {},
+        const VkDeviceSize maxChunkBytes = 0)
+    {
+        VKW_CHECK_BOOL_FAIL(this->init(device, size, usage, maxChunkBytes), "Error creating chunked buffer");
+    }
+
+    ChunkedBuffer(const ChunkedBuffer&) = delete;
+    ChunkedBuffer(ChunkedBuffer&& rhs) { *this = std::move(rhs); }
+
+    ChunkedBuffer& operator=(const ChunkedBuffer&) = delete;
+    ChunkedBuffer& operator=(ChunkedBuffer&& rhs)
+    {
+        this->clear();
+
+        std::swap(device_, rhs.device_);
+        std::swap(usage_, rhs.usage_);
+        std::swap(size_, rhs.size_);
+        std::swap(chunkSize_, rhs.chunkSize_);
+        std::swap(chunks_, rhs.chunks_);
+        std::swap(addressTable_, rhs.addressTable_);
+
+        std::swap(initialized_, rhs.initialized_);
+
+        return *this;
+    }
+
+    ~ChunkedBuffer() { this->clear(); }
+
+    bool init(
+        const Device& device, const size_t size, const VkBufferUsageFlags usage = {},
+        const VkDeviceSize maxChunkBytes = 0)
+    {
+        VKW_ASSERT(this->initialized() == false);
+        VKW_ASSERT(size > 0);
+
+        device_ = &device;
+        usage_ = usage | additionalFlags;
+        size_ = size;
+
+        const VkDeviceSize chunkBytes = maxChunkSizeBytes(device, usage_, maxChunkBytes);
+        chunkSize_ = static_cast<size_t>(chunkBytes / sizeof(T));
+        if(chunkSize_ == 0)
+        {
+            utils::Log::Error("vkw", "Chunk size limit is smaller than a single element");
+            return false;
+        }
+
+        const size_t chunkCount = (size_ + chunkSize_ - 1) / chunkSize_;
+        chunks_.resize(chunkCount);
+        for(size_t i = 0; i < chunkCount; ++i)
+        {
+            const size_t count = std::min(chunkSize_, size_ - i * chunkSize_);
+            VKW_INIT_CHECK_BOOL(chunks_[i].init(device, count, usage_));
+        }
+
+        if(usage_ & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+        {
+            VKW_INIT_CHECK_BOOL(addressTable_.init(
+                device, chunkCount,
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT));
+            const auto addresses = deviceAddresses();
+            VKW_INIT_CHECK_BOOL(addressTable_.copyFromHost(addresses.data(), addresses.size()));
+        }
+
+        utils::Log::Verbose(
+            "vkw", "Chunked buffer: %zu elements in %zu chunks of %zu elements", size_, chunkCount,
+            chunkSize_);
+
+        initialized_ = true;
+
+        return true;
+    }
+
+    void clear()
+    {
+        addressTable_.clear();
+        chunks_.clear();
+
+        size_ = 0;
+        chunkSize_ = 0;
+        usage_ = {};
+
+        device_ = nullptr;
+
+        initialized_ = false;
+    }
+
+    bool initialized() const { return initialized_; }
+
+    /// Largest chunk size in bytes allowed by the device for the given usage.
+    static VkDeviceSize maxChunkSizeBytes(
+        const Device& device, const VkBufferUsageFlags usage, const VkDeviceSize maxChunkBytes = 0)
+    {
+        const auto& limits = device.getProperties().limits;
+
+        VkDeviceSize ret = std::min(device.maxMemoryAllocationSize(), device.maxBufferSize());
+        if(usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+        {
+            ret = std::min(ret, VkDeviceSize(limits.maxStorageBufferRange));
+        }
+        if(usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+        {
+            ret = std::min(ret, VkDeviceSize(limits.maxUniformBufferRange));
+        }
+        if(maxChunkBytes > 0) { ret = std::min(ret, maxChunkBytes); }
+
+        return ret;
+    }
+
+    VkBufferUsageFlags usage() const { return usage_; }
+
+    size_t size() const { return size_; }
+    size_t sizeBytes() const { return size_ * sizeof(T); }
+
+    size_t chunkSize() const { return chunkSize_; }
+    size_t chunkCount() const { return chunks_.size(); }
+
+    const BufferType& chunk(const size_t i) const { return chunks_[i]; }
+    BufferType& chunk(const size_t i) { return chunks_[i]; }
+
+    const auto& chunks() const { return chunks_; }
+
+    size_t chunkIndex(const size_t i) const { return i / chunkSize_; }
+    size_t chunkOffset(const size_t i) const { return i % chunkSize_; }
+
+    /// Calls fn(chunkIndex, chunkOffset, count, rangeOffset) for each part of [offset, offset + count) lying
+    /// in a single chunk, rangeOffset being the position of the part in the range.
+    template <typename Fn>
+    void forEachChunk(const size_t offset, const size_t count, Fn&& fn) const
+    {
+        VKW_ASSERT(offset + count <= size_);
+
+        size_t done = 0;
+        while(done < count)
+        {
+            const size_t index = chunkIndex(offset + done);
+            const size_t chunkOff = chunkOffset(offset + done);
+            const size_t n = std::min(count - done, chunkSize_ - chunkOff);
+            fn(index, chunkOff, n, done);
+            done += n;
+        }
+    }
+
+    // -------------------------------------------------------------------------------------------------------
+    // --------------------------------------- Host copies ---------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    bool copyFromHost(const T* src, const size_t offset, const size_t count)
+    {
+        static_assert(memType != MemoryType::Device, "Host copies require a host visible memory type");
+        VKW_ASSERT(this->initialized());
+
+        bool ret = true;
+        forEachChunk(
+            offset, count, [&](const size_t index, const size_t off, const size_t n, const size_t i) {
+                ret = ret && chunks_[index].copyFromHost(src + i, off, n);
+            });
+        return ret;
+    }
+    bool copyFromHost(const T* src, const size_t count) { return copyFromHost(src, 0, count); }
+
+    bool copyToHost(T* dst, const size_t offset, const size_t count) const
+    {
+        static_assert(memType != MemoryType::Device, "Host copies require a host visible memory type");
+        VKW_ASSERT(this->initialized());
+
+        bool ret = true;
+        forEachChunk(
+            offset, count, [&](const size_t index, const size_t off, const size_t n, const size_t i) {
+                ret = ret && chunks_[index].copyToHost(dst + i, off, n);
+            });
+        return ret;
+    }
+    bool copyToHost(T* dst, const size_t count) const { return copyToHost(dst, 0, count); }
+
+    // -------------------------------------------------------------------------------------------------------
+    // -------------------------------------- Device copies --------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    /// Records the copy of count elements of src, starting at srcOffset, to this array at dstOffset.
+    void copyFrom(
+        const CommandBuffer& cmdBuffer, const BaseBuffer& src, const size_t srcOffset, const size_t dstOffset,
+        const size_t count)
+    {
+        VKW_ASSERT(this->initialized());
+        VKW_ASSERT(src.sizeBytes() >= (srcOffset + count) * sizeof(T));
+
+        forEachChunk(
+            dstOffset, count, [&](const size_t index, const size_t off, const size_t n, const size_t i) {
+                VkBufferCopy region = {};
+                region.srcOffset = (srcOffset + i) * sizeof(T);
+                region.dstOffset = off * sizeof(T);
+                region.size = n * sizeof(T);
+                cmdBuffer.copyBuffer(src, chunks_[index], std::span<VkBufferCopy>{&region, 1});
+            });
+    }
+
+    /// Records the copy of count elements of this array, starting at srcOffset, to dst at dstOffset.
+    void copyTo(
+        const CommandBuffer& cmdBuffer, const BaseBuffer& dst, const size_t srcOffset, const size_t dstOffset,
+        const size_t count) const
+    {
+        VKW_ASSERT(this->initialized());
+        VKW_ASSERT(dst.sizeBytes() >= (dstOffset + count) * sizeof(T));
+
+        forEachChunk(
+            srcOffset, count, [&](const size_t index, const size_t off, const size_t n, const size_t i) {
+                VkBufferCopy region = {};
+                region.srcOffset = off * sizeof(T);
+                region.dstOffset = (dstOffset + i) * sizeof(T);
+                region.size = n * sizeof(T);
+                cmdBuffer.copyBuffer(chunks_[index], dst, std::span<VkBufferCopy>{&region, 1});
+            });
+    }
+
+    /// Records the copy of count elements between two chunked arrays, which may have different chunk sizes.
+    template <MemoryType srcMemType, VkBufferUsageFlags srcFlags>
+    void copyFrom(
+        const CommandBuffer& cmdBuffer, const ChunkedBuffer<T, srcMemType, srcFlags>& src,
+        const size_t srcOffset, const size_t dstOffset, const size_t count)
+    {
+        VKW_ASSERT(this->initialized());
+
+        // Split along the source chunks, then along the destination chunks
+        const auto srcCopy = [&](const size_t srcIndex, const size_t srcOff, const size_t n, const size_t i) {
+            const auto& srcChunk = src.chunk(srcIndex);
+            forEachChunk(
+                dstOffset + i, n, [&](const size_t index, const size_t off, const size_t m, const size_t j) {
+                    VkBufferCopy region = {};
+                    region.srcOffset = (srcOff + j) * sizeof(T);
+                    region.dstOffset = off * sizeof(T);
+                    region.size = m * sizeof(T);
+                    cmdBuffer.copyBuffer(srcChunk, chunks_[index], std::span<VkBufferCopy>{&region, 1});
+                });
+        };
+        src.forEachChunk(srcOffset, count, srcCopy);
+    }
+
+    // -------------------------------------------------------------------------------------------------------
+    // ------------------------------------ Shader access ----------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    std::vector<VkBuffer> handles() const
+    {
+        std::vector<VkBuffer> ret;
+        ret.reserve(chunks_.size());
+        for(const auto& chunk : chunks_) { ret.push_back(chunk.getHandle()); }
+        return ret;
+    }
+
+    std::vector<VkDescriptorBufferInfo> getDescriptorInfos() const
+    {
+        std::vector<VkDescriptorBufferInfo> ret;
+        ret.reserve(chunks_.size());
+        for(const auto& chunk : chunks_) { ret.push_back(chunk.getFullSizeInfo()); }
+        return ret;
+    }
+
+    /// Binds one descriptor per chunk in the storage buffer array at the given binding, starting at
+    /// firstIndex. The array must hold at least chunkCount() descriptors.
+    DescriptorSet& bindStorageBuffers(
+        DescriptorSet& descriptorSet, const uint32_t binding, const uint32_t firstIndex = 0) const
+    {
+        VKW_ASSERT(this->initialized());
+        auto buffers = handles();
+        return descriptorSet.bindStorageBuffers(binding, firstIndex, std::span<VkBuffer>{buffers});
+    }
+
+    std::vector<VkDeviceAddress> deviceAddresses() const
+    {
+        std::vector<VkDeviceAddress> ret;
+        ret.reserve(chunks_.size());
+        for(const auto& chunk : chunks_) { ret.push_back(chunk.deviceAddress()); }
+        return ret;
+    }
+
+    /// Buffer holding the device address of each chunk, only available with
+    /// VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT. The table is small and written once from the host, it lives
+    /// in host visible memory.
+    const AddressTableType& addressTable() const
+    {
+        VKW_ASSERT(addressTable_.initialized());
+        return addressTable_;
+    }
+
+  private:
+    const Device* device_{nullptr};
+    VkBufferUsageFlags usage_{};
+
+    size_t size_{0};
+    size_t chunkSize_{0};
+    std::vector<BufferType> chunks_{};
+
+    AddressTableType addressTable_{};
+
+    bool initialized_{false};
+};
+} // namespace vkw
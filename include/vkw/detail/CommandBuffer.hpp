@@ -31,6 +31,8 @@
 #include "vkw/detail/GraphicsPipeline.hpp"
 #include "vkw/detail/Image.hpp"
 #include "vkw/detail/Instance.hpp"
+#include "vkw/detail/RayTracingPipeline.hpp"
+#include "vkw/detail/ReadbackRing.hpp"
 #include "vkw/detail/RenderPass.hpp"
 #include "vkw/detail/RenderingAttachment.hpp"
 #include "vkw/detail/Synchronization.hpp"
@@ -41,6 +43,14 @@
 
 namespace vkw
 {
+class AccelerationStructureCompactor;
+class AccelerationStructureScratchPool;
+class BufferCopyKernels;
+class DeferredDeletionQueue;
+class MipmapGenerator;
+class ShaderBindingTable;
+class TlasInstanceGenerator;
+
 class CommandBuffer
 {
   public:
@@ -77,6 +87,18 @@ class CommandBuffer
         const BaseBuffer& src, const BaseBuffer& dst, const std::span<VkBufferCopy>& regions) const;
     const CommandBuffer& copyBuffer(const BaseBuffer& src, const BaseBuffer& dst) const;
 
+    /// Same as copyBuffer() but sorts and merges the regions first, see utils::optimizeCopyRegions().
+    const CommandBuffer& copyBufferCoalesced(
+        const BaseBuffer& src, const BaseBuffer& dst, std::vector<VkBufferCopy> regions,
+        utils::CopyRegionStats* stats = nullptr) const;
+    /// Same as above, with the regions split to at most maxRegionSize bytes. Each part is recorded as its own
+    /// copy command and betweenParts(partIndex) is called after each part but the last one, so that other
+    /// commands can be recorded between the parts of a large copy.
+    const CommandBuffer& copyBufferCoalesced(
+        const BaseBuffer& src, const BaseBuffer& dst, std::vector<VkBufferCopy> regions,
+        const VkDeviceSize maxRegionSize, const std::function<void(const size_t)>& betweenParts,
+        utils::CopyRegionStats* stats = nullptr) const;
+
     const CommandBuffer& fillBuffer(
         const BaseBuffer& buffer, const uint32_t val, const size_t offset, const size_t size) const;
 
@@ -109,6 +131,59 @@ class CommandBuffer
         const VkImage src, const VkImageLayout srcLayout, const VkImage dst, const VkImageLayout dstLayout,
         const std::span<VkImageBlit>& regions, const VkFilter filter = VK_FILTER_LINEAR) const;
 
+    /// Generates the full mip chain of several images at once. Level 0 of each image must be in
+    /// initialLayout, all levels end up in finalLayout. Levels are processed in lockstep across images with a
+    /// single barrier batch per level so the blits of different images can overlap. Images whose format does
+    /// not support linear blits are downsampled with the compute fallback if one is given, and skipped
+    /// otherwise.
+    const CommandBuffer& generateMipmaps(
+        const std::vector<std::reference_wrapper<const BaseImage>>& images,
+        const VkImageLayout initialLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        const VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        MipmapGenerator* computeFallback = nullptr) const;
+
+    /// Copies count records of stride bytes, dst[i] = src[indices[i]], with a compute kernel. The index
+    /// buffer holds 32 bit record indices. Accesses to the buffers must be synchronized with the compute
+    /// shader stage.
+    const CommandBuffer& gatherBuffer(
+        const BufferCopyKernels& kernels, const BaseBuffer& src, const BaseBuffer& dst,
+        const BaseBuffer& indexBuffer, const uint32_t stride, const uint32_t count) const;
+
+    /// Same as gatherBuffer() with dst[indices[i]] = src[i], the indices must be unique.
+    const CommandBuffer& scatterBuffer(
+        const BufferCopyKernels& kernels, const BaseBuffer& src, const BaseBuffer& dst,
+        const BaseBuffer& indexBuffer, const uint32_t stride, const uint32_t count) const;
+
+    /// Repacks count records of stride bytes into stride / 4 contiguous arrays of count 32 bit fields.
+    const CommandBuffer& transposeAoSToSoA(
+        const BufferCopyKernels& kernels, const BaseBuffer& src, const BaseBuffer& dst, const uint32_t stride,
+        const uint32_t count) const;
+
+    // -------------------------------------------------------------------------------------------------------
+    // ------------------------------------ Readback ---------------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    /// Copies count elements of the buffer, starting at element offset, in the readback ring. The future
+    /// becomes ready once the ring timeline reaches signalValue, that must be signaled by the submission
+    /// containing this command buffer. Writes to the source buffer must be made available to the transfer
+    /// stage before this call.
+    template <typename T>
+    ReadbackFuture<T> readback(
+        ReadbackRing& ring, const BaseBuffer& buffer, const size_t offset, const size_t count,
+        const uint64_t signalValue) const
+    {
+        const auto allocation = ring.allocate(count * sizeof(T), alignof(T), signalValue);
+        if(allocation.id == 0) { return {}; }
+
+        this->recordReadback(ring, buffer, offset * sizeof(T), allocation);
+        return ReadbackFuture<T>(ring, allocation, count);
+    }
+    template <typename T>
+    ReadbackFuture<T> readback(ReadbackRing& ring, const BaseBuffer& buffer, const uint64_t signalValue) const
+    {
+        return readback<T>(ring, buffer, 0, buffer.sizeBytes() / sizeof(T), signalValue);
+    }
+
     // -------------------------------------------------------------------------------------------------------
     // ----------------------------------- Pipeline barriers -------------------------------------------------
     // -------------------------------------------------------------------------------------------------------
@@ -172,6 +247,14 @@ class CommandBuffer
         return imageMemoryBarriers({}, barriers);
     }
 
+    /// Transitions a range of an image with layout tracking enabled. Only the subresources whose state
+    /// requires it are transitioned, no barrier is recorded for read after read accesses in the same layout.
+    const CommandBuffer& transition(
+        BaseImage& image, const VkImageLayout newLayout, const VkPipelineStageFlags2 stages,
+        const VkAccessFlags2 access, const uint32_t baseLevel = 0,
+        const uint32_t levelCount = VK_REMAINING_MIP_LEVELS, const uint32_t baseLayer = 0,
+        const uint32_t layerCount = VK_REMAINING_ARRAY_LAYERS) const;
+
     const CommandBuffer& pipelineBarrier(
         const VkPipelineStageFlags srcFlags, const VkPipelineStageFlags dstFlags,
         const std::span<VkMemoryBarrier>& memoryBarriers,
@@ -542,7 +625,21 @@ class CommandBuffer
     const CommandBuffer& buildAccelerationStructure(
         const TopLevelAccelerationStructure& tlas, const BaseBuffer& scratchBuffer,
         const VkBuildAccelerationStructureFlagsKHR buildFlags = {}) const;
+    /// Uploads the dirty instances before building the structure.
+    const CommandBuffer& buildAccelerationStructure(
+        TopLevelAccelerationStructure& tlas, const BaseBuffer& scratchBuffer,
+        const VkBuildAccelerationStructureFlagsKHR buildFlags = {}) const;
 
+    /// Refits the structure in place, it must have been built with
+    /// VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR and the same flags. Once blas.needsRebuild(), the
+    /// structure is rebuilt instead and the scratch buffer must hold buildScratchSize() bytes. Compacted
+    /// structures are never rebuilt, building them again is refused.
+    const CommandBuffer& updateAccelerationStructure(
+        BottomLevelAccelerationStructure& blas, const BaseBuffer& scratchBuffer,
+        const VkBuildAccelerationStructureFlagsKHR buildFlags = {}) const;
+    /// Both versions upload the dirty instances first, only the transforms that changed are flagged dirty.
+    /// The instance count must be the one of the last build, see
+    /// TopLevelAccelerationStructure::setInstanceCount().
     const CommandBuffer& updateAccelerationStructure(
         TopLevelAccelerationStructure& tlas, const BaseBuffer& scratchBuffer,
         const VkBuildAccelerationStructureFlagsKHR buildFlags = {}) const;
@@ -550,16 +647,91 @@ class CommandBuffer
         TopLevelAccelerationStructure& tlas, const std::span<VkTransformMatrixKHR>& transforms,
         const BaseBuffer& scratchBuffer, const VkBuildAccelerationStructureFlagsKHR buildFlags = {}) const;
 
-    ///@todo Implement buildAccelerationStructures()
+    /// Copies the instances modified since the last upload to the TLAS instance buffer, contiguous dirty
+    /// instances being copied with a single region. The staging memory is rewritten by each upload, the
+    /// previous upload must have completed.
+    const CommandBuffer& uploadInstances(
+        TopLevelAccelerationStructure& tlas, utils::CopyRegionStats* stats = nullptr) const;
+
+    /// Makes writes done at srcStage visible to the acceleration structure builds reading them as build
+    /// inputs (geometry, instances). The second version covers every buffer.
+    const CommandBuffer& buildInputBarrier(
+        const BaseBuffer& buffer, const VkPipelineStageFlags srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT,
+        const VkAccessFlags srcAccess = VK_ACCESS_TRANSFER_WRITE_BIT) const;
+    const CommandBuffer& buildInputBarrier(
+        const VkPipelineStageFlags srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT,
+        const VkAccessFlags srcAccess = VK_ACCESS_TRANSFER_WRITE_BIT) const;
+
+    /// Builds all the structures with a single command, each one using its own region of the scratch pool.
+    /// The pool must have room for scratchPool.requiredSize(blasList), nothing is recorded otherwise.
+    const CommandBuffer& buildAccelerationStructures(
+        const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList,
+        AccelerationStructureScratchPool& scratchPool,
+        const VkBuildAccelerationStructureFlagsKHR buildFlags = {}) const;
+
+    /// Batched version of updateAccelerationStructure(), structures needing a rebuild are rebuilt in the same
+    /// command. The pool must have room for scratchPool.requiredSize(blasList, true).
+    const CommandBuffer& updateAccelerationStructures(
+        const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList,
+        AccelerationStructureScratchPool& scratchPool,
+        const VkBuildAccelerationStructureFlagsKHR buildFlags = {}) const;
+
+    /// Fills a TLAS instance buffer on the GPU, see TlasInstanceGenerator.
+    const CommandBuffer& generateInstances(
+        const TlasInstanceGenerator& generator, const BaseBuffer& transforms, const BaseBuffer& descriptors,
+        const BaseBuffer& blasAddresses, const BaseBuffer& instances, const uint32_t instanceCount,
+        const uint32_t blasCount) const;
+
     ///@todo Implement buildAccelerationStructureIndirect
     ///@todo Implement buildAccelerationStructuresIndirect()
-    ///@todo Implement copyAccelerationStructure()
+
+    const CommandBuffer& copyAccelerationStructure(
+        const BaseAccelerationStructure& src, const BaseAccelerationStructure& dst,
+        const VkCopyAccelerationStructureModeKHR mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_CLONE_KHR) const;
+
+    /// Writes the compacted size of freshly built structures, see AccelerationStructureCompactor.
+    const CommandBuffer& writeCompactedSizes(
+        AccelerationStructureCompactor& compactor,
+        const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList) const;
+
+    /// Replaces the structures by compacted copies, the original storage is retired in deletionQueue.
+    const CommandBuffer& compactAccelerationStructures(
+        AccelerationStructureCompactor& compactor,
+        const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList,
+        DeferredDeletionQueue& deletionQueue, const uint64_t timelineValue) const;
 
     // -------------------------------------------------------------------------------------------------------
+    // ------------------------------- Ray tracing pipelines -------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
 
-    ///@todo Implement setRayTracingPipelineStackSize()
-    ///@todo Implement traceRaysIndirect()
-    ///@todo Implement traceRays()
+    const CommandBuffer& bindRayTracingPipeline(const RayTracingPipeline& pipeline) const;
+
+    const CommandBuffer& bindRayTracingDescriptorSet(
+        const PipelineLayout& pipelineLayout, const uint32_t firstSet,
+        const DescriptorSet& descriptorSet) const;
+    const CommandBuffer& bindRayTracingDescriptorSet(
+        const PipelineLayout& pipelineLayout, const uint32_t firstSet,
+        const VkDescriptorSet descriptorSet) const;
+
+    /// The pipeline must have been created with VK_DYNAMIC_STATE_RAY_TRACING_PIPELINE_STACK_SIZE_KHR.
+    const CommandBuffer& setRayTracingPipelineStackSize(const uint32_t stackSize) const;
+
+    /// Copies the records modified since the last upload to the table buffer, the staging memory is rewritten
+    /// by each upload, the previous upload must have completed.
+    const CommandBuffer& uploadShaderBindingTable(
+        ShaderBindingTable& sbt, utils::CopyRegionStats* stats = nullptr) const;
+
+    const CommandBuffer& traceRays(
+        const ShaderBindingTable& sbt, const uint32_t width, const uint32_t height, const uint32_t depth = 1,
+        const uint32_t rayGenIndex = 0) const;
+    /// The indirect buffer holds a VkTraceRaysIndirectCommandKHR.
+    const CommandBuffer& traceRaysIndirect(
+        const ShaderBindingTable& sbt, const BaseBuffer& indirectBuffer, const VkDeviceSize offset = 0,
+        const uint32_t rayGenIndex = 0) const;
+    /// The indirect buffer holds a VkTraceRaysIndirectCommand2KHR, see ShaderBindingTable::indirectCommand().
+    /// Requires VK_KHR_ray_tracing_maintenance1.
+    const CommandBuffer& traceRaysIndirect2(
+        const BaseBuffer& indirectBuffer, const VkDeviceSize offset = 0) const;
 
     // -------------------------------------------------------------------------------------------------------
     // ------------------------------------ Debug utils-------------------------------------------------------
@@ -575,6 +747,15 @@ class CommandBuffer
     VkCommandBuffer getHandle() const { return commandBuffer_; }
 
   private:
+    const CommandBuffer& recordBottomLevelBuilds(
+        const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList,
+        AccelerationStructureScratchPool& scratchPool, const VkBuildAccelerationStructureFlagsKHR buildFlags,
+        const bool update) const;
+
+    void recordReadback(
+        const ReadbackRing& ring, const BaseBuffer& buffer, const VkDeviceSize srcOffset,
+        const ReadbackRing::Allocation& allocation) const;
+
     const Device* device_{nullptr};
     VkCommandPool cmdPool_{VK_NULL_HANDLE};
     VkCommandBuffer commandBuffer_{VK_NULL_HANDLE};
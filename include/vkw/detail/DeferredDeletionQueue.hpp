@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/Synchronization.hpp"
+#include "vkw/detail/utils.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace vkw
+{
+/// Keeps resources alive until the GPU is done with them.
+///
+/// Each retired resource is tagged with a timeline value, it is destroyed by collect() once the timeline
+/// reached this value. Destroying the queue destroys all the remaining resources, the device must be idle
+/// at that point.
+class DeferredDeletionQueue
+{
+  public:
+    DeferredDeletionQueue() {}
+
+    DeferredDeletionQueue(const DeferredDeletionQueue&) = delete;
+    DeferredDeletionQueue(DeferredDeletionQueue&& rhs);
+
+    DeferredDeletionQueue& operator=(const DeferredDeletionQueue&) = delete;
+    DeferredDeletionQueue& operator=(DeferredDeletionQueue&& rhs);
+
+    ~DeferredDeletionQueue();
+
+    /// Destroys all the pending resources
+    void clear();
+
+    /// Takes ownership of the resource, destroyed once the timeline reaches timelineValue. Only accepts
+    /// rvalues so that the caller's object is never moved from silently, callables go to the overload below.
+    template <
+        typename ResourceType,
+        typename = std::enable_if_t<
+            !std::is_lvalue_reference_v<ResourceType> && !std::is_invocable_v<ResourceType>>>
+    void retire(ResourceType&& resource, const uint64_t timelineValue)
+    {
+        using Type = std::remove_cvref_t<ResourceType>;
+        entries_.push_back({timelineValue, std::make_shared<Type>(std::move(resource)), {}});
+    }
+
+    /// Invokes the function once the timeline reaches timelineValue.
+    void retire(std::function<void()>&& deleter, const uint64_t timelineValue);
+
+    /// Destroys the resources whose timeline value is lower or equal to completedValue.
+    size_t collect(const uint64_t completedValue);
+    size_t collect(const TimelineSemaphore& timeline) { return collect(timeline.getValue()); }
+
+    size_t pendingCount() const { return entries_.size(); }
+
+  private:
+    struct Entry
+    {
+        uint64_t timelineValue;
+        std::shared_ptr<void> resource;
+        std::function<void()> deleter;
+    };
+
+    std::vector<Entry> entries_{};
+};
+} // namespace vkw
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/Device.hpp"
+#include "vkw/detail/ThreadPool.hpp"
+
+#include <cstdint>
+#include <future>
+#include <memory>
+
+namespace vkw
+{
+/// Wraps a VkDeferredOperationKHR (VK_KHR_deferred_host_operations) and joins it from worker threads.
+///
+/// A deferred command (for instance a host acceleration structure build) is launched with getHandle(), its
+/// return value is then passed to join() that distributes the operation on the threads of a pool, up to the
+/// concurrency reported by the implementation. The returned future holds the result of the operation.
+///
+/// Data referenced by the deferred command must stay valid until the operation completes, it can be handed
+/// over to join() that releases it once done. Operations can be reused once complete, see wait().
+class DeferredHostOperation
+{
+  public:
+    DeferredHostOperation() {}
+    explicit DeferredHostOperation(const Device& device);
+
+    DeferredHostOperation(const DeferredHostOperation&) = delete;
+    DeferredHostOperation(DeferredHostOperation&& rhs);
+
+    DeferredHostOperation& operator=(const DeferredHostOperation&) = delete;
+    DeferredHostOperation& operator=(DeferredHostOperation&& rhs);
+
+    ~DeferredHostOperation();
+
+    bool init(const Device& device);
+
+    /// Waits for the pending operation before destroying it.
+    void clear();
+
+    /// Waits for the operation launched by the last join(), the handle can then be used for a new command.
+    void wait();
+
+    bool initialized() const { return initialized_; }
+
+    VkDeferredOperationKHR getHandle() const { return deferredOperation_; }
+
+    /// True when no operation was launched or when the last one completed.
+    bool complete() const;
+
+    /// Number of threads that can usefully join the operation, 0 when it is complete.
+    uint32_t maxConcurrency() const;
+
+    /// Joins the operation from at most min(maxConcurrency(), pool.threadCount()) workers of the pool.
+    /// launchResult is the value returned by the deferred command: when the command was not deferred or
+    /// failed, the returned future is ready right away.
+    std::shared_future<VkResult> join(
+        const VkResult launchResult, utils::ThreadPool& pool, std::shared_ptr<void> keepAlive = {});
+
+    /// Future holding the result of the command, for commands launched without deferred operation.
+    static std::shared_future<VkResult> readyResult(const VkResult result);
+
+  private:
+    const Device* device_{nullptr};
+
+    VkDeferredOperationKHR deferredOperation_{VK_NULL_HANDLE};
+    std::shared_future<VkResult> pending_{};
+
+    bool initialized_{false};
+};
+} // namespace vkw
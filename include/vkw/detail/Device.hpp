@@ -86,6 +86,20 @@ class Device
     std::vector<MemoryBudget> getMemoryBudget() const;
 
     auto bufferMemoryAddressEnabled() const { return useDeviceBufferAddress_; }
+    auto memoryBudgetEnabled() const { return useMemoryBudget_; }
+    auto externalMemoryHostEnabled() const { return useExternalMemoryHost_; }
+    auto minImportedHostPointerAlignment() const { return minImportedHostPointerAlignment_; }
+    auto hostImageCopyEnabled() const { return useHostImageCopy_; }
+
+    auto maxMemoryAllocationSize() const { return maxMemoryAllocationSize_; }
+    auto maxBufferSize() const { return maxBufferSize_; }
+
+    auto accelerationStructureEnabled() const { return useAccelerationStructure_; }
+    const auto& accelerationStructureProperties() const { return accelerationStructureProperties_; }
+
+    auto rayTracingPipelineEnabled() const { return useRayTracingPipeline_; }
+    const auto& rayTracingPipelineProperties() const { return rayTracingPipelineProperties_; }
+    auto rayTracingMaintenance1Enabled() const { return useRayTracingMaintenance1_; }
 
     VkPhysicalDeviceFeatures getFeatures() const { return deviceFeatures_; }
     VkPhysicalDeviceProperties getProperties() const { return deviceProperties_; }
@@ -165,6 +179,17 @@ class Device
     VkDevice device_{VK_NULL_HANDLE};
 
     VkBool32 useDeviceBufferAddress_{VK_FALSE};
+    VkBool32 useMemoryBudget_{VK_FALSE};
+    VkBool32 useExternalMemoryHost_{VK_FALSE};
+    VkDeviceSize minImportedHostPointerAlignment_{0};
+    VkBool32 useHostImageCopy_{VK_FALSE};
+    VkDeviceSize maxMemoryAllocationSize_{0};
+    VkDeviceSize maxBufferSize_{0};
+    VkBool32 useAccelerationStructure_{VK_FALSE};
+    VkPhysicalDeviceAccelerationStructurePropertiesKHR accelerationStructureProperties_{};
+    VkBool32 useRayTracingPipeline_{VK_FALSE};
+    VkPhysicalDeviceRayTracingPipelinePropertiesKHR rayTracingPipelineProperties_{};
+    VkBool32 useRayTracingMaintenance1_{VK_FALSE};
 
     bool initialized_{false};
 
@@ -173,6 +198,7 @@ class Device
     std::vector<VkDeviceQueueCreateInfo> getAvailableQueuesInfo();
 
     void validateAdditionalFeatures(const VkBaseOutStructure* pCreateNext);
+    void validateAdditionalExtensions(const std::vector<const char*>& extensions);
 
     static bool validateFeatures(
         const VkPhysicalDevice physicalDevice, const VkPhysicalDeviceFeatures& curFeature);
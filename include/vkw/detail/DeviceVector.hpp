@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Buffer.hpp"
+#include "vkw/detail/CommandBuffer.hpp"
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/DeferredDeletionQueue.hpp"
+#include "vkw/detail/Device.hpp"
+#include "vkw/detail/MemoryCommon.hpp"
+#include "vkw/detail/utils.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace vkw
+{
+/// Growable buffer with amortized reallocations.
+///
+/// When the capacity is exceeded, a new buffer is allocated with a geometric growth and the current content
+/// is copied on the device using the provided command buffer. The previous buffer is retired in the
+/// deletion queue and destroyed once the timeline reaches the given retire value, which must be signaled
+/// by the submission of that command buffer (or a later one).
+///
+/// Each reallocation increments version(), descriptor sets referencing the buffer must be updated when it
+/// changes.
+template <typename T, MemoryType memType = MemoryType::Device, VkBufferUsageFlags additionalFlags = 0>
+class DeviceVector
+{
+  public:
+    using value_type = T;
+    static constexpr VkBufferUsageFlags bufferUsage
+        = additionalFlags | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    using BufferType = Buffer<T, memType, bufferUsage>;
+
+    static constexpr float growthFactor = 2.0f;
+
+    constexpr DeviceVector() {}
+
+    explicit DeviceVector(
+        const Device& device, DeferredDeletionQueue& deletionQueue, const size_t capacity = 0,
+        const VkBufferUsageFlags usage = {})
+    {
+        VKW_CHECK_BOOL_FAIL(
+            this->init(device, deletionQueue, capacity, usage), "Error creating device vector");
+    }
+
+    DeviceVector(const DeviceVector&) = delete;
+    DeviceVector(DeviceVector&& rhs) { *this = std::move(rhs); }
+
+    DeviceVector& operator=(const DeviceVector&) = delete;
+    DeviceVector& operator=(DeviceVector&& rhs)
+    {
+        this->clear();
+
+        std::swap(device_, rhs.device_);
+        std::swap(deletionQueue_, rhs.deletionQueue_);
+        std::swap(usage_, rhs.usage_);
+        std::swap(buffer_, rhs.buffer_);
+        std::swap(size_, rhs.size_);
+        std::swap(version_, rhs.version_);
+
+        std::swap(initialized_, rhs.initialized_);
+
+        return *this;
+    }
+
+    ~DeviceVector() { this->clear(); }
+
+    bool init(
+        const Device& device, DeferredDeletionQueue& deletionQueue, const size_t capacity = 0,
+        const VkBufferUsageFlags usage = {})
+    {
+        VKW_ASSERT(this->initialized() == false);
+
+        device_ = &device;
+        deletionQueue_ = &deletionQueue;
+        usage_ = usage;
+
+        if(capacity > 0) { VKW_INIT_CHECK_BOOL(buffer_.init(device, capacity, usage_)); }
+
+        size_ = 0;
+        version_ = 0;
+
+        initialized_ = true;
+
+        return true;
+    }
+
+    void clear()
+    {
+        buffer_.clear();
+
+        size_ = 0;
+        version_ = 0;
+        usage_ = {};
+
+        deletionQueue_ = nullptr;
+        device_ = nullptr;
+
+        initialized_ = false;
+    }
+
+    bool initialized() const { return initialized_; }
+
+    const BufferType& buffer() const { return buffer_; }
+
+    size_t size() const { return size_; }
+    size_t sizeBytes() const { return size_ * sizeof(T); }
+    size_t capacity() const { return buffer_.initialized() ? buffer_.size() : 0; }
+    bool empty() const { return size_ == 0; }
+
+    /// Incremented each time the underlying buffer changes.
+    uint64_t version() const { return version_; }
+
+    VkDescriptorBufferInfo getDescriptorInfo() const { return buffer_.getDescriptorInfo(0, size_); }
+
+    // -------------------------------------------------------------------------------------------------------
+    // ------------------------------------ Size management --------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    /// Makes sure the capacity is at least newCapacity, reallocating the buffer if needed.
+    bool reserve(const CommandBuffer& cmdBuffer, const size_t newCapacity, const uint64_t retireValue)
+    {
+        VKW_ASSERT(this->initialized());
+
+        if(newCapacity <= capacity()) { return true; }
+
+        BufferType newBuffer{};
+        VKW_CHECK_BOOL_RETURN_FALSE(newBuffer.init(*device_, newCapacity, usage_));
+
+        if(size_ > 0)
+        {
+            VkBufferCopy region = {};
+            region.srcOffset = 0;
+            region.dstOffset = 0;
+            region.size = size_ * sizeof(T);
+            cmdBuffer.copyBuffer(buffer_, newBuffer, std::span<VkBufferCopy>{&region, 1});
+        }
+
+        if(buffer_.initialized()) { deletionQueue_->retire(std::move(buffer_), retireValue); }
+        buffer_ = std::move(newBuffer);
+        version_++;
+
+        return true;
+    }
+
+    /// Changes the number of elements, new elements are left uninitialized.
+    bool resize(const CommandBuffer& cmdBuffer, const size_t newSize, const uint64_t retireValue)
+    {
+        VKW_ASSERT(this->initialized());
+
+        VKW_CHECK_BOOL_RETURN_FALSE(grow(cmdBuffer, newSize, retireValue));
+        size_ = newSize;
+
+        return true;
+    }
+
+    /// Appends count elements copied on the device from src, starting at element srcOffset.
+    bool push_back_batch(
+        const CommandBuffer& cmdBuffer, const BaseBuffer& src, const size_t srcOffset, const size_t count,
+        const uint64_t retireValue)
+    {
+        VKW_ASSERT(this->initialized());
+        VKW_ASSERT(src.sizeBytes() >= (srcOffset + count) * sizeof(T));
+
+        if(count == 0) { return true; }
+
+        VKW_CHECK_BOOL_RETURN_FALSE(grow(cmdBuffer, size_ + count, retireValue));
+
+        VkBufferCopy region = {};
+        region.srcOffset = srcOffset * sizeof(T);
+        region.dstOffset = size_ * sizeof(T);
+        region.size = count * sizeof(T);
+        cmdBuffer.copyBuffer(src, buffer_, std::span<VkBufferCopy>{&region, 1});
+        size_ += count;
+
+        return true;
+    }
+
+    /// Appends count elements copied from the host, only available if the buffer is host visible.
+    bool push_back_batch(
+        const CommandBuffer& cmdBuffer, const T* data, const size_t count, const uint64_t retireValue)
+    {
+        static_assert(memType != MemoryType::Device, "Host copies require a host visible memory type");
+        VKW_ASSERT(this->initialized());
+
+        if(count == 0) { return true; }
+
+        VKW_CHECK_BOOL_RETURN_FALSE(grow(cmdBuffer, size_ + count, retireValue));
+        VKW_ASSERT(buffer_.hostVisible());
+        VKW_CHECK_BOOL_RETURN_FALSE(buffer_.copyFromHost(data, size_, count));
+        size_ += count;
+
+        return true;
+    }
+
+  private:
+    const Device* device_{nullptr};
+    DeferredDeletionQueue* deletionQueue_{nullptr};
+
+    VkBufferUsageFlags usage_{};
+    BufferType buffer_{};
+
+    size_t size_{0};
+    uint64_t version_{0};
+
+    bool initialized_{false};
+
+    bool grow(const CommandBuffer& cmdBuffer, const size_t requiredSize, const uint64_t retireValue)
+    {
+        if(requiredSize <= capacity()) { return true; }
+
+        const auto grownCapacity = static_cast<size_t>(growthFactor * static_cast<float>(capacity()));
+        return reserve(cmdBuffer, std::max(requiredSize, grownCapacity), retireValue);
+    }
+};
+} // namespace vkw
@@ -24,9 +24,12 @@
 
 #include "vkw/detail/Common.hpp"
 #include "vkw/detail/Device.hpp"
+#include "vkw/detail/ImageLayoutTracker.hpp"
 #include "vkw/detail/MemoryCommon.hpp"
 #include "vkw/detail/utils.hpp"
 
+#include <algorithm>
+
 namespace vkw
 {
 class BaseImage
@@ -45,8 +48,15 @@ class BaseImage
     virtual VkImageUsageFlags usage() const = 0;
     virtual VkImage getHandle() const = 0;
 
+    virtual VkImageType imageType() const = 0;
     virtual VkExtent3D extent() const = 0;
     virtual VkFormat format() const = 0;
+    virtual uint32_t mipLevels() const = 0;
+    virtual uint32_t arrayLayers() const = 0;
+
+    /// Layout tracker of the image, nullptr if layout tracking is not enabled.
+    virtual ImageLayoutTracker* layoutTracker() = 0;
+    virtual const ImageLayoutTracker* layoutTracker() const = 0;
 
   protected:
     BaseImage() = default;
@@ -90,13 +100,18 @@ class Image : public BaseImage
 
         std::swap(image_, rhs.image_);
 
+        std::swap(imageType_, rhs.imageType_);
         std::swap(format_, rhs.format_);
         std::swap(extent_, rhs.extent_);
+        std::swap(mipLevels_, rhs.mipLevels_);
+        std::swap(arrayLayers_, rhs.arrayLayers_);
         std::swap(usage_, rhs.usage_);
 
         std::swap(allocInfo_, rhs.allocInfo_);
         std::swap(memAllocation_, rhs.memAllocation_);
 
+        std::swap(layoutTracker_, rhs.layoutTracker_);
+
         std::swap(device_, rhs.device_);
         std::swap(initialized_, rhs.initialized_);
 
@@ -139,8 +154,11 @@ class Image : public BaseImage
         VKW_ASSERT(this->initialized() == false);
 
         this->device_ = &device;
+        this->imageType_ = createInfo.imageType;
         this->format_ = createInfo.format;
         this->extent_ = createInfo.extent;
+        this->mipLevels_ = createInfo.mipLevels;
+        this->arrayLayers_ = createInfo.arrayLayers;
         this->usage_ = createInfo.usage | additionalFlags;
 
         VkImageCreateInfo imgCreateInfo = createInfo;
@@ -198,22 +216,195 @@ class Image : public BaseImage
             memAllocation_ = VK_NULL_HANDLE;
         }
 
+        imageType_ = {};
         format_ = {};
         extent_ = {};
+        mipLevels_ = 0;
+        arrayLayers_ = 0;
         usage_ = {};
 
         allocInfo_ = {};
 
+        layoutTracker_.clear();
+
         device_ = nullptr;
         initialized_ = false;
     }
 
     VkImageUsageFlags usage() const final override { return usage_; }
+    VkImageType imageType() const final override { return imageType_; }
     VkExtent3D extent() const final override { return extent_; }
     VkFormat format() const final override { return format_; }
+    uint32_t mipLevels() const final override { return mipLevels_; }
+    uint32_t arrayLayers() const final override { return arrayLayers_; }
 
     VkImage getHandle() const final override { return image_; }
 
+    // -------------------------------------------------------------------------------------------------------
+    // ----------------------------------- Layout tracking ---------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    /// Enables the per subresource layout tracking used by CommandBuffer::transition(). The layout must be
+    /// the current layout of the whole image.
+    bool enableLayoutTracking(const VkImageLayout currentLayout = VK_IMAGE_LAYOUT_UNDEFINED)
+    {
+        VKW_ASSERT(this->initialized());
+        if(layoutTracker_.initialized())
+        {
+            layoutTracker_.reset(currentLayout);
+            return true;
+        }
+        return layoutTracker_.init(
+            mipLevels_, arrayLayers_, ImageLayoutTracker::getAspectMask(format_), currentLayout);
+    }
+    void disableLayoutTracking() { layoutTracker_.clear(); }
+
+    bool layoutTrackingEnabled() const { return layoutTracker_.initialized(); }
+
+    ImageLayoutTracker* layoutTracker() final override
+    {
+        return layoutTracker_.initialized() ? &layoutTracker_ : nullptr;
+    }
+    const ImageLayoutTracker* layoutTracker() const final override
+    {
+        return layoutTracker_.initialized() ? &layoutTracker_ : nullptr;
+    }
+
+    // -------------------------------------------------------------------------------------------------------
+    // ---------------------------------- Host image copy ----------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    /// Host copies need VK_EXT_host_image_copy and an image created with the
+    /// VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT usage. When they are not available the copies must go through a
+    /// staging buffer and CommandBuffer::copyBufferToImage().
+    bool hostCopySupported() const
+    {
+        return device_->hostImageCopyEnabled() && (usage_ & VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT);
+    }
+
+    /// Transitions the image from the host, without any queue submission.
+    bool transitionLayoutOnHost(
+        const VkImageLayout oldLayout, const VkImageLayout newLayout, const uint32_t baseLevel = 0,
+        const uint32_t levelCount = VK_REMAINING_MIP_LEVELS, const uint32_t baseLayer = 0,
+        const uint32_t layerCount = VK_REMAINING_ARRAY_LAYERS)
+    {
+        VKW_ASSERT(this->initialized());
+        if(!hostCopySupported()) { return false; }
+
+        VkHostImageLayoutTransitionInfoEXT transitionInfo = {};
+        transitionInfo.sType = VK_STRUCTURE_TYPE_HOST_IMAGE_LAYOUT_TRANSITION_INFO_EXT;
+        transitionInfo.pNext = nullptr;
+        transitionInfo.image = image_;
+        transitionInfo.oldLayout = oldLayout;
+        transitionInfo.newLayout = newLayout;
+        transitionInfo.subresourceRange.aspectMask = ImageLayoutTracker::getAspectMask(format_);
+        transitionInfo.subresourceRange.baseMipLevel = baseLevel;
+        transitionInfo.subresourceRange.levelCount = levelCount;
+        transitionInfo.subresourceRange.baseArrayLayer = baseLayer;
+        transitionInfo.subresourceRange.layerCount = layerCount;
+        VKW_CHECK_VK_RETURN_FALSE(
+            device_->vk().vkTransitionImageLayoutEXT(device_->getHandle(), 1, &transitionInfo));
+
+        if(layoutTracker_.initialized())
+        {
+            layoutTracker_.reset(newLayout, baseLevel, levelCount, baseLayer, layerCount);
+        }
+        return true;
+    }
+
+    /// Copies host memory to a region of the image. The image must be in currentLayout, which must be one of
+    /// the layouts reported in VkPhysicalDeviceHostImageCopyPropertiesEXT::pCopyDstLayouts. memoryRowLength
+    /// and memoryImageHeight are given in texels, 0 means tightly packed.
+    bool copyFromHost(
+        const void* src, const VkImageLayout currentLayout, const VkImageSubresourceLayers& subresource,
+        const VkOffset3D offset, const VkExtent3D extent, const uint32_t memoryRowLength = 0,
+        const uint32_t memoryImageHeight = 0)
+    {
+        VKW_ASSERT(this->initialized());
+        if(!hostCopySupported()) { return false; }
+
+        VkMemoryToImageCopyEXT region = {};
+        region.sType = VK_STRUCTURE_TYPE_MEMORY_TO_IMAGE_COPY_EXT;
+        region.pNext = nullptr;
+        region.pHostPointer = src;
+        region.memoryRowLength = memoryRowLength;
+        region.memoryImageHeight = memoryImageHeight;
+        region.imageSubresource = subresource;
+        region.imageOffset = offset;
+        region.imageExtent = extent;
+
+        VkCopyMemoryToImageInfoEXT copyInfo = {};
+        copyInfo.sType = VK_STRUCTURE_TYPE_COPY_MEMORY_TO_IMAGE_INFO_EXT;
+        copyInfo.pNext = nullptr;
+        copyInfo.flags = 0;
+        copyInfo.dstImage = image_;
+        copyInfo.dstImageLayout = currentLayout;
+        copyInfo.regionCount = 1;
+        copyInfo.pRegions = &region;
+        VKW_CHECK_VK_RETURN_FALSE(device_->vk().vkCopyMemoryToImageEXT(device_->getHandle(), &copyInfo));
+
+        return true;
+    }
+
+    /// Copies tightly packed host memory to a whole mip level.
+    bool copyFromHost(
+        const void* src, const VkImageLayout currentLayout, const uint32_t mipLevel = 0,
+        const uint32_t baseLayer = 0, const uint32_t layerCount = 1)
+    {
+        return copyFromHost(
+            src, currentLayout, levelSubresource(mipLevel, baseLayer, layerCount), {0, 0, 0},
+            levelExtent(mipLevel));
+    }
+
+    /// Copies a region of the image to host memory, see copyFromHost() for the parameters.
+    bool copyToHost(
+        void* dst, const VkImageLayout currentLayout, const VkImageSubresourceLayers& subresource,
+        const VkOffset3D offset, const VkExtent3D extent, const uint32_t memoryRowLength = 0,
+        const uint32_t memoryImageHeight = 0) const
+    {
+        VKW_ASSERT(this->initialized());
+        if(!hostCopySupported()) { return false; }
+
+        VkImageToMemoryCopyEXT region = {};
+        region.sType = VK_STRUCTURE_TYPE_IMAGE_TO_MEMORY_COPY_EXT;
+        region.pNext = nullptr;
+        region.pHostPointer = dst;
+        region.memoryRowLength = memoryRowLength;
+        region.memoryImageHeight = memoryImageHeight;
+        region.imageSubresource = subresource;
+        region.imageOffset = offset;
+        region.imageExtent = extent;
+
+        VkCopyImageToMemoryInfoEXT copyInfo = {};
+        copyInfo.sType = VK_STRUCTURE_TYPE_COPY_IMAGE_TO_MEMORY_INFO_EXT;
+        copyInfo.pNext = nullptr;
+        copyInfo.flags = 0;
+        copyInfo.srcImage = image_;
+        copyInfo.srcImageLayout = currentLayout;
+        copyInfo.regionCount = 1;
+        copyInfo.pRegions = &region;
+        VKW_CHECK_VK_RETURN_FALSE(device_->vk().vkCopyImageToMemoryEXT(device_->getHandle(), &copyInfo));
+
+        return true;
+    }
+
+    /// Copies a whole mip level to tightly packed host memory.
+    bool copyToHost(
+        void* dst, const VkImageLayout currentLayout, const uint32_t mipLevel = 0,
+        const uint32_t baseLayer = 0, const uint32_t layerCount = 1) const
+    {
+        return copyToHost(
+            dst, currentLayout, levelSubresource(mipLevel, baseLayer, layerCount), {0, 0, 0},
+            levelExtent(mipLevel));
+    }
+
+    VkExtent3D levelExtent(const uint32_t mipLevel) const
+    {
+        return {
+            std::max(extent_.width >> mipLevel, 1u), std::max(extent_.height >> mipLevel, 1u),
+            std::max(extent_.depth >> mipLevel, 1u)};
+    }
+
     // -------------------------------------------------------------------------------------------------------
     // --------------------------------- Memory properties ---------------------------------------------------
     // -------------------------------------------------------------------------------------------------------
@@ -291,16 +482,32 @@ class Image : public BaseImage
     }
 
   private:
+    VkImageSubresourceLayers levelSubresource(
+        const uint32_t mipLevel, const uint32_t baseLayer, const uint32_t layerCount) const
+    {
+        VkImageSubresourceLayers subresource = {};
+        subresource.aspectMask = ImageLayoutTracker::getAspectMask(format_);
+        subresource.mipLevel = mipLevel;
+        subresource.baseArrayLayer = baseLayer;
+        subresource.layerCount = layerCount;
+        return subresource;
+    }
+
     const Device* device_{nullptr};
 
+    VkImageType imageType_{};
     VkFormat format_{};
     VkExtent3D extent_{};
+    uint32_t mipLevels_{0};
+    uint32_t arrayLayers_{0};
     VkImageUsageFlags usage_{};
     VkImage image_{VK_NULL_HANDLE};
 
     VmaAllocationInfo allocInfo_{};
     VmaAllocation memAllocation_{VK_NULL_HANDLE};
 
+    ImageLayoutTracker layoutTracker_{};
+
     bool initialized_{false};
 };
 
@@ -321,4 +528,7 @@ using HostToDeviceImage = Image<MemoryType::TransferHostDevice, additionalFlags>
 
 template <VkImageUsageFlags additionalFlags = 0>
 using DeviceToHostImage = Image<MemoryType::TransferDeviceHost, additionalFlags>;
+
+template <VkImageUsageFlags additionalFlags = 0>
+using TransientImage = Image<MemoryType::Transient, additionalFlags>;
 } // namespace vkw
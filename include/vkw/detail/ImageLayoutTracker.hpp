@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Common.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace vkw
+{
+/// Per subresource layout and access state of an image.
+///
+/// The tracker records the layout, the pipeline stages and the accesses of the last use of each mip level
+/// and array layer. Transitions only emit barriers for the subresources that need one: a layout change, or a
+/// hazard involving a write. Subresources sharing the same previous state are merged in as few barriers as
+/// possible, first across contiguous mip levels then across contiguous array layers.
+///
+/// @note: The tracker follows the order in which commands are recorded. Images used across several command
+///        buffers must be recorded in submission order, or be reset() with the known state.
+class ImageLayoutTracker
+{
+  public:
+    struct SubresourceState
+    {
+        VkImageLayout layout{VK_IMAGE_LAYOUT_UNDEFINED};
+        VkPipelineStageFlags2 stages{VK_PIPELINE_STAGE_2_NONE};
+        VkAccessFlags2 access{VK_ACCESS_2_NONE};
+
+        bool operator==(const SubresourceState& rhs) const
+        {
+            return layout == rhs.layout && stages == rhs.stages && access == rhs.access;
+        }
+    };
+
+    ImageLayoutTracker() {}
+
+    bool init(
+        const uint32_t mipLevels, const uint32_t arrayLayers, const VkImageAspectFlags aspectMask,
+        const VkImageLayout initialLayout = VK_IMAGE_LAYOUT_UNDEFINED);
+
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    /// Forgets the tracked state of the given range and sets it to the given layout.
+    void reset(
+        const VkImageLayout layout, const uint32_t baseLevel = 0,
+        const uint32_t levelCount = VK_REMAINING_MIP_LEVELS, const uint32_t baseLayer = 0,
+        const uint32_t layerCount = VK_REMAINING_ARRAY_LAYERS);
+
+    /// Appends to barriers the image barriers needed to use the range in newLayout with the given stages and
+    /// accesses, and updates the tracked state. Returns the number of barriers added.
+    uint32_t transition(
+        const VkImage image, const VkImageLayout newLayout, const VkPipelineStageFlags2 stages,
+        const VkAccessFlags2 access, std::vector<VkImageMemoryBarrier2>& barriers,
+        const uint32_t baseLevel = 0, const uint32_t levelCount = VK_REMAINING_MIP_LEVELS,
+        const uint32_t baseLayer = 0, const uint32_t layerCount = VK_REMAINING_ARRAY_LAYERS);
+
+    const SubresourceState& state(const uint32_t level, const uint32_t layer) const
+    {
+        VKW_ASSERT(level < mipLevels_ && layer < arrayLayers_);
+        return states_[layer * mipLevels_ + level];
+    }
+
+    uint32_t mipLevels() const { return mipLevels_; }
+    uint32_t arrayLayers() const { return arrayLayers_; }
+    VkImageAspectFlags aspectMask() const { return aspectMask_; }
+
+    static VkImageAspectFlags getAspectMask(const VkFormat format);
+
+  private:
+    struct LevelRun
+    {
+        uint32_t baseLevel;
+        uint32_t levelCount;
+        uint32_t baseLayer;
+        uint32_t layerCount;
+        SubresourceState oldState;
+    };
+
+    std::vector<SubresourceState> states_{};
+    uint32_t mipLevels_{0};
+    uint32_t arrayLayers_{0};
+    VkImageAspectFlags aspectMask_{};
+
+    bool initialized_{false};
+
+    static bool hasWriteAccess(const VkAccessFlags2 access);
+};
+} // namespace vkw
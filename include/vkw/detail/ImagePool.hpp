@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/Device.hpp"
+#include "vkw/detail/Image.hpp"
+#include "vkw/detail/ImageView.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace vkw
+{
+/// Recycles images and their views between passes and frames.
+///
+/// Images are looked up by description: acquiring an image returns a free pooled image with the same
+/// description if any, or creates a new one. Released images stay in the pool and are destroyed once they
+/// have not been used for a given number of frames, which must be at least the number of frames in flight.
+///
+/// Images with VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT are backed by lazily allocated memory when the device
+/// exposes it. The content of an acquired image is undefined, its first use must transition it from
+/// VK_IMAGE_LAYOUT_UNDEFINED.
+class ImagePool
+{
+  public:
+    struct Description
+    {
+        VkImageType imageType{VK_IMAGE_TYPE_2D};
+        VkFormat format{VK_FORMAT_UNDEFINED};
+        VkExtent3D extent{};
+        VkImageUsageFlags usage{};
+        VkSampleCountFlagBits samples{VK_SAMPLE_COUNT_1_BIT};
+        uint32_t mipLevels{1};
+        uint32_t arrayLayers{1};
+        VkImageViewType viewType{VK_IMAGE_VIEW_TYPE_2D};
+
+        bool operator==(const Description& rhs) const
+        {
+            return imageType == rhs.imageType && format == rhs.format && extent.width == rhs.extent.width
+                   && extent.height == rhs.extent.height && extent.depth == rhs.extent.depth
+                   && usage == rhs.usage && samples == rhs.samples && mipLevels == rhs.mipLevels
+                   && arrayLayers == rhs.arrayLayers && viewType == rhs.viewType;
+        }
+    };
+
+    struct DescriptionHash
+    {
+        size_t operator()(const Description& desc) const;
+    };
+
+    /// Image acquired from the pool, valid until released.
+    struct PooledImage
+    {
+        BaseImage* image{nullptr};
+        VkImageView view{VK_NULL_HANDLE};
+        uint64_t id{0};
+
+        bool valid() const { return image != nullptr; }
+    };
+
+    ImagePool() {}
+    explicit ImagePool(const Device& device, const uint32_t maxUnusedFrames = 3);
+
+    ImagePool(const ImagePool&) = delete;
+    ImagePool(ImagePool&& rhs) { *this = std::move(rhs); }
+
+    ImagePool& operator=(const ImagePool&) = delete;
+    ImagePool& operator=(ImagePool&& rhs);
+
+    ~ImagePool() { this->clear(); }
+
+    bool init(const Device& device, const uint32_t maxUnusedFrames = 3);
+
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    /// Returns a free image matching the description, creating one if needed.
+    PooledImage acquire(const Description& desc);
+
+    /// Gives the image back to the pool, it can be acquired again in the same frame.
+    void release(const PooledImage& pooledImage);
+
+    /// Ages the free images and destroys the ones unused for more than maxUnusedFrames frames. Returns the
+    /// number of destroyed images.
+    uint32_t nextFrame();
+
+    /// Destroys all the free images, images in use are kept.
+    void trim();
+
+    bool lazilyAllocatedMemoryAvailable() const { return lazilyAllocatedAvailable_; }
+
+    size_t imageCount() const { return imageCount_; }
+    uint64_t frameIndex() const { return frameIndex_; }
+
+  private:
+    struct Entry
+    {
+        std::unique_ptr<BaseImage> image;
+        ImageView view;
+        uint64_t id;
+        uint64_t lastUsedFrame;
+        bool inUse;
+    };
+
+    const Device* device_{nullptr};
+
+    std::unordered_map<Description, std::vector<std::unique_ptr<Entry>>, DescriptionHash> entries_{};
+    std::unordered_map<uint64_t, Entry*> entriesById_{};
+    size_t imageCount_{0};
+
+    uint64_t frameIndex_{0};
+    uint64_t nextId_{1};
+    uint32_t maxUnusedFrames_{3};
+    bool lazilyAllocatedAvailable_{false};
+
+    bool initialized_{false};
+
+    std::unique_ptr<Entry> createEntry(const Description& desc);
+};
+} // namespace vkw
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/utils.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace vkw
+{
+/// Private memory mapping of a file region.
+///
+/// The mapping itself always starts on a boundary aligned on the requested alignment (at least the system
+/// page size) and its size is rounded up to a multiple of it, so that the mapped range can be directly
+/// imported with VK_EXT_external_memory_host. data() and size() refer to the requested file region.
+///
+/// The mapping is copy on write: writes through an imported buffer are visible in the mapping but are never
+/// written back to the file. The part of the mapped range past the end of the file reads as zeros.
+class MappedFile
+{
+  public:
+    MappedFile() {}
+    explicit MappedFile(
+        const std::string& filename, const size_t offset = 0, const size_t size = 0,
+        const size_t alignment = 0);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&& rhs);
+
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&& rhs);
+
+    ~MappedFile();
+
+    /// Maps size bytes of the file starting at offset, a size of 0 maps the file until its end.
+    bool init(
+        const std::string& filename, const size_t offset = 0, const size_t size = 0,
+        const size_t alignment = 0);
+
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    const uint8_t* data() const { return mappedData_ + dataOffset_; }
+    size_t size() const { return size_; }
+
+    template <typename T>
+    const T* as() const
+    {
+        return reinterpret_cast<const T*>(data());
+    }
+
+    /// Aligned mapped range, contains the requested region
+    void* mappedData() const { return mappedData_; }
+    size_t mappedSize() const { return mappedSize_; }
+
+    /// Offset of the requested region in the aligned mapped range
+    size_t dataOffset() const { return dataOffset_; }
+
+    size_t fileSize() const { return fileSize_; }
+
+    static size_t pageSize();
+
+  private:
+    uint8_t* mappedData_{nullptr};
+    size_t mappedSize_{0};
+    size_t dataOffset_{0};
+    size_t size_{0};
+    size_t fileSize_{0};
+
+    bool initialized_{false};
+};
+} // namespace vkw
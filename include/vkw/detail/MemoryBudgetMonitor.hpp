@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Buffer.hpp"
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/Device.hpp"
+#include "vkw/detail/utils.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace vkw
+{
+/// Tracks the memory budget of each heap of a device and reacts to memory pressure.
+///
+/// The monitor polls the heap budgets each time update() is called (typically once per frame). When the
+/// usage of a heap crosses one of the registered high-water marks, the associated callbacks are invoked.
+/// When the usage goes above the eviction threshold, the least recently used evictable resources of that
+/// heap are evicted until the usage goes back below the eviction target.
+///
+/// Evicting a resource is delegated to the application through a callback: it can for instance demote a
+/// HostDevice buffer to host memory, or simply drop some cached data that can be recomputed later.
+///
+/// @note: Accurate budgets require VK_EXT_memory_budget to be enabled on the device, otherwise the values
+///        reported are estimations made by the allocator.
+class MemoryBudgetMonitor
+{
+  public:
+    using EvictableId = uint64_t;
+
+    /// Called when the usage of a heap crosses a high-water mark. Rising is true when the usage went above
+    /// the mark, false when it went back below it.
+    using PressureCallback
+        = std::function<void(const uint32_t heapIndex, const MemoryBudget& budget, const bool rising)>;
+
+    /// Called when a resource is evicted. Must release the memory held by the resource and return the number
+    /// of bytes actually released on the heap. The resource is already unregistered when it is invoked, the
+    /// callback must not unregister other resources.
+    using EvictionCallback = std::function<VkDeviceSize(const EvictableId id)>;
+
+    /// Returns the budget of each heap, Device::getMemoryBudget() by default.
+    using BudgetQuery = std::function<std::vector<MemoryBudget>()>;
+
+    static constexpr EvictableId invalidId = 0;
+
+    MemoryBudgetMonitor() {}
+    explicit MemoryBudgetMonitor(
+        const Device& device, const float evictionThreshold = 0.95f, const float evictionTarget = 0.85f);
+
+    MemoryBudgetMonitor(const MemoryBudgetMonitor&) = delete;
+    MemoryBudgetMonitor(MemoryBudgetMonitor&& rhs);
+
+    MemoryBudgetMonitor& operator=(const MemoryBudgetMonitor&) = delete;
+    MemoryBudgetMonitor& operator=(MemoryBudgetMonitor&& rhs);
+
+    ~MemoryBudgetMonitor();
+
+    bool init(
+        const Device& device, const float evictionThreshold = 0.95f, const float evictionTarget = 0.85f);
+
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    // -------------------------------------------------------------------------------------------------------
+    // ------------------------------------ Pressure callbacks -----------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    /// Registers a callback invoked when the usage / budget ratio of a heap crosses the given mark.
+    MemoryBudgetMonitor& addHighWaterMark(const float ratio, PressureCallback&& callback);
+
+    /// Usage is evicted once it goes above threshold * budget, until it goes below target * budget.
+    MemoryBudgetMonitor& setEvictionThresholds(const float evictionThreshold, const float evictionTarget);
+
+    /// Replaces the source of the heap budgets, for instance to enforce an application defined budget. Must
+    /// be set before registering high-water marks and resources, the heap count must not change.
+    MemoryBudgetMonitor& setBudgetQuery(BudgetQuery&& query);
+
+    // -------------------------------------------------------------------------------------------------------
+    // ------------------------------------ Evictable resources ----------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    EvictableId registerEvictable(
+        const uint32_t heapIndex, const VkDeviceSize sizeBytes, EvictionCallback&& callback);
+
+    /// Registers a buffer, the heap it lives in is deduced from its allocation.
+    EvictableId registerEvictable(const BaseBuffer& buffer, EvictionCallback&& callback);
+
+    /// Removes a resource from the eviction list, does not invoke its eviction callback.
+    void unregisterEvictable(const EvictableId id);
+
+    /// Marks the resource as recently used, to be called each time it is used.
+    void touch(const EvictableId id);
+
+    size_t evictableCount() const { return evictables_.size(); }
+
+    // -------------------------------------------------------------------------------------------------------
+    // ----------------------------------------- Budget ------------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    /// Polls the heap budgets, invokes the pressure callbacks and evicts resources if needed. Returns the
+    /// number of bytes released by evictions.
+    VkDeviceSize update();
+
+    /// Evicts least recently used resources of the given heap until at least sizeBytes are released.
+    VkDeviceSize evict(const uint32_t heapIndex, const VkDeviceSize sizeBytes);
+
+    uint32_t heapCount() const { return static_cast<uint32_t>(budgets_.size()); }
+    const auto& budgets() const { return budgets_; }
+    const MemoryBudget& budget(const uint32_t heapIndex) const
+    {
+        VKW_ASSERT(heapIndex < budgets_.size());
+        return budgets_[heapIndex];
+    }
+
+    float usageRatio(const uint32_t heapIndex) const;
+
+  private:
+    struct HighWaterMark
+    {
+        float ratio;
+        PressureCallback callback;
+        std::vector<bool> reached;
+    };
+
+    struct EvictableEntry
+    {
+        uint32_t heapIndex;
+        VkDeviceSize sizeBytes;
+        EvictionCallback callback;
+        std::list<EvictableId>::iterator lruPos;
+    };
+
+    const Device* device_{nullptr};
+
+    BudgetQuery budgetQuery_{};
+    std::vector<MemoryBudget> budgets_{};
+    std::vector<HighWaterMark> highWaterMarks_{};
+
+    float evictionThreshold_{0.95f};
+    float evictionTarget_{0.85f};
+
+    EvictableId nextId_{invalidId + 1};
+    std::list<EvictableId> lruList_{}; ///< Most recently used resources first
+    std::unordered_map<EvictableId, EvictableEntry> evictables_{};
+
+    bool initialized_{false};
+
+    std::vector<MemoryBudget> queryBudgets() const;
+};
+} // namespace vkw
@@ -52,7 +52,8 @@ enum class MemoryType
     HostStaging,        ///< Used for small staging or uniform buffers, permanently mapped
     HostDevice,         ///< Used for large buffers that can be on host if device size is limited
     TransferHostDevice, ///< Used to upload data. Needs to be mapped before using
-    TransferDeviceHost  ///< Used for readback. Needs to be mapped before using
+    TransferDeviceHost, ///< Used for readback. Needs to be mapped before using
+    Transient           ///< Used for transient attachments, requires lazily allocated memory
 };
 
 template <MemoryType memType>
@@ -116,4 +117,13 @@ struct MemoryFlags<MemoryType::TransferDeviceHost>
     static constexpr VmaAllocationCreateFlags allocationFlags
         = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
 };
+template <>
+struct MemoryFlags<MemoryType::Transient>
+{
+    static constexpr VkMemoryPropertyFlags requiredFlags
+        = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+    static constexpr VkMemoryPropertyFlags preferredFlags = {};
+    static constexpr VmaMemoryUsage usage = VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED;
+    static constexpr VmaAllocationCreateFlags allocationFlags = {};
+};
 } // namespace vkw
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/ComputePipeline.hpp"
+#include "vkw/detail/DescriptorSetLayout.hpp"
+#include "vkw/detail/Device.hpp"
+#include "vkw/detail/Image.hpp"
+#include "vkw/detail/ImageView.hpp"
+#include "vkw/detail/PipelineLayout.hpp"
+#include "vkw/detail/Sampler.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace vkw
+{
+class CommandBuffer;
+
+/// Compute fallback used by CommandBuffer::generateMipmaps() for formats that do not support linear blits.
+///
+/// Each level is computed from the previous one with a 2x2 box filter. The images must have been created
+/// with VK_IMAGE_USAGE_SAMPLED_BIT and VK_IMAGE_USAGE_STORAGE_BIT, and the device must support
+/// shaderStorageImageWriteWithoutFormat. Only 2D images (and 2D arrays) are supported.
+///
+/// The generator keeps the per-level image views alive, releaseViews() must be called once the command
+/// buffers that used it have finished executing.
+class MipmapGenerator
+{
+  public:
+    MipmapGenerator() {}
+    explicit MipmapGenerator(const Device& device);
+
+    MipmapGenerator(const MipmapGenerator&) = delete;
+    MipmapGenerator(MipmapGenerator&& rhs) { *this = std::move(rhs); }
+
+    MipmapGenerator& operator=(const MipmapGenerator&) = delete;
+    MipmapGenerator& operator=(MipmapGenerator&& rhs);
+
+    ~MipmapGenerator() { this->clear(); }
+
+    bool init(const Device& device);
+
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    /// Returns true if the compute path can be used for the given image.
+    bool supports(const BaseImage& image) const;
+
+    /// Records the computation of the given level from level - 1. Level - 1 must be in
+    /// VK_IMAGE_LAYOUT_GENERAL and readable from the compute stage, level must be in VK_IMAGE_LAYOUT_GENERAL.
+    bool record(const CommandBuffer& cmdBuffer, const BaseImage& image, const uint32_t level);
+
+    /// Destroys the image views created by record().
+    void releaseViews() { views_.clear(); }
+
+    size_t pendingViewCount() const { return views_.size(); }
+
+  private:
+    struct PushConstants
+    {
+        int32_t srcExtent[2];
+        int32_t dstExtent[2];
+    };
+
+    const Device* device_{nullptr};
+
+    DescriptorSetLayout descriptorSetLayout_{};
+    PipelineLayout pipelineLayout_{};
+    ComputePipeline pipeline_{};
+    Sampler sampler_{};
+
+    std::vector<ImageView> views_{};
+
+    bool initialized_{false};
+};
+} // namespace vkw
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/Device.hpp"
+#include "vkw/detail/MappedFile.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace vkw
+{
+/// Pipeline cache shared by the pipelines of a device, it can be saved to a file and reused by the next runs.
+///
+/// The initial data is only handed to the driver if its header matches the device (vendor, device and
+/// pipeline cache UUID), stale caches are discarded and an empty cache is created instead.
+class PipelineCache
+{
+  public:
+    PipelineCache() {}
+    explicit PipelineCache(const Device& device);
+    PipelineCache(const Device& device, const MappedFile& file);
+
+    PipelineCache(const PipelineCache&) = delete;
+    PipelineCache(PipelineCache&& rhs) { *this = std::move(rhs); }
+
+    PipelineCache& operator=(const PipelineCache&) = delete;
+    PipelineCache& operator=(PipelineCache&& rhs);
+
+    ~PipelineCache() { this->clear(); }
+
+    bool init(
+        const Device& device, const void* initialData = nullptr, const size_t initialDataSize = 0,
+        const VkPipelineCacheCreateFlags flags = {});
+    /// Initializes the cache with the content of a file written by save().
+    bool init(const Device& device, const MappedFile& file, const VkPipelineCacheCreateFlags flags = {});
+
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    std::vector<uint8_t> getData() const;
+
+    bool save(const std::string& filename) const;
+
+    /// Merges the content of other caches of the same device into this one.
+    bool merge(const std::vector<std::reference_wrapper<const PipelineCache>>& srcCaches);
+
+    VkPipelineCache getHandle() const { return pipelineCache_; }
+
+    /// Returns true if the data was produced by a cache of the same device and driver.
+    static bool compatible(const Device& device, const void* data, const size_t size);
+
+  private:
+    const Device* device_{nullptr};
+    VkPipelineCache pipelineCache_{VK_NULL_HANDLE};
+
+    bool initialized_{false};
+};
+} // namespace vkw
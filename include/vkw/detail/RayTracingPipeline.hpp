@@ -76,7 +76,7 @@ class RayTracingPipeline
         static constexpr size_t size = sizeof(T);
         const char* data = (char*) &value;
 
-        auto& info = moduleInfo_[id];
+        auto& info = moduleInfo_[stageId];
         for(size_t i = 0; i < size; i++)
         {
             info.specData.push_back(data[i]);
@@ -92,13 +92,37 @@ class RayTracingPipeline
         return addSpec(stageId, std::forward<Args>(args)...);
     }
 
+    /// Links a library created with createLibrary() into this pipeline. The shader groups of the libraries
+    /// are numbered after the groups of this pipeline, in the order the libraries are added. The library must
+    /// outlive this pipeline.
+    RayTracingPipeline& addLibrary(const RayTracingPipeline& library);
+
+    /// Required to create or link libraries, the pipeline and all its libraries must use the same values.
+    RayTracingPipeline& setLibraryInterface(
+        const uint32_t maxPayloadSize, const uint32_t maxHitAttributeSize);
+
     bool createPipeline(
-        const PipelineLayout& pipelineLayout, const uint32_t maxDepth,
-        const VkPipelineCreateFlags flags = {});
+        const PipelineLayout& pipelineLayout, const uint32_t maxDepth, const VkPipelineCreateFlags flags = {},
+        const VkPipelineCache pipelineCache = VK_NULL_HANDLE);
+
+    /// Creates a pipeline library (VK_PIPELINE_CREATE_LIBRARY_BIT_KHR) that can only be used by linking it
+    /// in other pipelines, typically to compile the hit groups of each material once and relink them when
+    /// the set of materials changes.
+    bool createLibrary(
+        const PipelineLayout& pipelineLayout, const uint32_t maxDepth, const VkPipelineCreateFlags flags = {},
+        const VkPipelineCache pipelineCache = VK_NULL_HANDLE);
 
     VkPipeline& getHandle() { return pipeline_; }
     const VkPipeline& getHandle() const { return pipeline_; }
 
+    bool isLibrary() const { return isLibrary_; }
+
+    /// Number of shader groups, including the groups of the linked libraries.
+    uint32_t groupCount() const
+    {
+        return static_cast<uint32_t>(shaderGroups_.size()) + libraryGroupCount_;
+    }
+
     auto& dynamicStateInfo() { return dynamicStateInfo_; }
     const auto& dynamicStateInfo() const { return dynamicStateInfo_; }
 
@@ -126,6 +150,11 @@ class RayTracingPipeline
 
     std::vector<VkRayTracingShaderGroupCreateInfoKHR> shaderGroups_{};
 
+    std::vector<VkPipeline> libraries_{};
+    uint32_t libraryGroupCount_{0};
+    VkRayTracingPipelineInterfaceCreateInfoKHR libraryInterface_{};
+    bool isLibrary_{false};
+
     void finalizePipelineStages();
     void clearShaderModules();
 };
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Buffer.hpp"
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/Device.hpp"
+#include "vkw/detail/RingAllocator.hpp"
+#include "vkw/detail/Synchronization.hpp"
+#include "vkw/detail/utils.hpp"
+
+#include <cstdint>
+#include <span>
+
+namespace vkw
+{
+template <typename T>
+class ReadbackFuture;
+
+/// Ring allocator over a persistently mapped readback buffer.
+///
+/// Each readback recorded with CommandBuffer::readback() reserves a region of the ring, tagged with the
+/// value the timeline semaphore reaches once the submission containing the copy is complete. The region is
+/// reused once this value is reached and the associated ReadbackFuture is released, so the ring must be
+/// large enough to hold all the readbacks in flight (typically two or three frames).
+class ReadbackRing
+{
+  public:
+    struct Allocation
+    {
+        uint64_t id{0};
+        VkDeviceSize offset{0};
+        VkDeviceSize size{0};
+        uint64_t timelineValue{0};
+    };
+
+    ReadbackRing() {}
+    explicit ReadbackRing(
+        const Device& device, const TimelineSemaphore& timeline, const VkDeviceSize sizeBytes);
+
+    ReadbackRing(const ReadbackRing&) = delete;
+    ReadbackRing(ReadbackRing&& rhs);
+
+    ReadbackRing& operator=(const ReadbackRing&) = delete;
+    ReadbackRing& operator=(ReadbackRing&& rhs);
+
+    ~ReadbackRing();
+
+    bool init(const Device& device, const TimelineSemaphore& timeline, const VkDeviceSize sizeBytes);
+
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    const auto& buffer() const { return buffer_; }
+    const auto& timeline() const { return *timeline_; }
+
+    VkDeviceSize capacity() const { return buffer_.sizeBytes(); }
+
+    /// Reserves a region that will be readable once the timeline reaches timelineValue. When the ring is
+    /// full, waits for the oldest released region to complete. Returns an allocation with a null id if no
+    /// space can be made.
+    Allocation allocate(const VkDeviceSize size, const VkDeviceSize alignment, const uint64_t timelineValue);
+
+    /// Marks a region as no longer used by the host.
+    void release(const uint64_t id) { allocator_.release(id); }
+
+    /// Reuses all the regions whose readback completed and have been released.
+    void reclaim() { allocator_.reclaim(); }
+
+    bool completed(const uint64_t timelineValue) const { return timeline_->getValue() >= timelineValue; }
+
+    const uint8_t* mappedData() const { return mappedData_; }
+
+    /// Makes device writes visible to the host for non coherent memory.
+    bool invalidate(const VkDeviceSize offset, const VkDeviceSize size) const;
+
+  private:
+    const Device* device_{nullptr};
+    const TimelineSemaphore* timeline_{nullptr};
+
+    DeviceToHostBuffer<uint8_t> buffer_{};
+    const uint8_t* mappedData_{nullptr};
+
+    RingAllocator allocator_{};
+
+    bool initialized_{false};
+};
+
+/// Handle on a pending readback, gives access to the data directly in the ring mapped memory.
+template <typename T>
+class ReadbackFuture
+{
+  public:
+    ReadbackFuture() {}
+    ReadbackFuture(ReadbackRing& ring, const ReadbackRing::Allocation& allocation, const size_t count)
+        : ring_(&ring), allocation_(allocation), count_(count)
+    {}
+
+    ReadbackFuture(const ReadbackFuture&) = delete;
+    ReadbackFuture(ReadbackFuture&& rhs) { *this = std::move(rhs); }
+
+    ReadbackFuture& operator=(const ReadbackFuture&) = delete;
+    ReadbackFuture& operator=(ReadbackFuture&& rhs)
+    {
+        this->release();
+        std::swap(ring_, rhs.ring_);
+        std::swap(allocation_, rhs.allocation_);
+        std::swap(count_, rhs.count_);
+        std::swap(invalidated_, rhs.invalidated_);
+        return *this;
+    }
+
+    ~ReadbackFuture() { this->release(); }
+
+    bool valid() const { return ring_ != nullptr; }
+
+    /// Non blocking check of the readback completion.
+    bool ready() const
+    {
+        VKW_ASSERT(this->valid());
+        return ring_->completed(allocation_.timelineValue);
+    }
+
+    bool wait(const uint64_t timeout = ~uint64_t(0)) const
+    {
+        VKW_ASSERT(this->valid());
+        return ring_->timeline().wait(allocation_.timelineValue, timeout);
+    }
+
+    /// Data in the ring mapped memory, only valid once the readback completed and until release() is called.
+    std::span<const T> get()
+    {
+        VKW_ASSERT(this->valid());
+        VKW_ASSERT(this->ready());
+
+        if(!invalidated_)
+        {
+            VKW_CHECK_BOOL_FAIL(
+                ring_->invalidate(allocation_.offset, allocation_.size), "Invalidating readback memory");
+            invalidated_ = true;
+        }
+        return {reinterpret_cast<const T*>(ring_->mappedData() + allocation_.offset), count_};
+    }
+
+    size_t size() const { return count_; }
+
+    /// Gives the region back to the ring, the data must not be accessed after this call.
+    void release()
+    {
+        if(ring_ != nullptr) { ring_->release(allocation_.id); }
+
+        ring_ = nullptr;
+        allocation_ = {};
+        count_ = 0;
+        invalidated_ = false;
+    }
+
+  private:
+    ReadbackRing* ring_{nullptr};
+    ReadbackRing::Allocation allocation_{};
+    size_t count_{0};
+
+    bool invalidated_{false};
+};
+} // namespace vkw
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/Synchronization.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <string>
+
+namespace vkw
+{
+/// Offset allocator shared by the ring buffers (StagingRing, ReadbackRing).
+///
+/// Regions are allocated one after the other and wrap around at the end of the ring. Each region is tagged
+/// with the timeline value signaled once the GPU is done with it, and is reused once this value is reached
+/// and the region has been released. Regions are reused in allocation order: a region still in use blocks
+/// the reuse of all the regions allocated after it.
+class RingAllocator
+{
+  public:
+    struct Region
+    {
+        uint64_t id{0}; ///< 0 for failed allocations
+        VkDeviceSize offset{0};
+        VkDeviceSize size{0};
+        uint64_t timelineValue{0};
+        bool released{false};
+    };
+
+    RingAllocator() {}
+
+    /// name is used in the log messages.
+    bool init(const TimelineSemaphore& timeline, const VkDeviceSize capacity, const char* name);
+
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    VkDeviceSize capacity() const { return capacity_; }
+
+    /// Reserves a region used by the submission signaling timelineValue. Regions allocated with released set
+    /// to false are only reused after a call to release(). When the ring is full, waits for the oldest region
+    /// to complete. Returns a region with a null id if no space can be made.
+    Region allocate(
+        const VkDeviceSize size, const VkDeviceSize alignment, const uint64_t timelineValue,
+        const bool released = true);
+
+    /// Marks a region as no longer used by the host.
+    void release(const uint64_t id);
+
+    /// Reuses all the released regions whose timeline value was reached.
+    void reclaim();
+
+    size_t regionCount() const { return regions_.size(); }
+
+  private:
+    const TimelineSemaphore* timeline_{nullptr};
+    VkDeviceSize capacity_{0};
+    std::string name_{};
+
+    std::deque<Region> regions_{};
+    VkDeviceSize head_{0};
+    uint64_t nextId_{1};
+
+    bool initialized_{false};
+
+    bool findSpace(const VkDeviceSize size, const VkDeviceSize alignment, VkDeviceSize& offset) const;
+};
+} // namespace vkw
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Buffer.hpp"
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/Device.hpp"
+#include "vkw/detail/RayTracingPipeline.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace vkw
+{
+/// Shader binding table of a RayTracingPipeline, stored in a single device buffer.
+///
+/// Records are declared per region, each one referencing a shader group of the pipeline and reserving some
+/// bytes of inline data right after the group handle (shaderRecordEXT in the shaders). create() fetches the
+/// group handles and lays the table out: records are aligned on shaderGroupHandleAlignment, regions and
+/// ray generation records on shaderGroupBaseAlignment.
+///
+/// A host copy of the table is kept, setRecordGroup() and setRecordData() only modify it and flag the record
+/// dirty. CommandBuffer::uploadShaderBindingTable() then copies the dirty records to the device buffer, so
+/// changing a few records does not require rebuilding the table. The whole table is dirty after create().
+class ShaderBindingTable
+{
+  public:
+    enum class Region : uint32_t
+    {
+        RayGen = 0,
+        Miss = 1,
+        Hit = 2,
+        Callable = 3
+    };
+    static constexpr uint32_t regionCount = 4;
+
+    ShaderBindingTable() {}
+    explicit ShaderBindingTable(const Device& device);
+
+    ShaderBindingTable(const ShaderBindingTable&) = delete;
+    ShaderBindingTable(ShaderBindingTable&& rhs) { *this = std::move(rhs); }
+
+    ShaderBindingTable& operator=(const ShaderBindingTable&) = delete;
+    ShaderBindingTable& operator=(ShaderBindingTable&& rhs);
+
+    ~ShaderBindingTable() { this->clear(); }
+
+    bool init(const Device& device);
+
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    // -------------------------------------------------------------------------------------------------------
+    // ---------------------------------------- Layout -------------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    /// Records must be added before create(), dataSize is the size of the inline data of the record.
+    ShaderBindingTable& addRecord(
+        const Region region, const uint32_t groupIndex, const uint32_t dataSize = 0);
+
+    ShaderBindingTable& addRayGenRecord(const uint32_t groupIndex, const uint32_t dataSize = 0)
+    {
+        return addRecord(Region::RayGen, groupIndex, dataSize);
+    }
+    ShaderBindingTable& addMissRecord(const uint32_t groupIndex, const uint32_t dataSize = 0)
+    {
+        return addRecord(Region::Miss, groupIndex, dataSize);
+    }
+    ShaderBindingTable& addHitRecord(const uint32_t groupIndex, const uint32_t dataSize = 0)
+    {
+        return addRecord(Region::Hit, groupIndex, dataSize);
+    }
+    ShaderBindingTable& addCallableRecord(const uint32_t groupIndex, const uint32_t dataSize = 0)
+    {
+        return addRecord(Region::Callable, groupIndex, dataSize);
+    }
+
+    /// Fetches the group handles of the pipeline and allocates the table. The pipeline must have been
+    /// created, it is not referenced afterwards.
+    bool create(const RayTracingPipeline& pipeline);
+
+    bool created() const { return sbtBuffer_.initialized(); }
+
+    uint32_t recordCount(const Region region) const
+    {
+        return static_cast<uint32_t>(records_[static_cast<uint32_t>(region)].size());
+    }
+    uint32_t recordDataSize(const Region region, const uint32_t recordIndex) const
+    {
+        VKW_ASSERT(recordIndex < recordCount(region));
+        return records_[static_cast<uint32_t>(region)][recordIndex].dataSize;
+    }
+
+    /// Device region as expected by vkCmdTraceRaysKHR(), the ray generation region only covers the given
+    /// ray generation record.
+    VkStridedDeviceAddressRegionKHR deviceRegion(const Region region, const uint32_t rayGenIndex = 0) const;
+
+    /// Indirect trace command for vkCmdTraceRaysIndirect2KHR(), to be written to the indirect buffer.
+    VkTraceRaysIndirectCommand2KHR indirectCommand(
+        const uint32_t width, const uint32_t height, const uint32_t depth,
+        const uint32_t rayGenIndex = 0) const;
+
+    // -------------------------------------------------------------------------------------------------------
+    // ---------------------------------------- Records ------------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    /// Points the record to another shader group of the same pipeline.
+    void setRecordGroup(const Region region, const uint32_t recordIndex, const uint32_t groupIndex);
+
+    /// sizeBytes must not exceed the data size given when the record was added.
+    void setRecordData(
+        const Region region, const uint32_t recordIndex, const void* data, const size_t sizeBytes);
+    template <typename T>
+    void setRecordData(const Region region, const uint32_t recordIndex, const T& data)
+    {
+        setRecordData(region, recordIndex, &data, sizeof(T));
+    }
+
+    void markAllDirty();
+
+    uint32_t dirtyRecordCount() const { return dirtyCount_; }
+    bool hasDirtyRecords() const { return dirtyCount_ > 0; }
+
+    const auto& buffer() const { return sbtBuffer_; }
+    VkDeviceSize sizeBytes() const { return static_cast<VkDeviceSize>(hostTable_.size()); }
+
+  private:
+    friend class CommandBuffer;
+
+    using SbtBuffer = DeviceBuffer<
+        uint8_t, VK_BUFFER_USAGE_SHADER_BINDING_TABLE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+                     | VK_BUFFER_USAGE_TRANSFER_DST_BIT>;
+
+    struct Record
+    {
+        uint32_t groupIndex;
+        uint32_t dataSize;
+    };
+
+    const Device* device_{nullptr};
+
+    uint32_t handleSize_{0};
+    uint32_t groupCount_{0};
+    std::vector<uint8_t> groupHandles_{};
+
+    std::array<std::vector<Record>, regionCount> records_{};
+    std::array<VkDeviceSize, regionCount> regionOffsets_{};
+    std::array<VkDeviceSize, regionCount> regionStrides_{};
+    std::array<uint32_t, regionCount> firstRecords_{}; ///< Index of the first record of each region
+
+    std::vector<uint8_t> hostTable_{};
+    std::vector<bool> dirtyRecords_{};
+    uint32_t dirtyCount_{0};
+
+    SbtBuffer sbtBuffer_{};
+    HostStagingBuffer<uint8_t> stagingBuffer_{};
+
+    bool initialized_{false};
+
+    uint8_t* recordPtr(const Region region, const uint32_t recordIndex);
+    void markDirty(const Region region, const uint32_t recordIndex);
+
+    // Copies the dirty records to the staging buffer and returns the regions to copy, one per run of
+    // contiguous dirty records.
+    std::vector<VkBufferCopy> stageDirtyRecords();
+};
+} // namespace vkw
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/Device.hpp"
+#include "vkw/detail/Queue.hpp"
+#include "vkw/detail/SparseResource.hpp"
+#include "vkw/detail/Synchronization.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace vkw
+{
+/// Manages the page tables of sparse buffers and images.
+///
+/// Bind and unbind requests only update the page tables of the resources, the memory of newly resident pages
+/// is allocated immediately from per memory type pools. All the pending requests are then submitted at once
+/// in a single vkQueueBindSparse call by flush(), which waits for and signals the timeline semaphore of the
+/// manager. The memory of unbound pages is kept alive until the timeline reaches the value signaled by the
+/// flush that unbinds them, and released by collect().
+///
+/// @note: Resources with pending requests must not be destroyed or moved before the next flush(). All the
+///        resources using the manager must be cleared before it.
+class SparseResidencyManager
+{
+  public:
+    static constexpr VkDeviceSize defaultPoolBlockSize = 64 * 1024 * 1024;
+
+    SparseResidencyManager() {}
+    explicit SparseResidencyManager(
+        const Device& device, const Queue& queue, const TimelineSemaphore& timeline,
+        const VkDeviceSize poolBlockSize = defaultPoolBlockSize);
+
+    SparseResidencyManager(const SparseResidencyManager&) = delete;
+    SparseResidencyManager(SparseResidencyManager&& rhs);
+
+    SparseResidencyManager& operator=(const SparseResidencyManager&) = delete;
+    SparseResidencyManager& operator=(SparseResidencyManager&& rhs);
+
+    ~SparseResidencyManager();
+
+    /// The queue must support sparse binding (QueueUsageBits::SparseBinding).
+    bool init(
+        const Device& device, const Queue& queue, const TimelineSemaphore& timeline,
+        const VkDeviceSize poolBlockSize = defaultPoolBlockSize);
+
+    /// Releases the pools, the device must be idle.
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    const auto& queue() const { return queue_; }
+    const auto& timeline() const { return *timeline_; }
+
+    // -------------------------------------------------------------------------------------------------------
+    // ----------------------------------------- Requests ----------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    /// Makes pages resident, already resident pages are left untouched.
+    bool bindPages(SparseBuffer& buffer, const uint32_t firstPage, const uint32_t pageCount = 1);
+    void unbindPages(SparseBuffer& buffer, const uint32_t firstPage, const uint32_t pageCount = 1);
+
+    /// Makes the tiles covering a region of a mip level resident. The region is given in texels and must be
+    /// above the mip tail.
+    bool bindRegion(
+        SparseImage& image, const uint32_t level, const uint32_t layer, const VkOffset3D& offset,
+        const VkExtent3D& extent);
+    void unbindRegion(
+        SparseImage& image, const uint32_t level, const uint32_t layer, const VkOffset3D& offset,
+        const VkExtent3D& extent);
+
+    /// The layer is ignored for images with a single mip tail.
+    bool bindMipTail(SparseImage& image, const uint32_t layer = 0);
+    void unbindMipTail(SparseImage& image, const uint32_t layer = 0);
+
+    bool hasPendingRequests() const
+    {
+        return !dirtyBufferPages_.empty() || !dirtyImagePages_.empty() || !dirtyMipTails_.empty();
+    }
+
+    // -------------------------------------------------------------------------------------------------------
+    // -------------------------------------- Synchronization ------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    /// Submits the pending requests in a single vkQueueBindSparse call, waiting for the timeline to reach
+    /// waitValue and signaling signalValue once the binding is done. The timeline is signaled even if no
+    /// request is pending.
+    bool flush(const uint64_t waitValue, const uint64_t signalValue);
+
+    /// Releases the memory of the pages whose unbinding completed.
+    void collect();
+
+    size_t retiredPageCount() const { return retired_.size() + pendingFrees_.size(); }
+
+    /// Total memory allocated by the pools, including blocks only partially used by pages.
+    VkDeviceSize allocatedBytes() const;
+
+  private:
+    struct RetiredPage
+    {
+        VmaAllocation allocation;
+        uint64_t timelineValue;
+    };
+
+    const Device* device_{nullptr};
+    Queue queue_{};
+    const TimelineSemaphore* timeline_{nullptr};
+
+    VkDeviceSize poolBlockSize_{defaultPoolBlockSize};
+    std::unordered_map<uint32_t, VmaPool> pools_{}; ///< One pool per memory type index
+
+    std::unordered_map<SparseBuffer*, std::set<uint32_t>> dirtyBufferPages_{};
+    std::unordered_map<SparseImage*, std::set<uint32_t>> dirtyImagePages_{};
+    std::unordered_map<SparseImage*, std::set<uint32_t>> dirtyMipTails_{};
+
+    std::vector<VmaAllocation> pendingFrees_{}; ///< Unbound by the next flush
+    std::deque<RetiredPage> retired_{};
+
+    bool initialized_{false};
+
+    bool allocatePages(
+        const uint32_t memoryTypeBits, const VkDeviceSize size, const VkDeviceSize alignment,
+        const size_t count, VmaAllocation* allocations);
+    VmaPool getPool(const uint32_t memoryTypeBits);
+
+    void releasePage(VmaAllocation& allocation);
+
+    template <typename Fn>
+    static void forEachTile(
+        const SparseImage& image, const uint32_t level, const uint32_t layer, const VkOffset3D& offset,
+        const VkExtent3D& extent, Fn&& fn);
+};
+} // namespace vkw
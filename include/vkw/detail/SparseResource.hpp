@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Buffer.hpp"
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/Device.hpp"
+#include "vkw/detail/Image.hpp"
+#include "vkw/detail/ImageLayoutTracker.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace vkw
+{
+class SparseResidencyManager;
+
+/// Buffer created with VK_BUFFER_CREATE_SPARSE_RESIDENCY_BIT, no memory is bound at creation.
+///
+/// The buffer is split in pages of pageSize() bytes, the sparse block size reported by the implementation.
+/// Pages are made resident or evicted through a SparseResidencyManager. Accessing a non resident page
+/// returns undefined values unless the device reports residencyNonResidentStrict.
+class SparseBuffer final : public BaseBuffer
+{
+  public:
+    SparseBuffer() {}
+    explicit SparseBuffer(
+        const Device& device, const VkDeviceSize sizeBytes, const VkBufferUsageFlags usage,
+        const char* pName = nullptr);
+
+    SparseBuffer(const SparseBuffer&) = delete;
+    SparseBuffer(SparseBuffer&& rhs);
+
+    SparseBuffer& operator=(const SparseBuffer&) = delete;
+    SparseBuffer& operator=(SparseBuffer&& rhs);
+
+    ~SparseBuffer();
+
+    bool init(
+        const Device& device, const VkDeviceSize sizeBytes, const VkBufferUsageFlags usage,
+        const char* pName = nullptr);
+
+    /// Releases the buffer and the memory of its resident pages, the device must not use them anymore.
+    void clear();
+
+    bool initialized() const override { return initialized_; }
+
+    const Device& device() const override { return *device_; }
+
+    /// Sparse buffers have no single allocation, always returns VK_NULL_HANDLE.
+    VmaAllocation memory() const override { return VK_NULL_HANDLE; }
+
+    VkBufferUsageFlags usage() const override { return usage_; }
+    VkBuffer getHandle() const override { return buffer_; }
+
+    size_t size() const override { return static_cast<size_t>(sizeBytes_); }
+    size_t sizeBytes() const override { return static_cast<size_t>(sizeBytes_); }
+    size_t stride() const override { return 1; }
+
+    VkDescriptorBufferInfo getFullSizeInfo() const override { return {buffer_, 0, sizeBytes_}; }
+    VkDescriptorBufferInfo getDescriptorInfo(const size_t offset, const size_t size) const override
+    {
+        return {buffer_, offset, size};
+    }
+
+    VkDeviceAddress deviceAddress() const override;
+
+    VkDeviceSize pageSize() const { return pageSize_; }
+    uint32_t pageCount() const { return static_cast<uint32_t>(pages_.size()); }
+    uint32_t memoryTypeBits() const { return memoryTypeBits_; }
+
+    /// Index of the page containing the given byte offset.
+    uint32_t pageIndex(const VkDeviceSize offset) const { return static_cast<uint32_t>(offset / pageSize_); }
+
+    bool resident(const uint32_t page) const
+    {
+        VKW_ASSERT(page < pages_.size());
+        return pages_[page] != VK_NULL_HANDLE;
+    }
+    uint32_t residentPageCount() const;
+
+  private:
+    friend class SparseResidencyManager;
+
+    const Device* device_{nullptr};
+
+    VkBuffer buffer_{VK_NULL_HANDLE};
+    VkBufferUsageFlags usage_{};
+    VkDeviceSize sizeBytes_{0};
+
+    VkDeviceSize pageSize_{0};
+    uint32_t memoryTypeBits_{0};
+
+    std::vector<VmaAllocation> pages_{}; ///< Memory backing each page, VK_NULL_HANDLE if not resident
+
+    bool initialized_{false};
+};
+
+/// Image created with VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT, no memory is bound at creation.
+///
+/// The mip levels above the mip tail are split in tiles of tileExtent() texels, each tile being backed by one
+/// page of memory. The mip tail, made of the smallest levels, can only be made resident as a whole, once per
+/// layer or once for the whole image if the implementation reports VK_SPARSE_IMAGE_FORMAT_SINGLE_MIPTAIL_BIT.
+///
+/// @note: Only color formats are supported, formats requiring metadata are rejected.
+class SparseImage final : public BaseImage
+{
+  public:
+    SparseImage() {}
+    explicit SparseImage(
+        const Device& device, const VkImageType imageType, const VkFormat format, const VkExtent3D extent,
+        const VkImageUsageFlags usage, const uint32_t mipLevels = 1, const uint32_t arrayLayers = 1,
+        const char* pName = nullptr);
+
+    SparseImage(const SparseImage&) = delete;
+    SparseImage(SparseImage&& rhs);
+
+    SparseImage& operator=(const SparseImage&) = delete;
+    SparseImage& operator=(SparseImage&& rhs);
+
+    ~SparseImage();
+
+    bool init(
+        const Device& device, const VkImageType imageType, const VkFormat format, const VkExtent3D extent,
+        const VkImageUsageFlags usage, const uint32_t mipLevels = 1, const uint32_t arrayLayers = 1,
+        const char* pName = nullptr);
+
+    /// Releases the image and the memory of its resident tiles, the device must not use them anymore.
+    void clear();
+
+    bool initialized() const override { return initialized_; }
+
+    VkImageUsageFlags usage() const override { return usage_; }
+    VkImage getHandle() const override { return image_; }
+
+    VkImageType imageType() const override { return imageType_; }
+    VkExtent3D extent() const override { return extent_; }
+    VkFormat format() const override { return format_; }
+    uint32_t mipLevels() const override { return mipLevels_; }
+    uint32_t arrayLayers() const override { return arrayLayers_; }
+
+    /// Same as Image::enableLayoutTracking().
+    bool enableLayoutTracking(const VkImageLayout currentLayout = VK_IMAGE_LAYOUT_UNDEFINED);
+    void disableLayoutTracking() { layoutTracker_.clear(); }
+
+    bool layoutTrackingEnabled() const { return layoutTracker_.initialized(); }
+
+    ImageLayoutTracker* layoutTracker() override
+    {
+        return layoutTracker_.initialized() ? &layoutTracker_ : nullptr;
+    }
+    const ImageLayoutTracker* layoutTracker() const override
+    {
+        return layoutTracker_.initialized() ? &layoutTracker_ : nullptr;
+    }
+
+    VkDeviceSize pageSize() const { return pageSize_; }
+    uint32_t memoryTypeBits() const { return memoryTypeBits_; }
+
+    /// Size of a tile in texels.
+    VkExtent3D tileExtent() const { return sparseRequirements_.formatProperties.imageGranularity; }
+
+    /// Number of tiles of a mip level, the level must be above the mip tail.
+    VkExtent3D tileCount(const uint32_t level) const
+    {
+        VKW_ASSERT(level < mipTailFirstLevel());
+        return levelTileCounts_[level];
+    }
+
+    /// First mip level stored in the mip tail, mipLevels() if the image has no mip tail.
+    uint32_t mipTailFirstLevel() const
+    {
+        return std::min(sparseRequirements_.imageMipTailFirstLod, mipLevels_);
+    }
+    bool hasMipTail() const { return !mipTailPages_.empty(); }
+    bool singleMipTail() const
+    {
+        return (sparseRequirements_.formatProperties.flags & VK_SPARSE_IMAGE_FORMAT_SINGLE_MIPTAIL_BIT) != 0;
+    }
+
+    bool tileResident(const uint32_t level, const uint32_t layer, const VkOffset3D& tile) const
+    {
+        return pages_[tileIndex(level, layer, tile)] != VK_NULL_HANDLE;
+    }
+    bool mipTailResident(const uint32_t layer) const
+    {
+        VKW_ASSERT(hasMipTail());
+        return mipTailPages_[singleMipTail() ? 0 : layer] != VK_NULL_HANDLE;
+    }
+    uint32_t residentPageCount() const;
+
+  private:
+    friend class SparseResidencyManager;
+
+    const Device* device_{nullptr};
+
+    VkImage image_{VK_NULL_HANDLE};
+    VkImageType imageType_{};
+    VkFormat format_{};
+    VkExtent3D extent_{};
+    VkImageUsageFlags usage_{};
+    uint32_t mipLevels_{0};
+    uint32_t arrayLayers_{0};
+
+    VkDeviceSize pageSize_{0};
+    uint32_t memoryTypeBits_{0};
+    VkSparseImageMemoryRequirements sparseRequirements_{};
+
+    std::vector<VkExtent3D> levelTileCounts_{};
+    std::vector<uint32_t> levelFirstPage_{}; ///< Index of the first page of each level in a layer
+    uint32_t pagesPerLayer_{0};
+
+    std::vector<VmaAllocation> pages_{};        ///< Memory backing each tile, VK_NULL_HANDLE if not resident
+    std::vector<VmaAllocation> mipTailPages_{}; ///< Memory backing the mip tail of each layer
+
+    ImageLayoutTracker layoutTracker_{};
+
+    bool initialized_{false};
+
+    uint32_t tileIndex(const uint32_t level, const uint32_t layer, const VkOffset3D& tile) const
+    {
+        VKW_ASSERT(level < mipTailFirstLevel());
+        VKW_ASSERT(layer < arrayLayers_);
+        const auto& count = levelTileCounts_[level];
+        VKW_ASSERT(uint32_t(tile.x) < count.width);
+        VKW_ASSERT(uint32_t(tile.y) < count.height);
+        VKW_ASSERT(uint32_t(tile.z) < count.depth);
+        return layer * pagesPerLayer_ + levelFirstPage_[level]
+               + (uint32_t(tile.z) * count.height + uint32_t(tile.y)) * count.width + uint32_t(tile.x);
+    }
+};
+} // namespace vkw
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Buffer.hpp"
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/Device.hpp"
+#include "vkw/detail/RingAllocator.hpp"
+#include "vkw/detail/Synchronization.hpp"
+#include "vkw/detail/utils.hpp"
+
+#include <cstdint>
+
+namespace vkw
+{
+/// Ring allocator over a persistently mapped upload buffer.
+///
+/// Each upload reserves a region of the ring, tagged with the value the timeline semaphore reaches once the
+/// submission consuming the region is complete. Regions are reused as soon as this value is reached. All the
+/// regions allocated for a given timeline value must fit in the ring at once.
+class StagingRing
+{
+  public:
+    struct Allocation
+    {
+        VkDeviceSize offset{0};
+        VkDeviceSize size{0};
+        uint64_t timelineValue{0};
+        uint8_t* data{nullptr};
+
+        bool valid() const { return data != nullptr; }
+    };
+
+    StagingRing() {}
+    explicit StagingRing(
+        const Device& device, const TimelineSemaphore& timeline, const VkDeviceSize sizeBytes);
+
+    StagingRing(const StagingRing&) = delete;
+    StagingRing(StagingRing&& rhs);
+
+    StagingRing& operator=(const StagingRing&) = delete;
+    StagingRing& operator=(StagingRing&& rhs);
+
+    ~StagingRing();
+
+    bool init(const Device& device, const TimelineSemaphore& timeline, const VkDeviceSize sizeBytes);
+
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    const auto& buffer() const { return buffer_; }
+    const auto& timeline() const { return *timeline_; }
+
+    VkDeviceSize capacity() const { return buffer_.sizeBytes(); }
+
+    /// Reserves a region consumed by the submission signaling timelineValue. When the ring is full, waits for
+    /// the oldest regions to complete. Returns an invalid allocation if no space can be made.
+    Allocation allocate(const VkDeviceSize size, const VkDeviceSize alignment, const uint64_t timelineValue);
+
+    /// Reuses all the regions whose submission completed.
+    void reclaim() { allocator_.reclaim(); }
+
+    /// Makes host writes visible to the device for non coherent memory.
+    bool flush(const Allocation& allocation) const;
+
+  private:
+    const Device* device_{nullptr};
+    const TimelineSemaphore* timeline_{nullptr};
+
+    HostStagingBuffer<uint8_t> buffer_{};
+    uint8_t* mappedData_{nullptr};
+
+    RingAllocator allocator_{};
+
+    bool initialized_{false};
+};
+} // namespace vkw
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Buffer.hpp"
+#include "vkw/detail/CommandBuffer.hpp"
+#include "vkw/detail/CommandPool.hpp"
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/ComputePipeline.hpp"
+#include "vkw/detail/Device.hpp"
+#include "vkw/detail/MappedFile.hpp"
+#include "vkw/detail/PipelineLayout.hpp"
+#include "vkw/detail/Queue.hpp"
+#include "vkw/detail/Synchronization.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace vkw
+{
+/// Runs a compute pipeline over a host dataset too large to fit in device memory.
+///
+/// The dataset is split in tiles of a fixed number of elements. Uploading tile i + 1 on the transfer queue,
+/// processing tile i on the compute queue and reading back tile i - 1 on the transfer queue overlap, each
+/// stage being ordered with the others through timeline semaphores. Tiles rotate over slotCount sets of
+/// buffers, the host only waits when a slot is reused.
+///
+/// The pipeline layout must use a push descriptor set 0 with the input tile bound as a storage buffer at
+/// binding 0 and the output tile at binding 1, and reserve the TileConstants push constants. One invocation
+/// is dispatched per element of the tile.
+class StreamingDispatcher
+{
+  public:
+    struct TileConstants
+    {
+        uint64_t firstElement; ///< Index of the first element of the tile in the dataset
+        uint32_t tileIndex;
+        uint32_t elementCount; ///< Smaller than the tile size for the last tile
+    };
+
+    /// Writes the input data of a tile to dst. Returns false to abort the run.
+    using SourceCallback = std::function<bool(
+        const size_t tileIndex, const size_t firstElement, const size_t elementCount, void* dst)>;
+
+    /// Receives the output data of a tile, the data is only valid during the call. Tiles are delivered in
+    /// order.
+    using OutputCallback = std::function<void(
+        const size_t tileIndex, const size_t firstElement, const size_t elementCount, const void* data)>;
+
+    static constexpr uint32_t defaultGroupSize = 256;
+    static constexpr uint32_t defaultSlotCount = 3;
+
+    StreamingDispatcher() {}
+    explicit StreamingDispatcher(
+        const Device& device, const Queue& transferQueue, const Queue& computeQueue,
+        const ComputePipeline& pipeline, const PipelineLayout& pipelineLayout, const size_t inputElementSize,
+        const size_t outputElementSize, const size_t tileElementCount,
+        const uint32_t groupSize = defaultGroupSize, const uint32_t slotCount = defaultSlotCount);
+
+    StreamingDispatcher(const StreamingDispatcher&) = delete;
+    StreamingDispatcher(StreamingDispatcher&& rhs);
+
+    StreamingDispatcher& operator=(const StreamingDispatcher&) = delete;
+    StreamingDispatcher& operator=(StreamingDispatcher&& rhs);
+
+    ~StreamingDispatcher();
+
+    /// The transfer and compute queues can be the same queue.
+    bool init(
+        const Device& device, const Queue& transferQueue, const Queue& computeQueue,
+        const ComputePipeline& pipeline, const PipelineLayout& pipelineLayout, const size_t inputElementSize,
+        const size_t outputElementSize, const size_t tileElementCount,
+        const uint32_t groupSize = defaultGroupSize, const uint32_t slotCount = defaultSlotCount);
+
+    /// run() only returns once all its work completed, no work is pending here.
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    size_t tileElementCount() const { return tileElementCount_; }
+    size_t tileCount(const size_t elementCount) const
+    {
+        return (elementCount + tileElementCount_ - 1) / tileElementCount_;
+    }
+
+    // -------------------------------------------------------------------------------------------------------
+    // ------------------------------------------- Run -------------------------------------------------------
+    // -------------------------------------------------------------------------------------------------------
+
+    /// Processes elementCount elements produced by the source callback. Returns once all the output tiles
+    /// have been delivered.
+    bool run(const size_t elementCount, const SourceCallback& source, const OutputCallback& output);
+
+    /// Processes elementCount contiguous elements from host memory.
+    bool run(const void* data, const size_t elementCount, const OutputCallback& output);
+
+    /// Processes the mapped region of a file, its size must be a multiple of the input element size.
+    bool run(const MappedFile& file, const OutputCallback& output);
+
+  private:
+    struct Slot
+    {
+        HostStagingBuffer<uint8_t> stagingIn{};
+        DeviceBuffer<uint8_t> deviceIn{};
+        DeviceBuffer<uint8_t> deviceOut{};
+        DeviceToHostBuffer<uint8_t> stagingOut{};
+
+        CommandBuffer uploadCmd{};
+        CommandBuffer computeCmd{};
+        CommandBuffer readbackCmd{};
+    };
+
+    const Device* device_{nullptr};
+    Queue transferQueue_{};
+    Queue computeQueue_{};
+    const ComputePipeline* pipeline_{nullptr};
+    const PipelineLayout* pipelineLayout_{nullptr};
+
+    size_t inputElementSize_{0};
+    size_t outputElementSize_{0};
+    size_t tileElementCount_{0};
+    uint32_t groupSize_{defaultGroupSize};
+
+    CommandPool transferPool_{};
+    CommandPool computePool_{};
+    std::vector<Slot> slots_{};
+
+    TimelineSemaphore uploadTimeline_{};
+    TimelineSemaphore computeTimeline_{};
+    TimelineSemaphore readbackTimeline_{};
+    uint64_t baseValue_{0}; ///< Timeline values of a run start after the last value of the previous run
+
+    bool initialized_{false};
+
+    uint64_t tileValue(const size_t tileIndex) const { return baseValue_ + tileIndex + 1; }
+
+    bool upload(const size_t tileIndex, const size_t elementCount, const SourceCallback& source);
+    bool compute(const size_t tileIndex, const size_t elementCount);
+    bool readback(const size_t tileIndex, const size_t elementCount);
+    bool deliver(const size_t tileIndex, const size_t elementCount, const OutputCallback& output);
+};
+} // namespace vkw
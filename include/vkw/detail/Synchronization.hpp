@@ -86,7 +86,7 @@ class TimelineSemaphore
     VkSemaphore& getHandle() { return semaphore_; }
     const VkSemaphore& getHandle() const { return semaphore_; }
 
-    bool wait(const uint64_t waitValue, const uint64_t timeout = ~uint64_t(0))
+    bool wait(const uint64_t waitValue, const uint64_t timeout = ~uint64_t(0)) const
     {
         VkSemaphoreWaitInfo waitInfo = {};
         waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
@@ -112,6 +112,15 @@ class TimelineSemaphore
         return true;
     }
 
+    uint64_t getValue() const
+    {
+        uint64_t value = 0;
+        VKW_CHECK_VK_FAIL(
+            device_->vk().vkGetSemaphoreCounterValue(device_->getHandle(), semaphore_, &value),
+            "Getting semaphore counter value");
+        return value;
+    }
+
   private:
     const Device* device_{nullptr};
     VkSemaphore semaphore_{VK_NULL_HANDLE};
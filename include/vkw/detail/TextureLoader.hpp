@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/CommandBuffer.hpp"
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/Device.hpp"
+#include "vkw/detail/Image.hpp"
+#include "vkw/detail/MappedFile.hpp"
+#include "vkw/detail/StagingRing.hpp"
+#include "vkw/detail/utils.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vkw
+{
+/// Loads KTX2 and DDS textures.
+///
+/// The file is memory mapped and its header parsed on open(), the payload is only read when uploading: the
+/// requested levels are copied from the mapping to a staging ring region and transferred to the image with
+/// a single copyBufferToImage() call. Block compressed formats (BC, ETC2, ASTC) are supported,
+/// supercompressed KTX2 files are not.
+///
+/// For progressive residency, uploadTopLevels() uploads the smallest levels only so a low resolution
+/// version of the texture can be used (with a clamped minLod) while the remaining levels are uploaded later.
+class TextureLoader
+{
+  public:
+    enum class FileType
+    {
+        Unknown = 0,
+        Ktx2 = 1,
+        Dds = 2
+    };
+
+    struct TextureInfo
+    {
+        FileType fileType{FileType::Unknown};
+        VkFormat format{VK_FORMAT_UNDEFINED};
+        VkImageType imageType{VK_IMAGE_TYPE_2D};
+        VkExtent3D extent{};
+        uint32_t mipLevels{0};
+        uint32_t arrayLayers{0}; ///< Includes the cube faces
+        bool cubemap{false};
+    };
+
+    TextureLoader() {}
+    explicit TextureLoader(const Device& device, StagingRing& stagingRing);
+
+    TextureLoader(const TextureLoader&) = delete;
+    TextureLoader(TextureLoader&& rhs) { *this = std::move(rhs); }
+
+    TextureLoader& operator=(const TextureLoader&) = delete;
+    TextureLoader& operator=(TextureLoader&& rhs);
+
+    ~TextureLoader() { this->clear(); }
+
+    bool init(const Device& device, StagingRing& stagingRing);
+
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    /// Maps the file and parses its header, the file type is deduced from its content.
+    bool open(const std::string& filename);
+    void close();
+
+    bool isOpen() const { return file_.initialized(); }
+
+    const TextureInfo& info() const { return info_; }
+
+    /// Creates an image matching the texture description, usable as a transfer destination.
+    template <MemoryType memType, VkImageUsageFlags flags>
+    bool createImage(
+        Image<memType, flags>& image, const VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT,
+        const char* pName = nullptr) const
+    {
+        VKW_ASSERT(this->isOpen());
+
+        const VkImageCreateFlags createFlags = info_.cubemap ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0;
+        return image.init(
+            *device_, info_.imageType, info_.format, info_.extent, usage | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+            VK_SAMPLE_COUNT_1_BIT, info_.arrayLayers, VK_IMAGE_TILING_OPTIMAL, info_.mipLevels, createFlags,
+            VK_SHARING_MODE_EXCLUSIVE, nullptr, pName);
+    }
+
+    /// Size of the staging region needed to upload the given levels.
+    VkDeviceSize payloadSize(
+        const uint32_t baseLevel = 0, const uint32_t levelCount = VK_REMAINING_MIP_LEVELS) const;
+
+    /// Copy regions of the given levels, for every layer. Buffer offsets are relative to bufferOffset, in
+    /// the layout used by the staging region of upload().
+    std::vector<VkBufferImageCopy> copyRegions(
+        const uint32_t baseLevel = 0, const uint32_t levelCount = VK_REMAINING_MIP_LEVELS,
+        const VkDeviceSize bufferOffset = 0) const;
+
+    /// Records the upload of the given levels. The staging region is reused once the timeline of the
+    /// staging ring reaches signalValue, that must be signaled by the submission of the command buffer.
+    /// Uploaded levels end up in finalLayout, their previous content is discarded.
+    bool upload(
+        const CommandBuffer& cmdBuffer, BaseImage& image, const uint64_t signalValue,
+        const uint32_t baseLevel = 0, const uint32_t levelCount = VK_REMAINING_MIP_LEVELS,
+        const VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    /// Uploads the count smallest levels only.
+    bool uploadTopLevels(
+        const CommandBuffer& cmdBuffer, BaseImage& image, const uint64_t signalValue, const uint32_t count,
+        const VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+    {
+        const uint32_t levelCount = std::min(count, info_.mipLevels);
+        return upload(cmdBuffer, image, signalValue, info_.mipLevels - levelCount, levelCount, finalLayout);
+    }
+
+    struct BlockInfo
+    {
+        uint32_t width{1};
+        uint32_t height{1};
+        uint32_t sizeBytes{0};
+    };
+
+    /// Texel block description of the formats supported by the loader, sizeBytes is 0 for other formats.
+    static BlockInfo getBlockInfo(const VkFormat format);
+
+  private:
+    /// Contiguous data of a level for a range of layers in the file
+    struct Subresource
+    {
+        uint32_t level;
+        uint32_t baseLayer;
+        uint32_t layerCount;
+        VkDeviceSize fileOffset;
+        VkDeviceSize sizeBytes;
+    };
+
+    const Device* device_{nullptr};
+    StagingRing* stagingRing_{nullptr};
+
+    MappedFile file_{};
+    TextureInfo info_{};
+    BlockInfo blockInfo_{};
+    std::vector<Subresource> subresources_{};
+
+    bool initialized_{false};
+
+    bool parseKtx2();
+    bool parseDds();
+
+    VkExtent3D levelExtent(const uint32_t level) const;
+    VkDeviceSize levelLayerSize(const uint32_t level) const;
+    VkDeviceSize payloadAlignment() const;
+};
+} // namespace vkw
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/utils.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vkw
+{
+namespace utils
+{
+    /// Fixed size pool of worker threads used for CPU side work (large host copies, deferred host
+    /// operations, ...).
+    class ThreadPool final
+    {
+      public:
+        ThreadPool() {}
+        explicit ThreadPool(const size_t threadCount);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) = delete;
+
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+
+        ~ThreadPool();
+
+        /// A thread count of 0 uses one thread per hardware thread.
+        bool init(const size_t threadCount = 0);
+
+        void clear();
+
+        bool initialized() const { return initialized_; }
+
+        size_t threadCount() const { return workers_.size(); }
+
+        template <typename Fn>
+        std::future<void> submit(Fn&& fn)
+        {
+            VKW_ASSERT(this->initialized());
+
+            auto task = std::make_shared<std::packaged_task<void()>>(std::forward<Fn>(fn));
+            auto ret = task->get_future();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                tasks_.emplace_back([task]() { (*task)(); });
+            }
+            cv_.notify_one();
+
+            return ret;
+        }
+
+        /// Invokes fn(i) for i in [0, n) on the pool workers and the calling thread, and waits for all
+        /// invocations to finish. Must not be called from a task running on the same pool.
+        void parallelFor(const size_t n, const std::function<void(const size_t)>& fn);
+
+        /// Process wide pool, lazily created with one thread per hardware thread.
+        static ThreadPool& instance();
+
+      private:
+        std::vector<std::thread> workers_{};
+        std::deque<std::function<void()>> tasks_{};
+
+        std::mutex mutex_{};
+        std::condition_variable cv_{};
+        bool stop_{false};
+
+        bool initialized_{false};
+
+        void workerLoop();
+    };
+} // namespace utils
+} // namespace vkw
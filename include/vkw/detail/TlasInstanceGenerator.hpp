@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "vkw/detail/Buffer.hpp"
+#include "vkw/detail/Common.hpp"
+#include "vkw/detail/ComputePipeline.hpp"
+#include "vkw/detail/DescriptorSetLayout.hpp"
+#include "vkw/detail/Device.hpp"
+#include "vkw/detail/PipelineLayout.hpp"
+
+#include <cstdint>
+
+namespace vkw
+{
+class CommandBuffer;
+
+/// Compute kernel filling a TLAS instance buffer on the GPU, see CommandBuffer::generateInstances().
+///
+/// Each instance is generated from compact per-object data:
+///   - a VkTransformMatrixKHR array,
+///   - an InstanceDescriptor array,
+///   - a table of BLAS device addresses, indexed by InstanceDescriptor::blasIndex.
+/// The instance buffer can then be consumed by a TLAS created with an external instance buffer, so that
+/// instance updates never leave the GPU. All the buffers are bound with push descriptors and need
+/// VK_BUFFER_USAGE_STORAGE_BUFFER_BIT.
+class TlasInstanceGenerator
+{
+  public:
+    struct InstanceDescriptor
+    {
+        uint32_t blasIndex;
+        uint32_t customIndex;     ///< 24 bits used
+        uint32_t hitBindingIndex; ///< 24 bits used
+        uint32_t maskAndFlags;    ///< Mask in bits [0, 8), VkGeometryInstanceFlagsKHR in bits [8, 16)
+
+        static constexpr uint32_t packMaskAndFlags(
+            const uint32_t mask, const VkGeometryInstanceFlagsKHR flags)
+        {
+            return (mask & 0xFFu) | ((flags & 0xFFu) << 8);
+        }
+    };
+    static_assert(sizeof(InstanceDescriptor) == 4 * sizeof(uint32_t));
+
+    TlasInstanceGenerator() {}
+    explicit TlasInstanceGenerator(const Device& device);
+
+    TlasInstanceGenerator(const TlasInstanceGenerator&) = delete;
+    TlasInstanceGenerator(TlasInstanceGenerator&& rhs) { *this = std::move(rhs); }
+
+    TlasInstanceGenerator& operator=(const TlasInstanceGenerator&) = delete;
+    TlasInstanceGenerator& operator=(TlasInstanceGenerator&& rhs);
+
+    ~TlasInstanceGenerator() { this->clear(); }
+
+    bool init(const Device& device);
+
+    void clear();
+
+    bool initialized() const { return initialized_; }
+
+    /// Writes instanceCount instances and makes them visible to acceleration structure builds. blasCount is
+    /// the size of the address table, descriptors referencing a BLAS out of it produce inactive instances.
+    bool recordGeneration(
+        const CommandBuffer& cmdBuffer, const BaseBuffer& transforms, const BaseBuffer& descriptors,
+        const BaseBuffer& blasAddresses, const BaseBuffer& instances, const uint32_t instanceCount,
+        const uint32_t blasCount) const;
+
+  private:
+    struct PushConstants
+    {
+        uint32_t instanceCount;
+        uint32_t blasCount;
+        uint32_t rowInvocations;
+    };
+
+    const Device* device_{nullptr};
+
+    DescriptorSetLayout descriptorSetLayout_{};
+    PipelineLayout pipelineLayout_{};
+    ComputePipeline pipeline_{};
+
+    bool initialized_{false};
+};
+} // namespace vkw
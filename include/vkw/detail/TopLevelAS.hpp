@@ -25,6 +25,11 @@
 #include "vkw/detail/BaseAS.hpp"
 #include "vkw/detail/BottomLevelAS.hpp"
 #include "vkw/detail/Common.hpp"
+#include "vkw/detail/DeferredHostOperation.hpp"
+#include "vkw/detail/ThreadPool.hpp"
+
+#include <future>
+#include <vector>
 
 namespace vkw
 {
@@ -46,13 +51,54 @@ class TopLevelAccelerationStructure final : public BaseAccelerationStructure
 
     bool init(const Device& device, const bool buildOnHost = false);
 
+    /// Device built structures are sized for instanceCapacity() instances, instances can then be added
+    /// until this capacity is reached without creating the structure again.
     void create(const VkBuildAccelerationStructureFlagBitsKHR buildFlags = {});
 
+    /// Creates a structure reading its instances from a device buffer filled by the application, for instance
+    /// with TlasInstanceGenerator. The buffer needs VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT and
+    /// VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR, it must outlive the structure.
+    void create(
+        const BaseBuffer& instanceBuffer, const uint32_t maxInstanceCount,
+        const VkBuildAccelerationStructureFlagBitsKHR buildFlags = {});
+
     void clear() override;
 
+    bool externalInstances() const { return externalInstances_; }
+
+    /// Number of instances used by the next build or update.
+    uint32_t instanceCount() const
+    {
+        return externalInstances_ ? externalInstanceCount_ : static_cast<uint32_t>(instancesList_.size());
+    }
+
+    /// Sets the number of instances read from the external instance buffer, up to maxInstanceCount. Updates
+    /// must use the instance count of the last build: after a count change, the structure must be built
+    /// again before it can be updated.
+    TopLevelAccelerationStructure& setInstanceCount(const uint32_t instanceCount);
+
+    /// Instances modified through this accessor must be flagged with markDirty().
     auto& instances() { return instancesList_; }
     const auto& instances() const { return instancesList_; }
 
+    /// Number of instances the structure and its instance buffer are sized for, must be set before create().
+    TopLevelAccelerationStructure& reserveInstances(const uint32_t instanceCount);
+    uint32_t instanceCapacity() const { return instanceCapacity_; }
+
+    // -------------------------------------------------------------------------------------------------------
+
+    /// Instances changed since the last upload, only those are copied to the device instance buffer by
+    /// CommandBuffer::uploadInstances().
+    TopLevelAccelerationStructure& setInstance(
+        const uint32_t index, const VkAccelerationStructureInstanceKHR& instance);
+    TopLevelAccelerationStructure& setTransform(const uint32_t index, const VkTransformMatrixKHR& transform);
+
+    TopLevelAccelerationStructure& markDirty(const uint32_t firstIndex, const uint32_t count = 1);
+    TopLevelAccelerationStructure& markAllDirty();
+
+    uint32_t dirtyInstanceCount() const { return dirtyCount_; }
+    bool hasDirtyInstances() const { return dirtyCount_ > 0; }
+
     inline VkAccelerationStructureTypeKHR type() const override
     {
         return VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR;
@@ -67,6 +113,7 @@ class TopLevelAccelerationStructure final : public BaseAccelerationStructure
 
     // -------------------------------------------------------------------------------------------------------
 
+    /// Host builds, see BottomLevelAccelerationStructure::build() for the deferred behavior.
     bool build(
         void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags,
         const bool deferred = false);
@@ -79,6 +126,15 @@ class TopLevelAccelerationStructure final : public BaseAccelerationStructure
         const std::vector<VkTransformMatrixKHR>& transforms, void* scratchData,
         const VkBuildAccelerationStructureFlagsKHR buildFlags, const bool deferred = false);
 
+    /// Asynchronous host builds joined by the pool workers, instances must not be modified until the returned
+    /// future is ready. A new host build first waits for the pending one.
+    std::shared_future<VkResult> buildDeferred(
+        void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags,
+        utils::ThreadPool& pool = utils::ThreadPool::instance());
+    std::shared_future<VkResult> updateDeferred(
+        void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags,
+        utils::ThreadPool& pool = utils::ThreadPool::instance());
+
     ///@todo Not implemented yet
     bool copy();
 
@@ -86,9 +142,31 @@ class TopLevelAccelerationStructure final : public BaseAccelerationStructure
     friend class CommandBuffer;
 
     VkAccelerationStructureGeometryKHR geometry_{};
-    HostBuffer<VkAccelerationStructureInstanceKHR> instancesBuffer_{};
+    DeviceBuffer<VkAccelerationStructureInstanceKHR> instancesBuffer_{};
+    HostStagingBuffer<VkAccelerationStructureInstanceKHR> instancesStagingBuffer_{};
     std::vector<VkAccelerationStructureInstanceKHR> instancesList_{};
+    uint32_t instanceCapacity_{0};
+
+    std::vector<bool> dirtyInstances_{};
+    uint32_t dirtyCount_{0};
+
+    bool externalInstances_{false};
+    uint32_t externalInstanceCount_{0};
+
+    DeferredHostOperation deferredOperation_{};
 
     bool initialized_{false};
+
+    void createStructure(
+        const VkDeviceOrHostAddressConstKHR& instanceData, const uint32_t maxInstanceCount,
+        const VkBuildAccelerationStructureFlagBitsKHR buildFlags);
+
+    /// Writes the dirty instances in the staging buffer and returns the regions to copy, one per contiguous
+    /// run of dirty instances. Clears the dirty flags.
+    std::vector<VkBufferCopy> stageDirtyInstances();
+
+    std::shared_future<VkResult> hostBuild(
+        void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags, const bool update,
+        utils::ThreadPool* pool);
 };
 } // namespace vkw
@@ -378,6 +378,15 @@ namespace utils
 
     inline uint32_t divUp(const uint32_t n, const uint32_t val) { return (n + val - 1) / val; }
 
+    /// Lays a linear dispatch of groupCount workgroups out on a 2D grid, to go beyond
+    /// maxComputeWorkGroupCount[0]. Shaders get their linear index back with width * groupSize invocations
+    /// per row. groupCount must not be 0.
+    inline VkExtent2D linearDispatchGrid(const uint32_t groupCount, const uint32_t maxGroupCountX)
+    {
+        const uint32_t width = groupCount < maxGroupCountX ? groupCount : maxGroupCountX;
+        return {width, divUp(groupCount, width)};
+    }
+
     VkShaderModule createShaderModule(
         const VolkDeviceTable& vk, const VkDevice device, const std::vector<char>& src);
 
@@ -387,6 +396,25 @@ namespace utils
         const VkMemoryRequirements requirements);
 
     std::vector<char> readShader(const std::string& filename);
+
+    /// Copy using non-temporal stores when available, meant for write-combined memory that will not be
+    /// read back by the host.
+    void streamingCopy(void* dst, const void* src, const size_t sizeBytes);
+
+    struct CopyRegionStats
+    {
+        size_t inputCount{0};
+        size_t mergedCount{0}; ///< Regions merged into a previous one
+        size_t splitCount{0};  ///< Regions added by splitting the large ones
+        size_t outputCount{0};
+    };
+
+    /// Sorts buffer copy regions by destination offset and merges the regions that are adjacent or overlap in
+    /// the destination with the same source to destination delta, since they copy contiguous data. Regions
+    /// with conflicting overlaps are left untouched. When maxRegionSize is not 0, larger regions are then
+    /// split so that big copies can be recorded in several parts, interleaved with other work.
+    CopyRegionStats optimizeCopyRegions(
+        std::vector<VkBufferCopy>& regions, const VkDeviceSize maxRegionSize = 0);
 } // namespace utils
 } // namespace vkw
 
@@ -22,29 +22,55 @@
 
 #pragma once
 
+#include "vkw/detail/ASCompactor.hpp"
 #include "vkw/detail/ASGeometryData.hpp"
+#include "vkw/detail/ASScratchPool.hpp"
+#include "vkw/detail/ASSerializer.hpp"
+#include "vkw/detail/BlasBatcher.hpp"
 #include "vkw/detail/BottomLevelAS.hpp"
 #include "vkw/detail/Buffer.hpp"
+#include "vkw/detail/BufferCopyKernels.hpp"
 #include "vkw/detail/BufferView.hpp"
+#include "vkw/detail/ChunkedBuffer.hpp"
 #include "vkw/detail/CommandBuffer.hpp"
 #include "vkw/detail/CommandPool.hpp"
 #include "vkw/detail/ComputePipeline.hpp"
 #include "vkw/detail/DebugMessenger.hpp"
+#include "vkw/detail/DeferredDeletionQueue.hpp"
+#include "vkw/detail/DeferredHostOperation.hpp"
 #include "vkw/detail/DescriptorPool.hpp"
 #include "vkw/detail/DescriptorSet.hpp"
 #include "vkw/detail/DescriptorSetLayout.hpp"
 #include "vkw/detail/Device.hpp"
+#include "vkw/detail/DeviceVector.hpp"
 #include "vkw/detail/Framebuffer.hpp"
 #include "vkw/detail/GraphicsPipeline.hpp"
 #include "vkw/detail/Image.hpp"
+#include "vkw/detail/ImageLayoutTracker.hpp"
+#include "vkw/detail/ImagePool.hpp"
 #include "vkw/detail/ImageView.hpp"
 #include "vkw/detail/Instance.hpp"
+#include "vkw/detail/MappedFile.hpp"
+#include "vkw/detail/MemoryBudgetMonitor.hpp"
+#include "vkw/detail/MipmapGenerator.hpp"
+#include "vkw/detail/PipelineCache.hpp"
 #include "vkw/detail/PipelineLayout.hpp"
 #include "vkw/detail/Queue.hpp"
+#include "vkw/detail/RayTracingPipeline.hpp"
+#include "vkw/detail/ReadbackRing.hpp"
 #include "vkw/detail/RenderPass.hpp"
 #include "vkw/detail/RenderingAttachment.hpp"
+#include "vkw/detail/RingAllocator.hpp"
 #include "vkw/detail/Sampler.hpp"
+#include "vkw/detail/ShaderBindingTable.hpp"
+#include "vkw/detail/SparseResidencyManager.hpp"
+#include "vkw/detail/SparseResource.hpp"
+#include "vkw/detail/StagingRing.hpp"
+#include "vkw/detail/StreamingDispatcher.hpp"
 #include "vkw/detail/Surface.hpp"
 #include "vkw/detail/Swapchain.hpp"
 #include "vkw/detail/Synchronization.hpp"
+#include "vkw/detail/TextureLoader.hpp"
+#include "vkw/detail/ThreadPool.hpp"
+#include "vkw/detail/TlasInstanceGenerator.hpp"
 #include "vkw/detail/TopLevelAS.hpp"
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/ASCompactor.hpp"
+
+#include "vkw/detail/CommandBuffer.hpp"
+
+namespace vkw
+{
+AccelerationStructureCompactor::AccelerationStructureCompactor(
+    const Device& device, const uint32_t maxStructureCount)
+{
+    VKW_CHECK_BOOL_FAIL(
+        this->init(device, maxStructureCount), "Initializing acceleration structure compactor");
+}
+
+AccelerationStructureCompactor::AccelerationStructureCompactor(AccelerationStructureCompactor&& rhs)
+{
+    *this = std::move(rhs);
+}
+
+AccelerationStructureCompactor& AccelerationStructureCompactor::operator=(
+    AccelerationStructureCompactor&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+
+    std::swap(queryPool_, rhs.queryPool_);
+    std::swap(maxStructureCount_, rhs.maxStructureCount_);
+
+    std::swap(queriedStructures_, rhs.queriedStructures_);
+    std::swap(compactedSizes_, rhs.compactedSizes_);
+
+    std::swap(originalBytes_, rhs.originalBytes_);
+    std::swap(compactedBytes_, rhs.compactedBytes_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+AccelerationStructureCompactor::~AccelerationStructureCompactor() { this->clear(); }
+
+bool AccelerationStructureCompactor::init(const Device& device, const uint32_t maxStructureCount)
+{
+    VKW_ASSERT(this->initialized() == false);
+    VKW_ASSERT(maxStructureCount > 0);
+
+    device_ = &device;
+    maxStructureCount_ = maxStructureCount;
+
+    VkQueryPoolCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = 0;
+    createInfo.queryType = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR;
+    createInfo.queryCount = maxStructureCount;
+    createInfo.pipelineStatistics = 0;
+    VKW_INIT_CHECK_VK(
+        device_->vk().vkCreateQueryPool(device_->getHandle(), &createInfo, nullptr, &queryPool_));
+
+    compactedSizes_.resize(maxStructureCount);
+
+    initialized_ = true;
+
+    return true;
+}
+
+void AccelerationStructureCompactor::clear()
+{
+    originalBytes_ = 0;
+    compactedBytes_ = 0;
+
+    compactedSizes_.clear();
+    queriedStructures_.clear();
+
+    VKW_DELETE_VK(QueryPool, queryPool_);
+    maxStructureCount_ = 0;
+
+    device_ = nullptr;
+
+    initialized_ = false;
+}
+
+bool AccelerationStructureCompactor::recordSizeQueries(
+    const CommandBuffer& cmdBuffer,
+    const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList)
+{
+    VKW_ASSERT(this->initialized());
+
+    if(blasList.size() > maxStructureCount_)
+    {
+        utils::Log::Error(
+            "vkw", "Too many structures to compact: %zu, compactor limited to %u", blasList.size(),
+            maxStructureCount_);
+        return false;
+    }
+
+    queriedStructures_.clear();
+    for(const auto& blas : blasList)
+    {
+        VKW_ASSERT(blas.get().buildOnHost() == false);
+        queriedStructures_.push_back(blas.get().getHandle());
+    }
+    if(queriedStructures_.empty()) { return true; }
+
+    const uint32_t queryCount = static_cast<uint32_t>(queriedStructures_.size());
+
+    // The build must be complete before its properties can be queried
+    VkMemoryBarrier memoryBarrier = {};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.pNext = nullptr;
+    memoryBarrier.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+    memoryBarrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+    device_->vk().vkCmdPipelineBarrier(
+        cmdBuffer.getHandle(), VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+    device_->vk().vkCmdResetQueryPool(cmdBuffer.getHandle(), queryPool_, 0, queryCount);
+    device_->vk().vkCmdWriteAccelerationStructuresPropertiesKHR(
+        cmdBuffer.getHandle(), queryCount, queriedStructures_.data(),
+        VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR, queryPool_, 0);
+
+    return true;
+}
+
+bool AccelerationStructureCompactor::recordCompaction(
+    const CommandBuffer& cmdBuffer,
+    const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList,
+    DeferredDeletionQueue& deletionQueue, const uint64_t timelineValue)
+{
+    VKW_ASSERT(this->initialized());
+
+    if(blasList.size() != queriedStructures_.size())
+    {
+        utils::Log::Error("vkw", "Compacted structures do not match the queried ones");
+        return false;
+    }
+    for(size_t i = 0; i < blasList.size(); ++i)
+    {
+        if(blasList[i].get().getHandle() != queriedStructures_[i])
+        {
+            utils::Log::Error("vkw", "Compacted structures do not match the queried ones");
+            return false;
+        }
+    }
+    if(queriedStructures_.empty()) { return true; }
+
+    const uint32_t queryCount = static_cast<uint32_t>(queriedStructures_.size());
+    VKW_CHECK_VK_RETURN_FALSE(device_->vk().vkGetQueryPoolResults(
+        device_->getHandle(), queryPool_, 0, queryCount, queryCount * sizeof(VkDeviceSize),
+        compactedSizes_.data(), sizeof(VkDeviceSize), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT));
+    queriedStructures_.clear();
+
+    originalBytes_ = 0;
+    compactedBytes_ = 0;
+    for(size_t i = 0; i < blasList.size(); ++i)
+    {
+        auto& blas = blasList[i].get();
+
+        const VkDeviceSize originalSize = blas.storageBuffer_.sizeBytes();
+        const VkDeviceSize compactedSize = compactedSizes_[i];
+        originalBytes_ += originalSize;
+
+        // Nothing to gain, the structure was most likely built without allowing compaction
+        if(compactedSize == 0 || compactedSize >= originalSize)
+        {
+            compactedBytes_ += originalSize;
+            continue;
+        }
+
+        BottomLevelAccelerationStructure compacted{};
+        VKW_CHECK_BOOL_RETURN_FALSE(compacted.init(*device_, false));
+        VKW_CHECK_BOOL_RETURN_FALSE(compacted.createStorage(compactedSize));
+
+        cmdBuffer.copyAccelerationStructure(
+            blas, compacted, VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR);
+
+        // The compacted structure takes the place of the original one, kept alive until the copy completes.
+        // The build sizes are kept as they are, they are still needed to refit the structure.
+        std::swap(blas.storageBuffer_, compacted.storageBuffer_);
+        std::swap(blas.accelerationStructure_, compacted.accelerationStructure_);
+        blas.compactedSize_ = compactedSize;
+        deletionQueue.retire(std::move(compacted), timelineValue);
+
+        compactedBytes_ += compactedSize;
+    }
+
+    utils::Log::Verbose(
+        "vkw", "Acceleration structures compacted: %llu bytes -> %llu bytes",
+        static_cast<unsigned long long>(originalBytes_), static_cast<unsigned long long>(compactedBytes_));
+
+    return true;
+}
+} // namespace vkw
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/ASScratchPool.hpp"
+
+#include <algorithm>
+
+namespace vkw
+{
+AccelerationStructureScratchPool::AccelerationStructureScratchPool(
+    const Device& device, const VkDeviceSize sizeBytes)
+{
+    VKW_CHECK_BOOL_FAIL(this->init(device, sizeBytes), "Initializing acceleration structure scratch pool");
+}
+
+AccelerationStructureScratchPool::AccelerationStructureScratchPool(AccelerationStructureScratchPool&& rhs)
+{
+    *this = std::move(rhs);
+}
+
+AccelerationStructureScratchPool& AccelerationStructureScratchPool::operator=(
+    AccelerationStructureScratchPool&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+
+    std::swap(buffer_, rhs.buffer_);
+    std::swap(baseAddress_, rhs.baseAddress_);
+    std::swap(alignment_, rhs.alignment_);
+    std::swap(offset_, rhs.offset_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+AccelerationStructureScratchPool::~AccelerationStructureScratchPool() { this->clear(); }
+
+bool AccelerationStructureScratchPool::init(const Device& device, const VkDeviceSize sizeBytes)
+{
+    VKW_ASSERT(this->initialized() == false);
+
+    if(!device.bufferMemoryAddressEnabled() || !device.accelerationStructureEnabled())
+    {
+        utils::Log::Error(
+            "vkw", "Scratch pool requires buffer device address and acceleration structure support");
+        return false;
+    }
+
+    device_ = &device;
+    const auto& properties = device.accelerationStructureProperties();
+    const VkDeviceSize scratchAlignment = properties.minAccelerationStructureScratchOffsetAlignment;
+    alignment_ = std::max(VkDeviceSize(1), scratchAlignment);
+
+    initialized_ = true;
+
+    if(sizeBytes > 0 && !this->reserve(sizeBytes))
+    {
+        this->clear();
+        return false;
+    }
+
+    return true;
+}
+
+void AccelerationStructureScratchPool::clear()
+{
+    offset_ = 0;
+    alignment_ = 1;
+    baseAddress_ = 0;
+    buffer_.clear();
+
+    device_ = nullptr;
+
+    initialized_ = false;
+}
+
+VkDeviceSize AccelerationStructureScratchPool::alignedSize(const VkDeviceSize sizeBytes) const
+{
+    return ((sizeBytes + alignment_ - 1) / alignment_) * alignment_;
+}
+
+VkDeviceSize AccelerationStructureScratchPool::requiredSize(
+    const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList,
+    const bool update) const
+{
+    VkDeviceSize ret = 0;
+    for(const auto& blas : blasList)
+    {
+        const bool refit = update && !blas.get().needsRebuild();
+        ret += alignedSize(refit ? blas.get().updateScratchSize() : blas.get().buildScratchSize());
+    }
+    return ret;
+}
+
+bool AccelerationStructureScratchPool::reserve(const VkDeviceSize sizeBytes)
+{
+    VKW_ASSERT(this->initialized());
+
+    if(sizeBytes <= capacity()) { return true; }
+
+    offset_ = 0;
+    baseAddress_ = 0;
+    buffer_.clear();
+
+    // The base address must be aligned as well, each region offset is then a multiple of the alignment
+    VKW_CHECK_BOOL_RETURN_FALSE(buffer_.init(*device_, static_cast<size_t>(sizeBytes), {}, alignment_));
+    baseAddress_ = buffer_.deviceAddress();
+    VKW_ASSERT((baseAddress_ % alignment_) == 0);
+
+    return true;
+}
+
+VkDeviceAddress AccelerationStructureScratchPool::allocate(const VkDeviceSize sizeBytes)
+{
+    VKW_ASSERT(this->initialized());
+
+    const VkDeviceSize regionSize = alignedSize(sizeBytes);
+    if(regionSize > availableBytes())
+    {
+        utils::Log::Error("vkw", "Acceleration structure scratch pool exhausted");
+        return 0;
+    }
+
+    const VkDeviceAddress ret = baseAddress_ + offset_;
+    offset_ += regionSize;
+
+    return ret;
+}
+} // namespace vkw
@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/ASSerializer.hpp"
+
+#include "vkw/detail/CommandBuffer.hpp"
+#include "vkw/detail/MappedFile.hpp"
+
+#include <cstring>
+#include <fstream>
+
+namespace vkw
+{
+namespace
+{
+// Resources read by the deserialization, the buffer is declared last to be destroyed before the mapping
+struct LoadResources
+{
+    MappedFile file{};
+    HostBuffer<uint8_t> buffer{};
+};
+
+constexpr size_t serializedHeaderSize = 2 * VK_UUID_SIZE + 3 * sizeof(uint64_t);
+} // namespace
+
+AccelerationStructureSerializer::AccelerationStructureSerializer(
+    const Device& device, const uint32_t maxStructureCount)
+{
+    VKW_CHECK_BOOL_FAIL(
+        this->init(device, maxStructureCount), "Initializing acceleration structure serializer");
+}
+
+AccelerationStructureSerializer::AccelerationStructureSerializer(AccelerationStructureSerializer&& rhs)
+{
+    *this = std::move(rhs);
+}
+
+AccelerationStructureSerializer& AccelerationStructureSerializer::operator=(
+    AccelerationStructureSerializer&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+
+    std::swap(queryPool_, rhs.queryPool_);
+    std::swap(maxStructureCount_, rhs.maxStructureCount_);
+
+    std::swap(queriedStructures_, rhs.queriedStructures_);
+
+    std::swap(serializationBuffer_, rhs.serializationBuffer_);
+    std::swap(serializedOffsets_, rhs.serializedOffsets_);
+    std::swap(serializedSizes_, rhs.serializedSizes_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+AccelerationStructureSerializer::~AccelerationStructureSerializer() { this->clear(); }
+
+bool AccelerationStructureSerializer::init(const Device& device, const uint32_t maxStructureCount)
+{
+    VKW_ASSERT(this->initialized() == false);
+    VKW_ASSERT(maxStructureCount > 0);
+
+    device_ = &device;
+    maxStructureCount_ = maxStructureCount;
+
+    VkQueryPoolCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = 0;
+    createInfo.queryType = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_SERIALIZATION_SIZE_KHR;
+    createInfo.queryCount = maxStructureCount;
+    createInfo.pipelineStatistics = 0;
+    VKW_INIT_CHECK_VK(
+        device_->vk().vkCreateQueryPool(device_->getHandle(), &createInfo, nullptr, &queryPool_));
+
+    initialized_ = true;
+
+    return true;
+}
+
+void AccelerationStructureSerializer::clear()
+{
+    serializationBuffer_.clear();
+    serializedOffsets_.clear();
+    serializedSizes_.clear();
+
+    queriedStructures_.clear();
+
+    VKW_DELETE_VK(QueryPool, queryPool_);
+    maxStructureCount_ = 0;
+
+    device_ = nullptr;
+
+    initialized_ = false;
+}
+
+bool AccelerationStructureSerializer::recordSizeQueries(
+    const CommandBuffer& cmdBuffer,
+    const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList)
+{
+    VKW_ASSERT(this->initialized());
+
+    if(blasList.size() > maxStructureCount_)
+    {
+        utils::Log::Error(
+            "vkw", "Too many structures to serialize: %zu, serializer limited to %u", blasList.size(),
+            maxStructureCount_);
+        return false;
+    }
+
+    queriedStructures_.clear();
+    for(const auto& blas : blasList)
+    {
+        VKW_ASSERT(blas.get().buildOnHost() == false);
+        queriedStructures_.push_back(blas.get().getHandle());
+    }
+    if(queriedStructures_.empty()) { return true; }
+
+    const uint32_t queryCount = static_cast<uint32_t>(queriedStructures_.size());
+
+    // The build must be complete before its properties can be queried
+    VkMemoryBarrier memoryBarrier = {};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.pNext = nullptr;
+    memoryBarrier.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+    memoryBarrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+    device_->vk().vkCmdPipelineBarrier(
+        cmdBuffer.getHandle(), VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+    device_->vk().vkCmdResetQueryPool(cmdBuffer.getHandle(), queryPool_, 0, queryCount);
+    device_->vk().vkCmdWriteAccelerationStructuresPropertiesKHR(
+        cmdBuffer.getHandle(), queryCount, queriedStructures_.data(),
+        VK_QUERY_TYPE_ACCELERATION_STRUCTURE_SERIALIZATION_SIZE_KHR, queryPool_, 0);
+
+    return true;
+}
+
+bool AccelerationStructureSerializer::recordSerialization(
+    const CommandBuffer& cmdBuffer,
+    const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList)
+{
+    VKW_ASSERT(this->initialized());
+
+    if(blasList.size() != queriedStructures_.size())
+    {
+        utils::Log::Error("vkw", "Serialized structures do not match the queried ones");
+        return false;
+    }
+    for(size_t i = 0; i < blasList.size(); ++i)
+    {
+        if(blasList[i].get().getHandle() != queriedStructures_[i])
+        {
+            utils::Log::Error("vkw", "Serialized structures do not match the queried ones");
+            return false;
+        }
+    }
+
+    serializedOffsets_.clear();
+    serializedSizes_.resize(queriedStructures_.size());
+    if(queriedStructures_.empty()) { return true; }
+
+    const uint32_t queryCount = static_cast<uint32_t>(queriedStructures_.size());
+    VKW_CHECK_VK_RETURN_FALSE(device_->vk().vkGetQueryPoolResults(
+        device_->getHandle(), queryPool_, 0, queryCount, queryCount * sizeof(VkDeviceSize),
+        serializedSizes_.data(), sizeof(VkDeviceSize), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT));
+    queriedStructures_.clear();
+
+    // Each structure is serialized at an address aligned on 256 bytes
+    VkDeviceSize totalSize = 0;
+    for(const auto size : serializedSizes_)
+    {
+        serializedOffsets_.push_back(totalSize);
+        totalSize += utils::alignedSize(size, VkDeviceSize(256));
+    }
+
+    if(serializationBuffer_.sizeBytes() < totalSize)
+    {
+        serializationBuffer_.clear();
+        VKW_CHECK_BOOL_RETURN_FALSE(serializationBuffer_.init(
+            *device_, static_cast<size_t>(totalSize), VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, 256));
+    }
+
+    for(size_t i = 0; i < blasList.size(); ++i)
+    {
+        blasList[i].get().serialize(cmdBuffer, serializationBuffer_, serializedOffsets_[i]);
+    }
+
+    // Serialized data is written as transfer writes by the acceleration structure copies
+    VkMemoryBarrier memoryBarrier = {};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.pNext = nullptr;
+    memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    device_->vk().vkCmdPipelineBarrier(
+        cmdBuffer.getHandle(), VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+        VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+    return true;
+}
+
+VkDeviceSize AccelerationStructureSerializer::serializedBytes() const
+{
+    VkDeviceSize ret = 0;
+    for(const auto size : serializedSizes_)
+    {
+        ret += size;
+    }
+    return ret;
+}
+
+bool AccelerationStructureSerializer::save(const size_t index, const std::string& filename) const
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(index < serializedSizes_.size());
+
+    const VkDeviceSize dataSize = serializedSizes_[index];
+
+    std::vector<uint8_t> fileData(fileDataOffset + dataSize, 0);
+    VKW_CHECK_BOOL_RETURN_FALSE(serializationBuffer_.copyToHost(
+        fileData.data() + fileDataOffset, static_cast<size_t>(serializedOffsets_[index]),
+        static_cast<size_t>(dataSize)));
+
+    FileHeader header = {};
+    header.magic = fileMagic;
+    header.version = fileVersion;
+    header.type = static_cast<uint32_t>(VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR);
+    header.reserved = 0;
+    header.dataSize = dataSize;
+    memcpy(fileData.data(), &header, sizeof(FileHeader));
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if(!file.is_open())
+    {
+        utils::Log::Error("vkw", "Error opening file %s", filename.c_str());
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(fileData.data()), static_cast<std::streamsize>(fileData.size()));
+
+    return file.good();
+}
+
+bool AccelerationStructureSerializer::recordLoad(
+    const CommandBuffer& cmdBuffer, BottomLevelAccelerationStructure& blas, const std::string& filename,
+    DeferredDeletionQueue& deletionQueue, const uint64_t timelineValue)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(blas.getHandle() == VK_NULL_HANDLE);
+
+    const bool importFile = device_->externalMemoryHostEnabled();
+
+    LoadResources resources{};
+    VKW_CHECK_BOOL_RETURN_FALSE(resources.file.init(
+        filename, 0, 0, importFile ? static_cast<size_t>(device_->minImportedHostPointerAlignment()) : 0));
+    const auto& file = resources.file;
+
+    FileHeader header = {};
+    if(file.size() >= fileDataOffset + serializedHeaderSize)
+    {
+        memcpy(&header, file.data(), sizeof(FileHeader));
+    }
+    if(header.magic != fileMagic || header.version != fileVersion
+       || header.type != static_cast<uint32_t>(VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR))
+    {
+        utils::Log::Error("vkw", "Invalid acceleration structure file %s", filename.c_str());
+        return false;
+    }
+
+    const uint8_t* data = file.data() + fileDataOffset;
+    if(header.dataSize > file.size() - fileDataOffset
+       || BaseAccelerationStructure::serializedSize(data) != header.dataSize)
+    {
+        utils::Log::Error("vkw", "Truncated acceleration structure file %s", filename.c_str());
+        return false;
+    }
+    if(!BaseAccelerationStructure::compatible(*device_, data))
+    {
+        utils::Log::Warning(
+            "vkw", "Acceleration structure file %s not compatible with the device", filename.c_str());
+        return false;
+    }
+
+    if(!blas.initialized()) { VKW_CHECK_BOOL_RETURN_FALSE(blas.init(*device_, false)); }
+    VKW_CHECK_BOOL_RETURN_FALSE(blas.createEmpty(BaseAccelerationStructure::deserializedSize(data)));
+
+    static constexpr VkBufferUsageFlags usage
+        = VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+          | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR;
+
+    // The mapping is read by the device in place when possible, the file is copied to host memory otherwise
+    VkDeviceSize srcOffset = 0;
+    if(importFile && resources.buffer.init(*device_, file, usage))
+    {
+        srcOffset = file.dataOffset() + fileDataOffset;
+    }
+    else
+    {
+        resources.buffer.clear();
+        VKW_CHECK_BOOL_RETURN_FALSE(
+            resources.buffer.init(*device_, static_cast<size_t>(header.dataSize), usage, 256));
+        VKW_CHECK_BOOL_RETURN_FALSE(
+            resources.buffer.copyFromHost(data, static_cast<size_t>(header.dataSize)));
+    }
+
+    blas.deserialize(cmdBuffer, resources.buffer, srcOffset);
+    deletionQueue.retire(std::move(resources), timelineValue);
+
+    return true;
+}
+} // namespace vkw
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/BaseAS.hpp"
+
+#include "vkw/detail/CommandBuffer.hpp"
+
+#include <cstring>
+
+namespace vkw
+{
+namespace
+{
+// Serialized data starts with the driver UUID and the compatibility UUID, followed by the serialized size,
+// the deserialized size and the count of bottom level handles, all 64 bits.
+constexpr size_t serializedSizeOffset = 2 * VK_UUID_SIZE;
+constexpr size_t deserializedSizeOffset = serializedSizeOffset + sizeof(uint64_t);
+} // namespace
+
+void BaseAccelerationStructure::serialize(
+    const CommandBuffer& cmdBuffer, const BaseBuffer& dst, const VkDeviceSize offset) const
+{
+    VKW_ASSERT(accelerationStructure_ != VK_NULL_HANDLE);
+    VKW_ASSERT(buildOnHost_ == false);
+    VKW_ASSERT((dst.deviceAddress() + offset) % 256 == 0);
+
+    VkCopyAccelerationStructureToMemoryInfoKHR copyInfo = {};
+    copyInfo.sType = VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_TO_MEMORY_INFO_KHR;
+    copyInfo.pNext = nullptr;
+    copyInfo.src = accelerationStructure_;
+    copyInfo.dst.deviceAddress = dst.deviceAddress() + offset;
+    copyInfo.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_SERIALIZE_KHR;
+    device_->vk().vkCmdCopyAccelerationStructureToMemoryKHR(cmdBuffer.getHandle(), &copyInfo);
+}
+
+void BaseAccelerationStructure::deserialize(
+    const CommandBuffer& cmdBuffer, const BaseBuffer& src, const VkDeviceSize offset) const
+{
+    VKW_ASSERT(accelerationStructure_ != VK_NULL_HANDLE);
+    VKW_ASSERT(buildOnHost_ == false);
+    VKW_ASSERT((src.deviceAddress() + offset) % 256 == 0);
+
+    VkCopyMemoryToAccelerationStructureInfoKHR copyInfo = {};
+    copyInfo.sType = VK_STRUCTURE_TYPE_COPY_MEMORY_TO_ACCELERATION_STRUCTURE_INFO_KHR;
+    copyInfo.pNext = nullptr;
+    copyInfo.src.deviceAddress = src.deviceAddress() + offset;
+    copyInfo.dst = accelerationStructure_;
+    copyInfo.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_DESERIALIZE_KHR;
+    device_->vk().vkCmdCopyMemoryToAccelerationStructureKHR(cmdBuffer.getHandle(), &copyInfo);
+}
+
+bool BaseAccelerationStructure::compatible(const Device& device, const void* serializedData)
+{
+    VKW_ASSERT(serializedData != nullptr);
+
+    VkAccelerationStructureVersionInfoKHR versionInfo = {};
+    versionInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_VERSION_INFO_KHR;
+    versionInfo.pNext = nullptr;
+    versionInfo.pVersionData = reinterpret_cast<const uint8_t*>(serializedData);
+
+    VkAccelerationStructureCompatibilityKHR compatibility
+        = VK_ACCELERATION_STRUCTURE_COMPATIBILITY_INCOMPATIBLE_KHR;
+    device.vk().vkGetDeviceAccelerationStructureCompatibilityKHR(
+        device.getHandle(), &versionInfo, &compatibility);
+
+    return compatibility == VK_ACCELERATION_STRUCTURE_COMPATIBILITY_COMPATIBLE_KHR;
+}
+
+VkDeviceSize BaseAccelerationStructure::serializedSize(const void* serializedData)
+{
+    uint64_t ret = 0;
+    memcpy(&ret, reinterpret_cast<const uint8_t*>(serializedData) + serializedSizeOffset, sizeof(uint64_t));
+    return static_cast<VkDeviceSize>(ret);
+}
+
+VkDeviceSize BaseAccelerationStructure::deserializedSize(const void* serializedData)
+{
+    uint64_t ret = 0;
+    memcpy(&ret, reinterpret_cast<const uint8_t*>(serializedData) + deserializedSizeOffset, sizeof(uint64_t));
+    return static_cast<VkDeviceSize>(ret);
+}
+} // namespace vkw
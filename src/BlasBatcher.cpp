@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/BlasBatcher.hpp"
+
+#include "vkw/detail/CommandBuffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace vkw
+{
+namespace
+{
+// Spreads the 10 lower bits of v so that they are 3 bits apart
+uint32_t expandBits(uint32_t v)
+{
+    v = (v * 0x00010001u) & 0xFF0000FFu;
+    v = (v * 0x00000101u) & 0x0F00F00Fu;
+    v = (v * 0x00000011u) & 0xC30C30C3u;
+    v = (v * 0x00000005u) & 0x49249249u;
+    return v;
+}
+
+// 30 bits Morton code of a point given in [0, 1]^3
+uint32_t mortonCode(const float x, const float y, const float z)
+{
+    const auto quantize = [](const float v) {
+        return static_cast<uint32_t>(std::clamp(v * 1024.0f, 0.0f, 1023.0f));
+    };
+    return (expandBits(quantize(x)) << 2) | (expandBits(quantize(y)) << 1) | expandBits(quantize(z));
+}
+} // namespace
+
+BlasBatcher::BlasBatcher(const Device& device)
+{
+    VKW_CHECK_BOOL_FAIL(this->init(device), "Initializing BLAS batcher");
+}
+
+BlasBatcher& BlasBatcher::operator=(BlasBatcher&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+
+    std::swap(targetPrimitiveCount_, rhs.targetPrimitiveCount_);
+    std::swap(maxGeometryCount_, rhs.maxGeometryCount_);
+
+    std::swap(meshes_, rhs.meshes_);
+    std::swap(positions_, rhs.positions_);
+    std::swap(indices_, rhs.indices_);
+    std::swap(transforms_, rhs.transforms_);
+
+    std::swap(vertexBuffer_, rhs.vertexBuffer_);
+    std::swap(indexBuffer_, rhs.indexBuffer_);
+    std::swap(transformBuffer_, rhs.transformBuffer_);
+
+    std::swap(vertexStagingBuffer_, rhs.vertexStagingBuffer_);
+    std::swap(indexStagingBuffer_, rhs.indexStagingBuffer_);
+    std::swap(transformStagingBuffer_, rhs.transformStagingBuffer_);
+    std::swap(uploadPending_, rhs.uploadPending_);
+
+    std::swap(structures_, rhs.structures_);
+    std::swap(meshLocations_, rhs.meshLocations_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+bool BlasBatcher::init(const Device& device)
+{
+    VKW_ASSERT(this->initialized() == false);
+
+    device_ = &device;
+
+    initialized_ = true;
+
+    return true;
+}
+
+void BlasBatcher::clear()
+{
+    this->clearStructures();
+
+    meshes_.clear();
+    positions_.clear();
+    indices_.clear();
+    transforms_.clear();
+
+    targetPrimitiveCount_ = 1u << 16;
+    maxGeometryCount_ = 1024;
+
+    device_ = nullptr;
+    initialized_ = false;
+}
+
+uint32_t BlasBatcher::addMesh(const MeshDesc& mesh)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(!this->created());
+    VKW_ASSERT(mesh.positions != nullptr && mesh.indices != nullptr);
+    VKW_ASSERT(mesh.vertexStride >= 3 * sizeof(float) && mesh.vertexStride % sizeof(float) == 0);
+    VKW_ASSERT(mesh.vertexCount > 0 && mesh.indexCount > 0 && mesh.indexCount % 3 == 0);
+
+    MeshInfo info = {};
+    info.firstVertex = static_cast<uint32_t>(positions_.size() / 3);
+    info.firstIndex = static_cast<uint32_t>(indices_.size());
+    info.indexCount = mesh.indexCount;
+    info.flags = mesh.flags;
+
+    // World space bounds, the centroid is used to sort the meshes
+    const auto& m = mesh.transform.matrix;
+    float minBounds[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                          std::numeric_limits<float>::max()};
+    float maxBounds[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                          std::numeric_limits<float>::lowest()};
+
+    const uint32_t strideFloats = mesh.vertexStride / sizeof(float);
+    positions_.reserve(positions_.size() + 3 * mesh.vertexCount);
+    for(uint32_t v = 0; v < mesh.vertexCount; ++v)
+    {
+        const float* p = mesh.positions + v * strideFloats;
+        positions_.insert(positions_.end(), p, p + 3);
+
+        for(uint32_t c = 0; c < 3; ++c)
+        {
+            const float w = m[c][0] * p[0] + m[c][1] * p[1] + m[c][2] * p[2] + m[c][3];
+            minBounds[c] = std::min(minBounds[c], w);
+            maxBounds[c] = std::max(maxBounds[c], w);
+        }
+    }
+    for(uint32_t c = 0; c < 3; ++c)
+    {
+        info.centroid[c] = 0.5f * (minBounds[c] + maxBounds[c]);
+    }
+
+    indices_.insert(indices_.end(), mesh.indices, mesh.indices + mesh.indexCount);
+    transforms_.push_back(mesh.transform);
+    meshes_.push_back(info);
+
+    return static_cast<uint32_t>(meshes_.size() - 1);
+}
+
+bool BlasBatcher::create(const VkBuildAccelerationStructureFlagBitsKHR buildFlags)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(!this->created());
+
+    if(meshes_.empty())
+    {
+        utils::Log::Error("vkw", "No mesh to batch");
+        return false;
+    }
+
+    // Batches must fit in a single structure
+    const auto& asProperties = device_->accelerationStructureProperties();
+    targetPrimitiveCount_
+        = static_cast<uint32_t>(std::min<uint64_t>(targetPrimitiveCount_, asProperties.maxPrimitiveCount));
+    maxGeometryCount_
+        = static_cast<uint32_t>(std::min<uint64_t>(maxGeometryCount_, asProperties.maxGeometryCount));
+    for(const auto& mesh : meshes_)
+    {
+        if(mesh.indexCount / 3 > asProperties.maxPrimitiveCount)
+        {
+            utils::Log::Error("vkw", "Mesh of %u triangles exceeds maxPrimitiveCount", mesh.indexCount / 3);
+            return false;
+        }
+    }
+
+    // A failure leaves the batcher as before the call, without any partly created structure
+    if(!this->createGeometryBuffers() || !this->createStructures(buildFlags))
+    {
+        this->clearStructures();
+        return false;
+    }
+
+    utils::Log::Verbose(
+        "vkw", "%zu meshes batched in %zu acceleration structures", meshes_.size(), structures_.size());
+
+    return true;
+}
+
+bool BlasBatcher::createStructures(const VkBuildAccelerationStructureFlagBitsKHR buildFlags)
+{
+    VkAccelerationStructureGeometryTrianglesDataKHR trianglesData = {};
+    trianglesData.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_TRIANGLES_DATA_KHR;
+    trianglesData.pNext = nullptr;
+    trianglesData.vertexFormat = VK_FORMAT_R32G32B32_SFLOAT;
+    trianglesData.vertexData.deviceAddress = vertexBuffer_.deviceAddress();
+    trianglesData.vertexStride = 3 * sizeof(float);
+    trianglesData.maxVertex = static_cast<uint32_t>(positions_.size() / 3 - 1);
+    trianglesData.indexType = VK_INDEX_TYPE_UINT32;
+    trianglesData.indexData.deviceAddress = indexBuffer_.deviceAddress();
+    trianglesData.transformData.deviceAddress = transformBuffer_.deviceAddress();
+
+    const auto batches = this->createBatches();
+
+    meshLocations_.resize(meshes_.size());
+    structures_.resize(batches.size());
+    for(size_t b = 0; b < batches.size(); ++b)
+    {
+        auto& blas = structures_[b];
+        VKW_CHECK_BOOL_RETURN_FALSE(blas.init(*device_, false));
+
+        const auto& batch = batches[b];
+        for(size_t g = 0; g < batch.size(); ++g)
+        {
+            const uint32_t meshIndex = batch[g];
+            const auto& mesh = meshes_[meshIndex];
+            const uint32_t primitiveCount = mesh.indexCount / 3;
+
+            VkAccelerationStructureBuildRangeInfoKHR range = {};
+            range.primitiveCount = primitiveCount;
+            range.primitiveOffset = mesh.firstIndex * static_cast<uint32_t>(sizeof(uint32_t));
+            range.firstVertex = mesh.firstVertex;
+            range.transformOffset = meshIndex * static_cast<uint32_t>(sizeof(VkTransformMatrixKHR));
+            blas.addGeometry(trianglesData, {range}, primitiveCount, mesh.flags);
+
+            meshLocations_[meshIndex] = {static_cast<uint32_t>(b), static_cast<uint32_t>(g)};
+        }
+
+        VKW_CHECK_BOOL_RETURN_FALSE(blas.create(buildFlags));
+    }
+
+    return true;
+}
+
+void BlasBatcher::clearStructures()
+{
+    structures_.clear();
+    meshLocations_.clear();
+
+    vertexStagingBuffer_.clear();
+    indexStagingBuffer_.clear();
+    transformStagingBuffer_.clear();
+    uploadPending_ = false;
+
+    vertexBuffer_.clear();
+    indexBuffer_.clear();
+    transformBuffer_.clear();
+}
+
+void BlasBatcher::recordUpload(
+    const CommandBuffer& cmdBuffer, DeferredDeletionQueue& deletionQueue, const uint64_t timelineValue)
+{
+    VKW_ASSERT(this->created());
+    if(!uploadPending_) { return; }
+
+    cmdBuffer.copyBuffer(vertexStagingBuffer_, vertexBuffer_);
+    cmdBuffer.copyBuffer(indexStagingBuffer_, indexBuffer_);
+    cmdBuffer.copyBuffer(transformStagingBuffer_, transformBuffer_);
+
+    cmdBuffer.buildInputBarrier();
+
+    deletionQueue.retire(std::move(vertexStagingBuffer_), timelineValue);
+    deletionQueue.retire(std::move(indexStagingBuffer_), timelineValue);
+    deletionQueue.retire(std::move(transformStagingBuffer_), timelineValue);
+    uploadPending_ = false;
+}
+
+std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>> BlasBatcher::blasList()
+{
+    std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>> ret{};
+    ret.reserve(structures_.size());
+    for(auto& blas : structures_)
+    {
+        ret.emplace_back(blas);
+    }
+    return ret;
+}
+
+void BlasBatcher::addInstances(
+    TopLevelAccelerationStructure& tlas, const uint32_t mask, const VkGeometryInstanceFlagsKHR flags,
+    const uint32_t hitBindingIndex) const
+{
+    VKW_ASSERT(this->created());
+
+    for(size_t i = 0; i < structures_.size(); ++i)
+    {
+        tlas.addInstance(
+            structures_[i], static_cast<uint32_t>(i), asIdentityMatrix, flags, mask, hitBindingIndex);
+    }
+}
+
+std::vector<std::vector<uint32_t>> BlasBatcher::createBatches() const
+{
+    float sceneMin[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                         std::numeric_limits<float>::max()};
+    float sceneMax[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                         std::numeric_limits<float>::lowest()};
+    for(const auto& mesh : meshes_)
+    {
+        for(uint32_t c = 0; c < 3; ++c)
+        {
+            sceneMin[c] = std::min(sceneMin[c], mesh.centroid[c]);
+            sceneMax[c] = std::max(sceneMax[c], mesh.centroid[c]);
+        }
+    }
+
+    // Centroids are normalized with the largest extent to keep the Morton cells cubic
+    const float extent = std::max(
+        {sceneMax[0] - sceneMin[0], sceneMax[1] - sceneMin[1], sceneMax[2] - sceneMin[2], 1e-6f});
+
+    std::vector<std::pair<uint32_t, uint32_t>> sortedMeshes{};
+    sortedMeshes.reserve(meshes_.size());
+    for(uint32_t i = 0; i < meshes_.size(); ++i)
+    {
+        const auto& c = meshes_[i].centroid;
+        const uint32_t code = mortonCode(
+            (c[0] - sceneMin[0]) / extent, (c[1] - sceneMin[1]) / extent, (c[2] - sceneMin[2]) / extent);
+        sortedMeshes.emplace_back(code, i);
+    }
+    std::sort(sortedMeshes.begin(), sortedMeshes.end());
+
+    std::vector<std::vector<uint32_t>> batches{};
+    uint32_t batchPrimitives = 0;
+    for(const auto& [code, meshIndex] : sortedMeshes)
+    {
+        const uint32_t primitiveCount = meshes_[meshIndex].indexCount / 3;
+        if(batches.empty() || batchPrimitives + primitiveCount > targetPrimitiveCount_
+           || batches.back().size() >= maxGeometryCount_)
+        {
+            batches.emplace_back();
+            batchPrimitives = 0;
+        }
+        batches.back().push_back(meshIndex);
+        batchPrimitives += primitiveCount;
+    }
+
+    return batches;
+}
+
+bool BlasBatcher::createGeometryBuffers()
+{
+    VKW_CHECK_BOOL_RETURN_FALSE(vertexBuffer_.init(*device_, positions_.size()));
+    VKW_CHECK_BOOL_RETURN_FALSE(indexBuffer_.init(*device_, indices_.size()));
+    VKW_CHECK_BOOL_RETURN_FALSE(transformBuffer_.init(*device_, transforms_.size()));
+
+    if(vertexBuffer_.hostVisible() && indexBuffer_.hostVisible() && transformBuffer_.hostVisible())
+    {
+        VKW_CHECK_BOOL_RETURN_FALSE(vertexBuffer_.copyFromHost(positions_.data(), positions_.size()));
+        VKW_CHECK_BOOL_RETURN_FALSE(indexBuffer_.copyFromHost(indices_.data(), indices_.size()));
+        VKW_CHECK_BOOL_RETURN_FALSE(transformBuffer_.copyFromHost(transforms_.data(), transforms_.size()));
+        return true;
+    }
+
+    // Device only memory, the geometry is uploaded by recordUpload()
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        vertexStagingBuffer_.init(*device_, positions_.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT));
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        indexStagingBuffer_.init(*device_, indices_.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT));
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        transformStagingBuffer_.init(*device_, transforms_.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT));
+    VKW_CHECK_BOOL_RETURN_FALSE(vertexStagingBuffer_.copyFromHost(positions_.data(), positions_.size()));
+    VKW_CHECK_BOOL_RETURN_FALSE(indexStagingBuffer_.copyFromHost(indices_.data(), indices_.size()));
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        transformStagingBuffer_.copyFromHost(transforms_.data(), transforms_.size()));
+    uploadPending_ = true;
+
+    return true;
+}
+} // namespace vkw
@@ -48,6 +48,13 @@ BottomLevelAccelerationStructure& BottomLevelAccelerationStructure::operator=(
     std::swap(geometryData_, rhs.geometryData_);
     std::swap(buildRanges_, rhs.buildRanges_);
 
+    std::swap(refitCount_, rhs.refitCount_);
+    std::swap(maxRefitCount_, rhs.maxRefitCount_);
+    std::swap(compactedSize_, rhs.compactedSize_);
+    std::swap(deferredOperation_, rhs.deferredOperation_);
+
+    std::swap(initialized_, rhs.initialized_);
+
     return *this;
 }
 
@@ -88,30 +95,38 @@ bool BottomLevelAccelerationStructure::create(const VkBuildAccelerationStructure
                      : VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR,
         &buildInfo, primitiveCounts_.data(), &buildSizes_);
 
-    VKW_CHECK_BOOL_RETURN_FALSE(storageBuffer_.init(
-        *device_, buildSizes_.accelerationStructureSize,
-        VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT));
-
-    VkAccelerationStructureCreateInfoKHR createInfo = {};
-    createInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
-    createInfo.pNext = nullptr;
-    createInfo.createFlags = 0; // Other flags are not supported for now
-    createInfo.buffer = storageBuffer_.getHandle();
-    createInfo.size = buildSizes_.accelerationStructureSize;
-    createInfo.type = type();
-    createInfo.deviceAddress = 0;
-    VKW_CHECK_VK_RETURN_FALSE(device_->vk().vkCreateAccelerationStructureKHR(
-        device_->getHandle(), &createInfo, nullptr, &accelerationStructure_));
+    VKW_CHECK_BOOL_RETURN_FALSE(this->createStorage(buildSizes_.accelerationStructureSize));
+
+    return true;
+}
+
+bool BottomLevelAccelerationStructure::createEmpty(const VkDeviceSize sizeBytes)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(geometryData_.empty());
+
+    buildSizes_ = {};
+    buildSizes_.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR;
+    buildSizes_.pNext = nullptr;
+    buildSizes_.accelerationStructureSize = sizeBytes;
+
+    VKW_CHECK_BOOL_RETURN_FALSE(this->createStorage(sizeBytes));
 
     return true;
 }
 
 void BottomLevelAccelerationStructure::clear()
 {
+    // Waits for a pending deferred build
+    deferredOperation_.clear();
+
     initialized_ = false;
     geometryData_.clear();
     buildRanges_.clear();
     primitiveCounts_.clear();
+    refitCount_ = 0;
+    maxRefitCount_ = 0;
+    compactedSize_ = 0;
 
     BaseAccelerationStructure::clear();
 }
@@ -229,33 +244,97 @@ BottomLevelAccelerationStructure& BottomLevelAccelerationStructure::addGeometry(
 }
 
 bool BottomLevelAccelerationStructure::build(
-    void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags, const bool /*deferred*/)
+    void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags, const bool deferred)
+{
+    auto* pool = deferred ? &utils::ThreadPool::instance() : nullptr;
+    VKW_CHECK_VK_RETURN_FALSE(this->hostBuild(scratchData, buildFlags, false, pool).get());
+    return true;
+}
+
+bool BottomLevelAccelerationStructure::update(
+    void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags, const bool deferred)
+{
+    auto* pool = deferred ? &utils::ThreadPool::instance() : nullptr;
+    VKW_CHECK_VK_RETURN_FALSE(this->hostBuild(scratchData, buildFlags, !needsRebuild(), pool).get());
+    return true;
+}
+
+std::shared_future<VkResult> BottomLevelAccelerationStructure::buildDeferred(
+    void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags, utils::ThreadPool& pool)
+{
+    return this->hostBuild(scratchData, buildFlags, false, &pool);
+}
+
+std::shared_future<VkResult> BottomLevelAccelerationStructure::updateDeferred(
+    void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags, utils::ThreadPool& pool)
+{
+    return this->hostBuild(scratchData, buildFlags, !needsRebuild(), &pool);
+}
+
+std::shared_future<VkResult> BottomLevelAccelerationStructure::hostBuild(
+    void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags, const bool refit,
+    utils::ThreadPool* pool)
 {
     VKW_ASSERT(this->initialized());
     VKW_ASSERT(this->buildOnHost());
     VKW_ASSERT(geometryData_.size() == buildRanges_.size());
 
-    std::vector<const VkAccelerationStructureBuildRangeInfoKHR*> ppBuildRanges = {};
+    if(!refit && compacted())
+    {
+        utils::Log::Error("vkw", "A compacted acceleration structure can only be refit");
+        return DeferredHostOperation::readyResult(VK_ERROR_UNKNOWN);
+    }
+
+    // A deferred build still running writes to the structure and owns the deferred operation
+    deferredOperation_.wait();
+
+    // Parameters of deferred builds must stay valid until the operation completes
+    struct HostBuildArgs
+    {
+        VkAccelerationStructureBuildGeometryInfoKHR buildInfo;
+        std::vector<VkAccelerationStructureBuildRangeInfoKHR> buildRanges;
+        const VkAccelerationStructureBuildRangeInfoKHR* pBuildRanges;
+    };
+    auto args = std::make_shared<HostBuildArgs>();
+
+    // One range per geometry, stored contiguously
     for(const auto& rangeList : buildRanges_)
     {
-        ppBuildRanges.push_back(rangeList.data());
+        VKW_ASSERT(rangeList.empty() == false);
+        args->buildRanges.push_back(rangeList.front());
     }
+    args->pBuildRanges = args->buildRanges.data();
 
-    VkAccelerationStructureBuildGeometryInfoKHR buildInfo = {};
+    auto& buildInfo = args->buildInfo;
+    buildInfo = {};
     buildInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
     buildInfo.pNext = nullptr;
     buildInfo.flags = buildFlags;
     buildInfo.type = type();
-    buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
-    buildInfo.srcAccelerationStructure = VK_NULL_HANDLE;
+    buildInfo.mode = refit ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR
+                           : VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+    buildInfo.srcAccelerationStructure = refit ? accelerationStructure_ : VK_NULL_HANDLE;
     buildInfo.dstAccelerationStructure = accelerationStructure_;
     buildInfo.geometryCount = static_cast<uint32_t>(geometryData_.size());
     buildInfo.pGeometries = geometryData_.data();
     buildInfo.ppGeometries = nullptr;
     buildInfo.scratchData.hostAddress = scratchData;
-    VKW_CHECK_VK_RETURN_FALSE(device_->vk().vkBuildAccelerationStructuresKHR(
-        device_->getHandle(), VK_NULL_HANDLE, 1, &buildInfo, ppBuildRanges.data()));
 
-    return true;
+    VkDeferredOperationKHR deferredOperation = VK_NULL_HANDLE;
+    if(pool != nullptr)
+    {
+        if(!deferredOperation_.initialized() && !deferredOperation_.init(*device_))
+        {
+            return DeferredHostOperation::readyResult(VK_ERROR_INITIALIZATION_FAILED);
+        }
+        deferredOperation = deferredOperation_.getHandle();
+    }
+
+    const VkResult res = device_->vk().vkBuildAccelerationStructuresKHR(
+        device_->getHandle(), deferredOperation, 1, &args->buildInfo, &args->pBuildRanges);
+    if(res >= 0) { refitCount_ = refit ? refitCount_ + 1 : 0; }
+
+    if(pool == nullptr) { return DeferredHostOperation::readyResult(res); }
+    return deferredOperation_.join(res, *pool, std::move(args));
 }
 } // namespace vkw
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/BufferCopyKernels.hpp"
+
+#include "vkw/detail/CommandBuffer.hpp"
+
+#include <limits>
+
+namespace vkw
+{
+namespace
+{
+const uint32_t bufferGatherSpv[] = {
+#include "spv/BufferGather.comp.spv"
+};
+const uint32_t bufferScatterSpv[] = {
+#include "spv/BufferScatter.comp.spv"
+};
+const uint32_t bufferTransposeAoSToSoASpv[] = {
+#include "spv/BufferTransposeAoSToSoA.comp.spv"
+};
+
+constexpr uint32_t groupSize = 256;
+} // namespace
+
+BufferCopyKernels::BufferCopyKernels(const Device& device)
+{
+    VKW_CHECK_BOOL_FAIL(this->init(device), "Initializing buffer copy kernels");
+}
+
+BufferCopyKernels& BufferCopyKernels::operator=(BufferCopyKernels&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+
+    std::swap(descriptorSetLayout_, rhs.descriptorSetLayout_);
+    std::swap(pipelineLayout_, rhs.pipelineLayout_);
+    std::swap(gatherPipeline_, rhs.gatherPipeline_);
+    std::swap(scatterPipeline_, rhs.scatterPipeline_);
+    std::swap(transposePipeline_, rhs.transposePipeline_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+bool BufferCopyKernels::init(const Device& device)
+{
+    VKW_ASSERT(this->initialized() == false);
+
+    device_ = &device;
+
+    VKW_INIT_CHECK_BOOL(descriptorSetLayout_.init(device));
+    descriptorSetLayout_.addBinding<DescriptorType::StorageBuffer>(VK_SHADER_STAGE_COMPUTE_BIT, 0)
+        .addBinding<DescriptorType::StorageBuffer>(VK_SHADER_STAGE_COMPUTE_BIT, 1)
+        .addBinding<DescriptorType::StorageBuffer>(VK_SHADER_STAGE_COMPUTE_BIT, 2);
+    VKW_INIT_CHECK_BOOL(descriptorSetLayout_.create(VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR));
+
+    VKW_INIT_CHECK_BOOL(pipelineLayout_.init(device, descriptorSetLayout_));
+    pipelineLayout_.reservePushConstants<PushConstants>(ShaderStage::Compute);
+    VKW_INIT_CHECK_BOOL(pipelineLayout_.create());
+
+    VKW_INIT_CHECK_BOOL(gatherPipeline_.init(
+        device, reinterpret_cast<const char*>(bufferGatherSpv), sizeof(bufferGatherSpv)));
+    VKW_INIT_CHECK_BOOL(gatherPipeline_.createPipeline(pipelineLayout_));
+
+    VKW_INIT_CHECK_BOOL(scatterPipeline_.init(
+        device, reinterpret_cast<const char*>(bufferScatterSpv), sizeof(bufferScatterSpv)));
+    VKW_INIT_CHECK_BOOL(scatterPipeline_.createPipeline(pipelineLayout_));
+
+    VKW_INIT_CHECK_BOOL(transposePipeline_.init(
+        device, reinterpret_cast<const char*>(bufferTransposeAoSToSoASpv),
+        sizeof(bufferTransposeAoSToSoASpv)));
+    VKW_INIT_CHECK_BOOL(transposePipeline_.createPipeline(pipelineLayout_));
+
+    initialized_ = true;
+
+    return true;
+}
+
+void BufferCopyKernels::clear()
+{
+    transposePipeline_.clear();
+    scatterPipeline_.clear();
+    gatherPipeline_.clear();
+    pipelineLayout_.clear();
+    descriptorSetLayout_.clear();
+
+    device_ = nullptr;
+    initialized_ = false;
+}
+
+bool BufferCopyKernels::recordGather(
+    const CommandBuffer& cmdBuffer, const BaseBuffer& src, const BaseBuffer& dst,
+    const BaseBuffer& indexBuffer, const uint32_t stride, const uint32_t count) const
+{
+    VKW_ASSERT(dst.sizeBytes() >= size_t(count) * stride);
+    VKW_ASSERT(indexBuffer.sizeBytes() >= size_t(count) * sizeof(uint32_t));
+    return record(cmdBuffer, gatherPipeline_, src, dst, &indexBuffer, stride, count);
+}
+
+bool BufferCopyKernels::recordScatter(
+    const CommandBuffer& cmdBuffer, const BaseBuffer& src, const BaseBuffer& dst,
+    const BaseBuffer& indexBuffer, const uint32_t stride, const uint32_t count) const
+{
+    VKW_ASSERT(src.sizeBytes() >= size_t(count) * stride);
+    VKW_ASSERT(indexBuffer.sizeBytes() >= size_t(count) * sizeof(uint32_t));
+    return record(cmdBuffer, scatterPipeline_, src, dst, &indexBuffer, stride, count);
+}
+
+bool BufferCopyKernels::recordTransposeAoSToSoA(
+    const CommandBuffer& cmdBuffer, const BaseBuffer& src, const BaseBuffer& dst, const uint32_t stride,
+    const uint32_t count) const
+{
+    VKW_ASSERT(src.sizeBytes() >= size_t(count) * stride);
+    VKW_ASSERT(dst.sizeBytes() >= size_t(count) * stride);
+    return record(cmdBuffer, transposePipeline_, src, dst, nullptr, stride, count);
+}
+
+bool BufferCopyKernels::record(
+    const CommandBuffer& cmdBuffer, const ComputePipeline& pipeline, const BaseBuffer& src,
+    const BaseBuffer& dst, const BaseBuffer* indexBuffer, const uint32_t stride, const uint32_t count) const
+{
+    if(!this->initialized())
+    {
+        utils::Log::Error("vkw", "Buffer copy kernels are not initialized");
+        return false;
+    }
+
+    if(stride == 0 || stride % sizeof(uint32_t) != 0)
+    {
+        utils::Log::Error("vkw", "Buffer copy kernels require a stride multiple of 4 bytes (%u)", stride);
+        return false;
+    }
+
+    const uint64_t wordCount = uint64_t(count) * (stride / sizeof(uint32_t));
+    if(wordCount > std::numeric_limits<uint32_t>::max())
+    {
+        utils::Log::Error("vkw", "Buffer copy kernels are limited to 2^32 words per call");
+        return false;
+    }
+    if(wordCount == 0) { return true; }
+
+    const auto grid = utils::linearDispatchGrid(
+        utils::divUp(static_cast<uint32_t>(wordCount), groupSize),
+        device_->getProperties().limits.maxComputeWorkGroupCount[0]);
+
+    PushConstants params = {};
+    params.recordCount = count;
+    params.recordWords = static_cast<uint32_t>(stride / sizeof(uint32_t));
+    params.rowInvocations = grid.width * groupSize;
+
+    cmdBuffer.bindComputePipeline(pipeline)
+        .pushComputeStorageBuffer(pipelineLayout_, 0, 0, src.getHandle(), 0, VK_WHOLE_SIZE)
+        .pushComputeStorageBuffer(pipelineLayout_, 0, 1, dst.getHandle(), 0, VK_WHOLE_SIZE);
+    if(indexBuffer != nullptr)
+    {
+        cmdBuffer.pushComputeStorageBuffer(pipelineLayout_, 0, 2, indexBuffer->getHandle(), 0, VK_WHOLE_SIZE);
+    }
+    cmdBuffer.pushConstants(pipelineLayout_, params, ShaderStage::Compute).dispatch(grid.width, grid.height);
+
+    return true;
+}
+} // namespace vkw
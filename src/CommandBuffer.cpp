@@ -22,8 +22,18 @@
 
 #include "vkw/detail/CommandBuffer.hpp"
 
+#include "vkw/detail/ASCompactor.hpp"
+#include "vkw/detail/ASScratchPool.hpp"
+#include "vkw/detail/BufferCopyKernels.hpp"
+#include "vkw/detail/MipmapGenerator.hpp"
+#include "vkw/detail/ShaderBindingTable.hpp"
+#include "vkw/detail/TlasInstanceGenerator.hpp"
 #include "vkw/detail/utils.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 namespace vkw
 {
 CommandBuffer::CommandBuffer(const Device& device, VkCommandPool commandPool, VkCommandBufferLevel level)
@@ -131,6 +141,35 @@ const CommandBuffer& CommandBuffer::copyBuffer(const BaseBuffer& src, const Base
     return *this;
 }
 
+const CommandBuffer& CommandBuffer::copyBufferCoalesced(
+    const BaseBuffer& src, const BaseBuffer& dst, std::vector<VkBufferCopy> regions,
+    utils::CopyRegionStats* stats) const
+{
+    const auto regionStats = utils::optimizeCopyRegions(regions);
+    if(stats != nullptr) { *stats = regionStats; }
+
+    if(regions.empty()) { return *this; }
+    return copyBuffer(src, dst, std::span<VkBufferCopy>{regions});
+}
+
+const CommandBuffer& CommandBuffer::copyBufferCoalesced(
+    const BaseBuffer& src, const BaseBuffer& dst, std::vector<VkBufferCopy> regions,
+    const VkDeviceSize maxRegionSize, const std::function<void(const size_t)>& betweenParts,
+    utils::CopyRegionStats* stats) const
+{
+    VKW_ASSERT(maxRegionSize > 0);
+
+    const auto regionStats = utils::optimizeCopyRegions(regions, maxRegionSize);
+    if(stats != nullptr) { *stats = regionStats; }
+
+    for(size_t i = 0; i < regions.size(); ++i)
+    {
+        copyBuffer(src, dst, std::span<VkBufferCopy>{&regions[i], 1});
+        if(betweenParts && (i + 1 < regions.size())) { betweenParts(i); }
+    }
+    return *this;
+}
+
 const CommandBuffer& CommandBuffer::fillBuffer(
     const BaseBuffer& buffer, const uint32_t val, const size_t offset, const size_t size) const
 {
@@ -215,6 +254,245 @@ const CommandBuffer& CommandBuffer::blitImage(
     return *this;
 }
 
+namespace
+{
+VkImageMemoryBarrier2 mipLevelBarrier(
+    const BaseImage& image, const VkPipelineStageFlags2 srcStages, const VkAccessFlags2 srcMask,
+    const VkPipelineStageFlags2 dstStages, const VkAccessFlags2 dstMask, const VkImageLayout oldLayout,
+    const VkImageLayout newLayout, const uint32_t baseLevel, const uint32_t levelCount)
+{
+    VkImageMemoryBarrier2 barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barrier.pNext = nullptr;
+    barrier.srcStageMask = srcStages;
+    barrier.srcAccessMask = srcMask;
+    barrier.dstStageMask = dstStages;
+    barrier.dstAccessMask = dstMask;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image.getHandle();
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = baseLevel;
+    barrier.subresourceRange.levelCount = levelCount;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = image.arrayLayers();
+    return barrier;
+}
+} // namespace
+
+const CommandBuffer& CommandBuffer::generateMipmaps(
+    const std::vector<std::reference_wrapper<const BaseImage>>& images, const VkImageLayout initialLayout,
+    const VkImageLayout finalLayout, MipmapGenerator* computeFallback) const
+{
+    static constexpr VkFormatFeatureFlags blitFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT
+                                                         | VK_FORMAT_FEATURE_BLIT_DST_BIT
+                                                         | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+
+    // Per method layouts, stages and accesses used while the levels are being generated
+    struct MipTarget
+    {
+        const BaseImage* image;
+        bool useCompute;
+        VkImageLayout srcLayout;
+        VkImageLayout dstLayout;
+        VkPipelineStageFlags2 stage;
+        VkAccessFlags2 readAccess;
+        VkAccessFlags2 writeAccess;
+    };
+
+    std::vector<MipTarget> targets{};
+    targets.reserve(images.size());
+
+    uint32_t maxLevels = 0;
+    for(const auto& imageRef : images)
+    {
+        const BaseImage& image = imageRef.get();
+        if(ImageLayoutTracker::getAspectMask(image.format()) != VK_IMAGE_ASPECT_COLOR_BIT)
+        {
+            utils::Log::Warning("vkw", "generateMipmaps(): depth / stencil formats not supported, skipping");
+            continue;
+        }
+
+        VkFormatProperties formatProperties = {};
+        vkGetPhysicalDeviceFormatProperties(device_->getPhysicalDevice(), image.format(), &formatProperties);
+
+        MipTarget target = {};
+        target.image = &image;
+        if((formatProperties.optimalTilingFeatures & blitFeatures) == blitFeatures)
+        {
+            target.useCompute = false;
+            target.srcLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            target.dstLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            target.stage = VK_PIPELINE_STAGE_2_BLIT_BIT;
+            target.readAccess = VK_ACCESS_2_TRANSFER_READ_BIT;
+            target.writeAccess = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        }
+        else if(computeFallback != nullptr && computeFallback->supports(image))
+        {
+            target.useCompute = true;
+            target.srcLayout = VK_IMAGE_LAYOUT_GENERAL;
+            target.dstLayout = VK_IMAGE_LAYOUT_GENERAL;
+            target.stage = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+            target.readAccess = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
+            target.writeAccess = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+        }
+        else
+        {
+            utils::Log::Warning(
+                "vkw", "generateMipmaps(): format %d does not support linear blits, skipping",
+                static_cast<int>(image.format()));
+            continue;
+        }
+
+        targets.push_back(target);
+        maxLevels = std::max(maxLevels, image.mipLevels());
+    }
+
+    if(targets.empty()) { return *this; }
+
+    std::vector<VkImageMemoryBarrier2> barriers{};
+    barriers.reserve(2 * targets.size());
+
+    // Level 0 becomes the source of the first pass, other levels are written before being read
+    for(const auto& target : targets)
+    {
+        const uint32_t levelCount = target.image->mipLevels();
+        if(levelCount == 1)
+        {
+            barriers.push_back(mipLevelBarrier(
+                *target.image, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_WRITE_BIT,
+                VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT, initialLayout, finalLayout,
+                0, 1));
+            continue;
+        }
+
+        barriers.push_back(mipLevelBarrier(
+            *target.image, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_WRITE_BIT, target.stage,
+            target.readAccess, initialLayout, target.srcLayout, 0, 1));
+        barriers.push_back(mipLevelBarrier(
+            *target.image, VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, target.stage, target.writeAccess,
+            VK_IMAGE_LAYOUT_UNDEFINED, target.dstLayout, 1, levelCount - 1));
+    }
+    this->imageMemoryBarriers(barriers);
+
+    for(uint32_t level = 1; level < maxLevels; ++level)
+    {
+        for(const auto& target : targets)
+        {
+            const BaseImage& image = *target.image;
+            if(level >= image.mipLevels()) { continue; }
+
+            if(target.useCompute)
+            {
+                computeFallback->record(*this, image, level);
+                continue;
+            }
+
+            const auto extent = image.extent();
+            const auto levelOffset = [&](const uint32_t l) -> VkOffset3D {
+                return {
+                    static_cast<int32_t>(std::max(extent.width >> l, 1u)),
+                    static_cast<int32_t>(std::max(extent.height >> l, 1u)),
+                    static_cast<int32_t>(std::max(extent.depth >> l, 1u))};
+            };
+
+            VkImageBlit region = {};
+            region.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.srcSubresource.mipLevel = level - 1;
+            region.srcSubresource.baseArrayLayer = 0;
+            region.srcSubresource.layerCount = image.arrayLayers();
+            region.srcOffsets[0] = {0, 0, 0};
+            region.srcOffsets[1] = levelOffset(level - 1);
+            region.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.dstSubresource.mipLevel = level;
+            region.dstSubresource.baseArrayLayer = 0;
+            region.dstSubresource.layerCount = image.arrayLayers();
+            region.dstOffsets[0] = {0, 0, 0};
+            region.dstOffsets[1] = levelOffset(level);
+            this->blitImage(image, target.srcLayout, image, target.dstLayout, region, VK_FILTER_LINEAR);
+        }
+
+        // The level just written becomes the next source, the previous one is done
+        barriers.clear();
+        for(const auto& target : targets)
+        {
+            const BaseImage& image = *target.image;
+            if(level >= image.mipLevels()) { continue; }
+
+            const bool lastLevel = (level == image.mipLevels() - 1);
+            barriers.push_back(mipLevelBarrier(
+                image, target.stage, target.readAccess, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                VK_ACCESS_2_MEMORY_READ_BIT, target.srcLayout, finalLayout, level - 1, 1));
+            barriers.push_back(mipLevelBarrier(
+                image, target.stage, target.writeAccess,
+                lastLevel ? VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT : target.stage,
+                lastLevel ? VK_ACCESS_2_MEMORY_READ_BIT : target.readAccess, target.dstLayout,
+                lastLevel ? finalLayout : target.srcLayout, level, 1));
+        }
+        this->imageMemoryBarriers(barriers);
+    }
+
+    return *this;
+}
+
+const CommandBuffer& CommandBuffer::gatherBuffer(
+    const BufferCopyKernels& kernels, const BaseBuffer& src, const BaseBuffer& dst,
+    const BaseBuffer& indexBuffer, const uint32_t stride, const uint32_t count) const
+{
+    VKW_CHECK_BOOL_FAIL(
+        kernels.recordGather(*this, src, dst, indexBuffer, stride, count), "Recording buffer gather");
+    return *this;
+}
+
+const CommandBuffer& CommandBuffer::scatterBuffer(
+    const BufferCopyKernels& kernels, const BaseBuffer& src, const BaseBuffer& dst,
+    const BaseBuffer& indexBuffer, const uint32_t stride, const uint32_t count) const
+{
+    VKW_CHECK_BOOL_FAIL(
+        kernels.recordScatter(*this, src, dst, indexBuffer, stride, count), "Recording buffer scatter");
+    return *this;
+}
+
+const CommandBuffer& CommandBuffer::transposeAoSToSoA(
+    const BufferCopyKernels& kernels, const BaseBuffer& src, const BaseBuffer& dst, const uint32_t stride,
+    const uint32_t count) const
+{
+    VKW_CHECK_BOOL_FAIL(
+        kernels.recordTransposeAoSToSoA(*this, src, dst, stride, count), "Recording AoS to SoA transpose");
+    return *this;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+void CommandBuffer::recordReadback(
+    const ReadbackRing& ring, const BaseBuffer& buffer, const VkDeviceSize srcOffset,
+    const ReadbackRing::Allocation& allocation) const
+{
+    VkBufferCopy region = {};
+    region.srcOffset = srcOffset;
+    region.dstOffset = allocation.offset;
+    region.size = allocation.size;
+    device_->vk().vkCmdCopyBuffer(
+        commandBuffer_, buffer.getHandle(), ring.buffer().getHandle(), 1, &region);
+
+    // Make the copy visible to the host once the timeline is signaled
+    VkBufferMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.pNext = nullptr;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = ring.buffer().getHandle();
+    barrier.offset = allocation.offset;
+    barrier.size = allocation.size;
+    device_->vk().vkCmdPipelineBarrier(
+        commandBuffer_, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1,
+        &barrier, 0, nullptr);
+}
+
 // -----------------------------------------------------------------------------------------------------------
 
 const CommandBuffer& CommandBuffer::memoryBarrier(
@@ -381,6 +659,26 @@ const CommandBuffer& CommandBuffer::imageMemoryBarriers(
     return *this;
 }
 
+const CommandBuffer& CommandBuffer::transition(
+    BaseImage& image, const VkImageLayout newLayout, const VkPipelineStageFlags2 stages,
+    const VkAccessFlags2 access, const uint32_t baseLevel, const uint32_t levelCount,
+    const uint32_t baseLayer, const uint32_t layerCount) const
+{
+    auto* tracker = image.layoutTracker();
+    if(tracker == nullptr)
+    {
+        utils::Log::Error("vkw", "transition(): layout tracking is not enabled for this image");
+        return *this;
+    }
+
+    std::vector<VkImageMemoryBarrier2> barriers{};
+    tracker->transition(
+        image.getHandle(), newLayout, stages, access, barriers, baseLevel, levelCount, baseLayer, layerCount);
+    if(barriers.empty()) { return *this; }
+
+    return this->imageMemoryBarriers(barriers);
+}
+
 const CommandBuffer& CommandBuffer::pipelineBarrier(
     const VkPipelineStageFlags srcFlags, const VkPipelineStageFlags dstFlags,
     const std::span<VkMemoryBarrier>& memoryBarriers,
@@ -1682,6 +1980,12 @@ const CommandBuffer& CommandBuffer::buildAccelerationStructure(
     VKW_ASSERT(blas.buildOnHost_ == false);
     VKW_ASSERT(blas.geometryData_.size() == blas.buildRanges_.size());
 
+    if(blas.compacted())
+    {
+        utils::Log::Error("vkw", "buildAccelerationStructure(): a compacted structure can only be refit");
+        return *this;
+    }
+
     auto ppBuildRanges
         = utils::ScopedAllocator::allocateArray<const VkAccelerationStructureBuildRangeInfoKHR*>(
             blas.buildRanges_.size());
@@ -1709,6 +2013,14 @@ const CommandBuffer& CommandBuffer::buildAccelerationStructure(
     return *this;
 }
 
+const CommandBuffer& CommandBuffer::buildAccelerationStructures(
+    const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList,
+    AccelerationStructureScratchPool& scratchPool,
+    const VkBuildAccelerationStructureFlagsKHR buildFlags) const
+{
+    return this->recordBottomLevelBuilds(blasList, scratchPool, buildFlags, false);
+}
+
 const CommandBuffer& CommandBuffer::buildAccelerationStructure(
     const TopLevelAccelerationStructure& tlas, const BaseBuffer& scratchBuffer,
     const VkBuildAccelerationStructureFlagsKHR buildFlags) const
@@ -1716,7 +2028,7 @@ const CommandBuffer& CommandBuffer::buildAccelerationStructure(
     VKW_ASSERT(tlas.buildOnHost_ == false);
 
     VkAccelerationStructureBuildRangeInfoKHR buildRange = {};
-    buildRange.primitiveCount = static_cast<uint32_t>(tlas.instancesList_.size());
+    buildRange.primitiveCount = tlas.instanceCount();
 
     const VkAccelerationStructureBuildRangeInfoKHR* pBuildRanges = &buildRange;
 
@@ -1737,14 +2049,160 @@ const CommandBuffer& CommandBuffer::buildAccelerationStructure(
     return *this;
 }
 
+const CommandBuffer& CommandBuffer::buildAccelerationStructure(
+    TopLevelAccelerationStructure& tlas, const BaseBuffer& scratchBuffer,
+    const VkBuildAccelerationStructureFlagsKHR buildFlags) const
+{
+    this->uploadInstances(tlas);
+    return this->buildAccelerationStructure(
+        static_cast<const TopLevelAccelerationStructure&>(tlas), scratchBuffer, buildFlags);
+}
+
+const CommandBuffer& CommandBuffer::updateAccelerationStructure(
+    BottomLevelAccelerationStructure& blas, const BaseBuffer& scratchBuffer,
+    const VkBuildAccelerationStructureFlagsKHR buildFlags) const
+{
+    VKW_ASSERT(blas.buildOnHost_ == false);
+    VKW_ASSERT(blas.geometryData_.size() == blas.buildRanges_.size());
+
+    const bool refit = !blas.needsRebuild();
+    VKW_ASSERT(scratchBuffer.sizeBytes() >= (refit ? blas.updateScratchSize() : blas.buildScratchSize()));
+
+    auto buildRanges
+        = utils::ScopedAllocator::allocateArray<VkAccelerationStructureBuildRangeInfoKHR>(
+            blas.buildRanges_.size());
+    size_t rangeIndex = 0;
+    for(const auto& rangeList : blas.buildRanges_)
+    {
+        VKW_ASSERT(rangeList.empty() == false);
+        buildRanges[rangeIndex++] = rangeList.front();
+    }
+    const VkAccelerationStructureBuildRangeInfoKHR* pBuildRanges = buildRanges.data();
+
+    VkAccelerationStructureBuildGeometryInfoKHR buildInfo = {};
+    buildInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
+    buildInfo.pNext = nullptr;
+    buildInfo.flags = buildFlags;
+    buildInfo.type = blas.type();
+    buildInfo.mode = refit ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR
+                           : VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+    buildInfo.srcAccelerationStructure = refit ? blas.getHandle() : VK_NULL_HANDLE;
+    buildInfo.dstAccelerationStructure = blas.getHandle();
+    buildInfo.geometryCount = static_cast<uint32_t>(blas.geometryData_.size());
+    buildInfo.pGeometries = blas.geometryData_.data();
+    buildInfo.ppGeometries = nullptr;
+    buildInfo.scratchData.deviceAddress = scratchBuffer.deviceAddress();
+    device_->vk().vkCmdBuildAccelerationStructuresKHR(commandBuffer_, 1, &buildInfo, &pBuildRanges);
+
+    blas.refitCount_ = refit ? blas.refitCount_ + 1 : 0;
+
+    return *this;
+}
+
+const CommandBuffer& CommandBuffer::updateAccelerationStructures(
+    const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList,
+    AccelerationStructureScratchPool& scratchPool,
+    const VkBuildAccelerationStructureFlagsKHR buildFlags) const
+{
+    return this->recordBottomLevelBuilds(blasList, scratchPool, buildFlags, true);
+}
+
+const CommandBuffer& CommandBuffer::recordBottomLevelBuilds(
+    const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList,
+    AccelerationStructureScratchPool& scratchPool, const VkBuildAccelerationStructureFlagsKHR buildFlags,
+    const bool update) const
+{
+    VKW_ASSERT(scratchPool.initialized());
+
+    if(blasList.empty()) { return *this; }
+
+    // Compacted structures are refit-only, their storage is too small for a full build
+    for(const auto& blas : blasList)
+    {
+        if(!update && blas.get().compacted())
+        {
+            utils::Log::Error(
+                "vkw", "buildAccelerationStructures(): a compacted structure can only be refit");
+            return *this;
+        }
+    }
+
+    const VkDeviceSize requiredScratchSize = scratchPool.requiredSize(blasList, update);
+    if(requiredScratchSize > scratchPool.availableBytes())
+    {
+        utils::Log::Error(
+            "vkw", "Scratch pool too small for batched build: %llu bytes required, %llu available",
+            static_cast<unsigned long long>(requiredScratchSize),
+            static_cast<unsigned long long>(scratchPool.availableBytes()));
+        return *this;
+    }
+
+    size_t geometryCount = 0;
+    for(const auto& blas : blasList)
+    {
+        geometryCount += blas.get().geometryData_.size();
+    }
+
+    auto buildInfos
+        = utils::ScopedAllocator::allocateArray<VkAccelerationStructureBuildGeometryInfoKHR>(blasList.size());
+    auto ppBuildRanges
+        = utils::ScopedAllocator::allocateArray<const VkAccelerationStructureBuildRangeInfoKHR*>(
+            blasList.size());
+    auto buildRanges
+        = utils::ScopedAllocator::allocateArray<VkAccelerationStructureBuildRangeInfoKHR>(geometryCount);
+
+    // Each build info expects one range per geometry, stored contiguously
+    size_t rangeIndex = 0;
+    for(size_t i = 0; i < blasList.size(); ++i)
+    {
+        auto& blas = blasList[i].get();
+        VKW_ASSERT(blas.buildOnHost_ == false);
+        VKW_ASSERT(blas.geometryData_.size() == blas.buildRanges_.size());
+
+        ppBuildRanges[i] = buildRanges.data() + rangeIndex;
+        for(const auto& rangeList : blas.buildRanges_)
+        {
+            VKW_ASSERT(rangeList.empty() == false);
+            buildRanges[rangeIndex++] = rangeList.front();
+        }
+
+        const bool refit = update && !blas.needsRebuild();
+
+        VkAccelerationStructureBuildGeometryInfoKHR buildInfo = {};
+        buildInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
+        buildInfo.pNext = nullptr;
+        buildInfo.flags = buildFlags;
+        buildInfo.type = blas.type();
+        buildInfo.mode = refit ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR
+                               : VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+        buildInfo.srcAccelerationStructure = refit ? blas.getHandle() : VK_NULL_HANDLE;
+        buildInfo.dstAccelerationStructure = blas.getHandle();
+        buildInfo.geometryCount = static_cast<uint32_t>(blas.geometryData_.size());
+        buildInfo.pGeometries = blas.geometryData_.data();
+        buildInfo.ppGeometries = nullptr;
+        buildInfo.scratchData.deviceAddress
+            = scratchPool.allocate(refit ? blas.updateScratchSize() : blas.buildScratchSize());
+        buildInfos[i] = buildInfo;
+
+        blas.refitCount_ = refit ? blas.refitCount_ + 1 : 0;
+    }
+
+    device_->vk().vkCmdBuildAccelerationStructuresKHR(
+        commandBuffer_, static_cast<uint32_t>(blasList.size()), buildInfos.data(), ppBuildRanges.data());
+
+    return *this;
+}
+
 const CommandBuffer& CommandBuffer::updateAccelerationStructure(
     TopLevelAccelerationStructure& tlas, const BaseBuffer& scratchBuffer,
     const VkBuildAccelerationStructureFlagsKHR buildFlags) const
 {
     VKW_ASSERT(tlas.buildOnHost_ == false);
 
+    this->uploadInstances(tlas);
+
     VkAccelerationStructureBuildRangeInfoKHR buildRange = {};
-    buildRange.primitiveCount = static_cast<uint32_t>(tlas.instancesList_.size());
+    buildRange.primitiveCount = tlas.instanceCount();
 
     const VkAccelerationStructureBuildRangeInfoKHR* pBuildRanges = &buildRange;
 
@@ -1753,7 +2211,7 @@ const CommandBuffer& CommandBuffer::updateAccelerationStructure(
     buildInfo.pNext = nullptr;
     buildInfo.flags = buildFlags;
     buildInfo.type = tlas.type();
-    buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+    buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR;
     buildInfo.srcAccelerationStructure = tlas.getHandle();
     buildInfo.dstAccelerationStructure = tlas.getHandle();
     buildInfo.geometryCount = 1;
@@ -1773,11 +2231,202 @@ const CommandBuffer& CommandBuffer::updateAccelerationStructure(
 
     for(size_t i = 0; i < tlas.instancesList_.size(); ++i)
     {
-        tlas.instancesList_[i].transform = transforms[i];
+        const auto& transform = transforms[i];
+        if(memcmp(&tlas.instancesList_[i].transform, &transform, sizeof(VkTransformMatrixKHR)) != 0)
+        {
+            tlas.setTransform(static_cast<uint32_t>(i), transform);
+        }
     }
     return this->updateAccelerationStructure(tlas, scratchBuffer, buildFlags);
 }
 
+const CommandBuffer& CommandBuffer::uploadInstances(
+    TopLevelAccelerationStructure& tlas, utils::CopyRegionStats* stats) const
+{
+    if(tlas.buildOnHost_ || !tlas.hasDirtyInstances()) { return *this; }
+
+    this->copyBufferCoalesced(
+        tlas.instancesStagingBuffer_, tlas.instancesBuffer_, tlas.stageDirtyInstances(), stats);
+
+    this->buildInputBarrier(tlas.instancesBuffer_);
+
+    return *this;
+}
+
+const CommandBuffer& CommandBuffer::buildInputBarrier(
+    const BaseBuffer& buffer, const VkPipelineStageFlags srcStage, const VkAccessFlags srcAccess) const
+{
+    // Build inputs are read by the builds as shader resources
+    VkBufferMemoryBarrier bufferBarrier = {};
+    bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    bufferBarrier.pNext = nullptr;
+    bufferBarrier.srcAccessMask = srcAccess;
+    bufferBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.buffer = buffer.getHandle();
+    bufferBarrier.offset = 0;
+    bufferBarrier.size = VK_WHOLE_SIZE;
+    return this->bufferMemoryBarrier(
+        srcStage, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, bufferBarrier);
+}
+
+const CommandBuffer& CommandBuffer::buildInputBarrier(
+    const VkPipelineStageFlags srcStage, const VkAccessFlags srcAccess) const
+{
+    VkMemoryBarrier memoryBarrier = {};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.pNext = nullptr;
+    memoryBarrier.srcAccessMask = srcAccess;
+    memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    return this->memoryBarrier(
+        srcStage, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, memoryBarrier);
+}
+
+const CommandBuffer& CommandBuffer::generateInstances(
+    const TlasInstanceGenerator& generator, const BaseBuffer& transforms, const BaseBuffer& descriptors,
+    const BaseBuffer& blasAddresses, const BaseBuffer& instances, const uint32_t instanceCount,
+    const uint32_t blasCount) const
+{
+    generator.recordGeneration(
+        *this, transforms, descriptors, blasAddresses, instances, instanceCount, blasCount);
+    return *this;
+}
+
+const CommandBuffer& CommandBuffer::copyAccelerationStructure(
+    const BaseAccelerationStructure& src, const BaseAccelerationStructure& dst,
+    const VkCopyAccelerationStructureModeKHR mode) const
+{
+    VKW_ASSERT(src.buildOnHost() == false);
+    VKW_ASSERT(dst.buildOnHost() == false);
+
+    VkCopyAccelerationStructureInfoKHR copyInfo = {};
+    copyInfo.sType = VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR;
+    copyInfo.pNext = nullptr;
+    copyInfo.src = src.getHandle();
+    copyInfo.dst = dst.getHandle();
+    copyInfo.mode = mode;
+    device_->vk().vkCmdCopyAccelerationStructureKHR(commandBuffer_, &copyInfo);
+
+    return *this;
+}
+
+const CommandBuffer& CommandBuffer::writeCompactedSizes(
+    AccelerationStructureCompactor& compactor,
+    const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList) const
+{
+    compactor.recordSizeQueries(*this, blasList);
+    return *this;
+}
+
+const CommandBuffer& CommandBuffer::compactAccelerationStructures(
+    AccelerationStructureCompactor& compactor,
+    const std::vector<std::reference_wrapper<BottomLevelAccelerationStructure>>& blasList,
+    DeferredDeletionQueue& deletionQueue, const uint64_t timelineValue) const
+{
+    compactor.recordCompaction(*this, blasList, deletionQueue, timelineValue);
+    return *this;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+const CommandBuffer& CommandBuffer::bindRayTracingPipeline(const RayTracingPipeline& pipeline) const
+{
+    device_->vk().vkCmdBindPipeline(
+        commandBuffer_, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, pipeline.getHandle());
+    return *this;
+}
+
+const CommandBuffer& CommandBuffer::bindRayTracingDescriptorSet(
+    const PipelineLayout& pipelineLayout, const uint32_t firstSet, const DescriptorSet& descriptorSet) const
+{
+    return bindRayTracingDescriptorSet(pipelineLayout, firstSet, descriptorSet.getHandle());
+}
+
+const CommandBuffer& CommandBuffer::bindRayTracingDescriptorSet(
+    const PipelineLayout& pipelineLayout, const uint32_t firstSet, const VkDescriptorSet descriptorSet) const
+{
+    device_->vk().vkCmdBindDescriptorSets(
+        commandBuffer_, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, pipelineLayout.getHandle(), firstSet, 1,
+        &descriptorSet, 0, nullptr);
+
+    return *this;
+}
+
+const CommandBuffer& CommandBuffer::setRayTracingPipelineStackSize(const uint32_t stackSize) const
+{
+    device_->vk().vkCmdSetRayTracingPipelineStackSizeKHR(commandBuffer_, stackSize);
+    return *this;
+}
+
+const CommandBuffer& CommandBuffer::uploadShaderBindingTable(
+    ShaderBindingTable& sbt, utils::CopyRegionStats* stats) const
+{
+    VKW_ASSERT(sbt.created());
+    if(!sbt.hasDirtyRecords()) { return *this; }
+
+    this->copyBufferCoalesced(sbt.stagingBuffer_, sbt.sbtBuffer_, sbt.stageDirtyRecords(), stats);
+
+    // Records are fetched by the ray tracing shader stages as shader reads
+    VkBufferMemoryBarrier bufferBarrier = {};
+    bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    bufferBarrier.pNext = nullptr;
+    bufferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    bufferBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.buffer = sbt.sbtBuffer_.getHandle();
+    bufferBarrier.offset = 0;
+    bufferBarrier.size = VK_WHOLE_SIZE;
+    device_->vk().vkCmdPipelineBarrier(
+        commandBuffer_, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR, 0, 0,
+        nullptr, 1, &bufferBarrier, 0, nullptr);
+
+    return *this;
+}
+
+const CommandBuffer& CommandBuffer::traceRays(
+    const ShaderBindingTable& sbt, const uint32_t width, const uint32_t height, const uint32_t depth,
+    const uint32_t rayGenIndex) const
+{
+    const auto rayGenRegion = sbt.deviceRegion(ShaderBindingTable::Region::RayGen, rayGenIndex);
+    const auto missRegion = sbt.deviceRegion(ShaderBindingTable::Region::Miss);
+    const auto hitRegion = sbt.deviceRegion(ShaderBindingTable::Region::Hit);
+    const auto callableRegion = sbt.deviceRegion(ShaderBindingTable::Region::Callable);
+    device_->vk().vkCmdTraceRaysKHR(
+        commandBuffer_, &rayGenRegion, &missRegion, &hitRegion, &callableRegion, width, height, depth);
+
+    return *this;
+}
+
+const CommandBuffer& CommandBuffer::traceRaysIndirect(
+    const ShaderBindingTable& sbt, const BaseBuffer& indirectBuffer, const VkDeviceSize offset,
+    const uint32_t rayGenIndex) const
+{
+    const auto rayGenRegion = sbt.deviceRegion(ShaderBindingTable::Region::RayGen, rayGenIndex);
+    const auto missRegion = sbt.deviceRegion(ShaderBindingTable::Region::Miss);
+    const auto hitRegion = sbt.deviceRegion(ShaderBindingTable::Region::Hit);
+    const auto callableRegion = sbt.deviceRegion(ShaderBindingTable::Region::Callable);
+    device_->vk().vkCmdTraceRaysIndirectKHR(
+        commandBuffer_, &rayGenRegion, &missRegion, &hitRegion, &callableRegion,
+        indirectBuffer.deviceAddress() + offset);
+
+    return *this;
+}
+
+const CommandBuffer& CommandBuffer::traceRaysIndirect2(
+    const BaseBuffer& indirectBuffer, const VkDeviceSize offset) const
+{
+    if(!device_->rayTracingMaintenance1Enabled())
+    {
+        utils::Log::Error("vkw", "traceRaysIndirect2(): VK_KHR_ray_tracing_maintenance1 is not enabled");
+        return *this;
+    }
+
+    device_->vk().vkCmdTraceRaysIndirect2KHR(commandBuffer_, indirectBuffer.deviceAddress() + offset);
+    return *this;
+}
+
 // -----------------------------------------------------------------------------------------------------------
 
 const CommandBuffer& CommandBuffer::insertDebugMarker(const char* name, const float color[4]) const
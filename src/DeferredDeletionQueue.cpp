@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/DeferredDeletionQueue.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace vkw
+{
+DeferredDeletionQueue::DeferredDeletionQueue(DeferredDeletionQueue&& rhs) { *this = std::move(rhs); }
+
+DeferredDeletionQueue& DeferredDeletionQueue::operator=(DeferredDeletionQueue&& rhs)
+{
+    this->clear();
+    std::swap(entries_, rhs.entries_);
+    return *this;
+}
+
+DeferredDeletionQueue::~DeferredDeletionQueue() { this->clear(); }
+
+void DeferredDeletionQueue::clear() { collect(~uint64_t(0)); }
+
+void DeferredDeletionQueue::retire(std::function<void()>&& deleter, const uint64_t timelineValue)
+{
+    entries_.push_back({timelineValue, nullptr, std::move(deleter)});
+}
+
+size_t DeferredDeletionQueue::collect(const uint64_t completedValue)
+{
+    // Deleters may retire other resources, extract the completed entries before destroying them
+    std::vector<Entry> completed{};
+    auto it = std::stable_partition(entries_.begin(), entries_.end(), [completedValue](const Entry& entry) {
+        return entry.timelineValue > completedValue;
+    });
+    std::move(it, entries_.end(), std::back_inserter(completed));
+    entries_.erase(it, entries_.end());
+
+    for(auto& entry : completed)
+    {
+        if(entry.deleter) { entry.deleter(); }
+        entry.resource.reset();
+    }
+
+    return completed.size();
+}
+} // namespace vkw
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/DeferredHostOperation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace vkw
+{
+DeferredHostOperation::DeferredHostOperation(const Device& device)
+{
+    VKW_CHECK_BOOL_FAIL(this->init(device), "Initializing deferred host operation");
+}
+
+DeferredHostOperation::DeferredHostOperation(DeferredHostOperation&& rhs) { *this = std::move(rhs); }
+
+DeferredHostOperation& DeferredHostOperation::operator=(DeferredHostOperation&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+
+    std::swap(deferredOperation_, rhs.deferredOperation_);
+    std::swap(pending_, rhs.pending_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+DeferredHostOperation::~DeferredHostOperation() { this->clear(); }
+
+bool DeferredHostOperation::init(const Device& device)
+{
+    VKW_ASSERT(this->initialized() == false);
+
+    device_ = &device;
+
+    if(device_->vk().vkCreateDeferredOperationKHR == nullptr)
+    {
+        utils::Log::Error("vkw", "VK_KHR_deferred_host_operations is not enabled");
+        device_ = nullptr;
+        return false;
+    }
+    VKW_INIT_CHECK_VK(
+        device_->vk().vkCreateDeferredOperationKHR(device_->getHandle(), nullptr, &deferredOperation_));
+
+    initialized_ = true;
+
+    return true;
+}
+
+void DeferredHostOperation::clear()
+{
+    wait();
+
+    VKW_DELETE_VK(DeferredOperationKHR, deferredOperation_);
+    device_ = nullptr;
+
+    initialized_ = false;
+}
+
+void DeferredHostOperation::wait()
+{
+    if(pending_.valid())
+    {
+        pending_.wait();
+        pending_ = {};
+    }
+}
+
+bool DeferredHostOperation::complete() const
+{
+    VKW_ASSERT(this->initialized());
+    return device_->vk().vkGetDeferredOperationResultKHR(device_->getHandle(), deferredOperation_)
+           != VK_NOT_READY;
+}
+
+uint32_t DeferredHostOperation::maxConcurrency() const
+{
+    VKW_ASSERT(this->initialized());
+    return device_->vk().vkGetDeferredOperationMaxConcurrencyKHR(device_->getHandle(), deferredOperation_);
+}
+
+std::shared_future<VkResult> DeferredHostOperation::join(
+    const VkResult launchResult, utils::ThreadPool& pool, std::shared_ptr<void> keepAlive)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(pool.initialized());
+
+    if(launchResult == VK_OPERATION_NOT_DEFERRED_KHR) { return readyResult(VK_SUCCESS); }
+    if(launchResult != VK_OPERATION_DEFERRED_KHR) { return readyResult(launchResult); }
+
+    struct JoinState
+    {
+        std::atomic<uint32_t> remaining{0};
+        std::promise<VkResult> result{};
+        std::shared_ptr<void> keepAlive{};
+    };
+
+    const uint32_t threadCount
+        = std::max(1u, std::min(maxConcurrency(), static_cast<uint32_t>(pool.threadCount())));
+
+    auto state = std::make_shared<JoinState>();
+    state->remaining = threadCount;
+    state->keepAlive = std::move(keepAlive);
+    pending_ = state->result.get_future().share();
+
+    const Device* device = device_;
+    const VkDeferredOperationKHR operation = deferredOperation_;
+    for(uint32_t i = 0; i < threadCount; ++i)
+    {
+        pool.submit([device, operation, state]() {
+            // VK_THREAD_IDLE_KHR: no work for now but more may come later, join again
+            VkResult res = VK_THREAD_IDLE_KHR;
+            while(res == VK_THREAD_IDLE_KHR)
+            {
+                res = device->vk().vkDeferredOperationJoinKHR(device->getHandle(), operation);
+                if(res == VK_THREAD_IDLE_KHR) { std::this_thread::yield(); }
+            }
+
+            if(state->remaining.fetch_sub(1) == 1)
+            {
+                // Last joining thread, the other threads may have left with VK_THREAD_DONE_KHR before the
+                // operation was completed
+                const VkDevice deviceHandle = device->getHandle();
+                VkResult result = device->vk().vkGetDeferredOperationResultKHR(deviceHandle, operation);
+                while(result == VK_NOT_READY)
+                {
+                    device->vk().vkDeferredOperationJoinKHR(deviceHandle, operation);
+                    result = device->vk().vkGetDeferredOperationResultKHR(deviceHandle, operation);
+                }
+                state->keepAlive.reset();
+                state->result.set_value(result);
+            }
+        });
+    }
+
+    return pending_;
+}
+
+std::shared_future<VkResult> DeferredHostOperation::readyResult(const VkResult result)
+{
+    std::promise<VkResult> promise{};
+    promise.set_value(result);
+    return promise.get_future().share();
+}
+} // namespace vkw
@@ -26,6 +26,7 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <stdexcept>
 #include <vector>
 
@@ -83,6 +84,17 @@ Device& Device::operator=(Device&& rhs)
     std::swap(device_, rhs.device_);
 
     std::swap(useDeviceBufferAddress_, rhs.useDeviceBufferAddress_);
+    std::swap(useMemoryBudget_, rhs.useMemoryBudget_);
+    std::swap(useExternalMemoryHost_, rhs.useExternalMemoryHost_);
+    std::swap(minImportedHostPointerAlignment_, rhs.minImportedHostPointerAlignment_);
+    std::swap(useHostImageCopy_, rhs.useHostImageCopy_);
+    std::swap(maxMemoryAllocationSize_, rhs.maxMemoryAllocationSize_);
+    std::swap(maxBufferSize_, rhs.maxBufferSize_);
+    std::swap(useAccelerationStructure_, rhs.useAccelerationStructure_);
+    std::swap(accelerationStructureProperties_, rhs.accelerationStructureProperties_);
+    std::swap(useRayTracingPipeline_, rhs.useRayTracingPipeline_);
+    std::swap(rayTracingPipelineProperties_, rhs.rayTracingPipelineProperties_);
+    std::swap(useRayTracingMaintenance1_, rhs.useRayTracingMaintenance1_);
 
     std::swap(initialized_, rhs.initialized_);
 
@@ -118,6 +130,25 @@ bool Device::init(
     deviceProperties_ = properties;
     memProperties_ = memProperties;
 
+    // Size limits of a single allocation and buffer, maxBufferSize is only reported from Vulkan 1.3
+    const bool maintenance4Core = properties.apiVersion >= VK_API_VERSION_1_3;
+
+    VkPhysicalDeviceMaintenance4Properties maintenance4Properties = {};
+    maintenance4Properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MAINTENANCE_4_PROPERTIES;
+    maintenance4Properties.pNext = nullptr;
+
+    VkPhysicalDeviceMaintenance3Properties maintenance3Properties = {};
+    maintenance3Properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MAINTENANCE_3_PROPERTIES;
+    maintenance3Properties.pNext = maintenance4Core ? &maintenance4Properties : nullptr;
+
+    VkPhysicalDeviceProperties2 properties2 = {};
+    properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties2.pNext = &maintenance3Properties;
+    vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+
+    maxMemoryAllocationSize_ = maintenance3Properties.maxMemoryAllocationSize;
+    maxBufferSize_ = maintenance4Core ? maintenance4Properties.maxBufferSize : maxMemoryAllocationSize_;
+
     utils::Log::Info("vkw", "Device used : %s", properties.deviceName);
     utils::Log::Info("vkw", "Device type : %s", getStringDeviceType(properties.deviceType));
 
@@ -142,6 +173,7 @@ bool Device::init(
     allocateQueues();
 
     validateAdditionalFeatures(reinterpret_cast<const VkBaseOutStructure*>(pCreateNext));
+    validateAdditionalExtensions(extensions);
 
     VmaVulkanFunctions vmaVkFunctions = {};
     vmaVkFunctions.vkGetInstanceProcAddr = vkGetInstanceProcAddr;
@@ -150,6 +182,7 @@ bool Device::init(
     // Create memory allocator
     VmaAllocatorCreateInfo allocatorCreateInfo = {};
     allocatorCreateInfo.flags = useDeviceBufferAddress_ ? VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT : 0;
+    allocatorCreateInfo.flags |= useMemoryBudget_ ? VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT : 0;
     allocatorCreateInfo.physicalDevice = physicalDevice_;
     allocatorCreateInfo.device = device_;
     allocatorCreateInfo.preferredLargeHeapBlockSize = 0; // Use default value
@@ -184,6 +217,18 @@ void Device::clear()
     deviceQueues_.clear();
     device_ = VK_NULL_HANDLE;
 
+    useMemoryBudget_ = VK_FALSE;
+    useExternalMemoryHost_ = VK_FALSE;
+    minImportedHostPointerAlignment_ = 0;
+    useHostImageCopy_ = VK_FALSE;
+    maxMemoryAllocationSize_ = 0;
+    maxBufferSize_ = 0;
+    useAccelerationStructure_ = VK_FALSE;
+    accelerationStructureProperties_ = {};
+    useRayTracingPipeline_ = VK_FALSE;
+    rayTracingPipelineProperties_ = {};
+    useRayTracingMaintenance1_ = VK_FALSE;
+
     initialized_ = false;
 }
 
@@ -324,6 +369,10 @@ void Device::validateAdditionalFeatures(const VkBaseOutStructure* pCreateNext)
                 useDeviceBufferAddress_ = reinterpret_cast<VkPhysicalDeviceBufferDeviceAddressFeatures*>(next)
                                               ->bufferDeviceAddress;
                 break;
+            case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_FEATURES_EXT:
+                useHostImageCopy_
+                    = reinterpret_cast<VkPhysicalDeviceHostImageCopyFeaturesEXT*>(next)->hostImageCopy;
+                break;
             default:
                 break;
         }
@@ -414,4 +463,71 @@ bool Device::checkExtensions(
     }
     return true;
 }
+
+void Device::validateAdditionalExtensions(const std::vector<const char*>& extensions)
+{
+    for(const auto* extensionName : extensions)
+    {
+        if(strcmp(extensionName, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == 0) { useMemoryBudget_ = VK_TRUE; }
+        if(strcmp(extensionName, VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME) == 0)
+        {
+            useExternalMemoryHost_ = VK_TRUE;
+        }
+        if(strcmp(extensionName, VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME) == 0)
+        {
+            useAccelerationStructure_ = VK_TRUE;
+        }
+        if(strcmp(extensionName, VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME) == 0)
+        {
+            useRayTracingPipeline_ = VK_TRUE;
+        }
+        if(strcmp(extensionName, VK_KHR_RAY_TRACING_MAINTENANCE_1_EXTENSION_NAME) == 0)
+        {
+            useRayTracingMaintenance1_ = VK_TRUE;
+        }
+    }
+
+    if(useExternalMemoryHost_)
+    {
+        VkPhysicalDeviceExternalMemoryHostPropertiesEXT externalMemoryHostProperties = {};
+        externalMemoryHostProperties.sType
+            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT;
+        externalMemoryHostProperties.pNext = nullptr;
+
+        VkPhysicalDeviceProperties2 properties = {};
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties.pNext = &externalMemoryHostProperties;
+        vkGetPhysicalDeviceProperties2(physicalDevice_, &properties);
+
+        minImportedHostPointerAlignment_ = externalMemoryHostProperties.minImportedHostPointerAlignment;
+    }
+
+    if(useAccelerationStructure_)
+    {
+        accelerationStructureProperties_ = {};
+        accelerationStructureProperties_.sType
+            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR;
+        accelerationStructureProperties_.pNext = nullptr;
+
+        VkPhysicalDeviceProperties2 properties = {};
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties.pNext = &accelerationStructureProperties_;
+        vkGetPhysicalDeviceProperties2(physicalDevice_, &properties);
+        accelerationStructureProperties_.pNext = nullptr;
+    }
+
+    if(useRayTracingPipeline_)
+    {
+        rayTracingPipelineProperties_ = {};
+        rayTracingPipelineProperties_.sType
+            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_PROPERTIES_KHR;
+        rayTracingPipelineProperties_.pNext = nullptr;
+
+        VkPhysicalDeviceProperties2 properties = {};
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties.pNext = &rayTracingPipelineProperties_;
+        vkGetPhysicalDeviceProperties2(physicalDevice_, &properties);
+        rayTracingPipelineProperties_.pNext = nullptr;
+    }
+}
 } // namespace vkw
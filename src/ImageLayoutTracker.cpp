@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/ImageLayoutTracker.hpp"
+
+#include "vkw/detail/utils.hpp"
+
+namespace vkw
+{
+namespace
+{
+constexpr VkAccessFlags2 writeAccessMask
+    = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+      | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
+      | VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_HOST_WRITE_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+} // namespace
+
+bool ImageLayoutTracker::init(
+    const uint32_t mipLevels, const uint32_t arrayLayers, const VkImageAspectFlags aspectMask,
+    const VkImageLayout initialLayout)
+{
+    VKW_ASSERT(this->initialized() == false);
+    VKW_ASSERT(mipLevels > 0 && arrayLayers > 0);
+
+    mipLevels_ = mipLevels;
+    arrayLayers_ = arrayLayers;
+    aspectMask_ = aspectMask;
+
+    SubresourceState initialState = {};
+    initialState.layout = initialLayout;
+    states_.assign(size_t(mipLevels_) * size_t(arrayLayers_), initialState);
+
+    initialized_ = true;
+
+    return true;
+}
+
+void ImageLayoutTracker::clear()
+{
+    states_.clear();
+    mipLevels_ = 0;
+    arrayLayers_ = 0;
+    aspectMask_ = {};
+
+    initialized_ = false;
+}
+
+void ImageLayoutTracker::reset(
+    const VkImageLayout layout, const uint32_t baseLevel, const uint32_t levelCount, const uint32_t baseLayer,
+    const uint32_t layerCount)
+{
+    VKW_ASSERT(this->initialized());
+
+    const uint32_t levelEnd = (levelCount == VK_REMAINING_MIP_LEVELS) ? mipLevels_ : baseLevel + levelCount;
+    const uint32_t layerEnd
+        = (layerCount == VK_REMAINING_ARRAY_LAYERS) ? arrayLayers_ : baseLayer + layerCount;
+    VKW_ASSERT(levelEnd <= mipLevels_ && layerEnd <= arrayLayers_);
+
+    SubresourceState resetState = {};
+    resetState.layout = layout;
+    for(uint32_t layer = baseLayer; layer < layerEnd; ++layer)
+    {
+        for(uint32_t level = baseLevel; level < levelEnd; ++level)
+        {
+            states_[layer * mipLevels_ + level] = resetState;
+        }
+    }
+}
+
+uint32_t ImageLayoutTracker::transition(
+    const VkImage image, const VkImageLayout newLayout, const VkPipelineStageFlags2 stages,
+    const VkAccessFlags2 access, std::vector<VkImageMemoryBarrier2>& barriers, const uint32_t baseLevel,
+    const uint32_t levelCount, const uint32_t baseLayer, const uint32_t layerCount)
+{
+    VKW_ASSERT(this->initialized());
+
+    const uint32_t levelEnd = (levelCount == VK_REMAINING_MIP_LEVELS) ? mipLevels_ : baseLevel + levelCount;
+    const uint32_t layerEnd
+        = (layerCount == VK_REMAINING_ARRAY_LAYERS) ? arrayLayers_ : baseLayer + layerCount;
+    VKW_ASSERT(levelEnd <= mipLevels_ && layerEnd <= arrayLayers_);
+
+    SubresourceState newState = {};
+    newState.layout = newLayout;
+    newState.stages = stages;
+    newState.access = access;
+
+    // Contiguous levels of a layer sharing the same previous state
+    std::vector<LevelRun> runs{};
+    for(uint32_t layer = baseLayer; layer < layerEnd; ++layer)
+    {
+        bool runOpen = false;
+        for(uint32_t level = baseLevel; level < levelEnd; ++level)
+        {
+            auto& state = states_[layer * mipLevels_ + level];
+
+            // Read after read in the same layout, only accumulate the readers for the next write
+            if(state.layout == newLayout && !hasWriteAccess(state.access) && !hasWriteAccess(access))
+            {
+                state.stages |= stages;
+                state.access |= access;
+                runOpen = false;
+                continue;
+            }
+
+            if(runOpen && runs.back().oldState == state) { runs.back().levelCount++; }
+            else
+            {
+                runs.push_back({level, 1, layer, 1, state});
+                runOpen = true;
+            }
+            state = newState;
+        }
+    }
+
+    // Merge identical level runs of contiguous layers
+    std::vector<LevelRun> merged{};
+    merged.reserve(runs.size());
+    for(const auto& run : runs)
+    {
+        bool found = false;
+        for(auto& candidate : merged)
+        {
+            if(candidate.baseLevel == run.baseLevel && candidate.levelCount == run.levelCount
+               && candidate.baseLayer + candidate.layerCount == run.baseLayer
+               && candidate.oldState == run.oldState)
+            {
+                candidate.layerCount++;
+                found = true;
+                break;
+            }
+        }
+        if(!found) { merged.push_back(run); }
+    }
+
+    for(const auto& run : merged)
+    {
+        VkImageMemoryBarrier2 barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+        barrier.pNext = nullptr;
+        barrier.srcStageMask = run.oldState.stages;
+        barrier.srcAccessMask = run.oldState.access & writeAccessMask;
+        barrier.dstStageMask = stages;
+        barrier.dstAccessMask = access;
+        barrier.oldLayout = run.oldState.layout;
+        barrier.newLayout = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = image;
+        barrier.subresourceRange.aspectMask = aspectMask_;
+        barrier.subresourceRange.baseMipLevel = run.baseLevel;
+        barrier.subresourceRange.levelCount = run.levelCount;
+        barrier.subresourceRange.baseArrayLayer = run.baseLayer;
+        barrier.subresourceRange.layerCount = run.layerCount;
+        barriers.push_back(barrier);
+    }
+
+    return static_cast<uint32_t>(merged.size());
+}
+
+VkImageAspectFlags ImageLayoutTracker::getAspectMask(const VkFormat format)
+{
+    switch(format)
+    {
+        case VK_FORMAT_D16_UNORM:
+        case VK_FORMAT_X8_D24_UNORM_PACK32:
+        case VK_FORMAT_D32_SFLOAT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT;
+        case VK_FORMAT_S8_UINT:
+            return VK_IMAGE_ASPECT_STENCIL_BIT;
+        case VK_FORMAT_D16_UNORM_S8_UINT:
+        case VK_FORMAT_D24_UNORM_S8_UINT:
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        default:
+            return VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+}
+
+bool ImageLayoutTracker::hasWriteAccess(const VkAccessFlags2 access)
+{
+    return (access & writeAccessMask) != 0;
+}
+} // namespace vkw
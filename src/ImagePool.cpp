@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/ImagePool.hpp"
+
+#include "vkw/detail/ImageLayoutTracker.hpp"
+
+#include <functional>
+
+namespace vkw
+{
+namespace
+{
+inline void hashCombine(size_t& seed, const uint64_t value)
+{
+    seed ^= std::hash<uint64_t>{}(value) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+}
+} // namespace
+
+size_t ImagePool::DescriptionHash::operator()(const Description& desc) const
+{
+    size_t seed = 0;
+    hashCombine(seed, uint64_t(desc.imageType));
+    hashCombine(seed, uint64_t(desc.format));
+    hashCombine(seed, (uint64_t(desc.extent.width) << 32) | uint64_t(desc.extent.height));
+    hashCombine(seed, uint64_t(desc.extent.depth));
+    hashCombine(seed, uint64_t(desc.usage));
+    hashCombine(seed, uint64_t(desc.samples));
+    hashCombine(seed, (uint64_t(desc.mipLevels) << 32) | uint64_t(desc.arrayLayers));
+    hashCombine(seed, uint64_t(desc.viewType));
+    return seed;
+}
+
+ImagePool::ImagePool(const Device& device, const uint32_t maxUnusedFrames)
+{
+    VKW_CHECK_BOOL_FAIL(this->init(device, maxUnusedFrames), "Initializing image pool");
+}
+
+ImagePool& ImagePool::operator=(ImagePool&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+
+    std::swap(entries_, rhs.entries_);
+    std::swap(entriesById_, rhs.entriesById_);
+    std::swap(imageCount_, rhs.imageCount_);
+
+    std::swap(frameIndex_, rhs.frameIndex_);
+    std::swap(nextId_, rhs.nextId_);
+    std::swap(maxUnusedFrames_, rhs.maxUnusedFrames_);
+    std::swap(lazilyAllocatedAvailable_, rhs.lazilyAllocatedAvailable_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+bool ImagePool::init(const Device& device, const uint32_t maxUnusedFrames)
+{
+    VKW_ASSERT(this->initialized() == false);
+
+    device_ = &device;
+    maxUnusedFrames_ = maxUnusedFrames;
+
+    const auto& memProperties = device_->getMemProperties();
+    for(uint32_t i = 0; i < memProperties.memoryTypeCount; ++i)
+    {
+        if(memProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)
+        {
+            lazilyAllocatedAvailable_ = true;
+            break;
+        }
+    }
+
+    initialized_ = true;
+
+    return true;
+}
+
+void ImagePool::clear()
+{
+    entriesById_.clear();
+    entries_.clear();
+    imageCount_ = 0;
+
+    frameIndex_ = 0;
+    nextId_ = 1;
+    maxUnusedFrames_ = 3;
+    lazilyAllocatedAvailable_ = false;
+
+    device_ = nullptr;
+    initialized_ = false;
+}
+
+ImagePool::PooledImage ImagePool::acquire(const Description& desc)
+{
+    VKW_ASSERT(this->initialized());
+
+    auto& bucket = entries_[desc];
+    Entry* entry = nullptr;
+    for(auto& candidate : bucket)
+    {
+        if(!candidate->inUse)
+        {
+            entry = candidate.get();
+            break;
+        }
+    }
+
+    if(entry == nullptr)
+    {
+        auto newEntry = createEntry(desc);
+        if(newEntry == nullptr) { return {}; }
+
+        entry = newEntry.get();
+        entriesById_[entry->id] = entry;
+        bucket.emplace_back(std::move(newEntry));
+        imageCount_++;
+    }
+
+    entry->inUse = true;
+    entry->lastUsedFrame = frameIndex_;
+
+    PooledImage ret = {};
+    ret.image = entry->image.get();
+    ret.view = entry->view.getHandle();
+    ret.id = entry->id;
+    return ret;
+}
+
+void ImagePool::release(const PooledImage& pooledImage)
+{
+    auto it = entriesById_.find(pooledImage.id);
+    if(it == entriesById_.end()) { return; }
+
+    it->second->inUse = false;
+    it->second->lastUsedFrame = frameIndex_;
+}
+
+uint32_t ImagePool::nextFrame()
+{
+    VKW_ASSERT(this->initialized());
+
+    frameIndex_++;
+
+    uint32_t destroyedCount = 0;
+    for(auto it = entries_.begin(); it != entries_.end();)
+    {
+        auto& bucket = it->second;
+        for(size_t i = 0; i < bucket.size();)
+        {
+            const auto& entry = *bucket[i];
+            if(!entry.inUse && (frameIndex_ - entry.lastUsedFrame > maxUnusedFrames_))
+            {
+                entriesById_.erase(entry.id);
+                bucket[i] = std::move(bucket.back());
+                bucket.pop_back();
+                destroyedCount++;
+                continue;
+            }
+            ++i;
+        }
+
+        if(bucket.empty()) { it = entries_.erase(it); }
+        else
+        {
+            ++it;
+        }
+    }
+    imageCount_ -= destroyedCount;
+
+    return destroyedCount;
+}
+
+void ImagePool::trim()
+{
+    for(auto& [desc, bucket] : entries_)
+    {
+        for(size_t i = 0; i < bucket.size();)
+        {
+            if(!bucket[i]->inUse)
+            {
+                entriesById_.erase(bucket[i]->id);
+                bucket[i] = std::move(bucket.back());
+                bucket.pop_back();
+                imageCount_--;
+                continue;
+            }
+            ++i;
+        }
+    }
+}
+
+std::unique_ptr<ImagePool::Entry> ImagePool::createEntry(const Description& desc)
+{
+    const bool cubeCompatible
+        = (desc.viewType == VK_IMAGE_VIEW_TYPE_CUBE) || (desc.viewType == VK_IMAGE_VIEW_TYPE_CUBE_ARRAY);
+
+    VkImageCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = cubeCompatible ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0;
+    createInfo.imageType = desc.imageType;
+    createInfo.format = desc.format;
+    createInfo.extent = desc.extent;
+    createInfo.mipLevels = desc.mipLevels;
+    createInfo.arrayLayers = desc.arrayLayers;
+    createInfo.samples = desc.samples;
+    createInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    createInfo.usage = desc.usage;
+    createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    createInfo.queueFamilyIndexCount = 0;
+    createInfo.pQueueFamilyIndices = nullptr;
+    createInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    auto entry = std::make_unique<Entry>();
+    entry->id = nextId_++;
+    entry->lastUsedFrame = frameIndex_;
+    entry->inUse = false;
+
+    if(lazilyAllocatedAvailable_ && (desc.usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT))
+    {
+        auto image = std::make_unique<TransientImage<>>();
+        if(image->init(*device_, createInfo)) { entry->image = std::move(image); }
+        else
+        {
+            utils::Log::Verbose("vkw", "Lazily allocated memory not usable, falling back to device memory");
+        }
+    }
+    if(entry->image == nullptr)
+    {
+        auto image = std::make_unique<DeviceImage<>>();
+        if(!image->init(*device_, createInfo))
+        {
+            utils::Log::Error("vkw", "Error creating pooled image");
+            return nullptr;
+        }
+        entry->image = std::move(image);
+    }
+
+    VkImageViewCreateInfo viewCreateInfo = {};
+    viewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewCreateInfo.pNext = nullptr;
+    viewCreateInfo.flags = 0;
+    viewCreateInfo.image = entry->image->getHandle();
+    viewCreateInfo.viewType = desc.viewType;
+    viewCreateInfo.format = desc.format;
+    viewCreateInfo.components.r = VK_COMPONENT_SWIZZLE_R;
+    viewCreateInfo.components.g = VK_COMPONENT_SWIZZLE_G;
+    viewCreateInfo.components.b = VK_COMPONENT_SWIZZLE_B;
+    viewCreateInfo.components.a = VK_COMPONENT_SWIZZLE_A;
+    viewCreateInfo.subresourceRange.aspectMask = ImageLayoutTracker::getAspectMask(desc.format);
+    viewCreateInfo.subresourceRange.baseMipLevel = 0;
+    viewCreateInfo.subresourceRange.levelCount = desc.mipLevels;
+    viewCreateInfo.subresourceRange.baseArrayLayer = 0;
+    viewCreateInfo.subresourceRange.layerCount = desc.arrayLayers;
+    if(!entry->view.init(*device_, viewCreateInfo))
+    {
+        utils::Log::Error("vkw", "Error creating pooled image view");
+        return nullptr;
+    }
+
+    return entry;
+}
+} // namespace vkw
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/MappedFile.hpp"
+
+#if defined(_WIN32)
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+
+namespace vkw
+{
+MappedFile::MappedFile(
+    const std::string& filename, const size_t offset, const size_t size, const size_t alignment)
+{
+    VKW_CHECK_BOOL_FAIL(this->init(filename, offset, size, alignment), "Mapping file");
+}
+
+MappedFile::MappedFile(MappedFile&& rhs) { *this = std::move(rhs); }
+
+MappedFile& MappedFile::operator=(MappedFile&& rhs)
+{
+    this->clear();
+
+    std::swap(mappedData_, rhs.mappedData_);
+    std::swap(mappedSize_, rhs.mappedSize_);
+    std::swap(dataOffset_, rhs.dataOffset_);
+    std::swap(size_, rhs.size_);
+    std::swap(fileSize_, rhs.fileSize_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+MappedFile::~MappedFile() { this->clear(); }
+
+bool MappedFile::init(
+    const std::string& filename, const size_t offset, const size_t size, const size_t alignment)
+{
+    VKW_ASSERT(this->initialized() == false);
+
+#if defined(_WIN32)
+    utils::Log::Error("vkw", "File mapping not supported on this platform: %s", filename.c_str());
+    return false;
+#else
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+        utils::Log::Error("vkw", "Error opening file %s", filename.c_str());
+        return false;
+    }
+
+    struct stat fileStat = {};
+    if(fstat(fd, &fileStat) != 0)
+    {
+        utils::Log::Error("vkw", "Error reading file size %s", filename.c_str());
+        close(fd);
+        return false;
+    }
+    fileSize_ = static_cast<size_t>(fileStat.st_size);
+
+    if(offset >= fileSize_)
+    {
+        utils::Log::Error("vkw", "Mapping offset out of file %s", filename.c_str());
+        close(fd);
+        this->clear();
+        return false;
+    }
+
+    size_ = (size == 0) ? (fileSize_ - offset) : std::min(size, fileSize_ - offset);
+
+    ///@note: Both alignment values are powers of two, we can just take the maximum of them.
+    const size_t mapAlignment = std::max(pageSize(), alignment);
+    const size_t mapOffset = offset & ~(mapAlignment - 1);
+    dataOffset_ = offset - mapOffset;
+    mappedSize_ = utils::alignedSize(dataOffset_ + size_, mapAlignment);
+
+    // mmap() only guarantees page alignment: reserve a larger anonymous range and map the file at an
+    // aligned address inside it. The pages of the range past the end of the file stay anonymous, accessing
+    // file pages past its end would raise SIGBUS.
+    const size_t reservedSize = mappedSize_ + mapAlignment - pageSize();
+    void* reserved
+        = mmap(nullptr, reservedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(reserved == MAP_FAILED)
+    {
+        utils::Log::Error("vkw", "Error reserving mapping range for file %s", filename.c_str());
+        close(fd);
+        this->clear();
+        return false;
+    }
+
+    auto* reservedBegin = reinterpret_cast<uint8_t*>(reserved);
+    const auto reservedAddress = reinterpret_cast<uintptr_t>(reserved);
+    const auto alignedAddress = utils::alignedSize(reservedAddress, static_cast<uintptr_t>(mapAlignment));
+    const size_t headSize = static_cast<size_t>(alignedAddress - reservedAddress);
+    const size_t tailSize = reservedSize - headSize - mappedSize_;
+    if(headSize > 0) { munmap(reservedBegin, headSize); }
+    if(tailSize > 0) { munmap(reservedBegin + headSize + mappedSize_, tailSize); }
+    mappedData_ = reservedBegin + headSize;
+
+    // Private writable mapping: host writes to the imported memory are allowed but never reach the file.
+    const size_t fileMapSize = utils::alignedSize(std::min(mappedSize_, fileSize_ - mapOffset), pageSize());
+    void* ptr = mmap(
+        mappedData_, fileMapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd,
+        static_cast<off_t>(mapOffset));
+    close(fd);
+    if(ptr == MAP_FAILED)
+    {
+        utils::Log::Error("vkw", "Error mapping file %s", filename.c_str());
+        this->clear();
+        return false;
+    }
+
+    initialized_ = true;
+
+    return true;
+#endif
+}
+
+void MappedFile::clear()
+{
+#if !defined(_WIN32)
+    if(mappedData_ != nullptr) { munmap(mappedData_, mappedSize_); }
+#endif
+
+    mappedData_ = nullptr;
+    mappedSize_ = 0;
+    dataOffset_ = 0;
+    size_ = 0;
+    fileSize_ = 0;
+
+    initialized_ = false;
+}
+
+size_t MappedFile::pageSize()
+{
+#if defined(_WIN32)
+    return 4096;
+#else
+    static const size_t systemPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return systemPageSize;
+#endif
+}
+} // namespace vkw
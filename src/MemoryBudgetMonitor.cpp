@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/MemoryBudgetMonitor.hpp"
+
+#include "vkw/detail/MemoryCommon.hpp"
+
+#include <algorithm>
+
+namespace vkw
+{
+MemoryBudgetMonitor::MemoryBudgetMonitor(
+    const Device& device, const float evictionThreshold, const float evictionTarget)
+{
+    VKW_CHECK_BOOL_FAIL(
+        this->init(device, evictionThreshold, evictionTarget), "Initializing memory budget monitor");
+}
+
+MemoryBudgetMonitor::MemoryBudgetMonitor(MemoryBudgetMonitor&& rhs) { *this = std::move(rhs); }
+
+MemoryBudgetMonitor& MemoryBudgetMonitor::operator=(MemoryBudgetMonitor&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+
+    std::swap(budgetQuery_, rhs.budgetQuery_);
+    std::swap(budgets_, rhs.budgets_);
+    std::swap(highWaterMarks_, rhs.highWaterMarks_);
+
+    std::swap(evictionThreshold_, rhs.evictionThreshold_);
+    std::swap(evictionTarget_, rhs.evictionTarget_);
+
+    std::swap(nextId_, rhs.nextId_);
+    std::swap(lruList_, rhs.lruList_);
+    std::swap(evictables_, rhs.evictables_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+MemoryBudgetMonitor::~MemoryBudgetMonitor() { this->clear(); }
+
+bool MemoryBudgetMonitor::init(
+    const Device& device, const float evictionThreshold, const float evictionTarget)
+{
+    VKW_ASSERT(this->initialized() == false);
+
+    device_ = &device;
+
+    if(!device_->memoryBudgetEnabled())
+    {
+        utils::Log::Warning(
+            "vkw", "VK_EXT_memory_budget not enabled, memory budgets will be estimated by the allocator");
+    }
+
+    setEvictionThresholds(evictionThreshold, evictionTarget);
+    budgets_ = device_->getMemoryBudget();
+
+    initialized_ = true;
+
+    return true;
+}
+
+void MemoryBudgetMonitor::clear()
+{
+    evictables_.clear();
+    lruList_.clear();
+    nextId_ = invalidId + 1;
+
+    evictionThreshold_ = 0.95f;
+    evictionTarget_ = 0.85f;
+
+    highWaterMarks_.clear();
+    budgets_.clear();
+    budgetQuery_ = {};
+
+    device_ = nullptr;
+
+    initialized_ = false;
+}
+
+MemoryBudgetMonitor& MemoryBudgetMonitor::addHighWaterMark(const float ratio, PressureCallback&& callback)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(ratio > 0.0f);
+
+    HighWaterMark mark = {};
+    mark.ratio = ratio;
+    mark.callback = std::move(callback);
+    mark.reached.resize(budgets_.size(), false);
+    for(uint32_t i = 0; i < heapCount(); ++i)
+    {
+        mark.reached[i] = usageRatio(i) >= ratio;
+    }
+    highWaterMarks_.emplace_back(std::move(mark));
+
+    return *this;
+}
+
+MemoryBudgetMonitor& MemoryBudgetMonitor::setEvictionThresholds(
+    const float evictionThreshold, const float evictionTarget)
+{
+    VKW_ASSERT(evictionTarget <= evictionThreshold);
+
+    evictionThreshold_ = evictionThreshold;
+    evictionTarget_ = evictionTarget;
+
+    return *this;
+}
+
+MemoryBudgetMonitor& MemoryBudgetMonitor::setBudgetQuery(BudgetQuery&& query)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(highWaterMarks_.empty() && evictables_.empty());
+
+    budgetQuery_ = std::move(query);
+    budgets_ = queryBudgets();
+
+    return *this;
+}
+
+MemoryBudgetMonitor::EvictableId MemoryBudgetMonitor::registerEvictable(
+    const uint32_t heapIndex, const VkDeviceSize sizeBytes, EvictionCallback&& callback)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(heapIndex < heapCount());
+    VKW_ASSERT(callback);
+
+    const EvictableId id = nextId_++;
+    lruList_.push_front(id);
+
+    EvictableEntry entry = {};
+    entry.heapIndex = heapIndex;
+    entry.sizeBytes = sizeBytes;
+    entry.callback = std::move(callback);
+    entry.lruPos = lruList_.begin();
+    evictables_.emplace(id, std::move(entry));
+
+    return id;
+}
+
+MemoryBudgetMonitor::EvictableId MemoryBudgetMonitor::registerEvictable(
+    const BaseBuffer& buffer, EvictionCallback&& callback)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(buffer.initialized());
+
+    VmaAllocationInfo allocInfo = {};
+    vmaGetAllocationInfo(device_->allocator(), buffer.memory(), &allocInfo);
+
+    const uint32_t heapIndex = device_->getMemProperties().memoryTypes[allocInfo.memoryType].heapIndex;
+    return registerEvictable(heapIndex, allocInfo.size, std::move(callback));
+}
+
+void MemoryBudgetMonitor::unregisterEvictable(const EvictableId id)
+{
+    auto it = evictables_.find(id);
+    if(it == evictables_.end()) { return; }
+
+    lruList_.erase(it->second.lruPos);
+    evictables_.erase(it);
+}
+
+void MemoryBudgetMonitor::touch(const EvictableId id)
+{
+    auto it = evictables_.find(id);
+    if(it == evictables_.end()) { return; }
+
+    lruList_.splice(lruList_.begin(), lruList_, it->second.lruPos);
+}
+
+VkDeviceSize MemoryBudgetMonitor::update()
+{
+    VKW_ASSERT(this->initialized());
+
+    budgets_ = queryBudgets();
+
+    VkDeviceSize releasedBytes = 0;
+    for(uint32_t i = 0; i < heapCount(); ++i)
+    {
+        const auto& heapBudget = budgets_[i];
+        if(heapBudget.totalSize == 0) { continue; }
+
+        const float totalSize = float(heapBudget.totalSize);
+        const auto thresholdSize = static_cast<VkDeviceSize>(evictionThreshold_ * totalSize);
+        const auto targetSize = static_cast<VkDeviceSize>(evictionTarget_ * totalSize);
+        if(heapBudget.usedSize > thresholdSize)
+        {
+            const auto released = evict(i, heapBudget.usedSize - targetSize);
+            releasedBytes += released;
+
+            utils::Log::Verbose(
+                "vkw", "Heap %u over budget threshold, %llu bytes evicted", i,
+                static_cast<unsigned long long>(released));
+        }
+    }
+
+    // Evictions changed the usage, fetch the budgets again before notifying
+    if(releasedBytes > 0) { budgets_ = queryBudgets(); }
+
+    for(auto& mark : highWaterMarks_)
+    {
+        for(uint32_t i = 0; i < heapCount(); ++i)
+        {
+            const bool reached = usageRatio(i) >= mark.ratio;
+            if(reached != mark.reached[i])
+            {
+                mark.reached[i] = reached;
+                if(mark.callback) { mark.callback(i, budgets_[i], reached); }
+            }
+        }
+    }
+
+    return releasedBytes;
+}
+
+VkDeviceSize MemoryBudgetMonitor::evict(const uint32_t heapIndex, const VkDeviceSize sizeBytes)
+{
+    VKW_ASSERT(this->initialized());
+
+    VkDeviceSize releasedBytes = 0;
+
+    // Walk from the least recently used resource
+    auto it = lruList_.end();
+    while(it != lruList_.begin() && releasedBytes < sizeBytes)
+    {
+        --it;
+
+        const EvictableId id = *it;
+        auto entryIt = evictables_.find(id);
+        VKW_ASSERT(entryIt != evictables_.end());
+        if(entryIt->second.heapIndex != heapIndex) { continue; }
+
+        // The resource is unregistered before invoking the callback so it can safely be destroyed by it
+        auto callback = std::move(entryIt->second.callback);
+        it = lruList_.erase(it);
+        evictables_.erase(entryIt);
+
+        releasedBytes += callback(id);
+    }
+
+    return releasedBytes;
+}
+
+float MemoryBudgetMonitor::usageRatio(const uint32_t heapIndex) const
+{
+    VKW_ASSERT(heapIndex < budgets_.size());
+
+    const auto& heapBudget = budgets_[heapIndex];
+    if(heapBudget.totalSize == 0) { return 0.0f; }
+    return float(heapBudget.usedSize) / float(heapBudget.totalSize);
+}
+
+std::vector<MemoryBudget> MemoryBudgetMonitor::queryBudgets() const
+{
+    if(budgetQuery_) { return budgetQuery_(); }
+    return device_->getMemoryBudget();
+}
+} // namespace vkw
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/MipmapGenerator.hpp"
+
+#include "vkw/detail/CommandBuffer.hpp"
+
+#include <algorithm>
+
+namespace vkw
+{
+namespace
+{
+const uint32_t mipmapDownsampleSpv[] = {
+#include "spv/MipmapDownsample.comp.spv"
+};
+
+constexpr uint32_t groupSize = 8;
+} // namespace
+
+MipmapGenerator::MipmapGenerator(const Device& device)
+{
+    VKW_CHECK_BOOL_FAIL(this->init(device), "Initializing mipmap generator");
+}
+
+MipmapGenerator& MipmapGenerator::operator=(MipmapGenerator&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+
+    std::swap(descriptorSetLayout_, rhs.descriptorSetLayout_);
+    std::swap(pipelineLayout_, rhs.pipelineLayout_);
+    std::swap(pipeline_, rhs.pipeline_);
+    std::swap(sampler_, rhs.sampler_);
+
+    std::swap(views_, rhs.views_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+bool MipmapGenerator::init(const Device& device)
+{
+    VKW_ASSERT(this->initialized() == false);
+
+    device_ = &device;
+
+    VKW_INIT_CHECK_BOOL(descriptorSetLayout_.init(device));
+    descriptorSetLayout_.addBinding<DescriptorType::CombinedImageSampler>(VK_SHADER_STAGE_COMPUTE_BIT, 0)
+        .addBinding<DescriptorType::StorageImage>(VK_SHADER_STAGE_COMPUTE_BIT, 1);
+    VKW_INIT_CHECK_BOOL(descriptorSetLayout_.create(VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR));
+
+    VKW_INIT_CHECK_BOOL(pipelineLayout_.init(device, descriptorSetLayout_));
+    pipelineLayout_.reservePushConstants<PushConstants>(ShaderStage::Compute);
+    VKW_INIT_CHECK_BOOL(pipelineLayout_.create());
+
+    VKW_INIT_CHECK_BOOL(pipeline_.init(
+        device, reinterpret_cast<const char*>(mipmapDownsampleSpv), sizeof(mipmapDownsampleSpv)));
+    VKW_INIT_CHECK_BOOL(pipeline_.createPipeline(pipelineLayout_));
+
+    // Only used with texelFetch(), filtering does not matter
+    VkSamplerCreateInfo samplerInfo = {};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.pNext = nullptr;
+    samplerInfo.flags = 0;
+    samplerInfo.magFilter = VK_FILTER_NEAREST;
+    samplerInfo.minFilter = VK_FILTER_NEAREST;
+    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.mipLodBias = 0.0f;
+    samplerInfo.anisotropyEnable = VK_FALSE;
+    samplerInfo.maxAnisotropy = 1.0f;
+    samplerInfo.compareEnable = VK_FALSE;
+    samplerInfo.compareOp = VK_COMPARE_OP_ALWAYS;
+    samplerInfo.minLod = 0.0f;
+    samplerInfo.maxLod = 0.0f;
+    samplerInfo.borderColor = VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK;
+    samplerInfo.unnormalizedCoordinates = VK_FALSE;
+    VKW_INIT_CHECK_BOOL(sampler_.init(device, samplerInfo));
+
+    initialized_ = true;
+
+    return true;
+}
+
+void MipmapGenerator::clear()
+{
+    views_.clear();
+
+    sampler_.clear();
+    pipeline_.clear();
+    pipelineLayout_.clear();
+    descriptorSetLayout_.clear();
+
+    device_ = nullptr;
+    initialized_ = false;
+}
+
+bool MipmapGenerator::supports(const BaseImage& image) const
+{
+    if(image.imageType() != VK_IMAGE_TYPE_2D) { return false; }
+
+    static constexpr VkImageUsageFlags requiredUsage
+        = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT;
+    if((image.usage() & requiredUsage) != requiredUsage) { return false; }
+
+    VkFormatProperties formatProperties = {};
+    vkGetPhysicalDeviceFormatProperties(device_->getPhysicalDevice(), image.format(), &formatProperties);
+
+    static constexpr VkFormatFeatureFlags requiredFeatures
+        = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT;
+    return (formatProperties.optimalTilingFeatures & requiredFeatures) == requiredFeatures;
+}
+
+bool MipmapGenerator::record(const CommandBuffer& cmdBuffer, const BaseImage& image, const uint32_t level)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(level > 0 && level < image.mipLevels());
+
+    const auto createView = [&](const uint32_t mipLevel) -> VkImageView {
+        VkImageViewCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.image = image.getHandle();
+        createInfo.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        createInfo.format = image.format();
+        createInfo.components.r = VK_COMPONENT_SWIZZLE_R;
+        createInfo.components.g = VK_COMPONENT_SWIZZLE_G;
+        createInfo.components.b = VK_COMPONENT_SWIZZLE_B;
+        createInfo.components.a = VK_COMPONENT_SWIZZLE_A;
+        createInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        createInfo.subresourceRange.baseMipLevel = mipLevel;
+        createInfo.subresourceRange.levelCount = 1;
+        createInfo.subresourceRange.baseArrayLayer = 0;
+        createInfo.subresourceRange.layerCount = image.arrayLayers();
+
+        ImageView view{};
+        if(!view.init(*device_, createInfo)) { return VK_NULL_HANDLE; }
+
+        views_.emplace_back(std::move(view));
+        return views_.back().getHandle();
+    };
+
+    const VkImageView srcView = createView(level - 1);
+    const VkImageView dstView = createView(level);
+    if(srcView == VK_NULL_HANDLE || dstView == VK_NULL_HANDLE)
+    {
+        utils::Log::Error("vkw", "Error creating mipmap views");
+        return false;
+    }
+
+    const auto extent = image.extent();
+
+    PushConstants params = {};
+    params.srcExtent[0] = static_cast<int32_t>(std::max(extent.width >> (level - 1), 1u));
+    params.srcExtent[1] = static_cast<int32_t>(std::max(extent.height >> (level - 1), 1u));
+    params.dstExtent[0] = static_cast<int32_t>(std::max(extent.width >> level, 1u));
+    params.dstExtent[1] = static_cast<int32_t>(std::max(extent.height >> level, 1u));
+
+    cmdBuffer.bindComputePipeline(pipeline_)
+        .pushComputeCombinedImageSampler(
+            pipelineLayout_, 0, 0, sampler_.getHandle(), srcView, VK_IMAGE_LAYOUT_GENERAL)
+        .pushComputeStorageImage(pipelineLayout_, 0, 1, dstView, VK_IMAGE_LAYOUT_GENERAL)
+        .pushConstants(pipelineLayout_, params, ShaderStage::Compute)
+        .dispatch(
+            utils::divUp(static_cast<uint32_t>(params.dstExtent[0]), groupSize),
+            utils::divUp(static_cast<uint32_t>(params.dstExtent[1]), groupSize), image.arrayLayers());
+
+    return true;
+}
+} // namespace vkw
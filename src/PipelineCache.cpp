@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/PipelineCache.hpp"
+
+#include <cstring>
+#include <fstream>
+
+namespace vkw
+{
+PipelineCache::PipelineCache(const Device& device)
+{
+    VKW_CHECK_BOOL_FAIL(this->init(device), "Creating pipeline cache");
+}
+
+PipelineCache::PipelineCache(const Device& device, const MappedFile& file)
+{
+    VKW_CHECK_BOOL_FAIL(this->init(device, file), "Creating pipeline cache");
+}
+
+PipelineCache& PipelineCache::operator=(PipelineCache&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+    std::swap(pipelineCache_, rhs.pipelineCache_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+bool PipelineCache::init(
+    const Device& device, const void* initialData, const size_t initialDataSize,
+    const VkPipelineCacheCreateFlags flags)
+{
+    VKW_ASSERT(this->initialized() == false);
+
+    device_ = &device;
+
+    const bool useData = initialDataSize > 0 && compatible(device, initialData, initialDataSize);
+    if(initialDataSize > 0 && !useData)
+    {
+        utils::Log::Warning("vkw", "Pipeline cache data does not match the device, discarding it");
+    }
+
+    VkPipelineCacheCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = flags;
+    createInfo.initialDataSize = useData ? initialDataSize : 0;
+    createInfo.pInitialData = useData ? initialData : nullptr;
+    VKW_INIT_CHECK_VK(
+        device_->vk().vkCreatePipelineCache(device_->getHandle(), &createInfo, nullptr, &pipelineCache_));
+
+    initialized_ = true;
+
+    return true;
+}
+
+bool PipelineCache::init(const Device& device, const MappedFile& file, const VkPipelineCacheCreateFlags flags)
+{
+    VKW_ASSERT(file.initialized());
+    return this->init(device, file.data(), file.size(), flags);
+}
+
+void PipelineCache::clear()
+{
+    VKW_DELETE_VK(PipelineCache, pipelineCache_);
+
+    device_ = nullptr;
+    initialized_ = false;
+}
+
+std::vector<uint8_t> PipelineCache::getData() const
+{
+    VKW_ASSERT(this->initialized());
+
+    size_t dataSize = 0;
+    device_->vk().vkGetPipelineCacheData(device_->getHandle(), pipelineCache_, &dataSize, nullptr);
+
+    std::vector<uint8_t> ret(dataSize);
+    if(device_->vk().vkGetPipelineCacheData(device_->getHandle(), pipelineCache_, &dataSize, ret.data())
+       != VK_SUCCESS)
+    {
+        utils::Log::Error("vkw", "Error reading pipeline cache data");
+        return {};
+    }
+    ret.resize(dataSize);
+
+    return ret;
+}
+
+bool PipelineCache::save(const std::string& filename) const
+{
+    const auto data = this->getData();
+    if(data.empty()) { return false; }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if(!file.is_open())
+    {
+        utils::Log::Error("vkw", "Error opening file %s", filename.c_str());
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+    return file.good();
+}
+
+bool PipelineCache::merge(const std::vector<std::reference_wrapper<const PipelineCache>>& srcCaches)
+{
+    VKW_ASSERT(this->initialized());
+
+    std::vector<VkPipelineCache> handles{};
+    handles.reserve(srcCaches.size());
+    for(const auto& cache : srcCaches)
+    {
+        VKW_ASSERT(cache.get().getHandle() != pipelineCache_);
+        handles.push_back(cache.get().getHandle());
+    }
+    if(handles.empty()) { return true; }
+
+    VKW_CHECK_VK_RETURN_FALSE(device_->vk().vkMergePipelineCaches(
+        device_->getHandle(), pipelineCache_, static_cast<uint32_t>(handles.size()), handles.data()));
+
+    return true;
+}
+
+bool PipelineCache::compatible(const Device& device, const void* data, const size_t size)
+{
+    if(data == nullptr || size < sizeof(VkPipelineCacheHeaderVersionOne)) { return false; }
+
+    VkPipelineCacheHeaderVersionOne header = {};
+    memcpy(&header, data, sizeof(VkPipelineCacheHeaderVersionOne));
+
+    const auto properties = device.getProperties();
+    return header.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne)
+           && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+           && header.vendorID == properties.vendorID && header.deviceID == properties.deviceID
+           && memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+} // namespace vkw
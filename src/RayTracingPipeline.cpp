@@ -49,6 +49,11 @@ RayTracingPipeline& RayTracingPipeline::operator=(RayTracingPipeline&& rhs)
     std::swap(shaderStages_, rhs.shaderStages_);
     std::swap(shaderGroups_, rhs.shaderGroups_);
 
+    std::swap(libraries_, rhs.libraries_);
+    std::swap(libraryGroupCount_, rhs.libraryGroupCount_);
+    std::swap(libraryInterface_, rhs.libraryInterface_);
+    std::swap(isLibrary_, rhs.isLibrary_);
+
     return *this;
 }
 
@@ -70,9 +75,17 @@ RayTracingPipeline::~RayTracingPipeline() { clear(); }
 
 void RayTracingPipeline::clear()
 {
-    clearShaderModules();
+    if(device_ != nullptr) { clearShaderModules(); }
     VKW_DELETE_VK(Pipeline, pipeline_);
 
+    dynamicStates_.clear();
+    shaderGroups_.clear();
+
+    libraries_.clear();
+    libraryGroupCount_ = 0;
+    libraryInterface_ = {};
+    isLibrary_ = false;
+
     device_ = nullptr;
     initialized_ = false;
 }
@@ -94,11 +107,11 @@ bool RayTracingPipeline::addShaderStage(
     createInfo.flags = 0;
     createInfo.codeSize = pSource.size() * sizeof(decltype(pSource)::value_type);
     createInfo.pCode = reinterpret_cast<const uint32_t*>(pSource.data());
-    VKW_CHECK_BOOL_RETURN_FALSE(device_->vk().vkCreateShaderModule(
+    VKW_CHECK_VK_RETURN_FALSE(device_->vk().vkCreateShaderModule(
         device_->getHandle(), &createInfo, nullptr, &moduleInfo.shaderModule));
 
     moduleInfo.shaderStage = stage;
-    moduleInfo.pName = std::string(pName);
+    moduleInfo.pName = std::string(pName != nullptr ? pName : "main");
 
     return true;
 }
@@ -119,11 +132,11 @@ bool RayTracingPipeline::addShaderStage(
     createInfo.flags = 0;
     createInfo.codeSize = byteCount;
     createInfo.pCode = reinterpret_cast<const uint32_t*>(srcData);
-    VKW_CHECK_BOOL_RETURN_FALSE(device_->vk().vkCreateShaderModule(
+    VKW_CHECK_VK_RETURN_FALSE(device_->vk().vkCreateShaderModule(
         device_->getHandle(), &createInfo, nullptr, &moduleInfo.shaderModule));
 
     moduleInfo.shaderStage = stage;
-    moduleInfo.pName = std::string(pName);
+    moduleInfo.pName = std::string(pName != nullptr ? pName : "main");
 
     return true;
 }
@@ -184,13 +197,63 @@ RayTracingPipeline& RayTracingPipeline::addProceduralHitShaderGroup(
     return *this;
 }
 
+RayTracingPipeline& RayTracingPipeline::addLibrary(const RayTracingPipeline& library)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(library.isLibrary());
+    VKW_ASSERT(library.getHandle() != VK_NULL_HANDLE);
+
+    libraries_.push_back(library.getHandle());
+    libraryGroupCount_ += library.groupCount();
+
+    return *this;
+}
+
+RayTracingPipeline& RayTracingPipeline::setLibraryInterface(
+    const uint32_t maxPayloadSize, const uint32_t maxHitAttributeSize)
+{
+    VKW_ASSERT(this->initialized());
+
+    libraryInterface_.sType = VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_INTERFACE_CREATE_INFO_KHR;
+    libraryInterface_.pNext = nullptr;
+    libraryInterface_.maxPipelineRayPayloadSize = maxPayloadSize;
+    libraryInterface_.maxPipelineRayHitAttributeSize = maxHitAttributeSize;
+
+    return *this;
+}
+
+bool RayTracingPipeline::createLibrary(
+    const PipelineLayout& pipelineLayout, const uint32_t maxDepth, const VkPipelineCreateFlags flags,
+    const VkPipelineCache pipelineCache)
+{
+    return this->createPipeline(
+        pipelineLayout, maxDepth, flags | VK_PIPELINE_CREATE_LIBRARY_BIT_KHR, pipelineCache);
+}
+
 bool RayTracingPipeline::createPipeline(
-    const PipelineLayout& pipelineLayout, const uint32_t maxDepth, const VkPipelineCreateFlags flags)
+    const PipelineLayout& pipelineLayout, const uint32_t maxDepth, const VkPipelineCreateFlags flags,
+    const VkPipelineCache pipelineCache)
 {
     VKW_ASSERT(this->initialized());
+    VKW_ASSERT(pipeline_ == VK_NULL_HANDLE);
+
+    isLibrary_ = (flags & VK_PIPELINE_CREATE_LIBRARY_BIT_KHR) != 0;
+    const bool useLibraries = isLibrary_ || !libraries_.empty();
+    if(useLibraries
+       && libraryInterface_.sType != VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_INTERFACE_CREATE_INFO_KHR)
+    {
+        utils::Log::Error("vkw", "Ray tracing pipeline libraries require setLibraryInterface()");
+        return false;
+    }
 
     finalizePipelineStages();
 
+    VkPipelineLibraryCreateInfoKHR libraryInfo = {};
+    libraryInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+    libraryInfo.pNext = nullptr;
+    libraryInfo.libraryCount = static_cast<uint32_t>(libraries_.size());
+    libraryInfo.pLibraries = libraries_.data();
+
     VkRayTracingPipelineCreateInfoKHR createInfo = {};
     createInfo.sType = VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_CREATE_INFO_KHR;
     createInfo.pNext = nullptr;
@@ -200,17 +263,15 @@ bool RayTracingPipeline::createPipeline(
     createInfo.groupCount = static_cast<uint32_t>(shaderGroups_.size());
     createInfo.pGroups = shaderGroups_.data();
     createInfo.maxPipelineRayRecursionDepth = maxDepth;
-    /// @todo: Add pipeline libraries support
-    createInfo.pLibraryInfo = nullptr;
-    /// @todo: Add library interface support
-    createInfo.pLibraryInterface = nullptr;
+    createInfo.pLibraryInfo = libraries_.empty() ? nullptr : &libraryInfo;
+    createInfo.pLibraryInterface = useLibraries ? &libraryInterface_ : nullptr;
     createInfo.pDynamicState = &dynamicStateInfo_;
     createInfo.layout = pipelineLayout.getHandle();
     /// @todo: Add support for pipeline derivatives
     createInfo.basePipelineHandle = VK_NULL_HANDLE;
     createInfo.basePipelineIndex = -1;
     VKW_CHECK_VK_RETURN_FALSE(device_->vk().vkCreateRayTracingPipelinesKHR(
-        device_->getHandle(), VK_NULL_HANDLE, VK_NULL_HANDLE, 1, &createInfo, nullptr, &pipeline_));
+        device_->getHandle(), VK_NULL_HANDLE, pipelineCache, 1, &createInfo, nullptr, &pipeline_));
 
     clearShaderModules();
 
@@ -255,7 +316,7 @@ void RayTracingPipeline::finalizePipelineStages()
         shaderStage.flags = 0;
         shaderStage.stage = moduleInfo.shaderStage;
         shaderStage.module = moduleInfo.shaderModule;
-        shaderStage.pName = "main";
+        shaderStage.pName = moduleInfo.pName.c_str();
         shaderStage.pSpecializationInfo = moduleInfo.specSizes.size() > 0 ? &specInfo : nullptr;
     }
 
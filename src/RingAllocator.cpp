@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/RingAllocator.hpp"
+
+#include "vkw/detail/utils.hpp"
+
+#include <algorithm>
+
+namespace vkw
+{
+bool RingAllocator::init(const TimelineSemaphore& timeline, const VkDeviceSize capacity, const char* name)
+{
+    VKW_ASSERT(this->initialized() == false);
+    VKW_ASSERT(timeline.initialized());
+
+    timeline_ = &timeline;
+    capacity_ = capacity;
+    name_ = name;
+
+    initialized_ = true;
+
+    return true;
+}
+
+void RingAllocator::clear()
+{
+    regions_.clear();
+    head_ = 0;
+    nextId_ = 1;
+
+    name_.clear();
+    capacity_ = 0;
+    timeline_ = nullptr;
+
+    initialized_ = false;
+}
+
+RingAllocator::Region RingAllocator::allocate(
+    const VkDeviceSize size, const VkDeviceSize alignment, const uint64_t timelineValue, const bool released)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(size > 0);
+
+    if(size > capacity_)
+    {
+        utils::Log::Error("vkw", "%s: allocation size exceeds the ring capacity", name_.c_str());
+        return {};
+    }
+
+    reclaim();
+
+    VkDeviceSize offset = 0;
+    while(!findSpace(size, alignment, offset))
+    {
+        // Ring full, the oldest region is the next one to be freed. Waiting on a region still used by the
+        // host, or on the value being recorded, would never return.
+        const Region& oldest = regions_.front();
+        if(!oldest.released || (oldest.timelineValue >= timelineValue))
+        {
+            utils::Log::Error("vkw", "%s full, release or submit the pending regions first", name_.c_str());
+            return {};
+        }
+
+        utils::Log::Verbose("vkw", "%s full, waiting for the oldest region", name_.c_str());
+        if(!timeline_->wait(oldest.timelineValue)) { return {}; }
+        reclaim();
+    }
+
+    Region region = {};
+    region.id = nextId_++;
+    region.offset = offset;
+    region.size = size;
+    region.timelineValue = timelineValue;
+    region.released = released;
+    regions_.push_back(region);
+
+    head_ = offset + size;
+
+    return region;
+}
+
+void RingAllocator::release(const uint64_t id)
+{
+    for(auto& region : regions_)
+    {
+        if(region.id == id)
+        {
+            region.released = true;
+            break;
+        }
+    }
+}
+
+void RingAllocator::reclaim()
+{
+    if(regions_.empty()) { return; }
+
+    const uint64_t timelineValue = timeline_->getValue();
+    while(!regions_.empty() && regions_.front().released
+          && (regions_.front().timelineValue <= timelineValue))
+    {
+        regions_.pop_front();
+    }
+
+    if(regions_.empty()) { head_ = 0; }
+}
+
+bool RingAllocator::findSpace(
+    const VkDeviceSize size, const VkDeviceSize alignment, VkDeviceSize& offset) const
+{
+    if(regions_.empty())
+    {
+        offset = 0;
+        return true;
+    }
+
+    // Live data is in [tail, head) when head > tail, [tail, capacity) + [0, head) otherwise
+    const VkDeviceSize tail = regions_.front().offset;
+    const VkDeviceSize alignedHead = utils::alignedSize(head_, std::max(alignment, VkDeviceSize(1)));
+    if(head_ > tail)
+    {
+        if(alignedHead + size <= capacity_)
+        {
+            offset = alignedHead;
+            return true;
+        }
+        if(size <= tail)
+        {
+            offset = 0;
+            return true;
+        }
+        return false;
+    }
+
+    if((head_ < tail) && (alignedHead + size <= tail))
+    {
+        offset = alignedHead;
+        return true;
+    }
+
+    return false;
+}
+} // namespace vkw
@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/ShaderBindingTable.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace vkw
+{
+ShaderBindingTable::ShaderBindingTable(const Device& device)
+{
+    VKW_CHECK_BOOL_FAIL(this->init(device), "Initializing shader binding table");
+}
+
+ShaderBindingTable& ShaderBindingTable::operator=(ShaderBindingTable&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+
+    std::swap(handleSize_, rhs.handleSize_);
+    std::swap(groupCount_, rhs.groupCount_);
+    std::swap(groupHandles_, rhs.groupHandles_);
+
+    std::swap(records_, rhs.records_);
+    std::swap(regionOffsets_, rhs.regionOffsets_);
+    std::swap(regionStrides_, rhs.regionStrides_);
+    std::swap(firstRecords_, rhs.firstRecords_);
+
+    std::swap(hostTable_, rhs.hostTable_);
+    std::swap(dirtyRecords_, rhs.dirtyRecords_);
+    std::swap(dirtyCount_, rhs.dirtyCount_);
+
+    std::swap(sbtBuffer_, rhs.sbtBuffer_);
+    std::swap(stagingBuffer_, rhs.stagingBuffer_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+bool ShaderBindingTable::init(const Device& device)
+{
+    VKW_ASSERT(this->initialized() == false);
+
+    device_ = &device;
+
+    if(!device_->rayTracingPipelineEnabled())
+    {
+        utils::Log::Error("vkw", "VK_KHR_ray_tracing_pipeline is not enabled");
+        device_ = nullptr;
+        return false;
+    }
+
+    initialized_ = true;
+
+    return true;
+}
+
+void ShaderBindingTable::clear()
+{
+    sbtBuffer_.clear();
+    stagingBuffer_.clear();
+
+    handleSize_ = 0;
+    groupCount_ = 0;
+    groupHandles_.clear();
+
+    for(auto& records : records_)
+    {
+        records.clear();
+    }
+    regionOffsets_ = {};
+    regionStrides_ = {};
+    firstRecords_ = {};
+
+    hostTable_.clear();
+    dirtyRecords_.clear();
+    dirtyCount_ = 0;
+
+    device_ = nullptr;
+    initialized_ = false;
+}
+
+ShaderBindingTable& ShaderBindingTable::addRecord(
+    const Region region, const uint32_t groupIndex, const uint32_t dataSize)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(!this->created());
+
+    records_[static_cast<uint32_t>(region)].push_back({groupIndex, dataSize});
+    return *this;
+}
+
+bool ShaderBindingTable::create(const RayTracingPipeline& pipeline)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(!this->created());
+    VKW_ASSERT(pipeline.getHandle() != VK_NULL_HANDLE);
+
+    if(records_[static_cast<uint32_t>(Region::RayGen)].empty())
+    {
+        utils::Log::Error("vkw", "Shader binding table has no ray generation record");
+        return false;
+    }
+
+    const auto& properties = device_->rayTracingPipelineProperties();
+    const VkDeviceSize handleAlignment = properties.shaderGroupHandleAlignment;
+    const VkDeviceSize baseAlignment = properties.shaderGroupBaseAlignment;
+
+    handleSize_ = properties.shaderGroupHandleSize;
+    groupCount_ = pipeline.groupCount();
+    groupHandles_.resize(static_cast<size_t>(groupCount_) * handleSize_);
+    VKW_CHECK_VK_RETURN_FALSE(device_->vk().vkGetRayTracingShaderGroupHandlesKHR(
+        device_->getHandle(), pipeline.getHandle(), 0, groupCount_, groupHandles_.size(),
+        groupHandles_.data()));
+
+    VkDeviceSize tableSize = 0;
+    uint32_t recordCount = 0;
+    for(uint32_t r = 0; r < regionCount; ++r)
+    {
+        const auto& records = records_[r];
+
+        uint32_t maxDataSize = 0;
+        for(const auto& record : records)
+        {
+            if(record.groupIndex >= groupCount_)
+            {
+                utils::Log::Error("vkw", "Shader binding table record references an invalid group");
+                return false;
+            }
+            maxDataSize = std::max(maxDataSize, record.dataSize);
+        }
+
+        // Each ray generation record is used as a region of its own
+        const VkDeviceSize recordAlignment
+            = (r == static_cast<uint32_t>(Region::RayGen)) ? baseAlignment : handleAlignment;
+        const VkDeviceSize stride
+            = utils::alignedSize(static_cast<VkDeviceSize>(handleSize_ + maxDataSize), recordAlignment);
+        if(!records.empty() && stride > properties.maxShaderGroupStride)
+        {
+            utils::Log::Error("vkw", "Shader binding table record exceeds maxShaderGroupStride");
+            return false;
+        }
+
+        regionOffsets_[r] = utils::alignedSize(tableSize, baseAlignment);
+        regionStrides_[r] = stride;
+        firstRecords_[r] = recordCount;
+
+        tableSize = regionOffsets_[r] + records.size() * stride;
+        recordCount += static_cast<uint32_t>(records.size());
+    }
+
+    VKW_CHECK_BOOL_RETURN_FALSE(sbtBuffer_.init(*device_, tableSize, {}, baseAlignment));
+    VKW_CHECK_BOOL_RETURN_FALSE(stagingBuffer_.init(*device_, tableSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT));
+
+    hostTable_.assign(tableSize, 0);
+    for(uint32_t r = 0; r < regionCount; ++r)
+    {
+        const auto region = static_cast<Region>(r);
+        for(uint32_t i = 0; i < records_[r].size(); ++i)
+        {
+            memcpy(recordPtr(region, i), groupHandles_.data() + records_[r][i].groupIndex * handleSize_,
+                   handleSize_);
+        }
+    }
+
+    dirtyRecords_.assign(recordCount, false);
+    dirtyCount_ = 0;
+    markAllDirty();
+
+    return true;
+}
+
+VkStridedDeviceAddressRegionKHR ShaderBindingTable::deviceRegion(
+    const Region region, const uint32_t rayGenIndex) const
+{
+    VKW_ASSERT(this->created());
+
+    const uint32_t r = static_cast<uint32_t>(region);
+
+    VkStridedDeviceAddressRegionKHR ret = {};
+    if(records_[r].empty()) { return ret; }
+
+    ret.deviceAddress = sbtBuffer_.deviceAddress() + regionOffsets_[r];
+    ret.stride = regionStrides_[r];
+    ret.size = records_[r].size() * regionStrides_[r];
+    if(region == Region::RayGen)
+    {
+        VKW_ASSERT(rayGenIndex < records_[r].size());
+        ret.deviceAddress += rayGenIndex * regionStrides_[r];
+        ret.size = regionStrides_[r];
+    }
+
+    return ret;
+}
+
+VkTraceRaysIndirectCommand2KHR ShaderBindingTable::indirectCommand(
+    const uint32_t width, const uint32_t height, const uint32_t depth, const uint32_t rayGenIndex) const
+{
+    const auto rayGenRegion = deviceRegion(Region::RayGen, rayGenIndex);
+    const auto missRegion = deviceRegion(Region::Miss);
+    const auto hitRegion = deviceRegion(Region::Hit);
+    const auto callableRegion = deviceRegion(Region::Callable);
+
+    VkTraceRaysIndirectCommand2KHR ret = {};
+    ret.raygenShaderRecordAddress = rayGenRegion.deviceAddress;
+    ret.raygenShaderRecordSize = rayGenRegion.size;
+    ret.missShaderBindingTableAddress = missRegion.deviceAddress;
+    ret.missShaderBindingTableSize = missRegion.size;
+    ret.missShaderBindingTableStride = missRegion.stride;
+    ret.hitShaderBindingTableAddress = hitRegion.deviceAddress;
+    ret.hitShaderBindingTableSize = hitRegion.size;
+    ret.hitShaderBindingTableStride = hitRegion.stride;
+    ret.callableShaderBindingTableAddress = callableRegion.deviceAddress;
+    ret.callableShaderBindingTableSize = callableRegion.size;
+    ret.callableShaderBindingTableStride = callableRegion.stride;
+    ret.width = width;
+    ret.height = height;
+    ret.depth = depth;
+
+    return ret;
+}
+
+void ShaderBindingTable::setRecordGroup(
+    const Region region, const uint32_t recordIndex, const uint32_t groupIndex)
+{
+    VKW_ASSERT(this->created());
+    VKW_ASSERT(groupIndex < groupCount_);
+
+    auto& record = records_[static_cast<uint32_t>(region)][recordIndex];
+    if(record.groupIndex == groupIndex) { return; }
+
+    record.groupIndex = groupIndex;
+    memcpy(recordPtr(region, recordIndex), groupHandles_.data() + groupIndex * handleSize_, handleSize_);
+    markDirty(region, recordIndex);
+}
+
+void ShaderBindingTable::setRecordData(
+    const Region region, const uint32_t recordIndex, const void* data, const size_t sizeBytes)
+{
+    VKW_ASSERT(this->created());
+    VKW_ASSERT(sizeBytes <= recordDataSize(region, recordIndex));
+
+    memcpy(recordPtr(region, recordIndex) + handleSize_, data, sizeBytes);
+    markDirty(region, recordIndex);
+}
+
+void ShaderBindingTable::markAllDirty()
+{
+    std::fill(dirtyRecords_.begin(), dirtyRecords_.end(), true);
+    dirtyCount_ = static_cast<uint32_t>(dirtyRecords_.size());
+}
+
+uint8_t* ShaderBindingTable::recordPtr(const Region region, const uint32_t recordIndex)
+{
+    const uint32_t r = static_cast<uint32_t>(region);
+    VKW_ASSERT(recordIndex < records_[r].size());
+    return hostTable_.data() + regionOffsets_[r] + recordIndex * regionStrides_[r];
+}
+
+void ShaderBindingTable::markDirty(const Region region, const uint32_t recordIndex)
+{
+    const uint32_t id = firstRecords_[static_cast<uint32_t>(region)] + recordIndex;
+    if(!dirtyRecords_[id])
+    {
+        dirtyRecords_[id] = true;
+        dirtyCount_++;
+    }
+}
+
+std::vector<VkBufferCopy> ShaderBindingTable::stageDirtyRecords()
+{
+    std::vector<VkBufferCopy> regions = {};
+    if(dirtyCount_ == 0) { return regions; }
+
+    for(uint32_t r = 0; r < regionCount; ++r)
+    {
+        const uint32_t first = firstRecords_[r];
+        const uint32_t count = static_cast<uint32_t>(records_[r].size());
+
+        uint32_t i = 0;
+        while(i < count)
+        {
+            if(!dirtyRecords_[first + i])
+            {
+                ++i;
+                continue;
+            }
+
+            const uint32_t runStart = i;
+            while(i < count && dirtyRecords_[first + i])
+            {
+                dirtyRecords_[first + i++] = false;
+            }
+
+            const VkDeviceSize offset = regionOffsets_[r] + runStart * regionStrides_[r];
+            const VkDeviceSize size = (i - runStart) * regionStrides_[r];
+            stagingBuffer_.copyFromHost(hostTable_.data() + offset, offset, size);
+
+            VkBufferCopy region = {};
+            region.srcOffset = offset;
+            region.dstOffset = offset;
+            region.size = size;
+            regions.push_back(region);
+        }
+    }
+    dirtyCount_ = 0;
+
+    return regions;
+}
+} // namespace vkw
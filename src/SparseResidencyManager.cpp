@@ -0,0 +1,553 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/SparseResidencyManager.hpp"
+
+#include "vkw/detail/utils.hpp"
+
+#include <algorithm>
+
+namespace vkw
+{
+namespace
+{
+/// Appends a bind to the list, merging it with the previous one when both ranges are contiguous in the
+/// resource and in memory.
+void appendBind(std::vector<VkSparseMemoryBind>& binds, const VkSparseMemoryBind& bind)
+{
+    if(!binds.empty())
+    {
+        auto& last = binds.back();
+        const bool sameMemory = (last.memory == bind.memory) && (last.flags == bind.flags);
+        const bool contiguous = (last.resourceOffset + last.size == bind.resourceOffset)
+                                && (last.memory == VK_NULL_HANDLE
+                                    || last.memoryOffset + last.size == bind.memoryOffset);
+        if(sameMemory && contiguous)
+        {
+            last.size += bind.size;
+            return;
+        }
+    }
+    binds.push_back(bind);
+}
+} // namespace
+
+SparseResidencyManager::SparseResidencyManager(
+    const Device& device, const Queue& queue, const TimelineSemaphore& timeline,
+    const VkDeviceSize poolBlockSize)
+{
+    VKW_CHECK_BOOL_FAIL(
+        this->init(device, queue, timeline, poolBlockSize), "Initializing sparse residency manager");
+}
+
+SparseResidencyManager::SparseResidencyManager(SparseResidencyManager&& rhs) { *this = std::move(rhs); }
+
+SparseResidencyManager& SparseResidencyManager::operator=(SparseResidencyManager&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+    std::swap(queue_, rhs.queue_);
+    std::swap(timeline_, rhs.timeline_);
+
+    std::swap(poolBlockSize_, rhs.poolBlockSize_);
+    std::swap(pools_, rhs.pools_);
+
+    std::swap(dirtyBufferPages_, rhs.dirtyBufferPages_);
+    std::swap(dirtyImagePages_, rhs.dirtyImagePages_);
+    std::swap(dirtyMipTails_, rhs.dirtyMipTails_);
+
+    std::swap(pendingFrees_, rhs.pendingFrees_);
+    std::swap(retired_, rhs.retired_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+SparseResidencyManager::~SparseResidencyManager() { this->clear(); }
+
+bool SparseResidencyManager::init(
+    const Device& device, const Queue& queue, const TimelineSemaphore& timeline,
+    const VkDeviceSize poolBlockSize)
+{
+    VKW_ASSERT(this->initialized() == false);
+    VKW_ASSERT(timeline.initialized());
+
+    if((queue.flags() & VK_QUEUE_SPARSE_BINDING_BIT) == 0)
+    {
+        utils::Log::Error("vkw", "Sparse residency manager requires a queue supporting sparse binding");
+        return false;
+    }
+
+    device_ = &device;
+    queue_ = queue;
+    timeline_ = &timeline;
+    poolBlockSize_ = poolBlockSize;
+
+    initialized_ = true;
+
+    return true;
+}
+
+void SparseResidencyManager::clear()
+{
+    if(device_ != nullptr)
+    {
+        for(auto allocation : pendingFrees_) { vmaFreeMemory(device_->allocator(), allocation); }
+        for(const auto& page : retired_) { vmaFreeMemory(device_->allocator(), page.allocation); }
+        for(const auto& [memoryType, pool] : pools_) { vmaDestroyPool(device_->allocator(), pool); }
+    }
+    pendingFrees_.clear();
+    retired_.clear();
+    pools_.clear();
+
+    dirtyBufferPages_.clear();
+    dirtyImagePages_.clear();
+    dirtyMipTails_.clear();
+
+    poolBlockSize_ = defaultPoolBlockSize;
+
+    timeline_ = nullptr;
+    queue_ = {};
+    device_ = nullptr;
+
+    initialized_ = false;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool SparseResidencyManager::bindPages(
+    SparseBuffer& buffer, const uint32_t firstPage, const uint32_t pageCount)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(buffer.initialized());
+    VKW_ASSERT(firstPage + pageCount <= buffer.pageCount());
+
+    std::vector<uint32_t> missingPages;
+    for(uint32_t page = firstPage; page < firstPage + pageCount; ++page)
+    {
+        if(!buffer.resident(page)) { missingPages.push_back(page); }
+    }
+    if(missingPages.empty()) { return true; }
+
+    std::vector<VmaAllocation> allocations(missingPages.size(), VK_NULL_HANDLE);
+    VKW_CHECK_BOOL_RETURN_FALSE(allocatePages(
+        buffer.memoryTypeBits(), buffer.pageSize(), buffer.pageSize(), allocations.size(),
+        allocations.data()));
+
+    auto& dirtyPages = dirtyBufferPages_[&buffer];
+    for(size_t i = 0; i < missingPages.size(); ++i)
+    {
+        buffer.pages_[missingPages[i]] = allocations[i];
+        dirtyPages.insert(missingPages[i]);
+    }
+
+    return true;
+}
+
+void SparseResidencyManager::unbindPages(
+    SparseBuffer& buffer, const uint32_t firstPage, const uint32_t pageCount)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(buffer.initialized());
+    VKW_ASSERT(firstPage + pageCount <= buffer.pageCount());
+
+    for(uint32_t page = firstPage; page < firstPage + pageCount; ++page)
+    {
+        if(!buffer.resident(page)) { continue; }
+
+        releasePage(buffer.pages_[page]);
+        dirtyBufferPages_[&buffer].insert(page);
+    }
+}
+
+template <typename Fn>
+void SparseResidencyManager::forEachTile(
+    const SparseImage& image, const uint32_t level, const uint32_t layer, const VkOffset3D& offset,
+    const VkExtent3D& extent, Fn&& fn)
+{
+    VKW_ASSERT(level < image.mipTailFirstLevel());
+    VKW_ASSERT(layer < image.arrayLayers());
+    VKW_ASSERT(offset.x >= 0 && offset.y >= 0 && offset.z >= 0);
+    VKW_ASSERT(extent.width > 0 && extent.height > 0 && extent.depth > 0);
+
+    const auto granularity = image.tileExtent();
+    const auto count = image.tileCount(level);
+
+    const uint32_t x0 = uint32_t(offset.x) / granularity.width;
+    const uint32_t y0 = uint32_t(offset.y) / granularity.height;
+    const uint32_t z0 = uint32_t(offset.z) / granularity.depth;
+    const uint32_t x1
+        = std::min(utils::divUp(uint32_t(offset.x) + extent.width, granularity.width), count.width);
+    const uint32_t y1
+        = std::min(utils::divUp(uint32_t(offset.y) + extent.height, granularity.height), count.height);
+    const uint32_t z1
+        = std::min(utils::divUp(uint32_t(offset.z) + extent.depth, granularity.depth), count.depth);
+
+    for(uint32_t z = z0; z < z1; ++z)
+    {
+        for(uint32_t y = y0; y < y1; ++y)
+        {
+            for(uint32_t x = x0; x < x1; ++x)
+            {
+                fn(image.tileIndex(level, layer, {int32_t(x), int32_t(y), int32_t(z)}));
+            }
+        }
+    }
+}
+
+bool SparseResidencyManager::bindRegion(
+    SparseImage& image, const uint32_t level, const uint32_t layer, const VkOffset3D& offset,
+    const VkExtent3D& extent)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(image.initialized());
+
+    std::vector<uint32_t> missingPages;
+    forEachTile(image, level, layer, offset, extent, [&](const uint32_t index) {
+        if(image.pages_[index] == VK_NULL_HANDLE) { missingPages.push_back(index); }
+    });
+    if(missingPages.empty()) { return true; }
+
+    std::vector<VmaAllocation> allocations(missingPages.size(), VK_NULL_HANDLE);
+    VKW_CHECK_BOOL_RETURN_FALSE(allocatePages(
+        image.memoryTypeBits(), image.pageSize(), image.pageSize(), allocations.size(), allocations.data()));
+
+    auto& dirtyPages = dirtyImagePages_[&image];
+    for(size_t i = 0; i < missingPages.size(); ++i)
+    {
+        image.pages_[missingPages[i]] = allocations[i];
+        dirtyPages.insert(missingPages[i]);
+    }
+
+    return true;
+}
+
+void SparseResidencyManager::unbindRegion(
+    SparseImage& image, const uint32_t level, const uint32_t layer, const VkOffset3D& offset,
+    const VkExtent3D& extent)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(image.initialized());
+
+    forEachTile(image, level, layer, offset, extent, [&](const uint32_t index) {
+        if(image.pages_[index] == VK_NULL_HANDLE) { return; }
+
+        releasePage(image.pages_[index]);
+        dirtyImagePages_[&image].insert(index);
+    });
+}
+
+bool SparseResidencyManager::bindMipTail(SparseImage& image, const uint32_t layer)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(image.initialized());
+    VKW_ASSERT(image.hasMipTail());
+    VKW_ASSERT(layer < image.arrayLayers());
+
+    const uint32_t index = image.singleMipTail() ? 0 : layer;
+    if(image.mipTailPages_[index] != VK_NULL_HANDLE) { return true; }
+
+    VKW_CHECK_BOOL_RETURN_FALSE(allocatePages(
+        image.memoryTypeBits(), image.sparseRequirements_.imageMipTailSize, image.pageSize(), 1,
+        &image.mipTailPages_[index]));
+    dirtyMipTails_[&image].insert(index);
+
+    return true;
+}
+
+void SparseResidencyManager::unbindMipTail(SparseImage& image, const uint32_t layer)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(image.initialized());
+    VKW_ASSERT(image.hasMipTail());
+    VKW_ASSERT(layer < image.arrayLayers());
+
+    const uint32_t index = image.singleMipTail() ? 0 : layer;
+    if(image.mipTailPages_[index] == VK_NULL_HANDLE) { return; }
+
+    releasePage(image.mipTailPages_[index]);
+    dirtyMipTails_[&image].insert(index);
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool SparseResidencyManager::flush(const uint64_t waitValue, const uint64_t signalValue)
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(signalValue > waitValue);
+
+    const auto memoryBind = [&](const VmaAllocation allocation, const VkDeviceSize resourceOffset,
+                                const VkDeviceSize size) {
+        VkSparseMemoryBind bind = {};
+        bind.resourceOffset = resourceOffset;
+        bind.size = size;
+        bind.memory = VK_NULL_HANDLE;
+        bind.memoryOffset = 0;
+        bind.flags = 0;
+        if(allocation != VK_NULL_HANDLE)
+        {
+            VmaAllocationInfo allocInfo = {};
+            vmaGetAllocationInfo(device_->allocator(), allocation, &allocInfo);
+            bind.memory = allocInfo.deviceMemory;
+            bind.memoryOffset = allocInfo.offset;
+        }
+        return bind;
+    };
+
+    // Buffer pages, sorted by index so that contiguous pages can be merged
+    std::vector<std::vector<VkSparseMemoryBind>> bufferBinds;
+    std::vector<VkSparseBufferMemoryBindInfo> bufferBindInfos;
+    bufferBinds.reserve(dirtyBufferPages_.size());
+    for(const auto& [buffer, pages] : dirtyBufferPages_)
+    {
+        auto& binds = bufferBinds.emplace_back();
+        for(const auto page : pages)
+        {
+            const VkDeviceSize pageSize = buffer->pageSize();
+            appendBind(binds, memoryBind(buffer->pages_[page], page * pageSize, pageSize));
+        }
+
+        VkSparseBufferMemoryBindInfo bindInfo = {};
+        bindInfo.buffer = buffer->getHandle();
+        bindInfo.bindCount = static_cast<uint32_t>(binds.size());
+        bindInfo.pBinds = binds.data();
+        bufferBindInfos.push_back(bindInfo);
+    }
+
+    // Image tiles
+    std::vector<std::vector<VkSparseImageMemoryBind>> imageBinds;
+    std::vector<VkSparseImageMemoryBindInfo> imageBindInfos;
+    imageBinds.reserve(dirtyImagePages_.size());
+    for(const auto& [image, pages] : dirtyImagePages_)
+    {
+        const auto granularity = image->tileExtent();
+        const auto extent = image->extent();
+
+        auto& binds = imageBinds.emplace_back();
+        binds.reserve(pages.size());
+        for(const auto index : pages)
+        {
+            const uint32_t layer = index / image->pagesPerLayer_;
+            const uint32_t layerIndex = index % image->pagesPerLayer_;
+            const auto levelIt = std::upper_bound(
+                image->levelFirstPage_.begin(), image->levelFirstPage_.end(), layerIndex);
+            const auto level
+                = static_cast<uint32_t>(std::distance(image->levelFirstPage_.begin(), levelIt) - 1);
+
+            const auto& count = image->levelTileCounts_[level];
+            const uint32_t tile = layerIndex - image->levelFirstPage_[level];
+            const uint32_t x = (tile % count.width) * granularity.width;
+            const uint32_t y = ((tile / count.width) % count.height) * granularity.height;
+            const uint32_t z = (tile / (count.width * count.height)) * granularity.depth;
+
+            // Tiles on the border of a level only cover the remaining texels
+            const uint32_t levelWidth = std::max(extent.width >> level, 1u);
+            const uint32_t levelHeight = std::max(extent.height >> level, 1u);
+            const uint32_t levelDepth = std::max(extent.depth >> level, 1u);
+
+            const auto memBind = memoryBind(image->pages_[index], 0, image->pageSize());
+
+            VkSparseImageMemoryBind bind = {};
+            bind.subresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, layer};
+            bind.offset = {int32_t(x), int32_t(y), int32_t(z)};
+            bind.extent = {
+                std::min(granularity.width, levelWidth - x), std::min(granularity.height, levelHeight - y),
+                std::min(granularity.depth, levelDepth - z)};
+            bind.memory = memBind.memory;
+            bind.memoryOffset = memBind.memoryOffset;
+            bind.flags = 0;
+            binds.push_back(bind);
+        }
+
+        VkSparseImageMemoryBindInfo bindInfo = {};
+        bindInfo.image = image->getHandle();
+        bindInfo.bindCount = static_cast<uint32_t>(binds.size());
+        bindInfo.pBinds = binds.data();
+        imageBindInfos.push_back(bindInfo);
+    }
+
+    // Mip tails are bound as opaque ranges of the image
+    std::vector<std::vector<VkSparseMemoryBind>> opaqueBinds;
+    std::vector<VkSparseImageOpaqueMemoryBindInfo> opaqueBindInfos;
+    opaqueBinds.reserve(dirtyMipTails_.size());
+    for(const auto& [image, layers] : dirtyMipTails_)
+    {
+        const auto& requirements = image->sparseRequirements_;
+
+        auto& binds = opaqueBinds.emplace_back();
+        for(const auto layer : layers)
+        {
+            const VkDeviceSize offset
+                = requirements.imageMipTailOffset + layer * requirements.imageMipTailStride;
+            binds.push_back(memoryBind(image->mipTailPages_[layer], offset, requirements.imageMipTailSize));
+        }
+
+        VkSparseImageOpaqueMemoryBindInfo bindInfo = {};
+        bindInfo.image = image->getHandle();
+        bindInfo.bindCount = static_cast<uint32_t>(binds.size());
+        bindInfo.pBinds = binds.data();
+        opaqueBindInfos.push_back(bindInfo);
+    }
+
+    const VkSemaphore semaphore = timeline_->getHandle();
+
+    VkTimelineSemaphoreSubmitInfo semaphoreSubmitInfo = {};
+    semaphoreSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    semaphoreSubmitInfo.pNext = nullptr;
+    semaphoreSubmitInfo.waitSemaphoreValueCount = 1;
+    semaphoreSubmitInfo.pWaitSemaphoreValues = &waitValue;
+    semaphoreSubmitInfo.signalSemaphoreValueCount = 1;
+    semaphoreSubmitInfo.pSignalSemaphoreValues = &signalValue;
+
+    VkBindSparseInfo bindSparseInfo = {};
+    bindSparseInfo.sType = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO;
+    bindSparseInfo.pNext = &semaphoreSubmitInfo;
+    bindSparseInfo.waitSemaphoreCount = 1;
+    bindSparseInfo.pWaitSemaphores = &semaphore;
+    bindSparseInfo.bufferBindCount = static_cast<uint32_t>(bufferBindInfos.size());
+    bindSparseInfo.pBufferBinds = bufferBindInfos.data();
+    bindSparseInfo.imageOpaqueBindCount = static_cast<uint32_t>(opaqueBindInfos.size());
+    bindSparseInfo.pImageOpaqueBinds = opaqueBindInfos.data();
+    bindSparseInfo.imageBindCount = static_cast<uint32_t>(imageBindInfos.size());
+    bindSparseInfo.pImageBinds = imageBindInfos.data();
+    bindSparseInfo.signalSemaphoreCount = 1;
+    bindSparseInfo.pSignalSemaphores = &semaphore;
+    VKW_CHECK_VK_RETURN_FALSE(
+        device_->vk().vkQueueBindSparse(queue_.getHandle(), 1, &bindSparseInfo, VK_NULL_HANDLE));
+
+    dirtyBufferPages_.clear();
+    dirtyImagePages_.clear();
+    dirtyMipTails_.clear();
+
+    for(auto allocation : pendingFrees_) { retired_.push_back({allocation, signalValue}); }
+    pendingFrees_.clear();
+
+    return true;
+}
+
+void SparseResidencyManager::collect()
+{
+    VKW_ASSERT(this->initialized());
+
+    if(retired_.empty()) { return; }
+
+    const uint64_t completedValue = timeline_->getValue();
+    while(!retired_.empty() && retired_.front().timelineValue <= completedValue)
+    {
+        vmaFreeMemory(device_->allocator(), retired_.front().allocation);
+        retired_.pop_front();
+    }
+}
+
+VkDeviceSize SparseResidencyManager::allocatedBytes() const
+{
+    VkDeviceSize ret = 0;
+    for(const auto& [memoryType, pool] : pools_)
+    {
+        VmaStatistics stats = {};
+        vmaGetPoolStatistics(device_->allocator(), pool, &stats);
+        ret += stats.blockBytes;
+    }
+    return ret;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+VmaPool SparseResidencyManager::getPool(const uint32_t memoryTypeBits)
+{
+    VmaAllocationCreateInfo allocCreateInfo = {};
+    allocCreateInfo.flags = 0;
+    allocCreateInfo.usage = VMA_MEMORY_USAGE_UNKNOWN;
+    allocCreateInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    allocCreateInfo.preferredFlags = 0;
+    allocCreateInfo.memoryTypeBits = 0;
+    allocCreateInfo.pool = VK_NULL_HANDLE;
+    allocCreateInfo.pUserData = nullptr;
+    allocCreateInfo.priority = 1.0f;
+
+    uint32_t memoryTypeIndex = 0;
+    if(vmaFindMemoryTypeIndex(device_->allocator(), memoryTypeBits, &allocCreateInfo, &memoryTypeIndex)
+       != VK_SUCCESS)
+    {
+        utils::Log::Error("vkw", "No device local memory type supports the sparse resource");
+        return VK_NULL_HANDLE;
+    }
+
+    auto it = pools_.find(memoryTypeIndex);
+    if(it != pools_.end()) { return it->second; }
+
+    VmaPoolCreateInfo poolCreateInfo = {};
+    poolCreateInfo.memoryTypeIndex = memoryTypeIndex;
+    poolCreateInfo.flags = 0;
+    poolCreateInfo.blockSize = poolBlockSize_;
+    poolCreateInfo.minBlockCount = 0;
+    poolCreateInfo.maxBlockCount = 0;
+    poolCreateInfo.priority = 1.0f;
+    poolCreateInfo.minAllocationAlignment = 0;
+    poolCreateInfo.pMemoryAllocateNext = nullptr;
+
+    VmaPool pool = VK_NULL_HANDLE;
+    if(vmaCreatePool(device_->allocator(), &poolCreateInfo, &pool) != VK_SUCCESS)
+    {
+        utils::Log::Error("vkw", "Error creating sparse page pool");
+        return VK_NULL_HANDLE;
+    }
+    pools_[memoryTypeIndex] = pool;
+
+    return pool;
+}
+
+bool SparseResidencyManager::allocatePages(
+    const uint32_t memoryTypeBits, const VkDeviceSize size, const VkDeviceSize alignment, const size_t count,
+    VmaAllocation* allocations)
+{
+    VmaPool pool = getPool(memoryTypeBits);
+    if(pool == VK_NULL_HANDLE) { return false; }
+
+    VkMemoryRequirements memRequirements = {};
+    memRequirements.size = size;
+    memRequirements.alignment = alignment;
+    memRequirements.memoryTypeBits = memoryTypeBits;
+
+    VmaAllocationCreateInfo allocCreateInfo = {};
+    allocCreateInfo.flags = 0;
+    allocCreateInfo.usage = VMA_MEMORY_USAGE_UNKNOWN;
+    allocCreateInfo.requiredFlags = 0;
+    allocCreateInfo.preferredFlags = 0;
+    allocCreateInfo.memoryTypeBits = 0;
+    allocCreateInfo.pool = pool;
+    allocCreateInfo.pUserData = nullptr;
+    allocCreateInfo.priority = 1.0f;
+    VKW_CHECK_VK_RETURN_FALSE(vmaAllocateMemoryPages(
+        device_->allocator(), &memRequirements, &allocCreateInfo, count, allocations, nullptr));
+
+    return true;
+}
+
+void SparseResidencyManager::releasePage(VmaAllocation& allocation)
+{
+    pendingFrees_.push_back(allocation);
+    allocation = VK_NULL_HANDLE;
+}
+} // namespace vkw
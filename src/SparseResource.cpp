@@ -0,0 +1,413 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/SparseResource.hpp"
+
+#include "vkw/detail/utils.hpp"
+
+#include <algorithm>
+
+namespace vkw
+{
+namespace
+{
+bool setObjectName(const Device& device, const VkObjectType type, const uint64_t handle, const char* pName)
+{
+    if(pName == nullptr) { return true; }
+
+    VkDebugUtilsObjectNameInfoEXT nameInfo = {};
+    nameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+    nameInfo.pNext = nullptr;
+    nameInfo.objectType = type;
+    nameInfo.pObjectName = pName;
+    nameInfo.objectHandle = handle;
+
+    static auto SetDebugUtilsObjectNameEXT = (PFN_vkSetDebugUtilsObjectNameEXT) vkGetInstanceProcAddr(
+        device.instance().getHandle(), "vkSetDebugUtilsObjectNameEXT");
+    if(SetDebugUtilsObjectNameEXT != nullptr)
+    {
+        VKW_CHECK_VK_RETURN_FALSE(SetDebugUtilsObjectNameEXT(device.getHandle(), &nameInfo));
+    }
+
+    return true;
+}
+
+uint32_t countResident(const std::vector<VmaAllocation>& pages)
+{
+    return static_cast<uint32_t>(std::count_if(
+        pages.begin(), pages.end(), [](const VmaAllocation page) { return page != VK_NULL_HANDLE; }));
+}
+
+void freePages(const Device& device, std::vector<VmaAllocation>& pages)
+{
+    for(auto& page : pages)
+    {
+        if(page != VK_NULL_HANDLE) { vmaFreeMemory(device.allocator(), page); }
+    }
+    pages.clear();
+}
+} // namespace
+
+// -----------------------------------------------------------------------------------------------------------
+// ----------------------------------------- SparseBuffer ----------------------------------------------------
+// -----------------------------------------------------------------------------------------------------------
+
+SparseBuffer::SparseBuffer(
+    const Device& device, const VkDeviceSize sizeBytes, const VkBufferUsageFlags usage, const char* pName)
+{
+    VKW_CHECK_BOOL_FAIL(this->init(device, sizeBytes, usage, pName), "Initializing sparse buffer");
+}
+
+SparseBuffer::SparseBuffer(SparseBuffer&& rhs) { *this = std::move(rhs); }
+
+SparseBuffer& SparseBuffer::operator=(SparseBuffer&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+
+    std::swap(buffer_, rhs.buffer_);
+    std::swap(usage_, rhs.usage_);
+    std::swap(sizeBytes_, rhs.sizeBytes_);
+
+    std::swap(pageSize_, rhs.pageSize_);
+    std::swap(memoryTypeBits_, rhs.memoryTypeBits_);
+
+    std::swap(pages_, rhs.pages_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+SparseBuffer::~SparseBuffer() { this->clear(); }
+
+bool SparseBuffer::init(
+    const Device& device, const VkDeviceSize sizeBytes, const VkBufferUsageFlags usage, const char* pName)
+{
+    VKW_ASSERT(this->initialized() == false);
+    VKW_ASSERT(sizeBytes > 0);
+
+    const auto features = device.getFeatures();
+    if(!features.sparseBinding || !features.sparseResidencyBuffer)
+    {
+        utils::Log::Error("vkw", "Sparse residency buffers not supported by the device");
+        return false;
+    }
+
+    device_ = &device;
+    usage_ = usage;
+    sizeBytes_ = sizeBytes;
+
+    VkBufferCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = VK_BUFFER_CREATE_SPARSE_BINDING_BIT | VK_BUFFER_CREATE_SPARSE_RESIDENCY_BIT;
+    createInfo.size = sizeBytes;
+    createInfo.usage = usage;
+    createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    createInfo.queueFamilyIndexCount = 0;
+    createInfo.pQueueFamilyIndices = nullptr;
+    VKW_INIT_CHECK_VK(device_->vk().vkCreateBuffer(device_->getHandle(), &createInfo, nullptr, &buffer_));
+
+    VkMemoryRequirements memRequirements = {};
+    device_->vk().vkGetBufferMemoryRequirements(device_->getHandle(), buffer_, &memRequirements);
+
+    // The alignment of a sparse resource is its sparse block size
+    pageSize_ = memRequirements.alignment;
+    memoryTypeBits_ = memRequirements.memoryTypeBits;
+    pages_.resize(static_cast<size_t>((memRequirements.size + pageSize_ - 1) / pageSize_), VK_NULL_HANDLE);
+
+    VKW_INIT_CHECK_BOOL(
+        setObjectName(*device_, VK_OBJECT_TYPE_BUFFER, reinterpret_cast<uint64_t>(buffer_), pName));
+
+    utils::Log::Verbose("vkw", "Sparse buffer %s", (pName != nullptr) ? pName : "");
+    utils::Log::Verbose("vkw", "  pageSize:  %zu", static_cast<size_t>(pageSize_));
+    utils::Log::Verbose("vkw", "  pageCount: %zu", pages_.size());
+
+    initialized_ = true;
+
+    return true;
+}
+
+void SparseBuffer::clear()
+{
+    if(device_ != nullptr) { freePages(*device_, pages_); }
+    pages_.clear();
+
+    VKW_DELETE_VK(Buffer, buffer_);
+
+    usage_ = {};
+    sizeBytes_ = 0;
+    pageSize_ = 0;
+    memoryTypeBits_ = 0;
+
+    device_ = nullptr;
+    initialized_ = false;
+}
+
+VkDeviceAddress SparseBuffer::deviceAddress() const
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(device_->bufferMemoryAddressEnabled());
+    VKW_ASSERT((usage_ & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) != 0);
+
+    VkBufferDeviceAddressInfo addressInfo = {};
+    addressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+    addressInfo.pNext = nullptr;
+    addressInfo.buffer = buffer_;
+    return device_->vk().vkGetBufferDeviceAddress(device_->getHandle(), &addressInfo);
+}
+
+uint32_t SparseBuffer::residentPageCount() const { return countResident(pages_); }
+
+// -----------------------------------------------------------------------------------------------------------
+// ----------------------------------------- SparseImage -----------------------------------------------------
+// -----------------------------------------------------------------------------------------------------------
+
+SparseImage::SparseImage(
+    const Device& device, const VkImageType imageType, const VkFormat format, const VkExtent3D extent,
+    const VkImageUsageFlags usage, const uint32_t mipLevels, const uint32_t arrayLayers, const char* pName)
+{
+    VKW_CHECK_BOOL_FAIL(
+        this->init(device, imageType, format, extent, usage, mipLevels, arrayLayers, pName),
+        "Initializing sparse image");
+}
+
+SparseImage::SparseImage(SparseImage&& rhs) { *this = std::move(rhs); }
+
+SparseImage& SparseImage::operator=(SparseImage&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+
+    std::swap(image_, rhs.image_);
+    std::swap(imageType_, rhs.imageType_);
+    std::swap(format_, rhs.format_);
+    std::swap(extent_, rhs.extent_);
+    std::swap(usage_, rhs.usage_);
+    std::swap(mipLevels_, rhs.mipLevels_);
+    std::swap(arrayLayers_, rhs.arrayLayers_);
+
+    std::swap(pageSize_, rhs.pageSize_);
+    std::swap(memoryTypeBits_, rhs.memoryTypeBits_);
+    std::swap(sparseRequirements_, rhs.sparseRequirements_);
+
+    std::swap(levelTileCounts_, rhs.levelTileCounts_);
+    std::swap(levelFirstPage_, rhs.levelFirstPage_);
+    std::swap(pagesPerLayer_, rhs.pagesPerLayer_);
+
+    std::swap(pages_, rhs.pages_);
+    std::swap(mipTailPages_, rhs.mipTailPages_);
+
+    std::swap(layoutTracker_, rhs.layoutTracker_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+SparseImage::~SparseImage() { this->clear(); }
+
+bool SparseImage::init(
+    const Device& device, const VkImageType imageType, const VkFormat format, const VkExtent3D extent,
+    const VkImageUsageFlags usage, const uint32_t mipLevels, const uint32_t arrayLayers, const char* pName)
+{
+    VKW_ASSERT(this->initialized() == false);
+    VKW_ASSERT(mipLevels > 0 && arrayLayers > 0);
+
+    const auto features = device.getFeatures();
+    const bool residencySupported = (imageType == VK_IMAGE_TYPE_2D && features.sparseResidencyImage2D)
+                                    || (imageType == VK_IMAGE_TYPE_3D && features.sparseResidencyImage3D);
+    if(!features.sparseBinding || !residencySupported)
+    {
+        utils::Log::Error("vkw", "Sparse residency images not supported by the device for this image type");
+        return false;
+    }
+
+    uint32_t formatPropertyCount = 0;
+    vkGetPhysicalDeviceSparseImageFormatProperties(
+        device.getPhysicalDevice(), format, imageType, VK_SAMPLE_COUNT_1_BIT, usage,
+        VK_IMAGE_TILING_OPTIMAL, &formatPropertyCount, nullptr);
+    if(formatPropertyCount == 0)
+    {
+        utils::Log::Error("vkw", "Format %d not supported for sparse images", static_cast<int>(format));
+        return false;
+    }
+
+    device_ = &device;
+    imageType_ = imageType;
+    format_ = format;
+    extent_ = extent;
+    usage_ = usage;
+    mipLevels_ = mipLevels;
+    arrayLayers_ = arrayLayers;
+
+    VkImageCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = VK_IMAGE_CREATE_SPARSE_BINDING_BIT | VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT;
+    createInfo.imageType = imageType;
+    createInfo.format = format;
+    createInfo.extent = extent;
+    createInfo.mipLevels = mipLevels;
+    createInfo.arrayLayers = arrayLayers;
+    createInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    createInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    createInfo.usage = usage;
+    createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    createInfo.queueFamilyIndexCount = 0;
+    createInfo.pQueueFamilyIndices = nullptr;
+    createInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VKW_INIT_CHECK_VK(device_->vk().vkCreateImage(device_->getHandle(), &createInfo, nullptr, &image_));
+
+    VkMemoryRequirements memRequirements = {};
+    device_->vk().vkGetImageMemoryRequirements(device_->getHandle(), image_, &memRequirements);
+    pageSize_ = memRequirements.alignment;
+    memoryTypeBits_ = memRequirements.memoryTypeBits;
+
+    uint32_t requirementCount = 0;
+    device_->vk().vkGetImageSparseMemoryRequirements(
+        device_->getHandle(), image_, &requirementCount, nullptr);
+    std::vector<VkSparseImageMemoryRequirements> requirements(requirementCount);
+    device_->vk().vkGetImageSparseMemoryRequirements(
+        device_->getHandle(), image_, &requirementCount, requirements.data());
+
+    bool colorFound = false;
+    for(const auto& requirement : requirements)
+    {
+        const auto aspect = requirement.formatProperties.aspectMask;
+        if(aspect & VK_IMAGE_ASPECT_METADATA_BIT)
+        {
+            utils::Log::Error("vkw", "Sparse images requiring metadata are not supported");
+            this->clear();
+            return false;
+        }
+        if(aspect & VK_IMAGE_ASPECT_COLOR_BIT)
+        {
+            sparseRequirements_ = requirement;
+            colorFound = true;
+        }
+    }
+    if(!colorFound)
+    {
+        utils::Log::Error("vkw", "Sparse images only support color formats");
+        this->clear();
+        return false;
+    }
+
+    // Tiles of the levels above the mip tail, the last tile of a row may be partially used
+    const auto granularity = tileExtent();
+    const uint32_t tiledLevels = mipTailFirstLevel();
+    levelTileCounts_.resize(tiledLevels);
+    levelFirstPage_.resize(tiledLevels);
+    pagesPerLayer_ = 0;
+    for(uint32_t level = 0; level < tiledLevels; ++level)
+    {
+        const uint32_t w = std::max(extent_.width >> level, 1u);
+        const uint32_t h = std::max(extent_.height >> level, 1u);
+        const uint32_t d = std::max(extent_.depth >> level, 1u);
+        levelTileCounts_[level] = {
+            utils::divUp(w, granularity.width), utils::divUp(h, granularity.height),
+            utils::divUp(d, granularity.depth)};
+        levelFirstPage_[level] = pagesPerLayer_;
+
+        const auto& count = levelTileCounts_[level];
+        pagesPerLayer_ += count.width * count.height * count.depth;
+    }
+    pages_.resize(size_t(pagesPerLayer_) * arrayLayers_, VK_NULL_HANDLE);
+
+    if(tiledLevels < mipLevels_)
+    {
+        mipTailPages_.resize(singleMipTail() ? 1 : arrayLayers_, VK_NULL_HANDLE);
+    }
+
+    VKW_INIT_CHECK_BOOL(
+        setObjectName(*device_, VK_OBJECT_TYPE_IMAGE, reinterpret_cast<uint64_t>(image_), pName));
+
+    utils::Log::Verbose("vkw", "Sparse image %s", (pName != nullptr) ? pName : "");
+    utils::Log::Verbose("vkw", "  pageSize:      %zu", static_cast<size_t>(pageSize_));
+    utils::Log::Verbose(
+        "vkw", "  tileExtent:    %ux%ux%u", granularity.width, granularity.height, granularity.depth);
+    utils::Log::Verbose("vkw", "  mipTailFirst:  %u", tiledLevels);
+
+    initialized_ = true;
+
+    return true;
+}
+
+void SparseImage::clear()
+{
+    if(device_ != nullptr)
+    {
+        freePages(*device_, pages_);
+        freePages(*device_, mipTailPages_);
+    }
+    pages_.clear();
+    mipTailPages_.clear();
+
+    levelTileCounts_.clear();
+    levelFirstPage_.clear();
+    pagesPerLayer_ = 0;
+
+    VKW_DELETE_VK(Image, image_);
+
+    imageType_ = {};
+    format_ = {};
+    extent_ = {};
+    usage_ = {};
+    mipLevels_ = 0;
+    arrayLayers_ = 0;
+
+    pageSize_ = 0;
+    memoryTypeBits_ = 0;
+    sparseRequirements_ = {};
+
+    layoutTracker_.clear();
+
+    device_ = nullptr;
+    initialized_ = false;
+}
+
+bool SparseImage::enableLayoutTracking(const VkImageLayout currentLayout)
+{
+    VKW_ASSERT(this->initialized());
+    if(layoutTracker_.initialized())
+    {
+        layoutTracker_.reset(currentLayout);
+        return true;
+    }
+    return layoutTracker_.init(
+        mipLevels_, arrayLayers_, ImageLayoutTracker::getAspectMask(format_), currentLayout);
+}
+
+uint32_t SparseImage::residentPageCount() const
+{
+    if(!this->initialized()) { return 0; }
+
+    // A mip tail may span several pages
+    const auto mipTailPages
+        = static_cast<uint32_t>((sparseRequirements_.imageMipTailSize + pageSize_ - 1) / pageSize_);
+    return countResident(pages_) + mipTailPages * countResident(mipTailPages_);
+}
+} // namespace vkw
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/StagingRing.hpp"
+
+#include "vkw/detail/MemoryCommon.hpp"
+
+#include <algorithm>
+
+namespace vkw
+{
+StagingRing::StagingRing(
+    const Device& device, const TimelineSemaphore& timeline, const VkDeviceSize sizeBytes)
+{
+    VKW_CHECK_BOOL_FAIL(this->init(device, timeline, sizeBytes), "Initializing staging ring");
+}
+
+StagingRing::StagingRing(StagingRing&& rhs) { *this = std::move(rhs); }
+
+StagingRing& StagingRing::operator=(StagingRing&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+    std::swap(timeline_, rhs.timeline_);
+
+    std::swap(buffer_, rhs.buffer_);
+    std::swap(mappedData_, rhs.mappedData_);
+
+    std::swap(allocator_, rhs.allocator_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+StagingRing::~StagingRing() { this->clear(); }
+
+bool StagingRing::init(const Device& device, const TimelineSemaphore& timeline, const VkDeviceSize sizeBytes)
+{
+    VKW_ASSERT(this->initialized() == false);
+    VKW_ASSERT(timeline.initialized());
+
+    device_ = &device;
+    timeline_ = &timeline;
+
+    VKW_INIT_CHECK_BOOL(
+        buffer_.init(device, static_cast<size_t>(sizeBytes), VK_BUFFER_USAGE_TRANSFER_SRC_BIT));
+
+    VmaAllocationInfo allocInfo = {};
+    vmaGetAllocationInfo(device_->allocator(), buffer_.memory(), &allocInfo);
+    mappedData_ = reinterpret_cast<uint8_t*>(allocInfo.pMappedData);
+    if(mappedData_ == nullptr)
+    {
+        utils::Log::Error("vkw", "Staging ring memory is not mapped");
+        this->clear();
+        return false;
+    }
+
+    VKW_INIT_CHECK_BOOL(allocator_.init(timeline, sizeBytes, "Staging ring"));
+
+    initialized_ = true;
+
+    return true;
+}
+
+void StagingRing::clear()
+{
+    allocator_.clear();
+
+    mappedData_ = nullptr;
+    buffer_.clear();
+
+    timeline_ = nullptr;
+    device_ = nullptr;
+
+    initialized_ = false;
+}
+
+StagingRing::Allocation StagingRing::allocate(
+    const VkDeviceSize size, const VkDeviceSize alignment, const uint64_t timelineValue)
+{
+    VKW_ASSERT(this->initialized());
+
+    // Regions are reused as soon as their submission completed
+    const auto region = allocator_.allocate(size, alignment, timelineValue);
+    if(region.id == 0) { return {}; }
+
+    Allocation allocation = {};
+    allocation.offset = region.offset;
+    allocation.size = region.size;
+    allocation.timelineValue = region.timelineValue;
+    allocation.data = mappedData_ + region.offset;
+    return allocation;
+}
+
+bool StagingRing::flush(const Allocation& allocation) const
+{
+    VKW_CHECK_VK_RETURN_FALSE(
+        vmaFlushAllocation(device_->allocator(), buffer_.memory(), allocation.offset, allocation.size));
+    return true;
+}
+} // namespace vkw
@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/StreamingDispatcher.hpp"
+
+#include "vkw/detail/utils.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace vkw
+{
+StreamingDispatcher::StreamingDispatcher(
+    const Device& device, const Queue& transferQueue, const Queue& computeQueue,
+    const ComputePipeline& pipeline, const PipelineLayout& pipelineLayout, const size_t inputElementSize,
+    const size_t outputElementSize, const size_t tileElementCount, const uint32_t groupSize,
+    const uint32_t slotCount)
+{
+    VKW_CHECK_BOOL_FAIL(
+        this->init(
+            device, transferQueue, computeQueue, pipeline, pipelineLayout, inputElementSize,
+            outputElementSize, tileElementCount, groupSize, slotCount),
+        "Initializing streaming dispatcher");
+}
+
+StreamingDispatcher::StreamingDispatcher(StreamingDispatcher&& rhs) { *this = std::move(rhs); }
+
+StreamingDispatcher& StreamingDispatcher::operator=(StreamingDispatcher&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+    std::swap(transferQueue_, rhs.transferQueue_);
+    std::swap(computeQueue_, rhs.computeQueue_);
+    std::swap(pipeline_, rhs.pipeline_);
+    std::swap(pipelineLayout_, rhs.pipelineLayout_);
+
+    std::swap(inputElementSize_, rhs.inputElementSize_);
+    std::swap(outputElementSize_, rhs.outputElementSize_);
+    std::swap(tileElementCount_, rhs.tileElementCount_);
+    std::swap(groupSize_, rhs.groupSize_);
+
+    std::swap(transferPool_, rhs.transferPool_);
+    std::swap(computePool_, rhs.computePool_);
+    std::swap(slots_, rhs.slots_);
+
+    std::swap(uploadTimeline_, rhs.uploadTimeline_);
+    std::swap(computeTimeline_, rhs.computeTimeline_);
+    std::swap(readbackTimeline_, rhs.readbackTimeline_);
+    std::swap(baseValue_, rhs.baseValue_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+StreamingDispatcher::~StreamingDispatcher() { this->clear(); }
+
+bool StreamingDispatcher::init(
+    const Device& device, const Queue& transferQueue, const Queue& computeQueue,
+    const ComputePipeline& pipeline, const PipelineLayout& pipelineLayout, const size_t inputElementSize,
+    const size_t outputElementSize, const size_t tileElementCount, const uint32_t groupSize,
+    const uint32_t slotCount)
+{
+    VKW_ASSERT(this->initialized() == false);
+    VKW_ASSERT(inputElementSize > 0 && outputElementSize > 0);
+    VKW_ASSERT(tileElementCount > 0 && tileElementCount <= std::numeric_limits<uint32_t>::max());
+    VKW_ASSERT(groupSize > 0);
+    VKW_ASSERT(slotCount >= 2);
+
+    device_ = &device;
+    transferQueue_ = transferQueue;
+    computeQueue_ = computeQueue;
+    pipeline_ = &pipeline;
+    pipelineLayout_ = &pipelineLayout;
+
+    inputElementSize_ = inputElementSize;
+    outputElementSize_ = outputElementSize;
+    tileElementCount_ = tileElementCount;
+    groupSize_ = groupSize;
+
+    VKW_INIT_CHECK_BOOL(transferPool_.init(device, transferQueue));
+    VKW_INIT_CHECK_BOOL(computePool_.init(device, computeQueue));
+
+    // Device buffers are accessed by both queues, avoid ownership transfers when they belong to different
+    // families
+    const bool sameFamily = transferQueue.queueFamilyIndex() == computeQueue.queueFamilyIndex();
+    const VkSharingMode sharingMode = sameFamily ? VK_SHARING_MODE_EXCLUSIVE : VK_SHARING_MODE_CONCURRENT;
+    std::vector<uint32_t> queueFamilies{};
+    if(!sameFamily) { queueFamilies = {transferQueue.queueFamilyIndex(), computeQueue.queueFamilyIndex()}; }
+
+    const size_t inputTileSize = tileElementCount * inputElementSize;
+    const size_t outputTileSize = tileElementCount * outputElementSize;
+
+    slots_.resize(slotCount);
+    for(auto& slot : slots_)
+    {
+        VKW_INIT_CHECK_BOOL(slot.stagingIn.init(device, inputTileSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT));
+        VKW_INIT_CHECK_BOOL(slot.deviceIn.init(
+            device, inputTileSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, 0,
+            sharingMode, queueFamilies));
+        VKW_INIT_CHECK_BOOL(slot.deviceOut.init(
+            device, outputTileSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, 0,
+            sharingMode, queueFamilies));
+        VKW_INIT_CHECK_BOOL(slot.stagingOut.init(device, outputTileSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT));
+
+        slot.uploadCmd = transferPool_.createCommandBuffer();
+        slot.computeCmd = computePool_.createCommandBuffer();
+        slot.readbackCmd = transferPool_.createCommandBuffer();
+        VKW_INIT_CHECK_BOOL(
+            slot.uploadCmd.initialized() && slot.computeCmd.initialized() && slot.readbackCmd.initialized());
+    }
+
+    VKW_INIT_CHECK_BOOL(uploadTimeline_.init(device));
+    VKW_INIT_CHECK_BOOL(computeTimeline_.init(device));
+    VKW_INIT_CHECK_BOOL(readbackTimeline_.init(device));
+    baseValue_ = 0;
+
+    initialized_ = true;
+
+    return true;
+}
+
+void StreamingDispatcher::clear()
+{
+    readbackTimeline_.clear();
+    computeTimeline_.clear();
+    uploadTimeline_.clear();
+    baseValue_ = 0;
+
+    slots_.clear();
+    computePool_.clear();
+    transferPool_.clear();
+
+    inputElementSize_ = 0;
+    outputElementSize_ = 0;
+    tileElementCount_ = 0;
+    groupSize_ = defaultGroupSize;
+
+    pipelineLayout_ = nullptr;
+    pipeline_ = nullptr;
+    computeQueue_ = {};
+    transferQueue_ = {};
+    device_ = nullptr;
+
+    initialized_ = false;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool StreamingDispatcher::run(
+    const size_t elementCount, const SourceCallback& source, const OutputCallback& output)
+{
+    VKW_ASSERT(this->initialized());
+
+    const size_t tileCount = this->tileCount(elementCount);
+    const size_t slotCount = slots_.size();
+    const auto tileElements = [&](const size_t tileIndex) {
+        return std::min(tileElementCount_, elementCount - tileIndex * tileElementCount_);
+    };
+
+    // At step i, tile i is uploaded while tile i - 1 is processed and tile i - 2 is read back. Outputs are
+    // delivered lazily, right before the readback slot they occupy is reused.
+    bool success = true;
+    size_t delivered = 0;
+    for(size_t step = 0; step < tileCount + 2 && success; ++step)
+    {
+        if(step < tileCount) { success = success && upload(step, tileElements(step), source); }
+        if(step >= 1 && step - 1 < tileCount)
+        {
+            success = success && compute(step - 1, tileElements(step - 1));
+        }
+        if(step >= 2 && step - 2 < tileCount)
+        {
+            const size_t tileIndex = step - 2;
+            if(tileIndex >= slotCount)
+            {
+                success = success && deliver(delivered, tileElements(delivered), output);
+                delivered++;
+            }
+            success = success && readback(tileIndex, tileElements(tileIndex));
+        }
+    }
+    for(; delivered < tileCount && success; ++delivered)
+    {
+        success = deliver(delivered, tileElements(delivered), output);
+    }
+
+    // Each submission only waits for values signaled by earlier submissions, so the work submitted before an
+    // error still completes. The remaining values are then signaled from the host for the next run to start
+    // from the same base value on all the timelines.
+    const uint64_t lastValue = baseValue_ + tileCount;
+    if(!success)
+    {
+        utils::Log::Error("vkw", "Streaming dispatch aborted");
+        transferQueue_.waitIdle();
+        computeQueue_.waitIdle();
+        for(auto* timeline : {&uploadTimeline_, &computeTimeline_, &readbackTimeline_})
+        {
+            if(timeline->getValue() < lastValue) { timeline->signal(lastValue); }
+        }
+    }
+    baseValue_ = lastValue;
+
+    return success;
+}
+
+bool StreamingDispatcher::run(const void* data, const size_t elementCount, const OutputCallback& output)
+{
+    const auto* src = reinterpret_cast<const uint8_t*>(data);
+    return run(
+        elementCount,
+        [&](const size_t, const size_t firstElement, const size_t count, void* dst) {
+            utils::streamingCopy(dst, src + firstElement * inputElementSize_, count * inputElementSize_);
+            return true;
+        },
+        output);
+}
+
+bool StreamingDispatcher::run(const MappedFile& file, const OutputCallback& output)
+{
+    VKW_ASSERT(file.size() % inputElementSize_ == 0);
+    return run(file.data(), file.size() / inputElementSize_, output);
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool StreamingDispatcher::upload(
+    const size_t tileIndex, const size_t elementCount, const SourceCallback& source)
+{
+    auto& slot = slots_[tileIndex % slots_.size()];
+    const size_t slotCount = slots_.size();
+    const VkDeviceSize size = elementCount * inputElementSize_;
+
+    // The staging buffer and the command buffer of the slot are still used by the upload of tile i - n
+    if(tileIndex >= slotCount)
+    {
+        VKW_CHECK_BOOL_RETURN_FALSE(uploadTimeline_.wait(tileValue(tileIndex - slotCount)));
+    }
+
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        source(tileIndex, tileIndex * tileElementCount_, elementCount, slot.stagingIn.data()));
+    VKW_CHECK_VK_RETURN_FALSE(vmaFlushAllocation(device_->allocator(), slot.stagingIn.memory(), 0, size));
+
+    VkBufferCopy region = {};
+    region.srcOffset = 0;
+    region.dstOffset = 0;
+    region.size = size;
+
+    VKW_CHECK_BOOL_RETURN_FALSE(slot.uploadCmd.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT));
+    slot.uploadCmd.copyBuffer(slot.stagingIn, slot.deviceIn, std::span<VkBufferCopy>{&region, 1});
+    VKW_CHECK_BOOL_RETURN_FALSE(slot.uploadCmd.end());
+
+    // The device input buffer is read by the processing of tile i - n
+    std::vector<VkSemaphore> waitSemaphores{};
+    std::vector<VkPipelineStageFlags> waitFlags{};
+    std::vector<uint64_t> waitValues{};
+    if(tileIndex >= slotCount)
+    {
+        waitSemaphores.push_back(computeTimeline_.getHandle());
+        waitFlags.push_back(VK_PIPELINE_STAGE_TRANSFER_BIT);
+        waitValues.push_back(tileValue(tileIndex - slotCount));
+    }
+
+    VkSemaphore signalSemaphore = uploadTimeline_.getHandle();
+    uint64_t signalValue = tileValue(tileIndex);
+    VKW_CHECK_VK_RETURN_FALSE(transferQueue_.submit(
+        slot.uploadCmd.getHandle(), waitSemaphores, waitFlags, waitValues, {&signalSemaphore, 1},
+        {&signalValue, 1}));
+
+    return true;
+}
+
+bool StreamingDispatcher::compute(const size_t tileIndex, const size_t elementCount)
+{
+    auto& slot = slots_[tileIndex % slots_.size()];
+    const size_t slotCount = slots_.size();
+
+    if(tileIndex >= slotCount)
+    {
+        VKW_CHECK_BOOL_RETURN_FALSE(computeTimeline_.wait(tileValue(tileIndex - slotCount)));
+    }
+
+    TileConstants constants = {};
+    constants.firstElement = tileIndex * tileElementCount_;
+    constants.tileIndex = static_cast<uint32_t>(tileIndex);
+    constants.elementCount = static_cast<uint32_t>(elementCount);
+
+    VKW_CHECK_BOOL_RETURN_FALSE(slot.computeCmd.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT));
+    slot.computeCmd.bindComputePipeline(*pipeline_)
+        .pushComputeStorageBuffer(
+            *pipelineLayout_, 0, 0, slot.deviceIn.getHandle(), 0, elementCount * inputElementSize_)
+        .pushComputeStorageBuffer(
+            *pipelineLayout_, 0, 1, slot.deviceOut.getHandle(), 0, elementCount * outputElementSize_)
+        .pushConstants(*pipelineLayout_, constants, ShaderStage::Compute)
+        .dispatch(utils::divUp(constants.elementCount, groupSize_));
+    VKW_CHECK_BOOL_RETURN_FALSE(slot.computeCmd.end());
+
+    // Waits for the upload of the tile and, for the output buffer, for the readback of tile i - n
+    std::vector<VkSemaphore> waitSemaphores{uploadTimeline_.getHandle()};
+    std::vector<VkPipelineStageFlags> waitFlags{VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT};
+    std::vector<uint64_t> waitValues{tileValue(tileIndex)};
+    if(tileIndex >= slotCount)
+    {
+        waitSemaphores.push_back(readbackTimeline_.getHandle());
+        waitFlags.push_back(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+        waitValues.push_back(tileValue(tileIndex - slotCount));
+    }
+
+    VkSemaphore signalSemaphore = computeTimeline_.getHandle();
+    uint64_t signalValue = tileValue(tileIndex);
+    VKW_CHECK_VK_RETURN_FALSE(computeQueue_.submit(
+        slot.computeCmd.getHandle(), waitSemaphores, waitFlags, waitValues, {&signalSemaphore, 1},
+        {&signalValue, 1}));
+
+    return true;
+}
+
+bool StreamingDispatcher::readback(const size_t tileIndex, const size_t elementCount)
+{
+    auto& slot = slots_[tileIndex % slots_.size()];
+
+    // The slot of tile i - n has been delivered before, its readback is complete
+    VkBufferCopy region = {};
+    region.srcOffset = 0;
+    region.dstOffset = 0;
+    region.size = elementCount * outputElementSize_;
+
+    VKW_CHECK_BOOL_RETURN_FALSE(slot.readbackCmd.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT));
+    slot.readbackCmd.copyBuffer(slot.deviceOut, slot.stagingOut, std::span<VkBufferCopy>{&region, 1});
+    VKW_CHECK_BOOL_RETURN_FALSE(slot.readbackCmd.end());
+
+    VkSemaphore waitSemaphore = computeTimeline_.getHandle();
+    VkPipelineStageFlags waitFlags = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    uint64_t waitValue = tileValue(tileIndex);
+    VkSemaphore signalSemaphore = readbackTimeline_.getHandle();
+    uint64_t signalValue = tileValue(tileIndex);
+    VKW_CHECK_VK_RETURN_FALSE(transferQueue_.submit(
+        slot.readbackCmd.getHandle(), {&waitSemaphore, 1}, {&waitFlags, 1}, {&waitValue, 1},
+        {&signalSemaphore, 1}, {&signalValue, 1}));
+
+    return true;
+}
+
+bool StreamingDispatcher::deliver(
+    const size_t tileIndex, const size_t elementCount, const OutputCallback& output)
+{
+    auto& slot = slots_[tileIndex % slots_.size()];
+    const VkDeviceSize size = elementCount * outputElementSize_;
+
+    VKW_CHECK_BOOL_RETURN_FALSE(readbackTimeline_.wait(tileValue(tileIndex)));
+    VKW_CHECK_VK_RETURN_FALSE(
+        vmaInvalidateAllocation(device_->allocator(), slot.stagingOut.memory(), 0, size));
+
+    output(tileIndex, tileIndex * tileElementCount_, elementCount, slot.stagingOut.data());
+
+    return true;
+}
+} // namespace vkw
@@ -0,0 +1,697 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/TextureLoader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace vkw
+{
+namespace
+{
+// -----------------------------------------------------------------------------------------------------------
+// ----------------------------------------- KTX2 ------------------------------------------------------------
+// -----------------------------------------------------------------------------------------------------------
+
+constexpr uint8_t ktx2Identifier[12]
+    = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+struct Ktx2Header
+{
+    uint8_t identifier[12];
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t layerCount;
+    uint32_t faceCount;
+    uint32_t levelCount;
+    uint32_t supercompressionScheme;
+    uint32_t dfdByteOffset;
+    uint32_t dfdByteLength;
+    uint32_t kvdByteOffset;
+    uint32_t kvdByteLength;
+    uint64_t sgdByteOffset;
+    uint64_t sgdByteLength;
+};
+static_assert(sizeof(Ktx2Header) == 80);
+
+struct Ktx2LevelIndex
+{
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+
+// -----------------------------------------------------------------------------------------------------------
+// ----------------------------------------- DDS -------------------------------------------------------------
+// -----------------------------------------------------------------------------------------------------------
+
+constexpr uint32_t makeFourCC(const char a, const char b, const char c, const char d)
+{
+    return uint32_t(uint8_t(a)) | (uint32_t(uint8_t(b)) << 8) | (uint32_t(uint8_t(c)) << 16)
+           | (uint32_t(uint8_t(d)) << 24);
+}
+
+constexpr uint32_t ddsMagic = makeFourCC('D', 'D', 'S', ' ');
+
+constexpr uint32_t ddsPixelFormatFourCC = 0x4;
+constexpr uint32_t ddsPixelFormatRgb = 0x40;
+constexpr uint32_t ddsPixelFormatLuminance = 0x20000;
+constexpr uint32_t ddsCaps2Cubemap = 0x200;
+constexpr uint32_t ddsCaps2Volume = 0x200000;
+constexpr uint32_t ddsDimensionTexture1D = 2;
+constexpr uint32_t ddsDimensionTexture3D = 4;
+constexpr uint32_t ddsMiscTextureCube = 0x4;
+
+struct DdsPixelFormat
+{
+    uint32_t size;
+    uint32_t flags;
+    uint32_t fourCC;
+    uint32_t rgbBitCount;
+    uint32_t rBitMask;
+    uint32_t gBitMask;
+    uint32_t bBitMask;
+    uint32_t aBitMask;
+};
+
+struct DdsHeader
+{
+    uint32_t size;
+    uint32_t flags;
+    uint32_t height;
+    uint32_t width;
+    uint32_t pitchOrLinearSize;
+    uint32_t depth;
+    uint32_t mipMapCount;
+    uint32_t reserved1[11];
+    DdsPixelFormat pixelFormat;
+    uint32_t caps;
+    uint32_t caps2;
+    uint32_t caps3;
+    uint32_t caps4;
+    uint32_t reserved2;
+};
+static_assert(sizeof(DdsHeader) == 124);
+
+struct DdsHeaderDx10
+{
+    uint32_t dxgiFormat;
+    uint32_t resourceDimension;
+    uint32_t miscFlag;
+    uint32_t arraySize;
+    uint32_t miscFlags2;
+};
+
+VkFormat getDxgiFormat(const uint32_t dxgiFormat)
+{
+    switch(dxgiFormat)
+    {
+        case 2:
+            return VK_FORMAT_R32G32B32A32_SFLOAT;
+        case 10:
+            return VK_FORMAT_R16G16B16A16_SFLOAT;
+        case 24:
+            return VK_FORMAT_A2B10G10R10_UNORM_PACK32;
+        case 26:
+            return VK_FORMAT_B10G11R11_UFLOAT_PACK32;
+        case 28:
+            return VK_FORMAT_R8G8B8A8_UNORM;
+        case 29:
+            return VK_FORMAT_R8G8B8A8_SRGB;
+        case 34:
+            return VK_FORMAT_R16G16_SFLOAT;
+        case 41:
+            return VK_FORMAT_R32_SFLOAT;
+        case 49:
+            return VK_FORMAT_R8G8_UNORM;
+        case 54:
+            return VK_FORMAT_R16_SFLOAT;
+        case 61:
+            return VK_FORMAT_R8_UNORM;
+        case 67:
+            return VK_FORMAT_E5B9G9R9_UFLOAT_PACK32;
+        case 71:
+            return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+        case 72:
+            return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+        case 74:
+            return VK_FORMAT_BC2_UNORM_BLOCK;
+        case 75:
+            return VK_FORMAT_BC2_SRGB_BLOCK;
+        case 77:
+            return VK_FORMAT_BC3_UNORM_BLOCK;
+        case 78:
+            return VK_FORMAT_BC3_SRGB_BLOCK;
+        case 80:
+            return VK_FORMAT_BC4_UNORM_BLOCK;
+        case 81:
+            return VK_FORMAT_BC4_SNORM_BLOCK;
+        case 83:
+            return VK_FORMAT_BC5_UNORM_BLOCK;
+        case 84:
+            return VK_FORMAT_BC5_SNORM_BLOCK;
+        case 87:
+            return VK_FORMAT_B8G8R8A8_UNORM;
+        case 91:
+            return VK_FORMAT_B8G8R8A8_SRGB;
+        case 95:
+            return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+        case 96:
+            return VK_FORMAT_BC6H_SFLOAT_BLOCK;
+        case 98:
+            return VK_FORMAT_BC7_UNORM_BLOCK;
+        case 99:
+            return VK_FORMAT_BC7_SRGB_BLOCK;
+        default:
+            return VK_FORMAT_UNDEFINED;
+    }
+}
+
+VkFormat getLegacyDdsFormat(const DdsPixelFormat& pixelFormat)
+{
+    if(pixelFormat.flags & ddsPixelFormatFourCC)
+    {
+        switch(pixelFormat.fourCC)
+        {
+            case makeFourCC('D', 'X', 'T', '1'):
+                return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+            case makeFourCC('D', 'X', 'T', '2'):
+            case makeFourCC('D', 'X', 'T', '3'):
+                return VK_FORMAT_BC2_UNORM_BLOCK;
+            case makeFourCC('D', 'X', 'T', '4'):
+            case makeFourCC('D', 'X', 'T', '5'):
+                return VK_FORMAT_BC3_UNORM_BLOCK;
+            case makeFourCC('A', 'T', 'I', '1'):
+            case makeFourCC('B', 'C', '4', 'U'):
+                return VK_FORMAT_BC4_UNORM_BLOCK;
+            case makeFourCC('B', 'C', '4', 'S'):
+                return VK_FORMAT_BC4_SNORM_BLOCK;
+            case makeFourCC('A', 'T', 'I', '2'):
+            case makeFourCC('B', 'C', '5', 'U'):
+                return VK_FORMAT_BC5_UNORM_BLOCK;
+            case makeFourCC('B', 'C', '5', 'S'):
+                return VK_FORMAT_BC5_SNORM_BLOCK;
+            // D3DFORMAT values stored in the fourCC field
+            case 111:
+                return VK_FORMAT_R16_SFLOAT;
+            case 113:
+                return VK_FORMAT_R16G16B16A16_SFLOAT;
+            case 114:
+                return VK_FORMAT_R32_SFLOAT;
+            case 116:
+                return VK_FORMAT_R32G32B32A32_SFLOAT;
+            default:
+                return VK_FORMAT_UNDEFINED;
+        }
+    }
+
+    if((pixelFormat.flags & ddsPixelFormatRgb) && pixelFormat.rgbBitCount == 32)
+    {
+        if(pixelFormat.rBitMask == 0x000000ff && pixelFormat.bBitMask == 0x00ff0000)
+        {
+            return VK_FORMAT_R8G8B8A8_UNORM;
+        }
+        if(pixelFormat.rBitMask == 0x00ff0000 && pixelFormat.bBitMask == 0x000000ff)
+        {
+            return VK_FORMAT_B8G8R8A8_UNORM;
+        }
+    }
+
+    if((pixelFormat.flags & ddsPixelFormatLuminance) && pixelFormat.rgbBitCount == 8)
+    {
+        return VK_FORMAT_R8_UNORM;
+    }
+
+    return VK_FORMAT_UNDEFINED;
+}
+
+VkImageMemoryBarrier2 levelsBarrier(
+    const BaseImage& image, const VkPipelineStageFlags2 srcStages, const VkAccessFlags2 srcMask,
+    const VkPipelineStageFlags2 dstStages, const VkAccessFlags2 dstMask, const VkImageLayout oldLayout,
+    const VkImageLayout newLayout, const uint32_t baseLevel, const uint32_t levelCount)
+{
+    VkImageMemoryBarrier2 barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barrier.pNext = nullptr;
+    barrier.srcStageMask = srcStages;
+    barrier.srcAccessMask = srcMask;
+    barrier.dstStageMask = dstStages;
+    barrier.dstAccessMask = dstMask;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image.getHandle();
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = baseLevel;
+    barrier.subresourceRange.levelCount = levelCount;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+    return barrier;
+}
+} // namespace
+
+TextureLoader::TextureLoader(const Device& device, StagingRing& stagingRing)
+{
+    VKW_CHECK_BOOL_FAIL(this->init(device, stagingRing), "Initializing texture loader");
+}
+
+TextureLoader& TextureLoader::operator=(TextureLoader&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+    std::swap(stagingRing_, rhs.stagingRing_);
+
+    std::swap(file_, rhs.file_);
+    std::swap(info_, rhs.info_);
+    std::swap(blockInfo_, rhs.blockInfo_);
+    std::swap(subresources_, rhs.subresources_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+bool TextureLoader::init(const Device& device, StagingRing& stagingRing)
+{
+    VKW_ASSERT(this->initialized() == false);
+    VKW_ASSERT(stagingRing.initialized());
+
+    device_ = &device;
+    stagingRing_ = &stagingRing;
+
+    initialized_ = true;
+
+    return true;
+}
+
+void TextureLoader::clear()
+{
+    this->close();
+
+    stagingRing_ = nullptr;
+    device_ = nullptr;
+
+    initialized_ = false;
+}
+
+bool TextureLoader::open(const std::string& filename)
+{
+    VKW_ASSERT(this->initialized());
+
+    this->close();
+    VKW_CHECK_BOOL_RETURN_FALSE(file_.init(filename));
+
+    bool parsed = false;
+    if(file_.size() >= sizeof(Ktx2Header)
+       && memcmp(file_.data(), ktx2Identifier, sizeof(ktx2Identifier)) == 0)
+    {
+        info_.fileType = FileType::Ktx2;
+        parsed = parseKtx2();
+    }
+    else if(file_.size() >= sizeof(uint32_t) + sizeof(DdsHeader) && *file_.as<uint32_t>() == ddsMagic)
+    {
+        info_.fileType = FileType::Dds;
+        parsed = parseDds();
+    }
+    else
+    {
+        utils::Log::Error("vkw", "%s: unknown texture file type", filename.c_str());
+    }
+
+    if(!parsed)
+    {
+        utils::Log::Error("vkw", "Error loading texture %s", filename.c_str());
+        this->close();
+        return false;
+    }
+
+    utils::Log::Verbose("vkw", "Texture %s", filename.c_str());
+    utils::Log::Verbose(
+        "vkw", "  extent: %ux%ux%u", info_.extent.width, info_.extent.height, info_.extent.depth);
+    utils::Log::Verbose("vkw", "  levels: %u, layers: %u", info_.mipLevels, info_.arrayLayers);
+
+    return true;
+}
+
+void TextureLoader::close()
+{
+    subresources_.clear();
+    blockInfo_ = {};
+    info_ = {};
+    file_.clear();
+}
+
+VkDeviceSize TextureLoader::payloadSize(const uint32_t baseLevel, const uint32_t levelCount) const
+{
+    VKW_ASSERT(this->isOpen());
+
+    const uint32_t levelEnd
+        = (levelCount == VK_REMAINING_MIP_LEVELS) ? info_.mipLevels : baseLevel + levelCount;
+    const VkDeviceSize alignment = payloadAlignment();
+
+    VkDeviceSize size = 0;
+    for(const auto& subresource : subresources_)
+    {
+        if(subresource.level < baseLevel || subresource.level >= levelEnd) { continue; }
+        size = utils::alignedSize(size, alignment) + subresource.sizeBytes;
+    }
+    return size;
+}
+
+std::vector<VkBufferImageCopy> TextureLoader::copyRegions(
+    const uint32_t baseLevel, const uint32_t levelCount, const VkDeviceSize bufferOffset) const
+{
+    VKW_ASSERT(this->isOpen());
+
+    const uint32_t levelEnd
+        = (levelCount == VK_REMAINING_MIP_LEVELS) ? info_.mipLevels : baseLevel + levelCount;
+    const VkDeviceSize alignment = payloadAlignment();
+
+    std::vector<VkBufferImageCopy> regions{};
+    VkDeviceSize offset = 0;
+    for(const auto& subresource : subresources_)
+    {
+        if(subresource.level < baseLevel || subresource.level >= levelEnd) { continue; }
+
+        offset = utils::alignedSize(offset, alignment);
+
+        VkBufferImageCopy region = {};
+        region.bufferOffset = bufferOffset + offset;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = subresource.level;
+        region.imageSubresource.baseArrayLayer = subresource.baseLayer;
+        region.imageSubresource.layerCount = subresource.layerCount;
+        region.imageOffset = {0, 0, 0};
+        region.imageExtent = levelExtent(subresource.level);
+        regions.push_back(region);
+
+        offset += subresource.sizeBytes;
+    }
+    return regions;
+}
+
+bool TextureLoader::upload(
+    const CommandBuffer& cmdBuffer, BaseImage& image, const uint64_t signalValue, const uint32_t baseLevel,
+    const uint32_t levelCount, const VkImageLayout finalLayout)
+{
+    VKW_ASSERT(this->isOpen());
+
+    const uint32_t count = (levelCount == VK_REMAINING_MIP_LEVELS) ? info_.mipLevels - baseLevel : levelCount;
+    if(baseLevel + count > info_.mipLevels || baseLevel + count > image.mipLevels())
+    {
+        utils::Log::Error("vkw", "Texture upload: level range out of bounds");
+        return false;
+    }
+    if(image.format() != info_.format || image.arrayLayers() < info_.arrayLayers)
+    {
+        utils::Log::Error("vkw", "Texture upload: image does not match the texture");
+        return false;
+    }
+
+    const auto allocation
+        = stagingRing_->allocate(payloadSize(baseLevel, count), payloadAlignment(), signalValue);
+    if(!allocation.valid()) { return false; }
+
+    // Same packing as copyRegions()
+    const VkDeviceSize alignment = payloadAlignment();
+    VkDeviceSize offset = 0;
+    for(const auto& subresource : subresources_)
+    {
+        if(subresource.level < baseLevel || subresource.level >= baseLevel + count) { continue; }
+
+        offset = utils::alignedSize(offset, alignment);
+        utils::streamingCopy(
+            allocation.data + offset, file_.data() + subresource.fileOffset,
+            static_cast<size_t>(subresource.sizeBytes));
+        offset += subresource.sizeBytes;
+    }
+    VKW_CHECK_BOOL_RETURN_FALSE(stagingRing_->flush(allocation));
+
+    auto regions = copyRegions(baseLevel, count, allocation.offset);
+
+    // The previous content of the uploaded levels is discarded
+    cmdBuffer.imageMemoryBarrier(levelsBarrier(
+        image, VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, VK_PIPELINE_STAGE_2_COPY_BIT,
+        VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        baseLevel, count));
+
+    cmdBuffer.copyBufferToImage(
+        stagingRing_->buffer(), image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, regions);
+
+    cmdBuffer.imageMemoryBarrier(levelsBarrier(
+        image, VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+        VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, finalLayout, baseLevel, count));
+
+    auto* tracker = image.layoutTracker();
+    if(tracker != nullptr) { tracker->reset(finalLayout, baseLevel, count); }
+
+    return true;
+}
+
+TextureLoader::BlockInfo TextureLoader::getBlockInfo(const VkFormat format)
+{
+    switch(format)
+    {
+        case VK_FORMAT_R8_UNORM:
+        case VK_FORMAT_R8_SRGB:
+            return {1, 1, 1};
+        case VK_FORMAT_R8G8_UNORM:
+        case VK_FORMAT_R16_SFLOAT:
+            return {1, 1, 2};
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+        case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+        case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+        case VK_FORMAT_E5B9G9R9_UFLOAT_PACK32:
+        case VK_FORMAT_R16G16_SFLOAT:
+        case VK_FORMAT_R32_SFLOAT:
+            return {1, 1, 4};
+        case VK_FORMAT_R16G16B16A16_SFLOAT:
+        case VK_FORMAT_R32G32_SFLOAT:
+            return {1, 1, 8};
+        case VK_FORMAT_R32G32B32A32_SFLOAT:
+            return {1, 1, 16};
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+        case VK_FORMAT_BC4_UNORM_BLOCK:
+        case VK_FORMAT_BC4_SNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
+            return {4, 4, 8};
+        case VK_FORMAT_BC2_UNORM_BLOCK:
+        case VK_FORMAT_BC2_SRGB_BLOCK:
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+        case VK_FORMAT_BC5_SNORM_BLOCK:
+        case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+        case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+        case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+        case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:
+            return {4, 4, 16};
+        case VK_FORMAT_ASTC_6x6_UNORM_BLOCK:
+        case VK_FORMAT_ASTC_6x6_SRGB_BLOCK:
+            return {6, 6, 16};
+        case VK_FORMAT_ASTC_8x8_UNORM_BLOCK:
+        case VK_FORMAT_ASTC_8x8_SRGB_BLOCK:
+            return {8, 8, 16};
+        default:
+            return {1, 1, 0};
+    }
+}
+
+bool TextureLoader::parseKtx2()
+{
+    Ktx2Header header = {};
+    memcpy(&header, file_.data(), sizeof(Ktx2Header));
+
+    if(header.supercompressionScheme != 0)
+    {
+        utils::Log::Error("vkw", "Supercompressed KTX2 files are not supported");
+        return false;
+    }
+
+    info_.format = static_cast<VkFormat>(header.vkFormat);
+    blockInfo_ = getBlockInfo(info_.format);
+    if(blockInfo_.sizeBytes == 0)
+    {
+        utils::Log::Error("vkw", "Unsupported KTX2 format %u", header.vkFormat);
+        return false;
+    }
+
+    info_.cubemap = (header.faceCount == 6);
+    info_.extent.width = header.pixelWidth;
+    info_.extent.height = std::max(header.pixelHeight, 1u);
+    info_.extent.depth = std::max(header.pixelDepth, 1u);
+    info_.imageType = (header.pixelDepth > 0)    ? VK_IMAGE_TYPE_3D
+                      : (header.pixelHeight > 0) ? VK_IMAGE_TYPE_2D
+                                                 : VK_IMAGE_TYPE_1D;
+    info_.mipLevels = std::max(header.levelCount, 1u);
+    info_.arrayLayers = std::max(header.layerCount, 1u) * std::max(header.faceCount, 1u);
+
+    const size_t levelIndexEnd = sizeof(Ktx2Header) + info_.mipLevels * sizeof(Ktx2LevelIndex);
+    VKW_CHECK_BOOL_RETURN_FALSE(file_.size() >= levelIndexEnd);
+
+    // Images of a level are tightly packed, layer by layer then face by face
+    for(uint32_t level = 0; level < info_.mipLevels; ++level)
+    {
+        Ktx2LevelIndex levelIndex = {};
+        memcpy(
+            &levelIndex, file_.data() + sizeof(Ktx2Header) + level * sizeof(Ktx2LevelIndex),
+            sizeof(Ktx2LevelIndex));
+
+        const VkDeviceSize sizeBytes = levelLayerSize(level) * info_.arrayLayers;
+        if(levelIndex.byteLength < sizeBytes || levelIndex.byteOffset + sizeBytes > file_.size())
+        {
+            utils::Log::Error("vkw", "KTX2 level %u out of bounds", level);
+            return false;
+        }
+
+        Subresource subresource = {};
+        subresource.level = level;
+        subresource.baseLayer = 0;
+        subresource.layerCount = info_.arrayLayers;
+        subresource.fileOffset = levelIndex.byteOffset;
+        subresource.sizeBytes = sizeBytes;
+        subresources_.push_back(subresource);
+    }
+
+    return true;
+}
+
+bool TextureLoader::parseDds()
+{
+    DdsHeader header = {};
+    memcpy(&header, file_.data() + sizeof(uint32_t), sizeof(DdsHeader));
+    size_t dataOffset = sizeof(uint32_t) + sizeof(DdsHeader);
+
+    uint32_t layerCount = 1;
+    bool volume = (header.caps2 & ddsCaps2Volume) != 0;
+    bool texture1D = false;
+    if((header.pixelFormat.flags & ddsPixelFormatFourCC)
+       && header.pixelFormat.fourCC == makeFourCC('D', 'X', '1', '0'))
+    {
+        VKW_CHECK_BOOL_RETURN_FALSE(file_.size() >= dataOffset + sizeof(DdsHeaderDx10));
+
+        DdsHeaderDx10 headerDx10 = {};
+        memcpy(&headerDx10, file_.data() + dataOffset, sizeof(DdsHeaderDx10));
+        dataOffset += sizeof(DdsHeaderDx10);
+
+        info_.format = getDxgiFormat(headerDx10.dxgiFormat);
+        info_.cubemap = (headerDx10.miscFlag & ddsMiscTextureCube) != 0;
+        layerCount = std::max(headerDx10.arraySize, 1u);
+        volume = (headerDx10.resourceDimension == ddsDimensionTexture3D);
+        texture1D = (headerDx10.resourceDimension == ddsDimensionTexture1D);
+    }
+    else
+    {
+        info_.format = getLegacyDdsFormat(header.pixelFormat);
+        info_.cubemap = (header.caps2 & ddsCaps2Cubemap) != 0;
+    }
+
+    blockInfo_ = getBlockInfo(info_.format);
+    if(blockInfo_.sizeBytes == 0)
+    {
+        utils::Log::Error("vkw", "Unsupported DDS format");
+        return false;
+    }
+
+    info_.extent.width = header.width;
+    info_.extent.height = texture1D ? 1 : std::max(header.height, 1u);
+    info_.extent.depth = volume ? std::max(header.depth, 1u) : 1;
+    info_.imageType = volume ? VK_IMAGE_TYPE_3D : (texture1D ? VK_IMAGE_TYPE_1D : VK_IMAGE_TYPE_2D);
+    info_.mipLevels = std::max(header.mipMapCount, 1u);
+    info_.arrayLayers = layerCount * (info_.cubemap ? 6 : 1);
+
+    // Each layer (or face) stores its full mip chain
+    VkDeviceSize fileOffset = dataOffset;
+    for(uint32_t layer = 0; layer < info_.arrayLayers; ++layer)
+    {
+        for(uint32_t level = 0; level < info_.mipLevels; ++level)
+        {
+            Subresource subresource = {};
+            subresource.level = level;
+            subresource.baseLayer = layer;
+            subresource.layerCount = 1;
+            subresource.fileOffset = fileOffset;
+            subresource.sizeBytes = levelLayerSize(level);
+            subresources_.push_back(subresource);
+
+            fileOffset += subresource.sizeBytes;
+        }
+    }
+
+    if(fileOffset > file_.size())
+    {
+        utils::Log::Error("vkw", "DDS file is truncated");
+        return false;
+    }
+
+    // Level major order, so the regions of a level are contiguous in the staging memory
+    std::stable_sort(subresources_.begin(), subresources_.end(), [](const auto& a, const auto& b) {
+        return a.level < b.level;
+    });
+
+    return true;
+}
+
+VkExtent3D TextureLoader::levelExtent(const uint32_t level) const
+{
+    return {
+        std::max(info_.extent.width >> level, 1u), std::max(info_.extent.height >> level, 1u),
+        std::max(info_.extent.depth >> level, 1u)};
+}
+
+VkDeviceSize TextureLoader::levelLayerSize(const uint32_t level) const
+{
+    const auto extent = levelExtent(level);
+    const VkDeviceSize blocksX = utils::divUp(extent.width, blockInfo_.width);
+    const VkDeviceSize blocksY = utils::divUp(extent.height, blockInfo_.height);
+    return blocksX * blocksY * VkDeviceSize(extent.depth) * VkDeviceSize(blockInfo_.sizeBytes);
+}
+
+VkDeviceSize TextureLoader::payloadAlignment() const
+{
+    // Buffer offsets must be multiples of both the texel block size and 4
+    return std::lcm(VkDeviceSize(blockInfo_.sizeBytes), VkDeviceSize(4));
+}
+} // namespace vkw
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace vkw
+{
+namespace utils
+{
+    ThreadPool::ThreadPool(const size_t threadCount)
+    {
+        VKW_CHECK_BOOL_FAIL(this->init(threadCount), "Initializing thread pool");
+    }
+
+    ThreadPool::~ThreadPool() { this->clear(); }
+
+    bool ThreadPool::init(const size_t threadCount)
+    {
+        VKW_ASSERT(this->initialized() == false);
+
+        const size_t hardwareThreads = std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+        const size_t count = (threadCount == 0) ? hardwareThreads : threadCount;
+
+        stop_ = false;
+        workers_.reserve(count);
+        for(size_t i = 0; i < count; ++i)
+        {
+            workers_.emplace_back([this]() { workerLoop(); });
+        }
+
+        initialized_ = true;
+
+        return true;
+    }
+
+    void ThreadPool::clear()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+
+        for(auto& worker : workers_)
+        {
+            if(worker.joinable()) { worker.join(); }
+        }
+        workers_.clear();
+        tasks_.clear();
+
+        stop_ = false;
+        initialized_ = false;
+    }
+
+    void ThreadPool::parallelFor(const size_t n, const std::function<void(const size_t)>& fn)
+    {
+        VKW_ASSERT(this->initialized());
+
+        if(n == 0) { return; }
+        if(n == 1)
+        {
+            fn(0);
+            return;
+        }
+
+        // The calling thread handles the first item to avoid idling while the workers run
+        std::vector<std::future<void>> futures;
+        futures.reserve(n - 1);
+        for(size_t i = 1; i < n; ++i)
+        {
+            futures.emplace_back(submit([&fn, i]() { fn(i); }));
+        }
+        fn(0);
+
+        for(auto& future : futures)
+        {
+            future.wait();
+        }
+    }
+
+    ThreadPool& ThreadPool::instance()
+    {
+        static ThreadPool pool{0};
+        return pool;
+    }
+
+    void ThreadPool::workerLoop()
+    {
+        while(true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+                if(stop_ && tasks_.empty()) { return; }
+
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+} // namespace utils
+} // namespace vkw
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vkw/detail/TlasInstanceGenerator.hpp"
+
+#include "vkw/detail/CommandBuffer.hpp"
+
+namespace vkw
+{
+namespace
+{
+const uint32_t tlasInstanceGenerationSpv[] = {
+#include "spv/TlasInstanceGeneration.comp.spv"
+};
+
+constexpr uint32_t groupSize = 256;
+} // namespace
+
+TlasInstanceGenerator::TlasInstanceGenerator(const Device& device)
+{
+    VKW_CHECK_BOOL_FAIL(this->init(device), "Initializing TLAS instance generator");
+}
+
+TlasInstanceGenerator& TlasInstanceGenerator::operator=(TlasInstanceGenerator&& rhs)
+{
+    this->clear();
+
+    std::swap(device_, rhs.device_);
+
+    std::swap(descriptorSetLayout_, rhs.descriptorSetLayout_);
+    std::swap(pipelineLayout_, rhs.pipelineLayout_);
+    std::swap(pipeline_, rhs.pipeline_);
+
+    std::swap(initialized_, rhs.initialized_);
+
+    return *this;
+}
+
+bool TlasInstanceGenerator::init(const Device& device)
+{
+    VKW_ASSERT(this->initialized() == false);
+
+    device_ = &device;
+
+    VKW_INIT_CHECK_BOOL(descriptorSetLayout_.init(device));
+    descriptorSetLayout_.addBinding<DescriptorType::StorageBuffer>(VK_SHADER_STAGE_COMPUTE_BIT, 0)
+        .addBinding<DescriptorType::StorageBuffer>(VK_SHADER_STAGE_COMPUTE_BIT, 1)
+        .addBinding<DescriptorType::StorageBuffer>(VK_SHADER_STAGE_COMPUTE_BIT, 2)
+        .addBinding<DescriptorType::StorageBuffer>(VK_SHADER_STAGE_COMPUTE_BIT, 3);
+    VKW_INIT_CHECK_BOOL(descriptorSetLayout_.create(VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR));
+
+    VKW_INIT_CHECK_BOOL(pipelineLayout_.init(device, descriptorSetLayout_));
+    pipelineLayout_.reservePushConstants<PushConstants>(ShaderStage::Compute);
+    VKW_INIT_CHECK_BOOL(pipelineLayout_.create());
+
+    VKW_INIT_CHECK_BOOL(pipeline_.init(
+        device, reinterpret_cast<const char*>(tlasInstanceGenerationSpv), sizeof(tlasInstanceGenerationSpv)));
+    VKW_INIT_CHECK_BOOL(pipeline_.createPipeline(pipelineLayout_));
+
+    initialized_ = true;
+
+    return true;
+}
+
+void TlasInstanceGenerator::clear()
+{
+    pipeline_.clear();
+    pipelineLayout_.clear();
+    descriptorSetLayout_.clear();
+
+    device_ = nullptr;
+    initialized_ = false;
+}
+
+bool TlasInstanceGenerator::recordGeneration(
+    const CommandBuffer& cmdBuffer, const BaseBuffer& transforms, const BaseBuffer& descriptors,
+    const BaseBuffer& blasAddresses, const BaseBuffer& instances, const uint32_t instanceCount,
+    const uint32_t blasCount) const
+{
+    VKW_ASSERT(this->initialized());
+    VKW_ASSERT(transforms.sizeBytes() >= size_t(instanceCount) * sizeof(VkTransformMatrixKHR));
+    VKW_ASSERT(descriptors.sizeBytes() >= size_t(instanceCount) * sizeof(InstanceDescriptor));
+    VKW_ASSERT(blasAddresses.sizeBytes() >= size_t(blasCount) * sizeof(VkDeviceAddress));
+    VKW_ASSERT(
+        instances.sizeBytes() >= size_t(instanceCount) * sizeof(VkAccelerationStructureInstanceKHR));
+
+    if(instanceCount == 0) { return true; }
+
+    const auto grid = utils::linearDispatchGrid(
+        utils::divUp(instanceCount, groupSize), device_->getProperties().limits.maxComputeWorkGroupCount[0]);
+
+    PushConstants params = {};
+    params.instanceCount = instanceCount;
+    params.blasCount = blasCount;
+    params.rowInvocations = grid.width * groupSize;
+
+    cmdBuffer.bindComputePipeline(pipeline_)
+        .pushComputeStorageBuffer(pipelineLayout_, 0, 0, transforms.getHandle(), 0, VK_WHOLE_SIZE)
+        .pushComputeStorageBuffer(pipelineLayout_, 0, 1, descriptors.getHandle(), 0, VK_WHOLE_SIZE)
+        .pushComputeStorageBuffer(pipelineLayout_, 0, 2, blasAddresses.getHandle(), 0, VK_WHOLE_SIZE)
+        .pushComputeStorageBuffer(pipelineLayout_, 0, 3, instances.getHandle(), 0, VK_WHOLE_SIZE)
+        .pushConstants(pipelineLayout_, params, ShaderStage::Compute)
+        .dispatch(grid.width, grid.height)
+        .buildInputBarrier(instances, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+
+    return true;
+}
+} // namespace vkw
@@ -22,6 +22,8 @@
 
 #include "vkw/detail/TopLevelAS.hpp"
 
+#include <algorithm>
+
 namespace vkw
 {
 TopLevelAccelerationStructure::TopLevelAccelerationStructure(const Device& device, const bool buildOnHost)
@@ -43,7 +45,19 @@ TopLevelAccelerationStructure& TopLevelAccelerationStructure::operator=(TopLevel
 
     std::swap(geometry_, rhs.geometry_);
     std::swap(instancesBuffer_, rhs.instancesBuffer_);
+    std::swap(instancesStagingBuffer_, rhs.instancesStagingBuffer_);
     std::swap(instancesList_, rhs.instancesList_);
+    std::swap(instanceCapacity_, rhs.instanceCapacity_);
+
+    std::swap(dirtyInstances_, rhs.dirtyInstances_);
+    std::swap(dirtyCount_, rhs.dirtyCount_);
+
+    std::swap(externalInstances_, rhs.externalInstances_);
+    std::swap(externalInstanceCount_, rhs.externalInstanceCount_);
+
+    std::swap(deferredOperation_, rhs.deferredOperation_);
+
+    std::swap(initialized_, rhs.initialized_);
 
     return *this;
 }
@@ -62,92 +76,91 @@ bool TopLevelAccelerationStructure::init(const Device& device, const bool buildO
 
 void TopLevelAccelerationStructure::create(const VkBuildAccelerationStructureFlagBitsKHR buildFlags)
 {
-    // Build geometry list
-    VkAccelerationStructureGeometryDataKHR geometryData = {};
-    geometryData.instances.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR;
-    geometryData.instances.pNext = nullptr;
-    geometryData.instances.arrayOfPointers = VK_FALSE;
+    VkDeviceOrHostAddressConstKHR instanceData = {};
+    instanceCapacity_ = std::max({instanceCapacity_, static_cast<uint32_t>(instancesList_.size()), 1u});
     if(buildOnHost_)
     {
-        geometryData.instances.data.hostAddress = reinterpret_cast<void*>(instancesList_.data());
+        // Host builds read the instance list directly, the storage must not move when instances are added
+        // after creation. The address is refreshed before each build anyway.
+        instancesList_.reserve(instanceCapacity_);
+        instanceData.hostAddress = reinterpret_cast<const void*>(instancesList_.data());
     }
     else
     {
-        instancesBuffer_.init(
-            *device_, instancesList_.size(),
-            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
-                | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR);
-        instancesBuffer_.copyFromHost(instancesList_.data(), instancesList_.size());
-
-        geometryData.instances.data.deviceAddress = instancesBuffer_.deviceAddress();
+        // Instances are uploaded by CommandBuffer::uploadInstances(), the buffers are kept for the whole
+        // lifetime of the structure
+        VKW_CHECK_BOOL_FAIL(
+            instancesBuffer_.init(
+                *device_, instanceCapacity_,
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+                    | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+                    | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR),
+            "Error initializing TLAS instance buffer");
+        VKW_CHECK_BOOL_FAIL(
+            instancesStagingBuffer_.init(*device_, instanceCapacity_, VK_BUFFER_USAGE_TRANSFER_SRC_BIT),
+            "Error initializing TLAS instance staging buffer");
+        markAllDirty();
+
+        instanceData.deviceAddress = instancesBuffer_.deviceAddress();
     }
 
-    geometry_.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
-    geometry_.pNext = nullptr;
-    geometry_.flags = 0;
-    geometry_.geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR;
-    geometry_.geometry = geometryData;
-
-    const uint32_t primitiveCount = static_cast<uint32_t>(instancesList_.size());
+    createStructure(instanceData, instanceCapacity_, buildFlags);
+}
 
-    buildSizes_.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR;
-    buildSizes_.pNext = nullptr;
+void TopLevelAccelerationStructure::create(
+    const BaseBuffer& instanceBuffer, const uint32_t maxInstanceCount,
+    const VkBuildAccelerationStructureFlagBitsKHR buildFlags)
+{
+    VKW_ASSERT(this->buildOnHost_ == false);
+    VKW_ASSERT(instancesList_.empty());
+    VKW_ASSERT(instanceBuffer.sizeBytes() >= maxInstanceCount * sizeof(VkAccelerationStructureInstanceKHR));
 
-    VkAccelerationStructureBuildGeometryInfoKHR buildInfo = {};
-    buildInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
-    buildInfo.pNext = nullptr;
-    buildInfo.type = type();
-    buildInfo.flags = buildFlags;
-    buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
-    buildInfo.srcAccelerationStructure = VK_NULL_HANDLE;
-    buildInfo.dstAccelerationStructure = VK_NULL_HANDLE;
-    buildInfo.geometryCount = 1;
-    buildInfo.pGeometries = &geometry_;
-    buildInfo.ppGeometries = nullptr;
-    buildInfo.scratchData = {};
-    device_->vk().vkGetAccelerationStructureBuildSizesKHR(
-        device_->getHandle(),
-        buildOnHost_ ? VK_ACCELERATION_STRUCTURE_BUILD_TYPE_HOST_KHR
-                     : VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR,
-        &buildInfo, &primitiveCount, &buildSizes_);
+    externalInstances_ = true;
+    instanceCapacity_ = maxInstanceCount;
+    externalInstanceCount_ = maxInstanceCount;
 
-    VKW_CHECK_BOOL_FAIL(
-        storageBuffer_.init(
-            *device_, buildSizes_.accelerationStructureSize,
-            VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR
-                | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT),
-        "Error initializing TLAS storage buffer");
-
-    VkAccelerationStructureCreateInfoKHR createInfo = {};
-    createInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
-    createInfo.pNext = nullptr;
-    createInfo.createFlags = 0; // Other flags are not supported for now
-    createInfo.buffer = storageBuffer_.getHandle();
-    createInfo.size = buildSizes_.accelerationStructureSize;
-    createInfo.type = type();
-    createInfo.deviceAddress = 0;
-    VKW_CHECK_VK_FAIL(
-        device_->vk().vkCreateAccelerationStructureKHR(
-            device_->getHandle(), &createInfo, nullptr, &accelerationStructure_),
-        "Error creating TLAS");
+    VkDeviceOrHostAddressConstKHR instanceData = {};
+    instanceData.deviceAddress = instanceBuffer.deviceAddress();
+    createStructure(instanceData, maxInstanceCount, buildFlags);
 }
 
 void TopLevelAccelerationStructure::clear()
 {
+    // Waits for a pending deferred build
+    deferredOperation_.clear();
+
     initialized_ = false;
 
     geometry_ = {};
     instancesBuffer_.clear();
+    instancesStagingBuffer_.clear();
     instancesList_.clear();
+    instanceCapacity_ = 0;
+
+    dirtyInstances_.clear();
+    dirtyCount_ = 0;
+
+    externalInstances_ = false;
+    externalInstanceCount_ = 0;
 
     BaseAccelerationStructure::clear();
 }
 
+TopLevelAccelerationStructure& TopLevelAccelerationStructure::reserveInstances(const uint32_t instanceCount)
+{
+    VKW_ASSERT(accelerationStructure_ == VK_NULL_HANDLE);
+    instanceCapacity_ = std::max(instanceCapacity_, instanceCount);
+    instancesList_.reserve(instanceCapacity_);
+    dirtyInstances_.reserve(instanceCapacity_);
+    return *this;
+}
+
 TopLevelAccelerationStructure& TopLevelAccelerationStructure::addInstance(
     const BottomLevelAccelerationStructure& geometry, const uint32_t instanceIndex,
     const VkTransformMatrixKHR& transform, const VkGeometryInstanceFlagsKHR flags, const uint32_t mask,
     const uint32_t hitBindingIndex)
 {
+    VKW_ASSERT(externalInstances_ == false);
     VKW_CHECK_BOOL_FAIL(
         this->buildOnHost() == geometry.buildOnHost(),
         "Error all structures must be build at the same place: device or host");
@@ -161,75 +174,244 @@ TopLevelAccelerationStructure& TopLevelAccelerationStructure::addInstance(
     geometryInstance.accelerationStructureReference
         = geometry.buildOnHost() ? reinterpret_cast<uint64_t>(geometry.getHandle())
                                  : static_cast<uint64_t>(geometry.getDeviceAddress());
+
+    if(accelerationStructure_ != VK_NULL_HANDLE && instancesList_.size() >= instanceCapacity_)
+    {
+        utils::Log::Error("vkw", "TLAS instance capacity (%u) exceeded, instance ignored", instanceCapacity_);
+        return *this;
+    }
     instancesList_.push_back(geometryInstance);
+    dirtyInstances_.push_back(true);
+    ++dirtyCount_;
+
+    return *this;
+}
+
+TopLevelAccelerationStructure& TopLevelAccelerationStructure::setInstanceCount(const uint32_t instanceCount)
+{
+    VKW_ASSERT(externalInstances_);
+    VKW_ASSERT(instanceCount <= instanceCapacity_);
+    externalInstanceCount_ = instanceCount;
+    return *this;
+}
+
+TopLevelAccelerationStructure& TopLevelAccelerationStructure::setInstance(
+    const uint32_t index, const VkAccelerationStructureInstanceKHR& instance)
+{
+    VKW_ASSERT(index < instancesList_.size());
+    instancesList_[index] = instance;
+    return markDirty(index);
+}
 
+TopLevelAccelerationStructure& TopLevelAccelerationStructure::setTransform(
+    const uint32_t index, const VkTransformMatrixKHR& transform)
+{
+    VKW_ASSERT(index < instancesList_.size());
+    instancesList_[index].transform = transform;
+    return markDirty(index);
+}
+
+TopLevelAccelerationStructure& TopLevelAccelerationStructure::markDirty(
+    const uint32_t firstIndex, const uint32_t count)
+{
+    VKW_ASSERT(firstIndex + count <= instancesList_.size());
+    for(uint32_t i = firstIndex; i < firstIndex + count; ++i)
+    {
+        if(!dirtyInstances_[i])
+        {
+            dirtyInstances_[i] = true;
+            ++dirtyCount_;
+        }
+    }
     return *this;
 }
 
+TopLevelAccelerationStructure& TopLevelAccelerationStructure::markAllDirty()
+{
+    dirtyInstances_.assign(instancesList_.size(), true);
+    dirtyCount_ = static_cast<uint32_t>(instancesList_.size());
+    return *this;
+}
+
+std::vector<VkBufferCopy> TopLevelAccelerationStructure::stageDirtyInstances()
+{
+    static constexpr VkDeviceSize instanceSize = sizeof(VkAccelerationStructureInstanceKHR);
+
+    std::vector<VkBufferCopy> regions = {};
+    if(dirtyCount_ == 0) { return regions; }
+
+    const size_t instanceCount = instancesList_.size();
+    size_t i = 0;
+    while(i < instanceCount)
+    {
+        if(!dirtyInstances_[i])
+        {
+            ++i;
+            continue;
+        }
+
+        const size_t first = i;
+        while(i < instanceCount && dirtyInstances_[i])
+        {
+            dirtyInstances_[i++] = false;
+        }
+
+        instancesStagingBuffer_.copyFromHost(instancesList_.data() + first, first, i - first);
+
+        VkBufferCopy region = {};
+        region.srcOffset = first * instanceSize;
+        region.dstOffset = first * instanceSize;
+        region.size = (i - first) * instanceSize;
+        regions.push_back(region);
+    }
+    dirtyCount_ = 0;
+
+    return regions;
+}
+
 bool TopLevelAccelerationStructure::build(
-    void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags, const bool /*deferred*/)
+    void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags, const bool deferred)
+{
+    auto* pool = deferred ? &utils::ThreadPool::instance() : nullptr;
+    VKW_CHECK_VK_RETURN_FALSE(this->hostBuild(scratchData, buildFlags, false, pool).get());
+    return true;
+}
+
+bool TopLevelAccelerationStructure::update(
+    void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags, const bool deferred)
+{
+    auto* pool = deferred ? &utils::ThreadPool::instance() : nullptr;
+    VKW_CHECK_VK_RETURN_FALSE(this->hostBuild(scratchData, buildFlags, true, pool).get());
+    return true;
+}
+
+std::shared_future<VkResult> TopLevelAccelerationStructure::buildDeferred(
+    void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags, utils::ThreadPool& pool)
+{
+    return this->hostBuild(scratchData, buildFlags, false, &pool);
+}
+
+std::shared_future<VkResult> TopLevelAccelerationStructure::updateDeferred(
+    void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags, utils::ThreadPool& pool)
+{
+    return this->hostBuild(scratchData, buildFlags, true, &pool);
+}
+
+bool TopLevelAccelerationStructure::update(
+    const std::vector<VkTransformMatrixKHR>& transforms, void* scratchData,
+    const VkBuildAccelerationStructureFlagsKHR buildFlags, const bool deferred)
 {
     VKW_ASSERT(this->buildOnHost_);
+    VKW_ASSERT(transforms.size() >= instancesList_.size());
 
-    VkAccelerationStructureBuildRangeInfoKHR buildRange = {};
-    buildRange.primitiveCount = static_cast<uint32_t>(instancesList_.size());
+    for(size_t i = 0; i < instancesList_.size(); ++i)
+    {
+        instancesList_[i].transform = transforms[i];
+    }
+    return this->update(scratchData, buildFlags, deferred);
+}
+
+// -----------------------------------------------------------------------------------------------------------
 
-    const VkAccelerationStructureBuildRangeInfoKHR* pBuildRanges = &buildRange;
+void TopLevelAccelerationStructure::createStructure(
+    const VkDeviceOrHostAddressConstKHR& instanceData, const uint32_t maxInstanceCount,
+    const VkBuildAccelerationStructureFlagBitsKHR buildFlags)
+{
+    // Build geometry list
+    VkAccelerationStructureGeometryDataKHR geometryData = {};
+    geometryData.instances.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR;
+    geometryData.instances.pNext = nullptr;
+    geometryData.instances.arrayOfPointers = VK_FALSE;
+    geometryData.instances.data = instanceData;
+
+    geometry_.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
+    geometry_.pNext = nullptr;
+    geometry_.flags = 0;
+    geometry_.geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR;
+    geometry_.geometry = geometryData;
+
+    buildSizes_.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR;
+    buildSizes_.pNext = nullptr;
 
     VkAccelerationStructureBuildGeometryInfoKHR buildInfo = {};
     buildInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
     buildInfo.pNext = nullptr;
-    buildInfo.flags = buildFlags;
     buildInfo.type = type();
+    buildInfo.flags = buildFlags;
+    buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
     buildInfo.srcAccelerationStructure = VK_NULL_HANDLE;
-    buildInfo.dstAccelerationStructure = accelerationStructure_;
+    buildInfo.dstAccelerationStructure = VK_NULL_HANDLE;
     buildInfo.geometryCount = 1;
     buildInfo.pGeometries = &geometry_;
     buildInfo.ppGeometries = nullptr;
-    buildInfo.scratchData.hostAddress = scratchData;
-    VKW_CHECK_VK_RETURN_FALSE(device_->vk().vkBuildAccelerationStructuresKHR(
-        device_->getHandle(), VK_NULL_HANDLE, 1, &buildInfo, &pBuildRanges));
-    return true;
+    buildInfo.scratchData = {};
+    device_->vk().vkGetAccelerationStructureBuildSizesKHR(
+        device_->getHandle(),
+        buildOnHost_ ? VK_ACCELERATION_STRUCTURE_BUILD_TYPE_HOST_KHR
+                     : VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR,
+        &buildInfo, &maxInstanceCount, &buildSizes_);
+
+    VKW_CHECK_BOOL_FAIL(this->createStorage(buildSizes_.accelerationStructureSize), "Error creating TLAS");
 }
 
-bool TopLevelAccelerationStructure::update(
-    void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags, const bool /*deferred*/)
+std::shared_future<VkResult> TopLevelAccelerationStructure::hostBuild(
+    void* scratchData, const VkBuildAccelerationStructureFlagsKHR buildFlags, const bool update,
+    utils::ThreadPool* pool)
 {
     VKW_ASSERT(this->buildOnHost_);
 
-    VkAccelerationStructureBuildRangeInfoKHR buildRange = {};
-    buildRange.primitiveCount = static_cast<uint32_t>(instancesList_.size());
+    // Parameters of deferred builds must stay valid until the operation completes
+    struct HostBuildArgs
+    {
+        VkAccelerationStructureBuildGeometryInfoKHR buildInfo;
+        VkAccelerationStructureBuildRangeInfoKHR buildRange;
+        const VkAccelerationStructureBuildRangeInfoKHR* pBuildRanges;
+    };
+    auto args = std::make_shared<HostBuildArgs>();
 
-    const VkAccelerationStructureBuildRangeInfoKHR* pBuildRanges = &buildRange;
+    // A deferred build still running writes to the structure and owns the deferred operation
+    deferredOperation_.wait();
 
-    VkAccelerationStructureBuildGeometryInfoKHR buildInfo = {};
+    // The instance list may have been reallocated since the last build
+    geometry_.geometry.instances.data.hostAddress = reinterpret_cast<const void*>(instancesList_.data());
+
+    args->buildRange = {};
+    args->buildRange.primitiveCount = static_cast<uint32_t>(instancesList_.size());
+    args->pBuildRanges = &args->buildRange;
+
+    auto& buildInfo = args->buildInfo;
+    buildInfo = {};
     buildInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
     buildInfo.pNext = nullptr;
     buildInfo.flags = buildFlags;
     buildInfo.type = type();
-    buildInfo.srcAccelerationStructure = accelerationStructure_;
+    buildInfo.mode = update ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR
+                            : VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+    buildInfo.srcAccelerationStructure = update ? accelerationStructure_ : VK_NULL_HANDLE;
     buildInfo.dstAccelerationStructure = accelerationStructure_;
     buildInfo.geometryCount = 1;
     buildInfo.pGeometries = &geometry_;
     buildInfo.ppGeometries = nullptr;
     buildInfo.scratchData.hostAddress = scratchData;
-    VKW_CHECK_VK_RETURN_FALSE(device_->vk().vkBuildAccelerationStructuresKHR(
-        device_->getHandle(), VK_NULL_HANDLE, 1, &buildInfo, &pBuildRanges));
-
-    return true;
-}
-
-bool TopLevelAccelerationStructure::update(
-    const std::vector<VkTransformMatrixKHR>& transforms, void* scratchData,
-    const VkBuildAccelerationStructureFlagsKHR buildFlags, const bool deferred)
-{
-    VKW_ASSERT(this->buildOnHost_);
-    VKW_ASSERT(transforms.size() >= instancesList_.size());
 
-    for(size_t i = 0; i < instancesList_.size(); ++i)
+    VkDeferredOperationKHR deferredOperation = VK_NULL_HANDLE;
+    if(pool != nullptr)
     {
-        instancesList_[i].transform = transforms[i];
+        if(!deferredOperation_.initialized() && !deferredOperation_.init(*device_))
+        {
+            return DeferredHostOperation::readyResult(VK_ERROR_INITIALIZATION_FAILED);
+        }
+        deferredOperation = deferredOperation_.getHandle();
     }
-    return this->update(scratchData, buildFlags, deferred);
+
+    const VkResult res = device_->vk().vkBuildAccelerationStructuresKHR(
+        device_->getHandle(), deferredOperation, 1, &args->buildInfo, &args->pBuildRanges);
+
+    // The structure reads the instances directly from host memory, nothing to upload
+    dirtyInstances_.assign(instancesList_.size(), false);
+    dirtyCount_ = 0;
+
+    if(pool == nullptr) { return DeferredHostOperation::readyResult(res); }
+    return deferredOperation_.join(res, *pool, std::move(args));
 }
 } // namespace vkw
@@ -22,10 +22,17 @@
 
 #include "vkw/detail/utils.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <string>
 #include <volk.h>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#    include <emmintrin.h>
+#    define VKW_HAS_SSE2
+#endif
+
 namespace vkw
 {
 namespace utils
@@ -128,5 +135,106 @@ namespace utils
 
         return index;
     }
+
+    void streamingCopy(void* dst, const void* src, const size_t sizeBytes)
+    {
+#ifdef VKW_HAS_SSE2
+        static constexpr size_t blockSize = 4 * sizeof(__m128i);
+
+        auto* dstPtr = reinterpret_cast<uint8_t*>(dst);
+        const auto* srcPtr = reinterpret_cast<const uint8_t*>(src);
+
+        // Non-temporal stores require 16 bytes aligned destinations
+        const size_t headSize
+            = std::min(sizeBytes, (sizeof(__m128i) - (reinterpret_cast<uintptr_t>(dstPtr) & 0xf)) & 0xf);
+        memcpy(dstPtr, srcPtr, headSize);
+        dstPtr += headSize;
+        srcPtr += headSize;
+
+        const size_t blockCount = (sizeBytes - headSize) / blockSize;
+        for(size_t i = 0; i < blockCount; ++i)
+        {
+            const auto* s = reinterpret_cast<const __m128i*>(srcPtr);
+            auto* d = reinterpret_cast<__m128i*>(dstPtr);
+
+            const __m128i v0 = _mm_loadu_si128(s + 0);
+            const __m128i v1 = _mm_loadu_si128(s + 1);
+            const __m128i v2 = _mm_loadu_si128(s + 2);
+            const __m128i v3 = _mm_loadu_si128(s + 3);
+            _mm_stream_si128(d + 0, v0);
+            _mm_stream_si128(d + 1, v1);
+            _mm_stream_si128(d + 2, v2);
+            _mm_stream_si128(d + 3, v3);
+
+            dstPtr += blockSize;
+            srcPtr += blockSize;
+        }
+
+        memcpy(dstPtr, srcPtr, sizeBytes - headSize - blockCount * blockSize);
+
+        // Make the streaming stores globally visible before the memory is used
+        _mm_sfence();
+#else
+        memcpy(dst, src, sizeBytes);
+#endif
+    }
+
+    CopyRegionStats optimizeCopyRegions(std::vector<VkBufferCopy>& regions, const VkDeviceSize maxRegionSize)
+    {
+        CopyRegionStats stats = {};
+        stats.inputCount = regions.size();
+
+        std::sort(regions.begin(), regions.end(), [](const VkBufferCopy& a, const VkBufferCopy& b) {
+            return (a.dstOffset < b.dstOffset) || (a.dstOffset == b.dstOffset && a.srcOffset < b.srcOffset);
+        });
+
+        std::vector<VkBufferCopy> ret;
+        ret.reserve(regions.size());
+        for(const auto& region : regions)
+        {
+            if(region.size == 0) { continue; }
+
+            if(!ret.empty())
+            {
+                // Same delta between source and destination offsets: the merged region copies contiguous
+                // data, and overlapping parts are written with the same values.
+                auto& last = ret.back();
+                const bool sameDelta
+                    = (region.srcOffset >= last.srcOffset)
+                      && (region.srcOffset - last.srcOffset == region.dstOffset - last.dstOffset);
+                if(sameDelta && region.dstOffset <= last.dstOffset + last.size)
+                {
+                    last.size = std::max(last.size, region.dstOffset + region.size - last.dstOffset);
+                    stats.mergedCount++;
+                    continue;
+                }
+            }
+            ret.push_back(region);
+        }
+
+        if(maxRegionSize > 0)
+        {
+            std::vector<VkBufferCopy> split;
+            split.reserve(ret.size());
+            for(const auto& region : ret)
+            {
+                for(VkDeviceSize offset = 0; offset < region.size; offset += maxRegionSize)
+                {
+                    VkBufferCopy part = {};
+                    part.srcOffset = region.srcOffset + offset;
+                    part.dstOffset = region.dstOffset + offset;
+                    part.size = std::min(maxRegionSize, region.size - offset);
+                    split.push_back(part);
+                }
+            }
+            stats.splitCount = split.size() - ret.size();
+            ret = std::move(split);
+        }
+
+        regions = std::move(ret);
+        stats.outputCount = regions.size();
+
+        return stats;
+    }
 } // namespace utils
 } // namespace vkw
@@ -22,9 +22,149 @@
 
 #pragma once
 
+#include <cstring>
+#include <functional>
+#include <vector>
 #include <vkw/vkw.hpp>
 
-bool changeImageLayout(
+inline bool extensionsAvailable(
+    const VkPhysicalDevice physicalDevice, const std::vector<const char*>& requiredExtensions)
+{
+    uint32_t extensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+    std::vector<VkExtensionProperties> extensions{extensionCount};
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, extensions.data());
+
+    for(const auto* extensionName : requiredExtensions)
+    {
+        bool found = false;
+        for(const auto& extension : extensions)
+        {
+            if(strcmp(extension.extensionName, extensionName) == 0) { found = true; }
+        }
+        if(!found) { return false; }
+    }
+    return true;
+}
+
+inline const std::vector<const char*>& accelerationStructureExtensions()
+{
+    static const std::vector<const char*> extensions
+        = {VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME, VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME};
+    return extensions;
+}
+
+inline bool accelerationStructuresAvailable(const VkPhysicalDevice physicalDevice)
+{
+    if(!extensionsAvailable(physicalDevice, accelerationStructureExtensions())) { return false; }
+
+    VkPhysicalDeviceBufferDeviceAddressFeatures bufferDeviceAddressFeatures = {};
+    bufferDeviceAddressFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
+    bufferDeviceAddressFeatures.pNext = nullptr;
+
+    VkPhysicalDeviceAccelerationStructureFeaturesKHR accelerationStructureFeatures = {};
+    accelerationStructureFeatures.sType
+        = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR;
+    accelerationStructureFeatures.pNext = &bufferDeviceAddressFeatures;
+
+    VkPhysicalDeviceFeatures2 availablePhysicalDeviceFeatures = {};
+    availablePhysicalDeviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    availablePhysicalDeviceFeatures.pNext = &accelerationStructureFeatures;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &availablePhysicalDeviceFeatures);
+
+    return (accelerationStructureFeatures.accelerationStructure == VK_TRUE)
+           && (bufferDeviceAddressFeatures.bufferDeviceAddress == VK_TRUE);
+}
+
+/// Device with acceleration structures and buffer device addresses enabled, they must be available.
+/// additionalFeatures is chained to the enabled features.
+inline bool initAccelerationStructureDevice(
+    vkw::Device& device, const vkw::Instance& instance, const VkPhysicalDevice physicalDevice,
+    const std::vector<const char*>& additionalExtensions = {}, void* additionalFeatures = nullptr)
+{
+    auto extensions = accelerationStructureExtensions();
+    extensions.insert(extensions.end(), additionalExtensions.begin(), additionalExtensions.end());
+
+    VkPhysicalDeviceBufferDeviceAddressFeatures bufferDeviceAddressFeatures = {};
+    bufferDeviceAddressFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
+    bufferDeviceAddressFeatures.pNext = additionalFeatures;
+    bufferDeviceAddressFeatures.bufferDeviceAddress = VK_TRUE;
+
+    VkPhysicalDeviceAccelerationStructureFeaturesKHR accelerationStructureFeatures = {};
+    accelerationStructureFeatures.sType
+        = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR;
+    accelerationStructureFeatures.pNext = &bufferDeviceAddressFeatures;
+    accelerationStructureFeatures.accelerationStructure = VK_TRUE;
+
+    return device.init(instance, physicalDevice, extensions, {}, &accelerationStructureFeatures);
+}
+
+inline const std::vector<const char*>& rayTracingPipelineExtensions()
+{
+    static const std::vector<const char*> extensions
+        = {VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME, VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME};
+    return extensions;
+}
+
+inline bool rayTracingPipelineAvailable(const VkPhysicalDevice physicalDevice)
+{
+    if(!accelerationStructuresAvailable(physicalDevice)) { return false; }
+    if(!extensionsAvailable(physicalDevice, rayTracingPipelineExtensions())) { return false; }
+
+    VkPhysicalDeviceRayTracingPipelineFeaturesKHR rayTracingPipelineFeatures = {};
+    rayTracingPipelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_FEATURES_KHR;
+    rayTracingPipelineFeatures.pNext = nullptr;
+
+    VkPhysicalDeviceFeatures2 availablePhysicalDeviceFeatures = {};
+    availablePhysicalDeviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    availablePhysicalDeviceFeatures.pNext = &rayTracingPipelineFeatures;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &availablePhysicalDeviceFeatures);
+
+    return rayTracingPipelineFeatures.rayTracingPipeline == VK_TRUE;
+}
+
+/// Device with ray tracing pipelines, pipeline libraries and acceleration structures enabled, they must be
+/// available.
+inline bool initRayTracingDevice(
+    vkw::Device& device, const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    VkPhysicalDeviceRayTracingPipelineFeaturesKHR rayTracingPipelineFeatures = {};
+    rayTracingPipelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_FEATURES_KHR;
+    rayTracingPipelineFeatures.pNext = nullptr;
+    rayTracingPipelineFeatures.rayTracingPipeline = VK_TRUE;
+
+    return initAccelerationStructureDevice(
+        device, instance, physicalDevice, rayTracingPipelineExtensions(), &rayTracingPipelineFeatures);
+}
+
+/// Records commands on a queue supporting the given usage, submits them and waits for completion.
+inline bool runCommands(
+    const vkw::Device& device, const vkw::QueueUsageFlags queueUsage,
+    const std::function<bool(const vkw::CommandBuffer&)>& recordFn)
+{
+    auto queue = device.getQueues(queueUsage)[0];
+
+    vkw::CommandPool cmdPool{device, queue};
+    VKW_CHECK_BOOL_RETURN_FALSE(cmdPool.initialized());
+
+    auto cmdBuffer = cmdPool.createCommandBuffer();
+    VKW_CHECK_BOOL_RETURN_FALSE(cmdBuffer.initialized());
+
+    cmdBuffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    const bool recorded = recordFn(cmdBuffer);
+    cmdBuffer.end();
+    VKW_CHECK_BOOL_RETURN_FALSE(recorded);
+
+    vkw::Fence fence{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(fence.initialized());
+
+    VKW_CHECK_VK_RETURN_FALSE(queue.submit(cmdBuffer, fence));
+    VKW_CHECK_BOOL_RETURN_FALSE(fence.wait());
+
+    return true;
+}
+
+inline bool changeImageLayout(
     const vkw::Device& device, const vkw::BaseImage& image, const VkImageLayout srcLayout,
     const VkImageLayout dstLayout)
 {
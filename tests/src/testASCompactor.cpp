@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "ASCompactorTest";
+
+static const float quadPositions[] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+static const uint32_t quadIndices[] = {0, 1, 2, 0, 2, 3};
+
+static bool testCompaction(const vkw::Device& device, const uint32_t quadCount);
+
+static bool testCompactedRefit(const vkw::Device& device);
+
+static bool testMismatch(const vkw::Device& device);
+
+static bool testEmptyList(const vkw::Device& device);
+
+// Batches quadCount quads in structures of at most 8 quads
+static bool createStructures(
+    vkw::BlasBatcher& batcher, const uint32_t quadCount,
+    const VkBuildAccelerationStructureFlagsKHR buildFlags);
+
+// Builds all the structures of the batcher and queries their compacted sizes
+static bool buildStructures(
+    const vkw::Device& device, vkw::BlasBatcher& batcher, vkw::AccelerationStructureCompactor& compactor,
+    const VkBuildAccelerationStructureFlagsKHR buildFlags);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchASCompactorTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    if(!accelerationStructuresAvailable(physicalDevice))
+    {
+        vkw::utils::Log::Info(testName, "Acceleration structures not available, skipping");
+        return true;
+    }
+
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(initAccelerationStructureDevice(device, instance, physicalDevice));
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    vkw::utils::Log::Info(testName, "Checking compaction...");
+    for(const uint32_t quadCount : {1, 8, 100})
+    {
+        if(!testCompaction(device, quadCount))
+        {
+            vkw::utils::Log::Warning(testName, "  Compaction of %u quads - FAILED", quadCount);
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    vkw::utils::Log::Info(testName, "Checking compacted structure refit...");
+    if(!testCompactedRefit(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Compacted refit - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking structure mismatch...");
+    if(!testMismatch(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Mismatch - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking empty list...");
+    if(!testEmptyList(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Empty list - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testCompaction(const vkw::Device& device, const uint32_t quadCount)
+{
+    const auto buildFlags = VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;
+
+    vkw::BlasBatcher batcher{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(createStructures(batcher, quadCount, buildFlags));
+
+    auto blasList = batcher.blasList();
+
+    vkw::AccelerationStructureCompactor compactor{};
+    VKW_CHECK_BOOL_RETURN_FALSE(compactor.init(device, static_cast<uint32_t>(blasList.size())));
+    VKW_CHECK_BOOL_RETURN_FALSE(buildStructures(device, batcher, compactor, buildFlags));
+
+    std::vector<VkDeviceSize> buildSizes{};
+    std::vector<VkDeviceSize> storageSizes{};
+    std::vector<VkDeviceAddress> addresses{};
+    VkDeviceSize originalBytes = 0;
+    for(const auto& blas : blasList)
+    {
+        if(blas.get().compacted()) { return false; }
+        buildSizes.push_back(blas.get().accelerationStructureSize());
+        storageSizes.push_back(blas.get().storageBuffer().sizeBytes());
+        addresses.push_back(blas.get().getDeviceAddress());
+        originalBytes += storageSizes.back();
+    }
+
+    vkw::DeferredDeletionQueue deletionQueue{};
+    bool compacted = false;
+    const auto compactFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        compacted = compactor.recordCompaction(cmdBuffer, blasList, deletionQueue, 1);
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, compactFn));
+    if(!compacted) { return false; }
+
+    if(compactor.originalBytes() != originalBytes) { return false; }
+    if(compactor.compactedBytes() == 0 || compactor.compactedBytes() > originalBytes) { return false; }
+
+    // Compacted structures are moved to a smaller storage, the others are left as they were
+    size_t compactedCount = 0;
+    VkDeviceSize compactedBytes = 0;
+    for(size_t i = 0; i < blasList.size(); ++i)
+    {
+        const auto& blas = blasList[i].get();
+        if(blas.accelerationStructureSize() != buildSizes[i]) { return false; }
+        if(blas.compacted())
+        {
+            if(blas.compactedSize() >= storageSizes[i]) { return false; }
+            if(blas.storageBuffer().sizeBytes() != blas.compactedSize()) { return false; }
+            if(blas.getDeviceAddress() == addresses[i]) { return false; }
+            compactedCount++;
+        }
+        else
+        {
+            if(blas.storageBuffer().sizeBytes() != storageSizes[i]) { return false; }
+            if(blas.getDeviceAddress() != addresses[i]) { return false; }
+        }
+        compactedBytes += blas.storageBuffer().sizeBytes();
+    }
+    if(compactedBytes != compactor.compactedBytes()) { return false; }
+
+    // The original storage is kept until the copy completed
+    if(deletionQueue.pendingCount() != compactedCount) { return false; }
+    deletionQueue.collect(1);
+
+    return deletionQueue.pendingCount() == 0;
+}
+
+bool testCompactedRefit(const vkw::Device& device)
+{
+    const auto buildFlags = VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR
+                            | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR;
+
+    vkw::BlasBatcher batcher{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(createStructures(batcher, 32, buildFlags));
+
+    auto blasList = batcher.blasList();
+
+    vkw::AccelerationStructureCompactor compactor{};
+    VKW_CHECK_BOOL_RETURN_FALSE(compactor.init(device, static_cast<uint32_t>(blasList.size())));
+    VKW_CHECK_BOOL_RETURN_FALSE(buildStructures(device, batcher, compactor, buildFlags));
+
+    vkw::DeferredDeletionQueue deletionQueue{};
+    const auto compactFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        return compactor.recordCompaction(cmdBuffer, blasList, deletionQueue, 1);
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, compactFn));
+    deletionQueue.collect(1);
+
+    // Only the compacted structures are checked
+    std::vector<std::reference_wrapper<vkw::BottomLevelAccelerationStructure>> compactedList{};
+    for(const auto& blas : blasList)
+    {
+        if(blas.get().compacted()) { compactedList.push_back(blas); }
+    }
+    if(compactedList.empty())
+    {
+        vkw::utils::Log::Info(testName, "  No structure compacted, skipping");
+        return true;
+    }
+
+    // Compacted structures never need a rebuild, even past the refit limit
+    for(const auto& blas : compactedList)
+    {
+        blas.get().setMaxRefitCount(1);
+    }
+
+    vkw::AccelerationStructureScratchPool scratchPool{};
+    VKW_CHECK_BOOL_RETURN_FALSE(scratchPool.init(device, scratchPool.requiredSize(compactedList)));
+
+    // Full builds are refused, nothing is recorded
+    const auto buildFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        cmdBuffer.buildAccelerationStructures(compactedList, scratchPool, buildFlags);
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, buildFn));
+    if(scratchPool.usedBytes() != 0) { return false; }
+
+    const auto updateFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        cmdBuffer.updateAccelerationStructures(compactedList, scratchPool, buildFlags);
+        return true;
+    };
+    for(uint32_t i = 1; i <= 3; ++i)
+    {
+        scratchPool.reset();
+        VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, updateFn));
+        if(scratchPool.usedBytes() != scratchPool.requiredSize(compactedList, true)) { return false; }
+
+        for(const auto& blas : compactedList)
+        {
+            if(blas.get().needsRebuild() || blas.get().refitCount() != i) { return false; }
+        }
+    }
+
+    return true;
+}
+
+bool testMismatch(const vkw::Device& device)
+{
+    const auto buildFlags = VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;
+
+    vkw::BlasBatcher batcher{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(createStructures(batcher, 24, buildFlags));
+
+    auto blasList = batcher.blasList();
+    if(blasList.size() < 3) { return false; }
+
+    // The compactor is too small for all the structures
+    vkw::AccelerationStructureCompactor compactor{};
+    VKW_CHECK_BOOL_RETURN_FALSE(compactor.init(device, 2));
+
+    bool queried = true;
+    const auto queryAllFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        queried = compactor.recordSizeQueries(cmdBuffer, blasList);
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, queryAllFn));
+    if(queried) { return false; }
+
+    // The compaction must be given the queried structures, in the same order
+    std::vector<std::reference_wrapper<vkw::BottomLevelAccelerationStructure>> queriedList{
+        blasList[0], blasList[1]};
+    std::vector<std::reference_wrapper<vkw::BottomLevelAccelerationStructure>> swappedList{
+        blasList[1], blasList[0]};
+    std::vector<std::reference_wrapper<vkw::BottomLevelAccelerationStructure>> partialList{blasList[0]};
+
+    vkw::AccelerationStructureScratchPool scratchPool{};
+    VKW_CHECK_BOOL_RETURN_FALSE(scratchPool.init(device, scratchPool.requiredSize(queriedList)));
+
+    vkw::DeferredDeletionQueue deletionQueue{};
+    const auto buildFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        if(batcher.needsUpload()) { batcher.recordUpload(cmdBuffer, deletionQueue, 1); }
+        cmdBuffer.buildAccelerationStructures(queriedList, scratchPool, buildFlags);
+        return compactor.recordSizeQueries(cmdBuffer, queriedList);
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, buildFn));
+    deletionQueue.collect(1);
+
+    bool swappedCompacted = true;
+    bool partialCompacted = true;
+    const auto compactFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        swappedCompacted = compactor.recordCompaction(cmdBuffer, swappedList, deletionQueue, 1);
+        partialCompacted = compactor.recordCompaction(cmdBuffer, partialList, deletionQueue, 1);
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, compactFn));
+
+    return !swappedCompacted && !partialCompacted && deletionQueue.pendingCount() == 0
+           && !blasList[0].get().compacted() && !blasList[1].get().compacted();
+}
+
+bool testEmptyList(const vkw::Device& device)
+{
+    vkw::AccelerationStructureCompactor compactor{};
+    VKW_CHECK_BOOL_RETURN_FALSE(compactor.init(device, 1));
+
+    vkw::DeferredDeletionQueue deletionQueue{};
+    bool res = false;
+    const auto recordFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        res = compactor.recordSizeQueries(cmdBuffer, {})
+              && compactor.recordCompaction(cmdBuffer, {}, deletionQueue, 1);
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, recordFn));
+
+    return res && deletionQueue.pendingCount() == 0;
+}
+
+bool createStructures(
+    vkw::BlasBatcher& batcher, const uint32_t quadCount,
+    const VkBuildAccelerationStructureFlagsKHR buildFlags)
+{
+    batcher.setTargetPrimitiveCount(16);
+
+    for(uint32_t i = 0; i < quadCount; ++i)
+    {
+        vkw::BlasBatcher::MeshDesc mesh{};
+        mesh.positions = quadPositions;
+        mesh.vertexCount = 4;
+        mesh.indices = quadIndices;
+        mesh.indexCount = 6;
+        mesh.transform.matrix[0][3] = 2.0f * float(i % 10);
+        mesh.transform.matrix[1][3] = 2.0f * float(i / 10);
+        batcher.addMesh(mesh);
+    }
+
+    return batcher.create(static_cast<VkBuildAccelerationStructureFlagBitsKHR>(buildFlags));
+}
+
+bool buildStructures(
+    const vkw::Device& device, vkw::BlasBatcher& batcher, vkw::AccelerationStructureCompactor& compactor,
+    const VkBuildAccelerationStructureFlagsKHR buildFlags)
+{
+    auto blasList = batcher.blasList();
+
+    vkw::AccelerationStructureScratchPool scratchPool{};
+    VKW_CHECK_BOOL_RETURN_FALSE(scratchPool.init(device, scratchPool.requiredSize(blasList)));
+
+    vkw::DeferredDeletionQueue deletionQueue{};
+    const auto buildFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        if(batcher.needsUpload()) { batcher.recordUpload(cmdBuffer, deletionQueue, 1); }
+        cmdBuffer.buildAccelerationStructures(blasList, scratchPool, buildFlags);
+        return compactor.recordSizeQueries(cmdBuffer, blasList);
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, buildFn));
+    deletionQueue.collect(1);
+
+    return true;
+}
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "ASScratchPoolTest";
+
+static const float quadPositions[] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+static const uint32_t quadIndices[] = {0, 1, 2, 0, 2, 3};
+
+static bool testAllocation(const vkw::Device& device);
+
+static bool testExhaustion(const vkw::Device& device);
+
+static bool testReserve(const vkw::Device& device);
+
+static bool testRequiredSize(const vkw::Device& device);
+
+static bool testBatchedBuild(const vkw::Device& device);
+
+// Batches quadCount quads in structures of at most 2 quads
+static bool createStructures(vkw::BlasBatcher& batcher, const uint32_t quadCount);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchASScratchPoolTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    if(!accelerationStructuresAvailable(physicalDevice))
+    {
+        vkw::utils::Log::Info(testName, "Acceleration structures not available, skipping");
+        return true;
+    }
+
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(initAccelerationStructureDevice(device, instance, physicalDevice));
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    vkw::utils::Log::Info(testName, "Checking allocation...");
+    if(!testAllocation(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Allocation - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking exhaustion...");
+    if(!testExhaustion(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Exhaustion - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking reserve...");
+    if(!testReserve(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Reserve - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking required size...");
+    if(!testRequiredSize(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Required size - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking batched build...");
+    if(!testBatchedBuild(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Batched build - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testAllocation(const vkw::Device& device)
+{
+    vkw::AccelerationStructureScratchPool scratchPool{};
+    VKW_CHECK_BOOL_RETURN_FALSE(scratchPool.init(device));
+
+    const VkDeviceSize alignment = scratchPool.alignment();
+    const auto& properties = device.accelerationStructureProperties();
+    if(alignment < properties.minAccelerationStructureScratchOffsetAlignment) { return false; }
+
+    // No memory until the first reserve
+    if(scratchPool.capacity() != 0 || scratchPool.buffer().initialized()) { return false; }
+    if(scratchPool.alignedSize(0) != 0 || scratchPool.alignedSize(1) != alignment) { return false; }
+    if(scratchPool.alignedSize(alignment + 1) != 2 * alignment) { return false; }
+
+    VKW_CHECK_BOOL_RETURN_FALSE(scratchPool.reserve(3 * alignment + 1));
+    if(scratchPool.capacity() < 3 * alignment + 1 || scratchPool.usedBytes() != 0) { return false; }
+
+    // Regions are contiguous and aligned, starting at the base of the buffer
+    const VkDeviceAddress first = scratchPool.allocate(1);
+    const VkDeviceAddress second = scratchPool.allocate(alignment + 1);
+    if(first == 0 || first != scratchPool.buffer().deviceAddress()) { return false; }
+    if((first % alignment) != 0 || second != first + alignment) { return false; }
+    if(scratchPool.usedBytes() != 3 * alignment) { return false; }
+    if(scratchPool.availableBytes() != scratchPool.capacity() - 3 * alignment) { return false; }
+
+    // All the regions are released at once
+    scratchPool.reset();
+    if(scratchPool.usedBytes() != 0) { return false; }
+
+    return scratchPool.allocate(alignment) == first;
+}
+
+bool testExhaustion(const vkw::Device& device)
+{
+    vkw::AccelerationStructureScratchPool scratchPool{};
+    VKW_CHECK_BOOL_RETURN_FALSE(scratchPool.init(device, 4 * 1024));
+
+    // A full pool can't hold any other region
+    const VkDeviceAddress whole = scratchPool.allocate(scratchPool.availableBytes());
+    if(whole == 0 || scratchPool.availableBytes() != 0) { return false; }
+
+    const VkDeviceSize usedBytes = scratchPool.usedBytes();
+    if(scratchPool.allocate(1) != 0 || scratchPool.usedBytes() != usedBytes) { return false; }
+
+    // A too large request fails without taking the remaining space
+    scratchPool.reset();
+    if(scratchPool.allocate(scratchPool.capacity() + 1) != 0) { return false; }
+    if(scratchPool.usedBytes() != 0) { return false; }
+
+    return scratchPool.allocate(scratchPool.capacity()) == whole;
+}
+
+bool testReserve(const vkw::Device& device)
+{
+    vkw::AccelerationStructureScratchPool scratchPool{};
+    VKW_CHECK_BOOL_RETURN_FALSE(scratchPool.init(device, 1024));
+
+    const VkDeviceSize capacity = scratchPool.capacity();
+    const VkBuffer buffer = scratchPool.buffer().getHandle();
+    if(capacity < 1024 || scratchPool.allocate(16) == 0) { return false; }
+
+    // Smaller reservations keep the buffer and its regions
+    const VkDeviceSize usedBytes = scratchPool.usedBytes();
+    VKW_CHECK_BOOL_RETURN_FALSE(scratchPool.reserve(512));
+    VKW_CHECK_BOOL_RETURN_FALSE(scratchPool.reserve(capacity));
+    if(scratchPool.buffer().getHandle() != buffer || scratchPool.usedBytes() != usedBytes) { return false; }
+
+    // Growing reallocates the buffer and drops the regions
+    VKW_CHECK_BOOL_RETURN_FALSE(scratchPool.reserve(4 * capacity));
+    if(scratchPool.capacity() < 4 * capacity || scratchPool.usedBytes() != 0) { return false; }
+
+    const VkDeviceAddress first = scratchPool.allocate(1);
+    return first == scratchPool.buffer().deviceAddress() && (first % scratchPool.alignment()) == 0;
+}
+
+bool testRequiredSize(const vkw::Device& device)
+{
+    vkw::BlasBatcher batcher{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(createStructures(batcher, 7));
+
+    auto blasList = batcher.blasList();
+    if(blasList.size() < 4) { return false; }
+
+    vkw::AccelerationStructureScratchPool scratchPool{};
+    VKW_CHECK_BOOL_RETURN_FALSE(scratchPool.init(device));
+
+    // Each structure takes its own aligned region
+    VkDeviceSize buildSize = 0;
+    VkDeviceSize updateSize = 0;
+    for(const auto& blas : blasList)
+    {
+        buildSize += scratchPool.alignedSize(blas.get().buildScratchSize());
+        updateSize += scratchPool.alignedSize(blas.get().updateScratchSize());
+    }
+
+    return scratchPool.requiredSize({}) == 0 && scratchPool.requiredSize(blasList) == buildSize
+           && scratchPool.requiredSize(blasList, true) == updateSize;
+}
+
+bool testBatchedBuild(const vkw::Device& device)
+{
+    vkw::BlasBatcher batcher{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(createStructures(batcher, 9));
+
+    auto blasList = batcher.blasList();
+    const auto buildFlags = VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR;
+
+    // The pool holds exactly the scratch regions of one batched build
+    vkw::AccelerationStructureScratchPool scratchPool{};
+    VKW_CHECK_BOOL_RETURN_FALSE(scratchPool.init(device));
+    const VkDeviceSize requiredSize = scratchPool.requiredSize(blasList);
+    VKW_CHECK_BOOL_RETURN_FALSE(scratchPool.reserve(requiredSize));
+    const VkDeviceSize capacity = scratchPool.capacity();
+
+    vkw::DeferredDeletionQueue deletionQueue{};
+    const auto buildFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        if(batcher.needsUpload()) { batcher.recordUpload(cmdBuffer, deletionQueue, 1); }
+        cmdBuffer.buildAccelerationStructures(blasList, scratchPool, buildFlags);
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, buildFn));
+    deletionQueue.collect(1);
+
+    if(scratchPool.usedBytes() != requiredSize) { return false; }
+    for(const auto& blas : blasList)
+    {
+        if(blas.get().getDeviceAddress() == 0) { return false; }
+    }
+
+    // Without a reset the pool is too small for another build, nothing is recorded
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, buildFn));
+    if(scratchPool.usedBytes() != requiredSize) { return false; }
+
+    // Once the previous build completed the regions can be reused, for builds or updates
+    scratchPool.reset();
+    const VkDeviceSize updateSize = scratchPool.requiredSize(blasList, true);
+    const auto updateFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        cmdBuffer.updateAccelerationStructures(blasList, scratchPool, buildFlags);
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, updateFn));
+
+    return scratchPool.usedBytes() == updateSize && scratchPool.capacity() == capacity;
+}
+
+bool createStructures(vkw::BlasBatcher& batcher, const uint32_t quadCount)
+{
+    batcher.setTargetPrimitiveCount(4);
+
+    for(uint32_t i = 0; i < quadCount; ++i)
+    {
+        vkw::BlasBatcher::MeshDesc mesh{};
+        mesh.positions = quadPositions;
+        mesh.vertexCount = 4;
+        mesh.indices = quadIndices;
+        mesh.indexCount = 6;
+        mesh.transform.matrix[0][3] = 10.0f * float(i);
+        batcher.addMesh(mesh);
+    }
+
+    // Update scratch sizes are only given to structures allowing updates
+    return batcher.create(VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR);
+}
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "ASSerializerTest";
+
+static const float quadPositions[] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+static const uint32_t quadIndices[] = {0, 1, 2, 0, 2, 3};
+
+static bool runTests(const vkw::Device& device, uint32_t& totalTests, uint32_t& failedTests);
+
+static bool testRoundTrip(const vkw::Device& device, const uint32_t quadCount);
+
+static bool testInvalidFile(const vkw::Device& device);
+
+// Builds a structure holding quadCount quads, serializes it and saves it to filename
+static bool saveStructure(
+    const vkw::Device& device, vkw::AccelerationStructureSerializer& serializer, const uint32_t quadCount,
+    const std::string& filename);
+
+static bool readFile(const std::string& filename, std::vector<uint8_t>& data);
+
+static bool writeFile(const std::string& filename, const std::vector<uint8_t>& data);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchASSerializerTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    if(!accelerationStructuresAvailable(physicalDevice))
+    {
+        vkw::utils::Log::Info(testName, "Acceleration structures not available, skipping");
+        return true;
+    }
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    // Files are copied to host memory before the deserialization
+    {
+        vkw::Device device{};
+        VKW_CHECK_BOOL_RETURN_FALSE(initAccelerationStructureDevice(device, instance, physicalDevice));
+
+        vkw::utils::Log::Info(testName, "Checking loads from a copy of the file...");
+        VKW_CHECK_BOOL_RETURN_FALSE(runTests(device, totalTests, failedTests));
+    }
+
+    // Files are imported and read in place by the device
+    if(extensionsAvailable(physicalDevice, {VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME}))
+    {
+        vkw::Device device{};
+        VKW_CHECK_BOOL_RETURN_FALSE(initAccelerationStructureDevice(
+            device, instance, physicalDevice, {VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME}));
+
+        vkw::utils::Log::Info(testName, "Checking loads from an imported file mapping...");
+        VKW_CHECK_BOOL_RETURN_FALSE(runTests(device, totalTests, failedTests));
+    }
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool runTests(const vkw::Device& device, uint32_t& totalTests, uint32_t& failedTests)
+{
+    for(uint32_t quadCount = 1; quadCount <= 1000; quadCount *= 10)
+    {
+        if(!testRoundTrip(device, quadCount))
+        {
+            vkw::utils::Log::Warning(testName, "  Round trip of %u quads - FAILED", quadCount);
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    if(!testInvalidFile(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Invalid file - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    return true;
+}
+
+bool testRoundTrip(const vkw::Device& device, const uint32_t quadCount)
+{
+    const std::string filename = "ASSerializerTest.bin";
+    const std::string reloadedFilename = "ASSerializerTestReloaded.bin";
+
+    vkw::AccelerationStructureSerializer serializer{device, 1};
+    VKW_CHECK_BOOL_RETURN_FALSE(serializer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(saveStructure(device, serializer, quadCount, filename));
+
+    // Load the structure back and serialize it again, both files must match
+    vkw::BottomLevelAccelerationStructure loaded{};
+    vkw::DeferredDeletionQueue deletionQueue{};
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        runCommands(device, vkw::QueueUsageBits::Compute, [&](const vkw::CommandBuffer& cmdBuffer) {
+            return serializer.recordLoad(cmdBuffer, loaded, filename, deletionQueue, 1)
+                   && serializer.recordSizeQueries(cmdBuffer, {loaded});
+        }));
+    deletionQueue.collect(1);
+
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        runCommands(device, vkw::QueueUsageBits::Compute, [&](const vkw::CommandBuffer& cmdBuffer) {
+            return serializer.recordSerialization(cmdBuffer, {loaded});
+        }));
+    VKW_CHECK_BOOL_RETURN_FALSE(serializer.save(0, reloadedFilename));
+
+    std::vector<uint8_t> savedData{};
+    std::vector<uint8_t> reloadedData{};
+    const bool res = readFile(filename, savedData) && readFile(reloadedFilename, reloadedData)
+                     && !savedData.empty() && savedData == reloadedData;
+
+    remove(filename.c_str());
+    remove(reloadedFilename.c_str());
+
+    return res;
+}
+
+bool testInvalidFile(const vkw::Device& device)
+{
+    using Serializer = vkw::AccelerationStructureSerializer;
+
+    const std::string filename = "ASSerializerInvalidTest.bin";
+
+    Serializer serializer{device, 1};
+    VKW_CHECK_BOOL_RETURN_FALSE(serializer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(saveStructure(device, serializer, 4, filename));
+
+    std::vector<uint8_t> data{};
+    VKW_CHECK_BOOL_RETURN_FALSE(readFile(filename, data));
+
+    const auto loadFails = [&](const std::vector<uint8_t>& fileData) {
+        if(!writeFile(filename, fileData)) { return false; }
+
+        vkw::BottomLevelAccelerationStructure blas{};
+        vkw::DeferredDeletionQueue deletionQueue{};
+        bool loaded = true;
+        const bool submitted
+            = runCommands(device, vkw::QueueUsageBits::Compute, [&](const vkw::CommandBuffer& cmdBuffer) {
+                  loaded = serializer.recordLoad(cmdBuffer, blas, filename, deletionQueue, 1);
+                  return true;
+              });
+        return submitted && !loaded;
+    };
+
+    // Wrong magic
+    auto invalidMagic = data;
+    invalidMagic[0] ^= 0xFF;
+
+    // Truncated serialized data
+    auto truncated = data;
+    truncated.resize(Serializer::fileDataOffset + (data.size() - Serializer::fileDataOffset) / 2);
+
+    // Driver UUID of another device, at the start of the serialized data
+    auto otherDriver = data;
+    otherDriver[Serializer::fileDataOffset] ^= 0xFF;
+
+    const bool res = loadFails(invalidMagic) && loadFails(truncated) && loadFails(otherDriver);
+
+    remove(filename.c_str());
+
+    return res;
+}
+
+bool saveStructure(
+    const vkw::Device& device, vkw::AccelerationStructureSerializer& serializer, const uint32_t quadCount,
+    const std::string& filename)
+{
+    vkw::BlasBatcher batcher{device};
+    batcher.setTargetPrimitiveCount(2 * quadCount);
+    for(uint32_t i = 0; i < quadCount; ++i)
+    {
+        vkw::BlasBatcher::MeshDesc mesh{};
+        mesh.positions = quadPositions;
+        mesh.vertexCount = 4;
+        mesh.indices = quadIndices;
+        mesh.indexCount = 6;
+        mesh.transform.matrix[0][3] = float(i % 32);
+        mesh.transform.matrix[1][3] = float(i / 32);
+        batcher.addMesh(mesh);
+    }
+    VKW_CHECK_BOOL_RETURN_FALSE(batcher.create());
+    VKW_CHECK_BOOL_RETURN_FALSE(batcher.blasCount() == 1);
+
+    auto blasList = batcher.blasList();
+
+    vkw::AccelerationStructureScratchPool scratchPool{};
+    VKW_CHECK_BOOL_RETURN_FALSE(scratchPool.init(device, scratchPool.requiredSize(blasList)));
+
+    vkw::DeferredDeletionQueue deletionQueue{};
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        runCommands(device, vkw::QueueUsageBits::Compute, [&](const vkw::CommandBuffer& cmdBuffer) {
+            if(batcher.needsUpload()) { batcher.recordUpload(cmdBuffer, deletionQueue, 1); }
+            cmdBuffer.buildAccelerationStructures(blasList, scratchPool);
+            return serializer.recordSizeQueries(cmdBuffer, blasList);
+        }));
+    deletionQueue.collect(1);
+
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        runCommands(device, vkw::QueueUsageBits::Compute, [&](const vkw::CommandBuffer& cmdBuffer) {
+            return serializer.recordSerialization(cmdBuffer, blasList);
+        }));
+
+    return serializer.save(0, filename);
+}
+
+bool readFile(const std::string& filename, std::vector<uint8_t>& data)
+{
+    FILE* fp = fopen(filename.c_str(), "rb");
+    VKW_CHECK_BOOL_RETURN_FALSE(fp != nullptr);
+
+    fseek(fp, 0, SEEK_END);
+    const long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    data.resize(size > 0 ? static_cast<size_t>(size) : 0);
+    const size_t readSize = fread(data.data(), 1, data.size(), fp);
+    fclose(fp);
+
+    return readSize == data.size();
+}
+
+bool writeFile(const std::string& filename, const std::vector<uint8_t>& data)
+{
+    FILE* fp = fopen(filename.c_str(), "wb");
+    VKW_CHECK_BOOL_RETURN_FALSE(fp != nullptr);
+
+    const size_t writtenSize = fwrite(data.data(), 1, data.size(), fp);
+    fclose(fp);
+
+    return writtenSize == data.size();
+}
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "BlasBatcherTest";
+
+static const float quadPositions[] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+static const uint32_t quadIndices[] = {0, 1, 2, 0, 2, 3};
+
+static bool testBatchGrouping(const vkw::Device& device);
+
+static bool testGeometryLimit(const vkw::Device& device);
+
+static bool testLargeMesh(const vkw::Device& device);
+
+static bool testEmptyBatcher(const vkw::Device& device);
+
+static bool testBuild(const vkw::Device& device);
+
+static vkw::BlasBatcher::MeshDesc quadMesh(const float x, const float y, const float z);
+
+// Meshes of each structure indexed by their geometry index, empty if two meshes share a location or if a
+// geometry index is missing
+static std::vector<std::vector<uint32_t>> meshesPerBlas(const vkw::BlasBatcher& batcher);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchBlasBatcherTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    if(!accelerationStructuresAvailable(physicalDevice))
+    {
+        vkw::utils::Log::Info(testName, "Acceleration structures not available, skipping");
+        return true;
+    }
+
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(initAccelerationStructureDevice(device, instance, physicalDevice));
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    vkw::utils::Log::Info(testName, "Checking batch grouping...");
+    if(!testBatchGrouping(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Batch grouping - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking geometry limit...");
+    if(!testGeometryLimit(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Geometry limit - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking large mesh...");
+    if(!testLargeMesh(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Large mesh - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking empty batcher...");
+    if(!testEmptyBatcher(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Empty batcher - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking build...");
+    if(!testBuild(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Build - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testBatchGrouping(const vkw::Device& device)
+{
+    vkw::BlasBatcher batcher{device};
+    batcher.setTargetPrimitiveCount(8);
+
+    // Two clusters of 4 quads far apart, added interleaved: each cluster fills exactly one structure
+    std::vector<uint32_t> clusterA{};
+    std::vector<uint32_t> clusterB{};
+    for(uint32_t i = 0; i < 4; ++i)
+    {
+        clusterA.push_back(batcher.addMesh(quadMesh(0.1f * float(i), 0.0f, 0.0f)));
+        clusterB.push_back(batcher.addMesh(quadMesh(100.0f + 0.1f * float(i), 0.0f, 0.0f)));
+    }
+    VKW_CHECK_BOOL_RETURN_FALSE(batcher.create());
+
+    if(batcher.blasCount() != 2 || meshesPerBlas(batcher).size() != 2) { return false; }
+
+    const uint32_t blasA = batcher.meshLocation(clusterA[0]).blasIndex;
+    for(uint32_t i = 0; i < 4; ++i)
+    {
+        if(batcher.meshLocation(clusterA[i]).blasIndex != blasA) { return false; }
+        if(batcher.meshLocation(clusterB[i]).blasIndex == blasA) { return false; }
+    }
+
+    return true;
+}
+
+bool testGeometryLimit(const vkw::Device& device)
+{
+    vkw::BlasBatcher batcher{device};
+    batcher.setTargetPrimitiveCount(1u << 16).setMaxGeometryCount(3);
+
+    for(uint32_t i = 0; i < 10; ++i)
+    {
+        batcher.addMesh(quadMesh(float(i % 4), float(i / 4), float(i % 3)));
+    }
+    VKW_CHECK_BOOL_RETURN_FALSE(batcher.create());
+
+    const auto batches = meshesPerBlas(batcher);
+    if(batcher.blasCount() != 4 || batches.size() != 4) { return false; }
+
+    size_t meshCount = 0;
+    for(const auto& batch : batches)
+    {
+        if(batch.empty() || batch.size() > 3) { return false; }
+        meshCount += batch.size();
+    }
+
+    return meshCount == 10;
+}
+
+bool testLargeMesh(const vkw::Device& device)
+{
+    vkw::BlasBatcher batcher{device};
+    batcher.setTargetPrimitiveCount(4);
+
+    // Strip of 4 quads, larger than the primitive target
+    std::vector<float> positions{};
+    std::vector<uint32_t> indices{};
+    for(uint32_t i = 0; i <= 4; ++i)
+    {
+        positions.insert(positions.end(), {float(i), 0.0f, 0.0f, float(i), 1.0f, 0.0f});
+    }
+    for(uint32_t i = 0; i < 4; ++i)
+    {
+        const uint32_t v = 2 * i;
+        indices.insert(indices.end(), {v, v + 2, v + 3, v, v + 3, v + 1});
+    }
+
+    vkw::BlasBatcher::MeshDesc largeMesh{};
+    largeMesh.positions = positions.data();
+    largeMesh.vertexCount = static_cast<uint32_t>(positions.size() / 3);
+    largeMesh.indices = indices.data();
+    largeMesh.indexCount = static_cast<uint32_t>(indices.size());
+
+    batcher.addMesh(quadMesh(0.0f, 0.0f, 0.0f));
+    batcher.addMesh(quadMesh(1.0f, 0.0f, 0.0f));
+    const uint32_t largeMeshIndex = batcher.addMesh(largeMesh);
+    batcher.addMesh(quadMesh(2.0f, 0.0f, 0.0f));
+    batcher.addMesh(quadMesh(3.0f, 0.0f, 0.0f));
+    VKW_CHECK_BOOL_RETURN_FALSE(batcher.create());
+
+    const auto batches = meshesPerBlas(batcher);
+    if(batches.empty()) { return false; }
+
+    // The large mesh is alone in its structure, the others hold at most 2 quads
+    for(uint32_t i = 0; i < batches.size(); ++i)
+    {
+        const auto& batch = batches[i];
+        if(i == batcher.meshLocation(largeMeshIndex).blasIndex)
+        {
+            if(batch.size() != 1) { return false; }
+        }
+        else if(batch.size() > 2) { return false; }
+    }
+
+    return true;
+}
+
+bool testEmptyBatcher(const vkw::Device& device)
+{
+    vkw::BlasBatcher batcher{device};
+
+    // Nothing to create, the batcher must not report structures
+    if(batcher.create()) { return false; }
+    if(batcher.created() || batcher.blasCount() != 0) { return false; }
+
+    // Meshes can still be added after a failed creation
+    batcher.addMesh(quadMesh(0.0f, 0.0f, 0.0f));
+    VKW_CHECK_BOOL_RETURN_FALSE(batcher.create());
+
+    return batcher.created() && batcher.blasCount() == 1;
+}
+
+bool testBuild(const vkw::Device& device)
+{
+    vkw::BlasBatcher batcher{device};
+    batcher.setTargetPrimitiveCount(8);
+
+    for(uint32_t i = 0; i < 16; ++i)
+    {
+        batcher.addMesh(quadMesh(float(i % 4), float(i / 4), 0.0f));
+    }
+    VKW_CHECK_BOOL_RETURN_FALSE(batcher.create());
+    if(meshesPerBlas(batcher).size() != batcher.blasCount()) { return false; }
+
+    auto blasList = batcher.blasList();
+
+    vkw::AccelerationStructureScratchPool scratchPool{};
+    VKW_CHECK_BOOL_RETURN_FALSE(scratchPool.init(device, scratchPool.requiredSize(blasList)));
+
+    auto computeQueue = device.getQueues(vkw::QueueUsageBits::Compute)[0];
+
+    vkw::CommandPool cmdPool{device, computeQueue};
+    VKW_CHECK_BOOL_RETURN_FALSE(cmdPool.initialized());
+
+    auto cmdBuffer = cmdPool.createCommandBuffer();
+    VKW_CHECK_BOOL_RETURN_FALSE(cmdBuffer.initialized());
+
+    vkw::DeferredDeletionQueue deletionQueue{};
+
+    cmdBuffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    if(batcher.needsUpload()) { batcher.recordUpload(cmdBuffer, deletionQueue, 1); }
+    cmdBuffer.buildAccelerationStructures(blasList, scratchPool);
+    cmdBuffer.end();
+
+    vkw::Fence fence{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(fence.initialized());
+
+    VKW_CHECK_VK_RETURN_FALSE(computeQueue.submit(cmdBuffer, fence));
+    VKW_CHECK_BOOL_RETURN_FALSE(fence.wait());
+    deletionQueue.collect(1);
+
+    if(batcher.needsUpload() || deletionQueue.pendingCount() != 0) { return false; }
+    for(uint32_t i = 0; i < batcher.blasCount(); ++i)
+    {
+        if(batcher.blas(i).getDeviceAddress() == 0) { return false; }
+    }
+
+    return true;
+}
+
+vkw::BlasBatcher::MeshDesc quadMesh(const float x, const float y, const float z)
+{
+    vkw::BlasBatcher::MeshDesc ret{};
+    ret.positions = quadPositions;
+    ret.vertexCount = 4;
+    ret.indices = quadIndices;
+    ret.indexCount = 6;
+    ret.transform.matrix[0][3] = x;
+    ret.transform.matrix[1][3] = y;
+    ret.transform.matrix[2][3] = z;
+    return ret;
+}
+
+std::vector<std::vector<uint32_t>> meshesPerBlas(const vkw::BlasBatcher& batcher)
+{
+    std::vector<std::vector<uint32_t>> ret(batcher.blasCount());
+    for(uint32_t meshIndex = 0; meshIndex < batcher.meshCount(); ++meshIndex)
+    {
+        const auto& location = batcher.meshLocation(meshIndex);
+        if(location.blasIndex >= ret.size()) { return {}; }
+
+        auto& batch = ret[location.blasIndex];
+        if(location.geometryIndex >= batch.size()) { batch.resize(location.geometryIndex + 1, ~0u); }
+        if(batch[location.geometryIndex] != ~0u) { return {}; }
+        batch[location.geometryIndex] = meshIndex;
+    }
+
+    for(const auto& batch : ret)
+    {
+        for(const uint32_t meshIndex : batch)
+        {
+            if(meshIndex == ~0u) { return {}; }
+        }
+    }
+    return ret;
+}
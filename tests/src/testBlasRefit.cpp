@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "BlasRefitTest";
+
+static const float quadPositions[] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+static const uint32_t quadIndices[] = {0, 1, 2, 0, 2, 3};
+
+static const auto refitBuildFlags = VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR;
+
+static bool testDefaultState(const vkw::Device& device);
+
+static bool testSingleRefit(const vkw::Device& device, const uint32_t maxRefitCount);
+
+static bool testBatchedRefit(const vkw::Device& device);
+
+// Batches quadCount quads in structures of a single quad, allowing updates, and builds them
+static bool buildStructures(const vkw::Device& device, vkw::BlasBatcher& batcher, const uint32_t quadCount);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchBlasRefitTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    if(!accelerationStructuresAvailable(physicalDevice))
+    {
+        vkw::utils::Log::Info(testName, "Acceleration structures not available, skipping");
+        return true;
+    }
+
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(initAccelerationStructureDevice(device, instance, physicalDevice));
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    vkw::utils::Log::Info(testName, "Checking default state...");
+    if(!testDefaultState(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Default state - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking single structure refits...");
+    for(const uint32_t maxRefitCount : {0, 1, 3})
+    {
+        if(!testSingleRefit(device, maxRefitCount))
+        {
+            vkw::utils::Log::Warning(testName, "  Max refit count %u - FAILED", maxRefitCount);
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    vkw::utils::Log::Info(testName, "Checking batched refits...");
+    if(!testBatchedRefit(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Batched refits - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testDefaultState(const vkw::Device& device)
+{
+    vkw::BlasBatcher batcher{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(buildStructures(device, batcher, 1));
+
+    auto& blas = batcher.blas(0);
+
+    // Refits are unlimited by default
+    if(blas.maxRefitCount() != 0 || blas.refitCount() != 0 || blas.needsRebuild()) { return false; }
+    if(blas.updateScratchSize() == 0) { return false; }
+
+    blas.setMaxRefitCount(2);
+    return blas.maxRefitCount() == 2 && !blas.needsRebuild();
+}
+
+bool testSingleRefit(const vkw::Device& device, const uint32_t maxRefitCount)
+{
+    vkw::BlasBatcher batcher{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(buildStructures(device, batcher, 1));
+
+    auto& blas = batcher.blas(0);
+    blas.setMaxRefitCount(maxRefitCount);
+
+    // The scratch buffer is large enough for the refits and the rebuilds
+    vkw::AccelerationStructureScratchPool scratchPool{};
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        scratchPool.init(device, std::max(blas.buildScratchSize(), blas.updateScratchSize())));
+
+    const auto updateFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        cmdBuffer.updateAccelerationStructure(blas, scratchPool.buffer(), refitBuildFlags);
+        return true;
+    };
+
+    // Refits until the limit is reached, the next update is a rebuild and refits start over
+    const uint32_t cycleLength = maxRefitCount + 1;
+    for(uint32_t i = 1; i <= 2 * cycleLength + 1; ++i)
+    {
+        const bool rebuild = blas.needsRebuild();
+        if(rebuild != (maxRefitCount > 0 && blas.refitCount() == maxRefitCount)) { return false; }
+
+        VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, updateFn));
+
+        const uint32_t expectedRefitCount = maxRefitCount > 0 ? i % cycleLength : i;
+        if(blas.refitCount() != expectedRefitCount) { return false; }
+    }
+
+    return blas.getDeviceAddress() != 0;
+}
+
+bool testBatchedRefit(const vkw::Device& device)
+{
+    static constexpr uint32_t maxRefitCounts[] = {0, 1, 2};
+    static constexpr uint32_t structureCount = sizeof(maxRefitCounts) / sizeof(uint32_t);
+
+    vkw::BlasBatcher batcher{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(buildStructures(device, batcher, structureCount));
+    if(batcher.blasCount() != structureCount) { return false; }
+
+    auto blasList = batcher.blasList();
+    for(uint32_t i = 0; i < structureCount; ++i)
+    {
+        blasList[i].get().setMaxRefitCount(maxRefitCounts[i]);
+    }
+
+    // Each structure either takes a build or an update region
+    vkw::AccelerationStructureScratchPool scratchPool{};
+    VKW_CHECK_BOOL_RETURN_FALSE(scratchPool.init(device));
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        scratchPool.reserve(scratchPool.requiredSize(blasList) + scratchPool.requiredSize(blasList, true)));
+
+    const auto updateFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        cmdBuffer.updateAccelerationStructures(blasList, scratchPool, refitBuildFlags);
+        return true;
+    };
+
+    for(uint32_t i = 1; i <= 6; ++i)
+    {
+        // Structures to rebuild take a build scratch region
+        VkDeviceSize requiredSize = 0;
+        for(const auto& blas : blasList)
+        {
+            const auto& b = blas.get();
+            const VkDeviceSize scratchSize = b.needsRebuild() ? b.buildScratchSize() : b.updateScratchSize();
+            requiredSize += scratchPool.alignedSize(scratchSize);
+        }
+        if(scratchPool.requiredSize(blasList, true) != requiredSize) { return false; }
+
+        scratchPool.reset();
+        VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, updateFn));
+        if(scratchPool.usedBytes() != requiredSize) { return false; }
+
+        for(uint32_t s = 0; s < structureCount; ++s)
+        {
+            const uint32_t maxRefitCount = maxRefitCounts[s];
+            const uint32_t expectedRefitCount = maxRefitCount > 0 ? i % (maxRefitCount + 1) : i;
+            if(blasList[s].get().refitCount() != expectedRefitCount) { return false; }
+        }
+    }
+
+    // A batched full build resets the refit counts
+    scratchPool.reset();
+    const auto buildFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        cmdBuffer.buildAccelerationStructures(blasList, scratchPool, refitBuildFlags);
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, buildFn));
+
+    for(const auto& blas : blasList)
+    {
+        if(blas.get().refitCount() != 0 || blas.get().needsRebuild()) { return false; }
+    }
+
+    return true;
+}
+
+bool buildStructures(const vkw::Device& device, vkw::BlasBatcher& batcher, const uint32_t quadCount)
+{
+    batcher.setTargetPrimitiveCount(2);
+
+    for(uint32_t i = 0; i < quadCount; ++i)
+    {
+        vkw::BlasBatcher::MeshDesc mesh{};
+        mesh.positions = quadPositions;
+        mesh.vertexCount = 4;
+        mesh.indices = quadIndices;
+        mesh.indexCount = 6;
+        mesh.transform.matrix[0][3] = 10.0f * float(i);
+        batcher.addMesh(mesh);
+    }
+    VKW_CHECK_BOOL_RETURN_FALSE(batcher.create(refitBuildFlags));
+
+    auto blasList = batcher.blasList();
+
+    vkw::AccelerationStructureScratchPool scratchPool{};
+    VKW_CHECK_BOOL_RETURN_FALSE(scratchPool.init(device, scratchPool.requiredSize(blasList)));
+
+    vkw::DeferredDeletionQueue deletionQueue{};
+    const auto buildFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        if(batcher.needsUpload()) { batcher.recordUpload(cmdBuffer, deletionQueue, 1); }
+        cmdBuffer.buildAccelerationStructures(blasList, scratchPool, refitBuildFlags);
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, buildFn));
+    deletionQueue.collect(1);
+
+    return true;
+}
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "BufferCopyKernelsTest";
+
+static bool testGather(
+    const vkw::Device& device, const vkw::BufferCopyKernels& kernels, const uint32_t stride,
+    const uint32_t count);
+
+static bool testScatter(
+    const vkw::Device& device, const vkw::BufferCopyKernels& kernels, const uint32_t stride,
+    const uint32_t count);
+
+static bool testTranspose(
+    const vkw::Device& device, const vkw::BufferCopyKernels& kernels, const uint32_t stride,
+    const uint32_t count);
+
+static bool testInvalidStride(const vkw::Device& device, const vkw::BufferCopyKernels& kernels);
+
+static std::vector<uint32_t> generateRecords(const uint32_t stride, const uint32_t count);
+
+static std::vector<uint32_t> generateIndices(const uint32_t count);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchBufferCopyKernelsTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    // The kernels bind their buffers with push descriptors, core in Vulkan 1.4
+    VkPhysicalDeviceProperties properties = {};
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    if(properties.apiVersion < VK_API_VERSION_1_4)
+    {
+        vkw::utils::Log::Info(testName, "Push descriptors not available, skipping");
+        return true;
+    }
+
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(device.init(instance, physicalDevice, {}, {}));
+
+    vkw::BufferCopyKernels kernels{};
+    VKW_CHECK_BOOL_RETURN_FALSE(kernels.init(device));
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    const uint32_t strides[] = {4, 12, 64};
+
+    vkw::utils::Log::Info(testName, "Checking buffer gather...");
+    for(const uint32_t stride : strides)
+    {
+        for(uint32_t count = 1000; count <= 100000; count *= 10)
+        {
+            if(!testGather(device, kernels, stride, count))
+            {
+                vkw::utils::Log::Warning(testName, "  Stride %u, count %u - FAILED", stride, count);
+                failedTests++;
+            }
+            totalTests++;
+        }
+    }
+
+    vkw::utils::Log::Info(testName, "Checking buffer scatter...");
+    for(const uint32_t stride : strides)
+    {
+        for(uint32_t count = 1000; count <= 100000; count *= 10)
+        {
+            if(!testScatter(device, kernels, stride, count))
+            {
+                vkw::utils::Log::Warning(testName, "  Stride %u, count %u - FAILED", stride, count);
+                failedTests++;
+            }
+            totalTests++;
+        }
+    }
+
+    vkw::utils::Log::Info(testName, "Checking AoS to SoA transpose...");
+    for(const uint32_t stride : strides)
+    {
+        for(uint32_t count = 1000; count <= 100000; count *= 10)
+        {
+            if(!testTranspose(device, kernels, stride, count))
+            {
+                vkw::utils::Log::Warning(testName, "  Stride %u, count %u - FAILED", stride, count);
+                failedTests++;
+            }
+            totalTests++;
+        }
+    }
+
+    vkw::utils::Log::Info(testName, "Checking invalid stride...");
+    if(!testInvalidStride(device, kernels))
+    {
+        vkw::utils::Log::Warning(testName, "  Invalid stride - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testGather(
+    const vkw::Device& device, const vkw::BufferCopyKernels& kernels, const uint32_t stride,
+    const uint32_t count)
+{
+    const uint32_t words = stride / sizeof(uint32_t);
+    const auto src = generateRecords(stride, count);
+    const auto indices = generateIndices(count);
+
+    std::vector<uint32_t> expected(src.size());
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        std::copy_n(src.data() + size_t(indices[i]) * words, words, expected.data() + size_t(i) * words);
+    }
+
+    const VkBufferUsageFlags usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+                                     | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    vkw::DeviceBuffer<uint32_t> srcBuffer{device, src.size(), usage};
+    vkw::DeviceBuffer<uint32_t> dstBuffer{device, src.size(), usage};
+    vkw::DeviceBuffer<uint32_t> indexBuffer{device, indices.size(), usage};
+    VKW_CHECK_BOOL_RETURN_FALSE(srcBuffer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(dstBuffer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(indexBuffer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer(device, src.data(), srcBuffer, src.size()));
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer(device, indices.data(), indexBuffer, indices.size()));
+
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        runCommands(device, vkw::QueueUsageBits::Compute, [&](const vkw::CommandBuffer& cmdBuffer) {
+            return kernels.recordGather(cmdBuffer, srcBuffer, dstBuffer, indexBuffer, stride, count);
+        }));
+
+    std::vector<uint32_t> result(src.size());
+    VKW_CHECK_BOOL_RETURN_FALSE(downloadBuffer(device, dstBuffer, result.data(), result.size()));
+
+    return result == expected;
+}
+
+bool testScatter(
+    const vkw::Device& device, const vkw::BufferCopyKernels& kernels, const uint32_t stride,
+    const uint32_t count)
+{
+    const uint32_t words = stride / sizeof(uint32_t);
+    const auto src = generateRecords(stride, count);
+    const auto indices = generateIndices(count);
+
+    std::vector<uint32_t> expected(src.size());
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        std::copy_n(src.data() + size_t(i) * words, words, expected.data() + size_t(indices[i]) * words);
+    }
+
+    const VkBufferUsageFlags usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+                                     | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    vkw::DeviceBuffer<uint32_t> srcBuffer{device, src.size(), usage};
+    vkw::DeviceBuffer<uint32_t> dstBuffer{device, src.size(), usage};
+    vkw::DeviceBuffer<uint32_t> indexBuffer{device, indices.size(), usage};
+    VKW_CHECK_BOOL_RETURN_FALSE(srcBuffer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(dstBuffer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(indexBuffer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer(device, src.data(), srcBuffer, src.size()));
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer(device, indices.data(), indexBuffer, indices.size()));
+
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        runCommands(device, vkw::QueueUsageBits::Compute, [&](const vkw::CommandBuffer& cmdBuffer) {
+            return kernels.recordScatter(cmdBuffer, srcBuffer, dstBuffer, indexBuffer, stride, count);
+        }));
+
+    std::vector<uint32_t> result(src.size());
+    VKW_CHECK_BOOL_RETURN_FALSE(downloadBuffer(device, dstBuffer, result.data(), result.size()));
+
+    return result == expected;
+}
+
+bool testTranspose(
+    const vkw::Device& device, const vkw::BufferCopyKernels& kernels, const uint32_t stride,
+    const uint32_t count)
+{
+    const uint32_t words = stride / sizeof(uint32_t);
+    const auto src = generateRecords(stride, count);
+
+    std::vector<uint32_t> expected(src.size());
+    for(uint32_t record = 0; record < count; ++record)
+    {
+        for(uint32_t word = 0; word < words; ++word)
+        {
+            expected[size_t(word) * count + record] = src[size_t(record) * words + word];
+        }
+    }
+
+    const VkBufferUsageFlags usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+                                     | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    vkw::DeviceBuffer<uint32_t> srcBuffer{device, src.size(), usage};
+    vkw::DeviceBuffer<uint32_t> dstBuffer{device, src.size(), usage};
+    VKW_CHECK_BOOL_RETURN_FALSE(srcBuffer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(dstBuffer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer(device, src.data(), srcBuffer, src.size()));
+
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        runCommands(device, vkw::QueueUsageBits::Compute, [&](const vkw::CommandBuffer& cmdBuffer) {
+            return kernels.recordTransposeAoSToSoA(cmdBuffer, srcBuffer, dstBuffer, stride, count);
+        }));
+
+    std::vector<uint32_t> result(src.size());
+    VKW_CHECK_BOOL_RETURN_FALSE(downloadBuffer(device, dstBuffer, result.data(), result.size()));
+
+    return result == expected;
+}
+
+bool testInvalidStride(const vkw::Device& device, const vkw::BufferCopyKernels& kernels)
+{
+    const VkBufferUsageFlags usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    vkw::DeviceBuffer<uint32_t> srcBuffer{device, 64, usage};
+    vkw::DeviceBuffer<uint32_t> dstBuffer{device, 64, usage};
+    VKW_CHECK_BOOL_RETURN_FALSE(srcBuffer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(dstBuffer.initialized());
+
+    // Records are moved as 32 bit words, recording must fail instead of dispatching anything
+    bool recorded = true;
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        runCommands(device, vkw::QueueUsageBits::Compute, [&](const vkw::CommandBuffer& cmdBuffer) {
+            recorded = kernels.recordTransposeAoSToSoA(cmdBuffer, srcBuffer, dstBuffer, 6, 16);
+            return true;
+        }));
+    if(recorded) { return false; }
+
+    // Uninitialized kernels are reported the same way
+    vkw::BufferCopyKernels emptyKernels{};
+    recorded = true;
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        runCommands(device, vkw::QueueUsageBits::Compute, [&](const vkw::CommandBuffer& cmdBuffer) {
+            recorded = emptyKernels.recordTransposeAoSToSoA(cmdBuffer, srcBuffer, dstBuffer, 4, 16);
+            return true;
+        }));
+
+    return !recorded;
+}
+
+std::vector<uint32_t> generateRecords(const uint32_t stride, const uint32_t count)
+{
+    const uint32_t words = stride / sizeof(uint32_t);
+
+    // Each word encodes its record and position to catch misplaced words
+    std::vector<uint32_t> ret(size_t(count) * words);
+    for(uint32_t record = 0; record < count; ++record)
+    {
+        for(uint32_t word = 0; word < words; ++word)
+        {
+            ret[size_t(record) * words + word] = (record << 5) | word;
+        }
+    }
+    return ret;
+}
+
+std::vector<uint32_t> generateIndices(const uint32_t count)
+{
+    // Permutation so that scattered records do not overlap
+    std::vector<uint32_t> ret(count);
+    std::iota(ret.begin(), ret.end(), 0);
+    std::mt19937 generator{42};
+    std::shuffle(ret.begin(), ret.end(), generator);
+    return ret;
+}
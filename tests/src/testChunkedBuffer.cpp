@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "ChunkedBufferTest";
+
+// Arrays of 1000 elements split in chunks of 256 elements
+static constexpr size_t arraySize = 1000;
+static constexpr size_t chunkSize = 256;
+
+static bool testChunkSplitting(const vkw::Device& device);
+
+static bool testHostCopies(const vkw::Device& device, const size_t offset, const size_t count);
+
+static bool testDeviceCopies(
+    const vkw::Device& device, const size_t srcOffset, const size_t dstOffset, const size_t count);
+
+static bool testAddressTable(const vkw::Device& device);
+
+static bool bufferDeviceAddressAvailable(const VkPhysicalDevice physicalDevice);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchChunkedBufferTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    VkPhysicalDeviceBufferDeviceAddressFeatures bufferDeviceAddressFeatures = {};
+    bufferDeviceAddressFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
+    bufferDeviceAddressFeatures.pNext = nullptr;
+    bufferDeviceAddressFeatures.bufferDeviceAddress = VK_TRUE;
+
+    const bool useDeviceAddress = bufferDeviceAddressAvailable(physicalDevice);
+
+    const void* pCreateNext = useDeviceAddress ? &bufferDeviceAddressFeatures : nullptr;
+
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(device.init(instance, physicalDevice, {}, {}, pCreateNext));
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    vkw::utils::Log::Info(testName, "Checking chunk splitting...");
+    if(!testChunkSplitting(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Chunk splitting - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    // Ranges inside a chunk, ending on a chunk boundary, and spanning several chunks
+    const std::vector<std::pair<size_t, size_t>> ranges
+        = {{0, arraySize}, {10, 100}, {0, chunkSize}, {chunkSize - 1, 2}, {250, 600}, {768, 232}};
+
+    vkw::utils::Log::Info(testName, "Checking host copies...");
+    for(const auto& [offset, count] : ranges)
+    {
+        if(!testHostCopies(device, offset, count))
+        {
+            vkw::utils::Log::Warning(testName, "  Offset %zu, count %zu - FAILED", offset, count);
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    vkw::utils::Log::Info(testName, "Checking device copies...");
+    for(const auto& [offset, count] : ranges)
+    {
+        const size_t dstOffset = arraySize - offset - count;
+        if(!testDeviceCopies(device, offset, dstOffset, count))
+        {
+            vkw::utils::Log::Warning(
+                testName, "  Source offset %zu, destination offset %zu, count %zu - FAILED", offset,
+                dstOffset, count);
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    if(useDeviceAddress)
+    {
+        vkw::utils::Log::Info(testName, "Checking address table...");
+        if(!testAddressTable(device))
+        {
+            vkw::utils::Log::Warning(testName, "  Address table - FAILED");
+            failedTests++;
+        }
+        totalTests++;
+    }
+    else
+    {
+        vkw::utils::Log::Info(testName, "Buffer device address not available, skipping address table");
+    }
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testChunkSplitting(const vkw::Device& device)
+{
+    vkw::ChunkedBuffer<uint32_t> buffer{
+        device, arraySize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, chunkSize * sizeof(uint32_t)};
+    VKW_CHECK_BOOL_RETURN_FALSE(buffer.initialized());
+
+    if(buffer.size() != arraySize || buffer.chunkSize() != chunkSize || buffer.chunkCount() != 4)
+    {
+        return false;
+    }
+    for(size_t i = 0; i < buffer.chunkCount(); ++i)
+    {
+        const size_t expectedSize = (i < 3) ? chunkSize : arraySize - 3 * chunkSize;
+        if(buffer.chunk(i).size() != expectedSize) { return false; }
+    }
+    if(buffer.getDescriptorInfos().size() != buffer.chunkCount()) { return false; }
+
+    if(buffer.chunkIndex(chunkSize - 1) != 0 || buffer.chunkOffset(chunkSize - 1) != chunkSize - 1)
+    {
+        return false;
+    }
+    if(buffer.chunkIndex(chunkSize) != 1 || buffer.chunkOffset(chunkSize) != 0) { return false; }
+
+    // [250, 850) is split along the chunk boundaries
+    struct Part
+    {
+        size_t index;
+        size_t offset;
+        size_t count;
+        size_t rangeOffset;
+    };
+    const std::vector<Part> expectedParts
+        = {{0, 250, 6, 0}, {1, 0, 256, 6}, {2, 0, 256, 262}, {3, 0, 82, 518}};
+
+    std::vector<Part> parts{};
+    buffer.forEachChunk(250, 600, [&](const size_t index, const size_t off, const size_t n, const size_t i) {
+        parts.push_back({index, off, n, i});
+    });
+    if(parts.size() != expectedParts.size()) { return false; }
+    for(size_t i = 0; i < parts.size(); ++i)
+    {
+        const auto& part = parts[i];
+        const auto& expectedPart = expectedParts[i];
+        if(part.index != expectedPart.index || part.offset != expectedPart.offset
+           || part.count != expectedPart.count || part.rangeOffset != expectedPart.rangeOffset)
+        {
+            return false;
+        }
+    }
+
+    // The chunk size limit must hold at least one element
+    vkw::ChunkedBuffer<uint32_t> invalidBuffer{};
+    if(invalidBuffer.init(device, arraySize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, sizeof(uint32_t) - 1))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool testHostCopies(const vkw::Device& device, const size_t offset, const size_t count)
+{
+    vkw::ChunkedBuffer<uint32_t, vkw::MemoryType::HostStaging> buffer{
+        device, arraySize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, chunkSize * sizeof(uint32_t)};
+    VKW_CHECK_BOOL_RETURN_FALSE(buffer.initialized());
+
+    std::vector<uint32_t> expected(arraySize, 0);
+    VKW_CHECK_BOOL_RETURN_FALSE(buffer.copyFromHost(expected.data(), arraySize));
+
+    std::vector<uint32_t> data(count);
+    for(size_t i = 0; i < count; ++i)
+    {
+        data[i] = static_cast<uint32_t>(i + 1);
+        expected[offset + i] = data[i];
+    }
+    VKW_CHECK_BOOL_RETURN_FALSE(buffer.copyFromHost(data.data(), offset, count));
+
+    // The whole array checks that nothing was written outside of the range
+    std::vector<uint32_t> result(arraySize);
+    VKW_CHECK_BOOL_RETURN_FALSE(buffer.copyToHost(result.data(), arraySize));
+    if(result != expected) { return false; }
+
+    std::vector<uint32_t> range(count);
+    VKW_CHECK_BOOL_RETURN_FALSE(buffer.copyToHost(range.data(), offset, count));
+
+    return range == data;
+}
+
+bool testDeviceCopies(
+    const vkw::Device& device, const size_t srcOffset, const size_t dstOffset, const size_t count)
+{
+    static constexpr VkBufferUsageFlags usage
+        = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    std::vector<uint32_t> data(arraySize);
+    for(size_t i = 0; i < arraySize; ++i)
+    {
+        data[i] = static_cast<uint32_t>(3 * i + 1);
+    }
+
+    vkw::DeviceBuffer<uint32_t> srcBuffer{device, arraySize, usage};
+    vkw::DeviceBuffer<uint32_t> dstBuffer{device, arraySize, usage};
+    VKW_CHECK_BOOL_RETURN_FALSE(srcBuffer.initialized() && dstBuffer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer(device, data.data(), srcBuffer, arraySize));
+
+    const std::vector<uint32_t> zeros(arraySize, 0);
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer(device, zeros.data(), dstBuffer, arraySize));
+
+    // Chunks of 256 and 100 elements, so that copies between the two arrays split on both sides
+    vkw::ChunkedBuffer<uint32_t> chunkedBuffer{device, arraySize, usage, chunkSize * sizeof(uint32_t)};
+    vkw::ChunkedBuffer<uint32_t> otherChunkedBuffer{device, arraySize, usage, 100 * sizeof(uint32_t)};
+    VKW_CHECK_BOOL_RETURN_FALSE(chunkedBuffer.initialized() && otherChunkedBuffer.initialized());
+
+    // src[srcOffset] -> chunked[dstOffset] -> other[srcOffset] -> dst[dstOffset]
+    const auto transferBarrier = [](const vkw::CommandBuffer& cmdBuffer) {
+        cmdBuffer.memoryBarrier(
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            vkw::createMemoryBarrier(VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT));
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        runCommands(device, vkw::QueueUsageBits::Transfer, [&](const vkw::CommandBuffer& cmdBuffer) {
+            chunkedBuffer.copyFrom(cmdBuffer, srcBuffer, srcOffset, dstOffset, count);
+            transferBarrier(cmdBuffer);
+            otherChunkedBuffer.copyFrom(cmdBuffer, chunkedBuffer, dstOffset, srcOffset, count);
+            transferBarrier(cmdBuffer);
+            otherChunkedBuffer.copyTo(cmdBuffer, dstBuffer, srcOffset, dstOffset, count);
+            return true;
+        }));
+
+    std::vector<uint32_t> result(arraySize);
+    VKW_CHECK_BOOL_RETURN_FALSE(downloadBuffer(device, dstBuffer, result.data(), arraySize));
+
+    for(size_t i = 0; i < arraySize; ++i)
+    {
+        const bool inRange = (i >= dstOffset) && (i < dstOffset + count);
+        const uint32_t expected = inRange ? data[srcOffset + i - dstOffset] : 0;
+        if(result[i] != expected) { return false; }
+    }
+
+    return true;
+}
+
+bool testAddressTable(const vkw::Device& device)
+{
+    vkw::ChunkedBuffer<uint32_t> buffer{
+        device, arraySize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+        chunkSize * sizeof(uint32_t)};
+    VKW_CHECK_BOOL_RETURN_FALSE(buffer.initialized());
+
+    const auto& addressTable = buffer.addressTable();
+    if(!addressTable.hostVisible() || addressTable.size() != buffer.chunkCount()) { return false; }
+
+    std::vector<VkDeviceAddress> addresses(buffer.chunkCount());
+    VKW_CHECK_BOOL_RETURN_FALSE(addressTable.copyToHost(addresses.data(), addresses.size()));
+    for(size_t i = 0; i < buffer.chunkCount(); ++i)
+    {
+        if(addresses[i] == 0 || addresses[i] != buffer.chunk(i).deviceAddress()) { return false; }
+    }
+
+    return true;
+}
+
+bool bufferDeviceAddressAvailable(const VkPhysicalDevice physicalDevice)
+{
+    VkPhysicalDeviceBufferDeviceAddressFeatures bufferDeviceAddressFeatures = {};
+    bufferDeviceAddressFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
+    bufferDeviceAddressFeatures.pNext = nullptr;
+
+    VkPhysicalDeviceFeatures2 availablePhysicalDeviceFeatures = {};
+    availablePhysicalDeviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    availablePhysicalDeviceFeatures.pNext = &bufferDeviceAddressFeatures;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &availablePhysicalDeviceFeatures);
+
+    return bufferDeviceAddressFeatures.bufferDeviceAddress == VK_TRUE;
+}
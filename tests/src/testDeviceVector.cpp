@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "DeviceVectorTest";
+
+static bool testDeletionQueueOrder();
+
+static bool testDeletionQueueNestedRetire();
+
+static bool testDeletionQueueResources(const vkw::Device& device);
+
+static bool testDeviceVectorGrowth(const vkw::Device& device);
+
+static bool testDeviceVectorHostPush(const vkw::Device& device);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchDeviceVectorTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(device.init(instance, physicalDevice, {}, {}));
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    vkw::utils::Log::Info(testName, "Checking deletion queue order...");
+    if(!testDeletionQueueOrder())
+    {
+        vkw::utils::Log::Warning(testName, "  Order - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking deletion queue nested retire...");
+    if(!testDeletionQueueNestedRetire())
+    {
+        vkw::utils::Log::Warning(testName, "  Nested retire - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking deletion queue resources...");
+    if(!testDeletionQueueResources(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Resources - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking device vector growth...");
+    if(!testDeviceVectorGrowth(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Growth - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking device vector host push...");
+    if(!testDeviceVectorHostPush(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Host push - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testDeletionQueueOrder()
+{
+    std::vector<uint32_t> deleted{};
+
+    vkw::DeferredDeletionQueue deletionQueue{};
+    deletionQueue.retire([&deleted]() { deleted.push_back(3); }, 3);
+    deletionQueue.retire([&deleted]() { deleted.push_back(1); }, 1);
+    deletionQueue.retire([&deleted]() { deleted.push_back(2); }, 2);
+    deletionQueue.retire([&deleted]() { deleted.push_back(4); }, 1);
+
+    // Nothing completed yet
+    if(deletionQueue.collect(0) != 0 || !deleted.empty() || deletionQueue.pendingCount() != 4)
+    {
+        return false;
+    }
+
+    // Completed entries are destroyed in the order they were retired
+    if(deletionQueue.collect(2) != 3 || deletionQueue.pendingCount() != 1) { return false; }
+    if(deleted != std::vector<uint32_t>{1, 2, 4}) { return false; }
+
+    // Clearing destroys the remaining entries regardless of their value
+    deletionQueue.clear();
+    return deletionQueue.pendingCount() == 0 && deleted == std::vector<uint32_t>{1, 2, 4, 3};
+}
+
+bool testDeletionQueueNestedRetire()
+{
+    uint32_t deletedCount = 0;
+
+    vkw::DeferredDeletionQueue deletionQueue{};
+    deletionQueue.retire(
+        [&deletionQueue, &deletedCount]() {
+            deletedCount++;
+            deletionQueue.retire([&deletedCount]() { deletedCount++; }, 5);
+        },
+        1);
+
+    // The entry retired from the deleter is kept until its own value is reached
+    if(deletionQueue.collect(1) != 1 || deletedCount != 1 || deletionQueue.pendingCount() != 1)
+    {
+        return false;
+    }
+    if(deletionQueue.collect(4) != 0 || deletedCount != 1) { return false; }
+    if(deletionQueue.collect(5) != 1 || deletedCount != 2) { return false; }
+
+    // Moving the queue transfers the pending entries
+    deletionQueue.retire([&deletedCount]() { deletedCount++; }, 6);
+    vkw::DeferredDeletionQueue movedQueue{std::move(deletionQueue)};
+    if(deletionQueue.pendingCount() != 0 || movedQueue.pendingCount() != 1) { return false; }
+
+    movedQueue.clear();
+    return deletedCount == 3;
+}
+
+bool testDeletionQueueResources(const vkw::Device& device)
+{
+    vkw::DeferredDeletionQueue deletionQueue{};
+    {
+        vkw::DeviceBuffer<uint32_t> buffer{device, 1024, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT};
+        VKW_CHECK_BOOL_RETURN_FALSE(buffer.initialized());
+        deletionQueue.retire(std::move(buffer), 1);
+
+        // The queue owns the resource, the original object is left empty
+        if(buffer.initialized()) { return false; }
+    }
+
+    if(deletionQueue.collect(0) != 0 || deletionQueue.pendingCount() != 1) { return false; }
+    return deletionQueue.collect(1) == 1 && deletionQueue.pendingCount() == 0;
+}
+
+bool testDeviceVectorGrowth(const vkw::Device& device)
+{
+    static constexpr uint64_t retireValue = 1;
+
+    vkw::DeferredDeletionQueue deletionQueue{};
+
+    vkw::DeviceVector<uint32_t> vector{device, deletionQueue, 4};
+    VKW_CHECK_BOOL_RETURN_FALSE(vector.initialized());
+    if(vector.capacity() != 4 || !vector.empty() || vector.version() != 0) { return false; }
+
+    std::vector<uint32_t> data(108);
+    for(size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint32_t>(3 * i + 1);
+    }
+
+    vkw::HostStagingBuffer<uint32_t> srcBuffer{device, data.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(srcBuffer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(srcBuffer.copyFromHost(data.data(), data.size()));
+
+    std::vector<size_t> capacities{};
+    const auto recordFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        // Reallocations read the previous content, the previous copies must be done first
+        const auto transferBarrier = [&cmdBuffer]() {
+            cmdBuffer.memoryBarrier(
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                vkw::createMemoryBarrier(VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT));
+        };
+
+        // Fits in the initial capacity
+        VKW_CHECK_BOOL_RETURN_FALSE(vector.push_back_batch(cmdBuffer, srcBuffer, 0, 3, retireValue));
+        capacities.push_back(vector.capacity());
+        transferBarrier();
+
+        // Grows geometrically, then exactly to the requested size when the growth is not enough
+        VKW_CHECK_BOOL_RETURN_FALSE(vector.push_back_batch(cmdBuffer, srcBuffer, 3, 5, retireValue));
+        capacities.push_back(vector.capacity());
+        transferBarrier();
+        VKW_CHECK_BOOL_RETURN_FALSE(vector.push_back_batch(cmdBuffer, srcBuffer, 8, 100, retireValue));
+        capacities.push_back(vector.capacity());
+        transferBarrier();
+
+        // Resizing keeps the existing elements
+        VKW_CHECK_BOOL_RETURN_FALSE(vector.resize(cmdBuffer, 200, retireValue));
+        capacities.push_back(vector.capacity());
+
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Transfer, recordFn));
+
+    if(capacities != std::vector<size_t>{4, 8, 108, 216}) { return false; }
+    if(vector.size() != 200 || vector.version() != 3) { return false; }
+
+    // Each reallocation retired the previous buffer
+    if(deletionQueue.pendingCount() != 3 || deletionQueue.collect(retireValue) != 3) { return false; }
+
+    std::vector<uint32_t> result(vector.capacity());
+    VKW_CHECK_BOOL_RETURN_FALSE(downloadBuffer(device, vector.buffer(), result.data(), result.size()));
+
+    return std::equal(data.begin(), data.end(), result.begin());
+}
+
+bool testDeviceVectorHostPush(const vkw::Device& device)
+{
+    static constexpr uint64_t retireValue = 1;
+
+    vkw::DeferredDeletionQueue deletionQueue{};
+
+    vkw::DeviceVector<uint32_t, vkw::MemoryType::HostStaging> vector{device, deletionQueue, 4};
+    VKW_CHECK_BOOL_RETURN_FALSE(vector.initialized());
+
+    const std::vector<uint32_t> data = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+    // The first batch fits, the second one reallocates and copies the first one on the device
+    const auto recordFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        VKW_CHECK_BOOL_RETURN_FALSE(vector.push_back_batch(cmdBuffer, data.data(), 3, retireValue));
+        if(vector.version() != 0) { return false; }
+        VKW_CHECK_BOOL_RETURN_FALSE(vector.push_back_batch(cmdBuffer, data.data() + 3, 7, retireValue));
+        return vector.version() == 1;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Transfer, recordFn));
+
+    if(vector.size() != data.size() || deletionQueue.collect(retireValue) != 1) { return false; }
+
+    std::vector<uint32_t> result(data.size());
+    VKW_CHECK_BOOL_RETURN_FALSE(vector.buffer().copyToHost(result.data(), result.size()));
+
+    return result == data;
+}
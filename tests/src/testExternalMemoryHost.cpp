@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <vkw/high_level/Types.hpp>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "ExternalMemoryHostTest";
+
+static bool testImportHostPointer(const vkw::Device& device, const size_t size);
+
+static bool testImportMappedFile(const vkw::Device& device, const size_t size);
+
+static bool testWriteMappedFile(const vkw::Device& device, const size_t size);
+
+static bool testMappedFileAlignment(const size_t size, const size_t alignment);
+
+static bool checkImportedBuffer(
+    const vkw::Device& device, const vkw::BaseBuffer& importedBuffer, const uint32_t* expected,
+    const size_t byteOffset, const size_t count);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchExternalMemoryHostTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    const std::vector<const char*> requiredExtensions = {VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME};
+    uint32_t extensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+    std::vector<VkExtensionProperties> extensions{extensionCount};
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, extensions.data());
+
+    bool externalMemoryHostAvailable = false;
+    for(const auto& extension : extensions)
+    {
+        if(strcmp(extension.extensionName, VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME) == 0)
+        {
+            externalMemoryHostAvailable = true;
+        }
+    }
+
+    if(!externalMemoryHostAvailable)
+    {
+        vkw::utils::Log::Info(testName, "External host memory not available, skipping");
+        return true;
+    }
+
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(device.init(instance, physicalDevice, requiredExtensions, {}));
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    vkw::utils::Log::Info(testName, "Checking host pointer import...");
+    for(size_t size = 1024; size <= 16 * 1024 * 1024; size *= 4)
+    {
+        if(!testImportHostPointer(device, size))
+        {
+            vkw::utils::Log::Warning(testName, "  Size %zu - FAILED", size);
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    vkw::utils::Log::Info(testName, "Checking mapped file import...");
+    for(size_t size = 1024; size <= 16 * 1024 * 1024; size *= 4)
+    {
+        if(!testImportMappedFile(device, size))
+        {
+            vkw::utils::Log::Warning(testName, "  Size %zu - FAILED", size);
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    vkw::utils::Log::Info(testName, "Checking imported mapped file writes...");
+    for(size_t size = 1024; size <= 16 * 1024 * 1024; size *= 4)
+    {
+        if(!testWriteMappedFile(device, size))
+        {
+            vkw::utils::Log::Warning(testName, "  Size %zu - FAILED", size);
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    vkw::utils::Log::Info(testName, "Checking mapped file alignment...");
+    for(size_t alignment = vkw::MappedFile::pageSize(); alignment <= 1024 * 1024; alignment *= 4)
+    {
+        if(!testMappedFileAlignment(12345, alignment))
+        {
+            vkw::utils::Log::Warning(testName, "  Alignment %zu - FAILED", alignment);
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testImportHostPointer(const vkw::Device& device, const size_t size)
+{
+    const size_t alignment = static_cast<size_t>(device.minImportedHostPointerAlignment());
+    const size_t sizeBytes = vkw::utils::alignedSize(size * sizeof(uint32_t), alignment);
+
+    auto* hostPtr = reinterpret_cast<uint32_t*>(std::aligned_alloc(alignment, sizeBytes));
+    VKW_CHECK_BOOL_RETURN_FALSE(hostPtr != nullptr);
+    for(size_t i = 0; i < size; ++i)
+    {
+        hostPtr[i] = static_cast<uint32_t>(i);
+    }
+
+    bool ret = true;
+    {
+        vkw::HostBuffer<uint32_t> importedBuffer{
+            device, hostPtr, sizeBytes / sizeof(uint32_t), VK_BUFFER_USAGE_TRANSFER_SRC_BIT};
+        ret = importedBuffer.initialized() && checkImportedBuffer(device, importedBuffer, hostPtr, 0, size);
+    }
+
+    std::free(hostPtr);
+    return ret;
+}
+
+bool testImportMappedFile(const vkw::Device& device, const size_t size)
+{
+    static constexpr size_t fileOffset = 64;
+
+    auto data = std::make_unique<uint32_t[]>(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        data[i] = static_cast<uint32_t>(3 * i + 1);
+    }
+
+    const std::string filename = "ExternalMemoryHostTest.bin";
+    FILE* fp = fopen(filename.c_str(), "wb");
+    VKW_CHECK_BOOL_RETURN_FALSE(fp != nullptr);
+    const uint8_t header[fileOffset] = {};
+    fwrite(header, 1, fileOffset, fp);
+    fwrite(data.get(), sizeof(uint32_t), size, fp);
+    fclose(fp);
+
+    bool ret = true;
+    {
+        vkw::MappedFile file{
+            filename, fileOffset, size * sizeof(uint32_t),
+            static_cast<size_t>(device.minImportedHostPointerAlignment())};
+        vkw::HostBuffer<uint32_t> importedBuffer{device, file, VK_BUFFER_USAGE_TRANSFER_SRC_BIT};
+        ret = file.initialized() && importedBuffer.initialized()
+              && checkImportedBuffer(device, importedBuffer, data.get(), file.dataOffset(), size);
+    }
+
+    remove(filename.c_str());
+    return ret;
+}
+
+bool testWriteMappedFile(const vkw::Device& device, const size_t size)
+{
+    static constexpr size_t fileOffset = 64;
+
+    auto data = std::make_unique<uint32_t[]>(size);
+    auto newData = std::make_unique<uint32_t[]>(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        data[i] = static_cast<uint32_t>(i);
+        newData[i] = static_cast<uint32_t>(size - i);
+    }
+
+    const std::string filename = "ExternalMemoryHostWriteTest.bin";
+    FILE* fp = fopen(filename.c_str(), "wb");
+    VKW_CHECK_BOOL_RETURN_FALSE(fp != nullptr);
+    const uint8_t header[fileOffset] = {};
+    fwrite(header, 1, fileOffset, fp);
+    fwrite(data.get(), sizeof(uint32_t), size, fp);
+    fclose(fp);
+
+    bool ret = true;
+    {
+        vkw::MappedFile file{
+            filename, fileOffset, size * sizeof(uint32_t),
+            static_cast<size_t>(device.minImportedHostPointerAlignment())};
+        vkw::HostBuffer<uint32_t> importedBuffer{
+            device, file, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT};
+        ret = file.initialized() && importedBuffer.initialized();
+
+        // Host writes must reach the device
+        const size_t offset = file.dataOffset() / sizeof(uint32_t);
+        ret = ret && importedBuffer.copyFromHost(newData.get(), offset, size)
+              && checkImportedBuffer(device, importedBuffer, newData.get(), file.dataOffset(), size);
+
+        // Device writes must be visible from the host
+        vkw::DeviceBuffer<uint32_t> deviceBuffer{
+            device, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT};
+        ret = ret && deviceBuffer.initialized() && uploadBuffer(device, data.get(), deviceBuffer, size);
+        if(ret)
+        {
+            auto transferQueue = device.getQueues(vkw::QueueUsageBits::Transfer)[0];
+
+            vkw::CommandPool cmdPool{device, transferQueue};
+            VKW_CHECK_BOOL_RETURN_FALSE(cmdPool.initialized());
+
+            VkBufferCopy region = {0, file.dataOffset(), size * sizeof(uint32_t)};
+
+            auto cmdBuffer = cmdPool.createCommandBuffer();
+            cmdBuffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+            cmdBuffer.copyBuffer(deviceBuffer, importedBuffer, std::span<VkBufferCopy>{&region, 1});
+            cmdBuffer.end();
+
+            vkw::Fence fence{device};
+            VKW_CHECK_BOOL_RETURN_FALSE(fence.initialized());
+            VKW_CHECK_VK_RETURN_FALSE(transferQueue.submit(cmdBuffer, fence));
+            VKW_CHECK_BOOL_RETURN_FALSE(fence.wait());
+
+            auto result = std::make_unique<uint32_t[]>(size);
+            ret = importedBuffer.copyToHost(result.get(), offset, size)
+                  && (memcmp(result.get(), data.get(), size * sizeof(uint32_t)) == 0);
+        }
+    }
+
+    // The mapping is private, the file must not have been modified
+    if(ret)
+    {
+        vkw::MappedFile file{filename, fileOffset};
+        ret = file.initialized() && (file.size() == size * sizeof(uint32_t))
+              && (memcmp(file.data(), data.get(), size * sizeof(uint32_t)) == 0);
+    }
+
+    remove(filename.c_str());
+    return ret;
+}
+
+bool testMappedFileAlignment(const size_t size, const size_t alignment)
+{
+    static constexpr size_t fileOffset = 100;
+
+    std::vector<uint8_t> data(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        data[i] = static_cast<uint8_t>(i % 251 + 1);
+    }
+
+    const std::string filename = "MappedFileAlignmentTest.bin";
+    FILE* fp = fopen(filename.c_str(), "wb");
+    VKW_CHECK_BOOL_RETURN_FALSE(fp != nullptr);
+    const uint8_t header[fileOffset] = {};
+    fwrite(header, 1, fileOffset, fp);
+    fwrite(data.data(), 1, size, fp);
+    fclose(fp);
+
+    bool ret = true;
+    {
+        vkw::MappedFile file{filename, fileOffset, 0, alignment};
+        ret = file.initialized() && (file.size() == size)
+              && (reinterpret_cast<uintptr_t>(file.mappedData()) % alignment == 0)
+              && (file.mappedSize() % alignment == 0)
+              && (memcmp(file.data(), data.data(), size) == 0);
+
+        // The whole mapped range must be accessible, the part past the end of the file reads as zeros
+        if(ret)
+        {
+            const auto* mapped = reinterpret_cast<const uint8_t*>(file.mappedData());
+            for(size_t i = file.dataOffset() + size; i < file.mappedSize(); i += 512)
+            {
+                if(mapped[i] != 0) { ret = false; }
+            }
+            ret = ret && (mapped[file.mappedSize() - 1] == 0);
+        }
+    }
+
+    remove(filename.c_str());
+    return ret;
+}
+
+bool checkImportedBuffer(
+    const vkw::Device& device, const vkw::BaseBuffer& importedBuffer, const uint32_t* expected,
+    const size_t byteOffset, const size_t count)
+{
+    vkw::DeviceBuffer<uint32_t> deviceBuffer{
+        device, count, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(deviceBuffer.initialized());
+
+    auto transferQueue = device.getQueues(vkw::QueueUsageBits::Transfer)[0];
+
+    vkw::CommandPool cmdPool{device, transferQueue};
+    VKW_CHECK_BOOL_RETURN_FALSE(cmdPool.initialized());
+
+    VkBufferCopy region = {byteOffset, 0, count * sizeof(uint32_t)};
+
+    auto cmdBuffer = cmdPool.createCommandBuffer();
+    cmdBuffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    cmdBuffer.copyBuffer(importedBuffer, deviceBuffer, std::span<VkBufferCopy>{&region, 1});
+    cmdBuffer.end();
+
+    vkw::Fence fence{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(fence.initialized());
+    VKW_CHECK_VK_RETURN_FALSE(transferQueue.submit(cmdBuffer, fence));
+    VKW_CHECK_BOOL_RETURN_FALSE(fence.wait());
+
+    auto result = std::make_unique<uint32_t[]>(count);
+    VKW_CHECK_BOOL_RETURN_FALSE(downloadBuffer(device, deviceBuffer, result.get(), count));
+    for(size_t i = 0; i < count; ++i)
+    {
+        if(result[i] != expected[i]) { return false; }
+    }
+
+    return true;
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "HostImageCopyTest";
+
+using HostCopyImage = vkw::DeviceImage<VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT>;
+
+static bool testHostImageCopy(const vkw::Device& device, const uint32_t w, const uint32_t h);
+
+static bool testHostImageRegionCopy(const vkw::Device& device, const uint32_t w, const uint32_t h);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchHostImageCopyTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    const std::vector<const char*> requiredExtensions = {VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME};
+    uint32_t extensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+    std::vector<VkExtensionProperties> extensions{extensionCount};
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, extensions.data());
+
+    bool hostImageCopyAvailable = false;
+    for(const auto& extension : extensions)
+    {
+        if(strcmp(extension.extensionName, VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME) == 0)
+        {
+            hostImageCopyAvailable = true;
+        }
+    }
+
+    VkPhysicalDeviceHostImageCopyFeaturesEXT hostImageCopyFeatures = {};
+    hostImageCopyFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_FEATURES_EXT;
+    hostImageCopyFeatures.pNext = nullptr;
+
+    VkPhysicalDeviceFeatures2 availablePhysicalDeviceFeatures = {};
+    availablePhysicalDeviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    availablePhysicalDeviceFeatures.pNext = &hostImageCopyFeatures;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &availablePhysicalDeviceFeatures);
+
+    VkFormatProperties3 formatProperties3 = {};
+    formatProperties3.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_3;
+    formatProperties3.pNext = nullptr;
+
+    VkFormatProperties2 formatProperties = {};
+    formatProperties.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+    formatProperties.pNext = &formatProperties3;
+    vkGetPhysicalDeviceFormatProperties2(physicalDevice, VK_FORMAT_R32_UINT, &formatProperties);
+
+    if(!hostImageCopyAvailable || (hostImageCopyFeatures.hostImageCopy == VK_FALSE)
+       || ((formatProperties3.optimalTilingFeatures & VK_FORMAT_FEATURE_2_HOST_IMAGE_TRANSFER_BIT_EXT) == 0))
+    {
+        vkw::utils::Log::Info(testName, "Host image copy not available, skipping");
+        return true;
+    }
+
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        device.init(instance, physicalDevice, requiredExtensions, {}, &hostImageCopyFeatures));
+    VKW_CHECK_BOOL_RETURN_FALSE(device.hostImageCopyEnabled());
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    vkw::utils::Log::Info(testName, "Checking whole image host copies...");
+    for(uint32_t size = 16; size <= 1024; size *= 4)
+    {
+        if(!testHostImageCopy(device, size, size + 3))
+        {
+            vkw::utils::Log::Warning(testName, "  Size %u - FAILED", size);
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    vkw::utils::Log::Info(testName, "Checking image region host copies...");
+    for(uint32_t size = 16; size <= 1024; size *= 4)
+    {
+        if(!testHostImageRegionCopy(device, size, size))
+        {
+            vkw::utils::Log::Warning(testName, "  Size %u - FAILED", size);
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testHostImageCopy(const vkw::Device& device, const uint32_t w, const uint32_t h)
+{
+    const size_t res = size_t(w) * size_t(h);
+
+    std::vector<uint32_t> data(res);
+    for(size_t i = 0; i < res; ++i)
+    {
+        data[i] = static_cast<uint32_t>(7 * i + 3);
+    }
+
+    HostCopyImage image{
+        device, VK_IMAGE_TYPE_2D, VK_FORMAT_R32_UINT, {w, h, 1}, VK_IMAGE_USAGE_TRANSFER_SRC_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(image.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(image.hostCopySupported());
+
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        image.transitionLayoutOnHost(VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL));
+    VKW_CHECK_BOOL_RETURN_FALSE(image.copyFromHost(data.data(), VK_IMAGE_LAYOUT_GENERAL));
+
+    // Read back from the host
+    std::vector<uint32_t> result(res);
+    VKW_CHECK_BOOL_RETURN_FALSE(image.copyToHost(result.data(), VK_IMAGE_LAYOUT_GENERAL));
+    if(result != data) { return false; }
+
+    // Read back through the device, the host copy must be visible to the queues
+    std::fill(result.begin(), result.end(), 0);
+    VKW_CHECK_BOOL_RETURN_FALSE(downloadImage<uint32_t>(device, image, result.data(), w, h));
+
+    return result == data;
+}
+
+bool testHostImageRegionCopy(const vkw::Device& device, const uint32_t w, const uint32_t h)
+{
+    const size_t res = size_t(w) * size_t(h);
+
+    HostCopyImage image{
+        device, VK_IMAGE_TYPE_2D, VK_FORMAT_R32_UINT, {w, h, 1}, VK_IMAGE_USAGE_TRANSFER_SRC_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(image.initialized());
+
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        image.transitionLayoutOnHost(VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL));
+
+    std::vector<uint32_t> expected(res, 0);
+    VKW_CHECK_BOOL_RETURN_FALSE(image.copyFromHost(expected.data(), VK_IMAGE_LAYOUT_GENERAL));
+
+    // Copy the bottom right quarter of a full size host image, with a row pitch larger than the region
+    const uint32_t rw = w / 2;
+    const uint32_t rh = h / 2;
+    std::vector<uint32_t> src(res);
+    for(size_t i = 0; i < res; ++i)
+    {
+        src[i] = static_cast<uint32_t>(i + 1);
+    }
+
+    const VkImageSubresourceLayers subresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    const VkOffset3D offset = {static_cast<int32_t>(w - rw), static_cast<int32_t>(h - rh), 0};
+    const size_t srcOffset = size_t(h - rh) * w + size_t(w - rw);
+    VKW_CHECK_BOOL_RETURN_FALSE(image.copyFromHost(
+        src.data() + srcOffset, VK_IMAGE_LAYOUT_GENERAL, subresource, offset, {rw, rh, 1}, w, h));
+
+    for(uint32_t y = h - rh; y < h; ++y)
+    {
+        for(uint32_t x = w - rw; x < w; ++x)
+        {
+            expected[size_t(y) * w + x] = src[size_t(y) * w + x];
+        }
+    }
+
+    std::vector<uint32_t> result(res);
+    VKW_CHECK_BOOL_RETURN_FALSE(image.copyToHost(result.data(), VK_IMAGE_LAYOUT_GENERAL));
+    if(result != expected) { return false; }
+
+    // Region read back, tightly packed
+    std::vector<uint32_t> region(size_t(rw) * size_t(rh));
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        image.copyToHost(region.data(), VK_IMAGE_LAYOUT_GENERAL, subresource, offset, {rw, rh, 1}));
+    for(uint32_t y = 0; y < rh; ++y)
+    {
+        for(uint32_t x = 0; x < rw; ++x)
+        {
+            if(region[size_t(y) * rw + x] != src[srcOffset + size_t(y) * w + x]) { return false; }
+        }
+    }
+
+    return true;
+}
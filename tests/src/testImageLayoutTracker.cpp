@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "ImageLayoutTrackerTest";
+
+static bool testInitialTransition();
+
+static bool testReadAfterRead();
+
+static bool testWriteAfterWrite();
+
+static bool testPartialRanges();
+
+static bool testReset();
+
+static bool testAspectMask();
+
+static bool testTrackedCopies(const vkw::Device& device);
+
+static bool checkBarrier(
+    const VkImageMemoryBarrier2& barrier, const VkImageLayout oldLayout, const VkImageLayout newLayout,
+    const uint32_t baseLevel, const uint32_t levelCount, const uint32_t baseLayer, const uint32_t layerCount);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchImageLayoutTrackerTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    const auto runTest = [&](const char* name, const std::function<bool()>& fn) {
+        vkw::utils::Log::Info(testName, "Checking %s...", name);
+        if(!fn())
+        {
+            vkw::utils::Log::Warning(testName, "  %s - FAILED", name);
+            failedTests++;
+        }
+        totalTests++;
+    };
+
+    runTest("initial transition", testInitialTransition);
+    runTest("read after read", testReadAfterRead);
+    runTest("write after write", testWriteAfterWrite);
+    runTest("partial ranges", testPartialRanges);
+    runTest("reset", testReset);
+    runTest("aspect mask", testAspectMask);
+
+    // CommandBuffer::transition() records synchronization2 barriers
+    VkPhysicalDeviceSynchronization2Features synchronization2Features = {};
+    synchronization2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES;
+    synchronization2Features.pNext = nullptr;
+
+    VkPhysicalDeviceFeatures2 availablePhysicalDeviceFeatures = {};
+    availablePhysicalDeviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    availablePhysicalDeviceFeatures.pNext = &synchronization2Features;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &availablePhysicalDeviceFeatures);
+
+    if(synchronization2Features.synchronization2 == VK_TRUE)
+    {
+        vkw::Device device{};
+        VKW_CHECK_BOOL_RETURN_FALSE(device.init(instance, physicalDevice, {}, {}, &synchronization2Features));
+
+        runTest("tracked copies", [&device]() { return testTrackedCopies(device); });
+    }
+    else
+    {
+        vkw::utils::Log::Info(testName, "Synchronization2 not available, skipping tracked copies");
+    }
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testInitialTransition()
+{
+    vkw::ImageLayoutTracker tracker{};
+    VKW_CHECK_BOOL_RETURN_FALSE(tracker.init(4, 3, VK_IMAGE_ASPECT_COLOR_BIT));
+
+    // All the subresources share the same state, a single barrier covers the whole image
+    std::vector<VkImageMemoryBarrier2> barriers{};
+    const uint32_t count = tracker.transition(
+        VK_NULL_HANDLE, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_2_COPY_BIT,
+        VK_ACCESS_2_TRANSFER_WRITE_BIT, barriers);
+    if(count != 1 || barriers.size() != 1) { return false; }
+    if(!checkBarrier(
+           barriers[0], VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, 4, 0, 3))
+    {
+        return false;
+    }
+    if(barriers[0].srcStageMask != VK_PIPELINE_STAGE_2_NONE || barriers[0].srcAccessMask != VK_ACCESS_2_NONE)
+    {
+        return false;
+    }
+    if(barriers[0].subresourceRange.aspectMask != VK_IMAGE_ASPECT_COLOR_BIT) { return false; }
+
+    const auto& state = tracker.state(3, 2);
+    return state.layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+           && state.stages == VK_PIPELINE_STAGE_2_COPY_BIT && state.access == VK_ACCESS_2_TRANSFER_WRITE_BIT;
+}
+
+bool testReadAfterRead()
+{
+    vkw::ImageLayoutTracker tracker{};
+    VKW_CHECK_BOOL_RETURN_FALSE(tracker.init(2, 1, VK_IMAGE_ASPECT_COLOR_BIT));
+
+    std::vector<VkImageMemoryBarrier2> barriers{};
+    tracker.transition(
+        VK_NULL_HANDLE, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_2_COPY_BIT,
+        VK_ACCESS_2_TRANSFER_WRITE_BIT, barriers);
+
+    // Layout change, the previous write is made available
+    barriers.clear();
+    if(tracker.transition(
+           VK_NULL_HANDLE, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+           VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, barriers)
+       != 1)
+    {
+        return false;
+    }
+    if(barriers[0].srcStageMask != VK_PIPELINE_STAGE_2_COPY_BIT
+       || barriers[0].srcAccessMask != VK_ACCESS_2_TRANSFER_WRITE_BIT)
+    {
+        return false;
+    }
+
+    // A second reader in the same layout does not need a barrier, its stage is accumulated
+    barriers.clear();
+    if(tracker.transition(
+           VK_NULL_HANDLE, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+           VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, barriers)
+       != 0)
+    {
+        return false;
+    }
+    if(!barriers.empty()) { return false; }
+    if(tracker.state(1, 0).stages
+       != (VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT))
+    {
+        return false;
+    }
+
+    // The next write waits for both readers, reads never need to be made available
+    if(tracker.transition(
+           VK_NULL_HANDLE, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_2_COPY_BIT,
+           VK_ACCESS_2_TRANSFER_WRITE_BIT, barriers)
+       != 1)
+    {
+        return false;
+    }
+    return barriers[0].srcStageMask
+               == (VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT)
+           && barriers[0].srcAccessMask == VK_ACCESS_2_NONE
+           && barriers[0].oldLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+}
+
+bool testWriteAfterWrite()
+{
+    vkw::ImageLayoutTracker tracker{};
+    VKW_CHECK_BOOL_RETURN_FALSE(tracker.init(1, 1, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_GENERAL));
+
+    // Writes in the same layout still need a barrier
+    std::vector<VkImageMemoryBarrier2> barriers{};
+    for(uint32_t i = 0; i < 2; ++i)
+    {
+        barriers.clear();
+        if(tracker.transition(
+               VK_NULL_HANDLE, VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+               VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, barriers)
+           != 1)
+        {
+            return false;
+        }
+    }
+    return checkBarrier(barriers[0], VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL, 0, 1, 0, 1)
+           && barriers[0].srcAccessMask == VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+}
+
+bool testPartialRanges()
+{
+    vkw::ImageLayoutTracker tracker{};
+    VKW_CHECK_BOOL_RETURN_FALSE(tracker.init(4, 3, VK_IMAGE_ASPECT_COLOR_BIT));
+
+    std::vector<VkImageMemoryBarrier2> barriers{};
+    tracker.transition(
+        VK_NULL_HANDLE, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_2_COPY_BIT,
+        VK_ACCESS_2_TRANSFER_WRITE_BIT, barriers);
+
+    // Level 1 of every layer, merged across layers
+    barriers.clear();
+    if(tracker.transition(
+           VK_NULL_HANDLE, VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+           VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, barriers, 1, 1)
+       != 1)
+    {
+        return false;
+    }
+    if(!checkBarrier(
+           barriers[0], VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_GENERAL, 1, 1, 0, 3))
+    {
+        return false;
+    }
+
+    // Layer 2 only
+    barriers.clear();
+    if(tracker.transition(
+           VK_NULL_HANDLE, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+           VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, barriers, 0, VK_REMAINING_MIP_LEVELS, 2, 1)
+       != 3)
+    {
+        return false;
+    }
+
+    // Layers 0 and 1 share the same states, layer 2 differs
+    barriers.clear();
+    if(tracker.transition(
+           VK_NULL_HANDLE, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_2_COPY_BIT,
+           VK_ACCESS_2_TRANSFER_READ_BIT, barriers)
+       != 4)
+    {
+        return false;
+    }
+
+    static constexpr VkImageLayout srcLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    static constexpr VkImageLayout dstLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    const bool layerRuns = checkBarrier(barriers[0], dstLayout, srcLayout, 0, 1, 0, 2)
+                           && checkBarrier(barriers[1], VK_IMAGE_LAYOUT_GENERAL, srcLayout, 1, 1, 0, 2)
+                           && checkBarrier(barriers[2], dstLayout, srcLayout, 2, 2, 0, 2)
+                           && checkBarrier(
+                               barriers[3], VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, srcLayout, 0, 4, 2, 1);
+    if(!layerRuns) { return false; }
+
+    for(uint32_t layer = 0; layer < tracker.arrayLayers(); ++layer)
+    {
+        for(uint32_t level = 0; level < tracker.mipLevels(); ++level)
+        {
+            if(tracker.state(level, layer).layout != VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) { return false; }
+        }
+    }
+    return true;
+}
+
+bool testReset()
+{
+    vkw::ImageLayoutTracker tracker{};
+    VKW_CHECK_BOOL_RETURN_FALSE(tracker.init(3, 2, VK_IMAGE_ASPECT_COLOR_BIT));
+
+    std::vector<VkImageMemoryBarrier2> barriers{};
+    tracker.transition(
+        VK_NULL_HANDLE, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_2_COPY_BIT,
+        VK_ACCESS_2_TRANSFER_WRITE_BIT, barriers);
+
+    // The reset range forgets its accesses, the rest is untouched
+    tracker.reset(VK_IMAGE_LAYOUT_GENERAL, 1, 2, 1, 1);
+    for(uint32_t layer = 0; layer < 2; ++layer)
+    {
+        for(uint32_t level = 0; level < 3; ++level)
+        {
+            const auto& state = tracker.state(level, layer);
+            const bool isReset = (layer == 1 && level >= 1);
+            if(isReset && !(state == vkw::ImageLayoutTracker::SubresourceState{VK_IMAGE_LAYOUT_GENERAL}))
+            {
+                return false;
+            }
+            if(!isReset && state.layout != VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) { return false; }
+        }
+    }
+
+    // Reset subresources are transitioned from their new layout without waiting on anything
+    barriers.clear();
+    if(tracker.transition(
+           VK_NULL_HANDLE, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_2_COPY_BIT,
+           VK_ACCESS_2_TRANSFER_READ_BIT, barriers, 0, VK_REMAINING_MIP_LEVELS, 1, 1)
+       != 2)
+    {
+        return false;
+    }
+    return checkBarrier(
+               barriers[1], VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, 1, 2, 1, 1)
+           && barriers[1].srcStageMask == VK_PIPELINE_STAGE_2_NONE;
+}
+
+bool testAspectMask()
+{
+    return vkw::ImageLayoutTracker::getAspectMask(VK_FORMAT_R8G8B8A8_UNORM) == VK_IMAGE_ASPECT_COLOR_BIT
+           && vkw::ImageLayoutTracker::getAspectMask(VK_FORMAT_D32_SFLOAT) == VK_IMAGE_ASPECT_DEPTH_BIT
+           && vkw::ImageLayoutTracker::getAspectMask(VK_FORMAT_S8_UINT) == VK_IMAGE_ASPECT_STENCIL_BIT
+           && vkw::ImageLayoutTracker::getAspectMask(VK_FORMAT_D24_UNORM_S8_UINT)
+                  == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT);
+}
+
+bool testTrackedCopies(const vkw::Device& device)
+{
+    static constexpr uint32_t w = 64;
+    static constexpr uint32_t h = 32;
+    static constexpr uint32_t layers = 2;
+    static constexpr size_t count = size_t(w) * h * layers;
+
+    vkw::DeviceImage<> image{
+        device, VK_IMAGE_TYPE_2D, VK_FORMAT_R32_UINT, VkExtent3D{w, h, 1},
+        VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, VK_SAMPLE_COUNT_1_BIT, layers};
+    VKW_CHECK_BOOL_RETURN_FALSE(image.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(image.enableLayoutTracking());
+
+    std::vector<uint32_t> data(count);
+    for(size_t i = 0; i < count; ++i)
+    {
+        data[i] = static_cast<uint32_t>(3 * i + 1);
+    }
+
+    vkw::HostStagingBuffer<uint32_t> uploadBuffer{device, count, VK_BUFFER_USAGE_TRANSFER_SRC_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer.copyFromHost(data.data(), count));
+    vkw::HostStagingBuffer<uint32_t> readbackBuffer{device, count, VK_BUFFER_USAGE_TRANSFER_DST_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(readbackBuffer.initialized());
+
+    const auto recordFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        VkBufferImageCopy region = {};
+        region.bufferOffset = 0;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, layers};
+        region.imageOffset = {0, 0, 0};
+        region.imageExtent = {w, h, 1};
+
+        cmdBuffer.transition(
+            image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_2_COPY_BIT,
+            VK_ACCESS_2_TRANSFER_WRITE_BIT);
+        cmdBuffer.copyBufferToImage(uploadBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, region);
+
+        // Each layer is transitioned separately, the tracker keeps the per layer state
+        for(uint32_t layer = 0; layer < layers; ++layer)
+        {
+            cmdBuffer.transition(
+                image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_2_COPY_BIT,
+                VK_ACCESS_2_TRANSFER_READ_BIT, 0, 1, layer, 1);
+        }
+        cmdBuffer.copyImageToBuffer(image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readbackBuffer, region);
+
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Transfer, recordFn));
+
+    const auto* tracker = image.layoutTracker();
+    if(tracker == nullptr || tracker->state(0, 1).layout != VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL)
+    {
+        return false;
+    }
+
+    std::vector<uint32_t> result(count);
+    VKW_CHECK_BOOL_RETURN_FALSE(readbackBuffer.copyToHost(result.data(), count));
+
+    return result == data;
+}
+
+bool checkBarrier(
+    const VkImageMemoryBarrier2& barrier, const VkImageLayout oldLayout, const VkImageLayout newLayout,
+    const uint32_t baseLevel, const uint32_t levelCount, const uint32_t baseLayer, const uint32_t layerCount)
+{
+    return barrier.oldLayout == oldLayout && barrier.newLayout == newLayout
+           && barrier.subresourceRange.baseMipLevel == baseLevel
+           && barrier.subresourceRange.levelCount == levelCount
+           && barrier.subresourceRange.baseArrayLayer == baseLayer
+           && barrier.subresourceRange.layerCount == layerCount;
+}
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "ImagePoolTest";
+
+static bool testReuse(const vkw::Device& device);
+
+static bool testAging(const vkw::Device& device);
+
+static bool testTrim(const vkw::Device& device);
+
+static bool testDescriptions(const vkw::Device& device);
+
+static bool testPooledImageContent(const vkw::Device& device);
+
+static vkw::ImagePool::Description colorDescription(const uint32_t w, const uint32_t h);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchImagePoolTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(device.init(instance, physicalDevice, {}, {}));
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    vkw::utils::Log::Info(testName, "Checking image reuse...");
+    if(!testReuse(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Reuse - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking unused images aging...");
+    if(!testAging(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Aging - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking trim...");
+    if(!testTrim(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Trim - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking image descriptions...");
+    if(!testDescriptions(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Descriptions - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking pooled image content...");
+    if(!testPooledImageContent(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Content - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testReuse(const vkw::Device& device)
+{
+    vkw::ImagePool pool{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(pool.initialized());
+
+    const auto desc = colorDescription(64, 64);
+
+    // Images in use are never handed out twice
+    const auto image0 = pool.acquire(desc);
+    const auto image1 = pool.acquire(desc);
+    if(!image0.valid() || !image1.valid() || image0.view == VK_NULL_HANDLE) { return false; }
+    if(image0.id == image1.id || image0.image == image1.image || pool.imageCount() != 2) { return false; }
+
+    // A released image is reused in the same frame
+    pool.release(image0);
+    const auto image2 = pool.acquire(desc);
+    if(image2.id != image0.id || image2.image != image0.image || image2.view != image0.view) { return false; }
+
+    // Different descriptions never share images
+    const auto image3 = pool.acquire(colorDescription(64, 32));
+    if(!image3.valid() || image3.id == image0.id || image3.id == image1.id || pool.imageCount() != 3)
+    {
+        return false;
+    }
+    if(image3.image->extent().height != 32) { return false; }
+
+    // Releasing an unknown image is ignored
+    pool.release(vkw::ImagePool::PooledImage{});
+    return pool.imageCount() == 3;
+}
+
+bool testAging(const vkw::Device& device)
+{
+    static constexpr uint32_t maxUnusedFrames = 2;
+
+    vkw::ImagePool pool{device, maxUnusedFrames};
+    VKW_CHECK_BOOL_RETURN_FALSE(pool.initialized());
+
+    const auto desc = colorDescription(32, 32);
+
+    const auto kept = pool.acquire(desc);
+    const auto released = pool.acquire(desc);
+    if(!kept.valid() || !released.valid()) { return false; }
+    pool.release(released);
+
+    // Free images survive maxUnusedFrames frames
+    for(uint32_t i = 0; i < maxUnusedFrames; ++i)
+    {
+        if(pool.nextFrame() != 0) { return false; }
+    }
+
+    // Acquiring the image again refreshes its age
+    const auto reacquired = pool.acquire(desc);
+    if(reacquired.id != released.id) { return false; }
+    pool.release(reacquired);
+    for(uint32_t i = 0; i < maxUnusedFrames; ++i)
+    {
+        if(pool.nextFrame() != 0) { return false; }
+    }
+
+    // Destroyed once unused for longer, images in use are kept
+    if(pool.nextFrame() != 1 || pool.imageCount() != 1) { return false; }
+    for(uint32_t i = 0; i < 2 * maxUnusedFrames; ++i)
+    {
+        if(pool.nextFrame() != 0) { return false; }
+    }
+    if(pool.frameIndex() != 4 * maxUnusedFrames + 1) { return false; }
+
+    // The destroyed image is recreated with a new id
+    const auto recreated = pool.acquire(desc);
+    return recreated.valid() && recreated.id != released.id && recreated.id != kept.id
+           && pool.imageCount() == 2;
+}
+
+bool testTrim(const vkw::Device& device)
+{
+    vkw::ImagePool pool{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(pool.initialized());
+
+    const auto image0 = pool.acquire(colorDescription(16, 16));
+    const auto image1 = pool.acquire(colorDescription(16, 16));
+    const auto image2 = pool.acquire(colorDescription(8, 8));
+    if(!image0.valid() || !image1.valid() || !image2.valid()) { return false; }
+
+    pool.release(image1);
+    pool.release(image2);
+
+    // Only the free images are destroyed
+    pool.trim();
+    if(pool.imageCount() != 1) { return false; }
+
+    const auto image3 = pool.acquire(colorDescription(16, 16));
+    if(!image3.valid() || image3.id == image0.id || image3.id == image1.id) { return false; }
+
+    // Releasing a trimmed image is ignored
+    pool.release(image1);
+    return pool.imageCount() == 2;
+}
+
+bool testDescriptions(const vkw::Device& device)
+{
+    vkw::ImagePool pool{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(pool.initialized());
+
+    // Equal descriptions hash the same
+    const auto desc = colorDescription(128, 64);
+    auto otherDesc = desc;
+    const vkw::ImagePool::DescriptionHash hash{};
+    if(!(otherDesc == desc) || hash(otherDesc) != hash(desc)) { return false; }
+    otherDesc.usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+    if(otherDesc == desc) { return false; }
+
+    // Transient attachments, backed by lazily allocated memory if available
+    vkw::ImagePool::Description transientDesc = {};
+    transientDesc.format = VK_FORMAT_R8G8B8A8_UNORM;
+    transientDesc.extent = {256, 256, 1};
+    transientDesc.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+    const auto transientImage = pool.acquire(transientDesc);
+    if(!transientImage.valid() || transientImage.view == VK_NULL_HANDLE) { return false; }
+
+    // Depth formats get a depth view
+    vkw::ImagePool::Description depthDesc = {};
+    depthDesc.format = VK_FORMAT_D32_SFLOAT;
+    depthDesc.extent = {256, 256, 1};
+    depthDesc.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    const auto depthImage = pool.acquire(depthDesc);
+    if(!depthImage.valid() || depthImage.view == VK_NULL_HANDLE) { return false; }
+
+    // Cube views need cube compatible images
+    vkw::ImagePool::Description cubeDesc = {};
+    cubeDesc.format = VK_FORMAT_R8G8B8A8_UNORM;
+    cubeDesc.extent = {32, 32, 1};
+    cubeDesc.usage = VK_IMAGE_USAGE_SAMPLED_BIT;
+    cubeDesc.mipLevels = 6;
+    cubeDesc.arrayLayers = 6;
+    cubeDesc.viewType = VK_IMAGE_VIEW_TYPE_CUBE;
+    const auto cubeImage = pool.acquire(cubeDesc);
+    if(!cubeImage.valid() || cubeImage.view == VK_NULL_HANDLE) { return false; }
+
+    return cubeImage.image->arrayLayers() == 6 && cubeImage.image->mipLevels() == 6
+           && pool.imageCount() == 3;
+}
+
+bool testPooledImageContent(const vkw::Device& device)
+{
+    static constexpr uint32_t w = 64;
+    static constexpr uint32_t h = 32;
+
+    vkw::ImagePool pool{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(pool.initialized());
+
+    const auto desc = colorDescription(w, h);
+
+    std::vector<uint32_t> data(w * h);
+    for(uint32_t i = 0; i < w * h; ++i)
+    {
+        data[i] = 5 * i + 2;
+    }
+
+    // The content is undefined after a release, each use starts from the undefined layout
+    for(uint32_t i = 0; i < 2; ++i)
+    {
+        const auto pooledImage = pool.acquire(desc);
+        if(!pooledImage.valid()) { return false; }
+
+        auto& image = *pooledImage.image;
+        VKW_CHECK_BOOL_RETURN_FALSE(
+            changeImageLayout(device, image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL));
+        VKW_CHECK_BOOL_RETURN_FALSE(uploadImage<uint32_t>(device, data.data(), image, w, h));
+
+        std::vector<uint32_t> result(w * h);
+        VKW_CHECK_BOOL_RETURN_FALSE(downloadImage<uint32_t>(device, image, result.data(), w, h));
+        if(result != data) { return false; }
+
+        pool.release(pooledImage);
+        for(auto& val : data)
+        {
+            val = ~val;
+        }
+    }
+
+    return pool.imageCount() == 1;
+}
+
+vkw::ImagePool::Description colorDescription(const uint32_t w, const uint32_t h)
+{
+    vkw::ImagePool::Description desc = {};
+    desc.imageType = VK_IMAGE_TYPE_2D;
+    desc.format = VK_FORMAT_R32_UINT;
+    desc.extent = {w, h, 1};
+    desc.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    desc.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    return desc;
+}
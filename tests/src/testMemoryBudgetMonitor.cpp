@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "MemoryBudgetMonitorTest";
+
+// Two heaps of 1000 bytes, the monitor reads the budgets from this stub instead of the device
+using BudgetStub = std::shared_ptr<std::vector<vkw::MemoryBudget>>;
+
+static bool testEvictionOrder(const vkw::Device& device);
+
+static bool testHighWaterMarks(const vkw::Device& device);
+
+static bool testUpdateEviction(const vkw::Device& device);
+
+static bool initMonitor(vkw::MemoryBudgetMonitor& monitor, const vkw::Device& device, const BudgetStub& stub);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchMemoryBudgetMonitorTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(device.init(instance, physicalDevice, {}, {}));
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    vkw::utils::Log::Info(testName, "Checking eviction order...");
+    if(!testEvictionOrder(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Eviction order - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking high-water marks...");
+    if(!testHighWaterMarks(device))
+    {
+        vkw::utils::Log::Warning(testName, "  High-water marks - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking update eviction...");
+    if(!testUpdateEviction(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Update eviction - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testEvictionOrder(const vkw::Device& device)
+{
+    auto stub = std::make_shared<std::vector<vkw::MemoryBudget>>(2, vkw::MemoryBudget{1000, 0});
+
+    vkw::MemoryBudgetMonitor monitor{};
+    VKW_CHECK_BOOL_RETURN_FALSE(initMonitor(monitor, device, stub));
+
+    std::vector<vkw::MemoryBudgetMonitor::EvictableId> evicted{};
+    const auto onEvict = [&evicted](const vkw::MemoryBudgetMonitor::EvictableId id) -> VkDeviceSize {
+        evicted.push_back(id);
+        return 100;
+    };
+
+    const auto a = monitor.registerEvictable(0, 100, onEvict);
+    const auto b = monitor.registerEvictable(0, 100, onEvict);
+    const auto c = monitor.registerEvictable(0, 100, onEvict);
+    const auto d = monitor.registerEvictable(1, 100, onEvict);
+    if(monitor.evictableCount() != 4) { return false; }
+
+    // Least recently used first: b, c, then a that was touched after them
+    monitor.touch(a);
+    if(monitor.evict(0, 150) != 200) { return false; }
+    if(evicted != std::vector<vkw::MemoryBudgetMonitor::EvictableId>{b, c}) { return false; }
+    if(monitor.evictableCount() != 2) { return false; }
+
+    // Only resources of the requested heap are evicted
+    evicted.clear();
+    if(monitor.evict(0, 1000) != 100) { return false; }
+    if(evicted != std::vector<vkw::MemoryBudgetMonitor::EvictableId>{a}) { return false; }
+
+    // Unregistered resources are not evicted
+    evicted.clear();
+    monitor.unregisterEvictable(d);
+    if(monitor.evict(1, 100) != 0 || !evicted.empty()) { return false; }
+
+    return monitor.evictableCount() == 0;
+}
+
+bool testHighWaterMarks(const vkw::Device& device)
+{
+    auto stub = std::make_shared<std::vector<vkw::MemoryBudget>>(2, vkw::MemoryBudget{1000, 0});
+
+    vkw::MemoryBudgetMonitor monitor{};
+    VKW_CHECK_BOOL_RETURN_FALSE(initMonitor(monitor, device, stub));
+
+    struct Notification
+    {
+        uint32_t heapIndex;
+        VkDeviceSize usedSize;
+        bool rising;
+    };
+    std::vector<Notification> notifications{};
+    monitor.addHighWaterMark(
+        0.5f, [&notifications](const uint32_t heapIndex, const vkw::MemoryBudget& budget, const bool rising) {
+            notifications.push_back({heapIndex, budget.usedSize, rising});
+        });
+
+    // Crossing the mark upwards notifies once
+    (*stub)[0].usedSize = 600;
+    monitor.update();
+    monitor.update();
+    if(notifications.size() != 1) { return false; }
+    if(notifications[0].heapIndex != 0 || notifications[0].usedSize != 600 || !notifications[0].rising)
+    {
+        return false;
+    }
+
+    // Going back below the mark notifies again
+    (*stub)[0].usedSize = 400;
+    monitor.update();
+    if(notifications.size() != 2 || notifications[1].heapIndex != 0 || notifications[1].rising)
+    {
+        return false;
+    }
+
+    // Heaps are tracked separately
+    (*stub)[1].usedSize = 500;
+    monitor.update();
+    if(notifications.size() != 3 || notifications[2].heapIndex != 1 || !notifications[2].rising)
+    {
+        return false;
+    }
+
+    return monitor.usageRatio(0) == 0.4f && monitor.usageRatio(1) == 0.5f;
+}
+
+bool testUpdateEviction(const vkw::Device& device)
+{
+    auto stub = std::make_shared<std::vector<vkw::MemoryBudget>>(2, vkw::MemoryBudget{1000, 0});
+
+    vkw::MemoryBudgetMonitor monitor{};
+    VKW_CHECK_BOOL_RETURN_FALSE(initMonitor(monitor, device, stub));
+    monitor.setEvictionThresholds(0.9f, 0.5f);
+
+    uint32_t markNotifications = 0;
+    monitor.addHighWaterMark(
+        0.9f, [&markNotifications](const uint32_t, const vkw::MemoryBudget&, const bool) {
+            markNotifications++;
+        });
+
+    // Evicted resources release their memory from the stubbed heap
+    std::vector<vkw::MemoryBudgetMonitor::EvictableId> evicted{};
+    const auto onEvict = [&evicted, stub](const vkw::MemoryBudgetMonitor::EvictableId id) -> VkDeviceSize {
+        evicted.push_back(id);
+        (*stub)[0].usedSize -= 300;
+        return 300;
+    };
+    const auto a = monitor.registerEvictable(0, 300, onEvict);
+    const auto b = monitor.registerEvictable(0, 300, onEvict);
+    const auto c = monitor.registerEvictable(0, 300, onEvict);
+    monitor.touch(a);
+
+    // Below the threshold, nothing is evicted
+    (*stub)[0].usedSize = 850;
+    if(monitor.update() != 0 || !evicted.empty()) { return false; }
+
+    // Above the threshold, 950 - 500 bytes must be released: b and c, the least recently used
+    (*stub)[0].usedSize = 950;
+    if(monitor.update() != 600) { return false; }
+    if(evicted != std::vector<vkw::MemoryBudgetMonitor::EvictableId>{b, c}) { return false; }
+    if(monitor.evictableCount() != 1 || monitor.budget(0).usedSize != 350) { return false; }
+
+    // The marks see the usage after eviction, which never stayed above 0.9
+    return markNotifications == 0;
+}
+
+bool initMonitor(vkw::MemoryBudgetMonitor& monitor, const vkw::Device& device, const BudgetStub& stub)
+{
+    VKW_CHECK_BOOL_RETURN_FALSE(monitor.init(device));
+    monitor.setBudgetQuery([stub]() { return *stub; });
+    return monitor.heapCount() == stub->size();
+}
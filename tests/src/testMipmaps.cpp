@@ -0,0 +1,487 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <span>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "MipmapsTest";
+
+struct MipFormat
+{
+    VkFormat format;
+    uint32_t channels;
+};
+
+static bool testGenerateMipmaps(
+    const vkw::Device& device, const MipFormat& format, vkw::MipmapGenerator* computeFallback,
+    const std::vector<VkExtent2D>& extents, const uint32_t layers);
+
+static bool testMipmapGenerator(
+    const vkw::Device& device, vkw::MipmapGenerator& generator, const VkExtent2D extent,
+    const uint32_t layers);
+
+static bool blitSupported(const VkPhysicalDevice physicalDevice, const VkFormat format);
+
+static bool computeSupported(const VkPhysicalDevice physicalDevice, const VkFormat format);
+
+static uint32_t mipLevelCount(const VkExtent2D extent);
+
+static size_t levelSize(
+    const VkExtent2D extent, const uint32_t level, const uint32_t layers, const uint32_t channels);
+
+static std::vector<float> generateLevel0(
+    const VkExtent2D extent, const uint32_t layers, const uint32_t channels);
+
+static std::vector<std::vector<float>> referenceMipmaps(
+    const std::vector<float>& level0, const VkExtent2D extent, const uint32_t layers,
+    const uint32_t channels);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchMipmapsTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    // generateMipmaps() records synchronization2 barriers
+    VkPhysicalDeviceSynchronization2Features synchronization2Features = {};
+    synchronization2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES;
+    synchronization2Features.pNext = nullptr;
+
+    VkPhysicalDeviceFeatures2 availablePhysicalDeviceFeatures = {};
+    availablePhysicalDeviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    availablePhysicalDeviceFeatures.pNext = &synchronization2Features;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &availablePhysicalDeviceFeatures);
+
+    if(synchronization2Features.synchronization2 == VK_FALSE)
+    {
+        vkw::utils::Log::Info(testName, "Synchronization2 not available, skipping");
+        return true;
+    }
+
+    // The compute fallback binds its images with push descriptors, core in Vulkan 1.4
+    VkPhysicalDeviceProperties properties = {};
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    const bool computeAvailable
+        = properties.apiVersion >= VK_API_VERSION_1_4
+          && availablePhysicalDeviceFeatures.features.shaderStorageImageWriteWithoutFormat == VK_TRUE;
+
+    VkPhysicalDeviceFeatures enabledFeatures = {};
+    enabledFeatures.shaderStorageImageWriteWithoutFormat = computeAvailable ? VK_TRUE : VK_FALSE;
+
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        device.init(instance, physicalDevice, {}, enabledFeatures, &synchronization2Features));
+
+    vkw::MipmapGenerator generator{};
+    if(computeAvailable) { VKW_CHECK_BOOL_RETURN_FALSE(generator.init(device)); }
+
+    // Float formats only, the reference is computed with a box filter
+    const std::vector<MipFormat> formats
+        = {{VK_FORMAT_R32_SFLOAT, 1}, {VK_FORMAT_R32G32_SFLOAT, 2}, {VK_FORMAT_R32G32B32A32_SFLOAT, 4}};
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    // Linear blits of power of two extents are exact box filters. Images with different level counts are
+    // generated in the same call, the 1x1 image only changes layout.
+    vkw::utils::Log::Info(testName, "Checking blit mipmaps...");
+    for(const auto& format : formats)
+    {
+        if(!blitSupported(physicalDevice, format.format)) { continue; }
+
+        for(const uint32_t layers : {1, 3})
+        {
+            if(!testGenerateMipmaps(device, format, nullptr, {{32, 32}, {16, 8}, {1, 1}}, layers))
+            {
+                vkw::utils::Log::Warning(
+                    testName, "  Format %d, %u layers - FAILED", static_cast<int>(format.format), layers);
+                failedTests++;
+            }
+            totalTests++;
+        }
+    }
+
+    if(!computeAvailable)
+    {
+        vkw::utils::Log::Info(testName, "Compute fallback not available, skipping");
+        vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+        return true;
+    }
+
+    // Only formats without linear blits use the fallback in generateMipmaps()
+    vkw::utils::Log::Info(testName, "Checking compute fallback mipmaps...");
+    for(const auto& format : formats)
+    {
+        if(blitSupported(physicalDevice, format.format) || !computeSupported(physicalDevice, format.format))
+        {
+            continue;
+        }
+
+        if(!testGenerateMipmaps(device, format, &generator, {{32, 32}, {13, 7}}, 2))
+        {
+            vkw::utils::Log::Warning(testName, "  Format %d - FAILED", static_cast<int>(format.format));
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    // Recorded directly so that the compute path is covered on devices where every format can be blitted
+    vkw::utils::Log::Info(testName, "Checking mipmap generator...");
+    for(const VkExtent2D extent : {VkExtent2D{32, 32}, VkExtent2D{13, 7}, VkExtent2D{1, 9}})
+    {
+        if(!testMipmapGenerator(device, generator, extent, 2))
+        {
+            vkw::utils::Log::Warning(testName, "  Extent %ux%u - FAILED", extent.width, extent.height);
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testGenerateMipmaps(
+    const vkw::Device& device, const MipFormat& format, vkw::MipmapGenerator* computeFallback,
+    const std::vector<VkExtent2D>& extents, const uint32_t layers)
+{
+    static constexpr float tolerance = 1e-4f;
+
+    VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    if(computeFallback != nullptr) { usage |= VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT; }
+
+    std::vector<vkw::DeviceImage<>> images{};
+    images.reserve(extents.size());
+    std::vector<std::vector<float>> inputs{};
+    size_t inputSize = 0;
+    size_t outputSize = 0;
+    for(const auto extent : extents)
+    {
+        const uint32_t levels = mipLevelCount(extent);
+        images.emplace_back(
+            device, VK_IMAGE_TYPE_2D, format.format, VkExtent3D{extent.width, extent.height, 1}, usage,
+            VK_SAMPLE_COUNT_1_BIT, layers, VK_IMAGE_TILING_OPTIMAL, levels);
+        VKW_CHECK_BOOL_RETURN_FALSE(images.back().initialized());
+
+        inputs.emplace_back(generateLevel0(extent, layers, format.channels));
+        inputSize += inputs.back().size();
+        for(uint32_t level = 0; level < levels; ++level)
+        {
+            outputSize += levelSize(extent, level, layers, format.channels);
+        }
+    }
+
+    vkw::HostStagingBuffer<float> uploadBuffer{device, inputSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer.initialized());
+    vkw::HostStagingBuffer<float> readbackBuffer{device, outputSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(readbackBuffer.initialized());
+
+    size_t offset = 0;
+    for(const auto& input : inputs)
+    {
+        VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer.copyFromHost(input.data(), offset, input.size()));
+        offset += input.size();
+    }
+
+    const auto recordFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        std::vector<std::reference_wrapper<const vkw::BaseImage>> imageRefs{};
+
+        size_t inputOffset = 0;
+        for(size_t i = 0; i < images.size(); ++i)
+        {
+            const auto& image = images[i];
+            cmdBuffer.imageMemoryBarrier(
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                vkw::createImageMemoryBarrier(
+                    image, 0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED,
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, layers));
+
+            VkBufferImageCopy region = {};
+            region.bufferOffset = inputOffset * sizeof(float);
+            region.bufferRowLength = 0;
+            region.bufferImageHeight = 0;
+            region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, layers};
+            region.imageOffset = {0, 0, 0};
+            region.imageExtent = {extents[i].width, extents[i].height, 1};
+            cmdBuffer.copyBufferToImage(uploadBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, region);
+
+            inputOffset += inputs[i].size();
+            imageRefs.emplace_back(image);
+        }
+
+        cmdBuffer.generateMipmaps(
+            imageRefs, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            computeFallback);
+
+        std::vector<VkBufferImageCopy> regions{};
+        size_t outputOffset = 0;
+        for(size_t i = 0; i < images.size(); ++i)
+        {
+            for(uint32_t level = 0; level < images[i].mipLevels(); ++level)
+            {
+                VkBufferImageCopy region = {};
+                region.bufferOffset = outputOffset * sizeof(float);
+                region.bufferRowLength = 0;
+                region.bufferImageHeight = 0;
+                region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, layers};
+                region.imageOffset = {0, 0, 0};
+                region.imageExtent
+                    = {std::max(extents[i].width >> level, 1u), std::max(extents[i].height >> level, 1u), 1};
+                regions.push_back(region);
+
+                outputOffset += levelSize(extents[i], level, layers, format.channels);
+            }
+            cmdBuffer.copyImageToBuffer(
+                images[i], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readbackBuffer,
+                std::span<VkBufferImageCopy>{regions});
+            regions.clear();
+        }
+
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Graphics, recordFn));
+
+    if(computeFallback != nullptr) { computeFallback->releaseViews(); }
+
+    std::vector<float> result(outputSize);
+    VKW_CHECK_BOOL_RETURN_FALSE(readbackBuffer.copyToHost(result.data(), outputSize));
+
+    size_t resultOffset = 0;
+    for(size_t i = 0; i < images.size(); ++i)
+    {
+        const auto reference = referenceMipmaps(inputs[i], extents[i], layers, format.channels);
+        for(const auto& level : reference)
+        {
+            for(size_t j = 0; j < level.size(); ++j)
+            {
+                if(std::abs(result[resultOffset + j] - level[j]) > tolerance) { return false; }
+            }
+            resultOffset += level.size();
+        }
+    }
+
+    return true;
+}
+
+bool testMipmapGenerator(
+    const vkw::Device& device, vkw::MipmapGenerator& generator, const VkExtent2D extent,
+    const uint32_t layers)
+{
+    static constexpr float tolerance = 1e-4f;
+
+    const uint32_t levels = mipLevelCount(extent);
+
+    static constexpr VkImageUsageFlags usage
+        = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT
+          | VK_IMAGE_USAGE_STORAGE_BIT;
+
+    vkw::DeviceImage<> image{
+        device, VK_IMAGE_TYPE_2D, VK_FORMAT_R32_SFLOAT, VkExtent3D{extent.width, extent.height, 1}, usage,
+        VK_SAMPLE_COUNT_1_BIT, layers, VK_IMAGE_TILING_OPTIMAL, levels};
+    VKW_CHECK_BOOL_RETURN_FALSE(image.initialized());
+    if(!generator.supports(image)) { return false; }
+
+    const auto input = generateLevel0(extent, layers, 1);
+    const auto reference = referenceMipmaps(input, extent, layers, 1);
+
+    size_t outputSize = 0;
+    for(const auto& level : reference)
+    {
+        outputSize += level.size();
+    }
+
+    vkw::HostStagingBuffer<float> uploadBuffer{device, input.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer.copyFromHost(input.data(), input.size()));
+    vkw::HostStagingBuffer<float> readbackBuffer{device, outputSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(readbackBuffer.initialized());
+
+    const auto recordFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        cmdBuffer.imageMemoryBarrier(
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            vkw::createImageMemoryBarrier(
+                image, 0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                VK_IMAGE_ASPECT_COLOR_BIT, 0, levels, 0, layers));
+
+        VkBufferImageCopy region = {};
+        region.bufferOffset = 0;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, layers};
+        region.imageOffset = {0, 0, 0};
+        region.imageExtent = {extent.width, extent.height, 1};
+        cmdBuffer.copyBufferToImage(uploadBuffer, image, VK_IMAGE_LAYOUT_GENERAL, region);
+
+        // Each level reads the previous one, everything stays in the general layout
+        for(uint32_t level = 1; level < levels; ++level)
+        {
+            cmdBuffer.memoryBarrier(
+                VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                vkw::createMemoryBarrier(
+                    VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT));
+            VKW_CHECK_BOOL_RETURN_FALSE(generator.record(cmdBuffer, image, level));
+        }
+
+        cmdBuffer.memoryBarrier(
+            VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            vkw::createMemoryBarrier(
+                VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT));
+
+        std::vector<VkBufferImageCopy> regions{};
+        size_t outputOffset = 0;
+        for(uint32_t level = 0; level < levels; ++level)
+        {
+            region.bufferOffset = outputOffset * sizeof(float);
+            region.imageSubresource.mipLevel = level;
+            region.imageExtent
+                = {std::max(extent.width >> level, 1u), std::max(extent.height >> level, 1u), 1};
+            regions.push_back(region);
+
+            outputOffset += reference[level].size();
+        }
+        cmdBuffer.copyImageToBuffer(
+            image, VK_IMAGE_LAYOUT_GENERAL, readbackBuffer, std::span<VkBufferImageCopy>{regions});
+
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Graphics, recordFn));
+
+    // Two views per generated level are kept alive until released
+    if(generator.pendingViewCount() != 2 * (levels - 1)) { return false; }
+    generator.releaseViews();
+    if(generator.pendingViewCount() != 0) { return false; }
+
+    std::vector<float> result(outputSize);
+    VKW_CHECK_BOOL_RETURN_FALSE(readbackBuffer.copyToHost(result.data(), outputSize));
+
+    size_t resultOffset = 0;
+    for(const auto& level : reference)
+    {
+        for(size_t j = 0; j < level.size(); ++j)
+        {
+            if(std::abs(result[resultOffset + j] - level[j]) > tolerance) { return false; }
+        }
+        resultOffset += level.size();
+    }
+
+    return true;
+}
+
+bool blitSupported(const VkPhysicalDevice physicalDevice, const VkFormat format)
+{
+    static constexpr VkFormatFeatureFlags blitFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT
+                                                         | VK_FORMAT_FEATURE_BLIT_DST_BIT
+                                                         | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+
+    VkFormatProperties formatProperties = {};
+    vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &formatProperties);
+    return (formatProperties.optimalTilingFeatures & blitFeatures) == blitFeatures;
+}
+
+bool computeSupported(const VkPhysicalDevice physicalDevice, const VkFormat format)
+{
+    static constexpr VkFormatFeatureFlags computeFeatures
+        = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT;
+
+    VkFormatProperties formatProperties = {};
+    vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &formatProperties);
+    return (formatProperties.optimalTilingFeatures & computeFeatures) == computeFeatures;
+}
+
+uint32_t mipLevelCount(const VkExtent2D extent)
+{
+    return static_cast<uint32_t>(std::floor(std::log2(std::max(extent.width, extent.height)))) + 1;
+}
+
+size_t levelSize(
+    const VkExtent2D extent, const uint32_t level, const uint32_t layers, const uint32_t channels)
+{
+    const size_t w = std::max(extent.width >> level, 1u);
+    const size_t h = std::max(extent.height >> level, 1u);
+    return w * h * layers * channels;
+}
+
+std::vector<float> generateLevel0(const VkExtent2D extent, const uint32_t layers, const uint32_t channels)
+{
+    std::vector<float> ret(levelSize(extent, 0, layers, channels));
+    for(size_t i = 0; i < ret.size(); ++i)
+    {
+        ret[i] = static_cast<float>((7 * i + 3) % 17) / 16.0f;
+    }
+    return ret;
+}
+
+std::vector<std::vector<float>> referenceMipmaps(
+    const std::vector<float>& level0, const VkExtent2D extent, const uint32_t layers,
+    const uint32_t channels)
+{
+    std::vector<std::vector<float>> ret{level0};
+
+    // 2x2 box filter, clamped at the border for odd extents
+    for(uint32_t level = 1; level < mipLevelCount(extent); ++level)
+    {
+        const auto& src = ret.back();
+        const uint32_t srcW = std::max(extent.width >> (level - 1), 1u);
+        const uint32_t srcH = std::max(extent.height >> (level - 1), 1u);
+        const uint32_t dstW = std::max(extent.width >> level, 1u);
+        const uint32_t dstH = std::max(extent.height >> level, 1u);
+
+        const auto srcValue = [&](const uint32_t layer, uint32_t x, uint32_t y, const uint32_t c) {
+            x = std::min(x, srcW - 1);
+            y = std::min(y, srcH - 1);
+            return src[((size_t(layer) * srcH + y) * srcW + x) * channels + c];
+        };
+
+        std::vector<float> dst(levelSize(extent, level, layers, channels));
+        for(uint32_t layer = 0; layer < layers; ++layer)
+        {
+            for(uint32_t y = 0; y < dstH; ++y)
+            {
+                for(uint32_t x = 0; x < dstW; ++x)
+                {
+                    for(uint32_t c = 0; c < channels; ++c)
+                    {
+                        const float sum = srcValue(layer, 2 * x, 2 * y, c)
+                                          + srcValue(layer, 2 * x + 1, 2 * y, c)
+                                          + srcValue(layer, 2 * x, 2 * y + 1, c)
+                                          + srcValue(layer, 2 * x + 1, 2 * y + 1, c);
+                        dst[((size_t(layer) * dstH + y) * dstW + x) * channels + c] = 0.25f * sum;
+                    }
+                }
+            }
+        }
+        ret.emplace_back(std::move(dst));
+    }
+
+    return ret;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "ParallelHostCopyTest";
+
+static bool testParallelFor(vkw::utils::ThreadPool& pool, const size_t n);
+
+template <vkw::MemoryType memType>
+static bool testParallelCopy(
+    const vkw::Device& device, vkw::utils::ThreadPool& pool, const size_t offset, const size_t count,
+    const size_t chunkSizeBytes);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchParallelHostCopyTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(device.init(instance, physicalDevice, {}, {}));
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    for(const size_t threadCount : {1, 4})
+    {
+        vkw::utils::ThreadPool pool{threadCount};
+        VKW_CHECK_BOOL_RETURN_FALSE(pool.initialized());
+
+        vkw::utils::Log::Info(testName, "Checking parallel for with %zu threads...", threadCount);
+        for(const size_t n : {0, 1, 7, 1000})
+        {
+            if(!testParallelFor(pool, n))
+            {
+                vkw::utils::Log::Warning(testName, "  Count %zu - FAILED", n);
+                failedTests++;
+            }
+            totalTests++;
+        }
+
+        // Copies smaller than a chunk, with a partial last chunk, and with unaligned offsets
+        struct CopyParams
+        {
+            size_t offset;
+            size_t count;
+            size_t chunkSizeBytes;
+        };
+        const std::vector<CopyParams> copies
+            = {{0, 100, 4096}, {0, 10000, 4096}, {3, 10000, 4096}, {1, 4096, 1024}, {5, 1 << 20, 1 << 16}};
+
+        vkw::utils::Log::Info(testName, "Checking parallel copies with %zu threads...", threadCount);
+        for(const auto& copy : copies)
+        {
+            bool ret = true;
+            ret &= testParallelCopy<vkw::MemoryType::Host>(
+                device, pool, copy.offset, copy.count, copy.chunkSizeBytes);
+            ret &= testParallelCopy<vkw::MemoryType::HostStaging>(
+                device, pool, copy.offset, copy.count, copy.chunkSizeBytes);
+            ret &= testParallelCopy<vkw::MemoryType::TransferHostDevice>(
+                device, pool, copy.offset, copy.count, copy.chunkSizeBytes);
+            if(!ret)
+            {
+                vkw::utils::Log::Warning(
+                    testName, "  Offset %zu, count %zu, chunk size %zu - FAILED", copy.offset, copy.count,
+                    copy.chunkSizeBytes);
+                failedTests++;
+            }
+            totalTests++;
+        }
+    }
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testParallelFor(vkw::utils::ThreadPool& pool, const size_t n)
+{
+    std::vector<std::atomic<uint32_t>> visits(n);
+    for(auto& visit : visits)
+    {
+        visit = 0;
+    }
+
+    pool.parallelFor(n, [&visits](const size_t i) { visits[i]++; });
+
+    // Each index is processed exactly once, and parallelFor() returns once they are all done
+    for(const auto& visit : visits)
+    {
+        if(visit != 1) { return false; }
+    }
+    return true;
+}
+
+template <vkw::MemoryType memType>
+bool testParallelCopy(
+    const vkw::Device& device, vkw::utils::ThreadPool& pool, const size_t offset, const size_t count,
+    const size_t chunkSizeBytes)
+{
+    // One extra element after the range checks that nothing is written past it
+    const size_t size = offset + count + 1;
+
+    vkw::Buffer<uint32_t, memType> buffer{
+        device, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(buffer.initialized());
+
+    std::vector<uint32_t> expected(size, 0xffffffff);
+    VKW_CHECK_BOOL_RETURN_FALSE(buffer.copyFromHost(expected.data(), size));
+
+    std::vector<uint32_t> data(count);
+    for(size_t i = 0; i < count; ++i)
+    {
+        data[i] = static_cast<uint32_t>(7 * i + 1);
+        expected[offset + i] = data[i];
+    }
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        buffer.copyFromHostParallel(pool, data.data(), offset, count, chunkSizeBytes));
+
+    std::vector<uint32_t> result(size);
+    VKW_CHECK_BOOL_RETURN_FALSE(buffer.copyToHost(result.data(), size));
+
+    return result == expected;
+}
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "RayTracingPipelineTest";
+
+static const uint32_t rayGenShader[] = {
+#include "spv/RayTracingTest.rgen.spv"
+};
+static const uint32_t missShader[] = {
+#include "spv/RayTracingTest.rmiss.spv"
+};
+static const uint32_t closestHitShader[] = {
+#include "spv/RayTracingTest.rchit.spv"
+};
+
+// Interface shared by the test pipelines and libraries: vec4 payload and vec2 hit attributes
+static constexpr uint32_t maxPayloadSize = 4 * sizeof(float);
+static constexpr uint32_t maxHitAttributeSize = 2 * sizeof(float);
+
+static bool testCacheRoundTrip(const vkw::Device& device);
+
+static bool testStaleCache(const vkw::Device& device);
+
+static bool testCacheMerge(const vkw::Device& device);
+
+static bool testPipelineClear(const vkw::Device& device);
+
+static bool testPipelineLibraries(const vkw::Device& device);
+
+static bool testCachedPipeline(const vkw::Device& device);
+
+// Adds the ray generation, miss and closest hit stages with one group each
+static bool addTestStages(vkw::RayTracingPipeline& pipeline);
+
+static bool sameHeader(const std::vector<uint8_t>& data, const uint8_t* other, const size_t size);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchRayTracingPipelineTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    {
+        vkw::Device device{};
+        VKW_CHECK_BOOL_RETURN_FALSE(device.init(instance, physicalDevice, {}, {}));
+
+        vkw::utils::Log::Info(testName, "Checking pipeline cache round trip...");
+        if(!testCacheRoundTrip(device))
+        {
+            vkw::utils::Log::Warning(testName, "  Pipeline cache round trip - FAILED");
+            failedTests++;
+        }
+        totalTests++;
+
+        vkw::utils::Log::Info(testName, "Checking stale pipeline cache...");
+        if(!testStaleCache(device))
+        {
+            vkw::utils::Log::Warning(testName, "  Stale pipeline cache - FAILED");
+            failedTests++;
+        }
+        totalTests++;
+
+        vkw::utils::Log::Info(testName, "Checking pipeline cache merge...");
+        if(!testCacheMerge(device))
+        {
+            vkw::utils::Log::Warning(testName, "  Pipeline cache merge - FAILED");
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    if(!rayTracingPipelineAvailable(physicalDevice))
+    {
+        vkw::utils::Log::Info(testName, "Ray tracing pipelines not available, skipping pipeline tests");
+        vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+        return true;
+    }
+
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(initRayTracingDevice(device, instance, physicalDevice));
+
+    vkw::utils::Log::Info(testName, "Checking pipeline clear...");
+    if(!testPipelineClear(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Pipeline clear - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking pipeline libraries...");
+    if(!testPipelineLibraries(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Pipeline libraries - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking cached pipeline...");
+    if(!testCachedPipeline(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Cached pipeline - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testCacheRoundTrip(const vkw::Device& device)
+{
+    vkw::PipelineCache cache{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(cache.initialized());
+
+    const auto data = cache.getData();
+    if(!vkw::PipelineCache::compatible(device, data.data(), data.size())) { return false; }
+
+    const std::string filename = "PipelineCacheTest.bin";
+    VKW_CHECK_BOOL_RETURN_FALSE(cache.save(filename));
+
+    bool ret = true;
+    {
+        vkw::MappedFile file{filename};
+        ret = file.initialized() && (file.size() == data.size())
+              && (memcmp(file.data(), data.data(), data.size()) == 0);
+
+        // The saved header matches the device, the data is handed to the driver
+        vkw::PipelineCache reloaded{};
+        ret = ret && reloaded.init(device, file);
+        if(ret)
+        {
+            const auto reloadedData = reloaded.getData();
+            ret = vkw::PipelineCache::compatible(device, reloadedData.data(), reloadedData.size())
+                  && sameHeader(data, reloadedData.data(), reloadedData.size());
+        }
+    }
+
+    remove(filename.c_str());
+    return ret;
+}
+
+bool testStaleCache(const vkw::Device& device)
+{
+    vkw::PipelineCache cache{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(cache.initialized());
+
+    const auto data = cache.getData();
+    if(data.size() < sizeof(VkPipelineCacheHeaderVersionOne)) { return false; }
+
+    // Cache produced by another driver version
+    auto staleData = data;
+    staleData[offsetof(VkPipelineCacheHeaderVersionOne, pipelineCacheUUID)] ^= 0xff;
+    if(vkw::PipelineCache::compatible(device, staleData.data(), staleData.size())) { return false; }
+
+    // Cache produced by another device
+    auto otherDeviceData = data;
+    otherDeviceData[offsetof(VkPipelineCacheHeaderVersionOne, deviceID)] ^= 0xff;
+    if(vkw::PipelineCache::compatible(device, otherDeviceData.data(), otherDeviceData.size()))
+    {
+        return false;
+    }
+
+    // Truncated or missing data
+    if(vkw::PipelineCache::compatible(device, data.data(), sizeof(VkPipelineCacheHeaderVersionOne) - 1))
+    {
+        return false;
+    }
+    if(vkw::PipelineCache::compatible(device, nullptr, data.size())) { return false; }
+
+    // Stale data is discarded, an empty cache is created instead
+    const std::string filename = "StalePipelineCacheTest.bin";
+    FILE* fp = fopen(filename.c_str(), "wb");
+    VKW_CHECK_BOOL_RETURN_FALSE(fp != nullptr);
+    fwrite(staleData.data(), 1, staleData.size(), fp);
+    fclose(fp);
+
+    bool ret = true;
+    {
+        vkw::MappedFile file{filename};
+        vkw::PipelineCache staleCache{};
+        ret = file.initialized() && staleCache.init(device, file);
+        if(ret)
+        {
+            const auto newData = staleCache.getData();
+            ret = vkw::PipelineCache::compatible(device, newData.data(), newData.size())
+                  && !sameHeader(staleData, newData.data(), newData.size());
+        }
+    }
+
+    remove(filename.c_str());
+    return ret;
+}
+
+bool testCacheMerge(const vkw::Device& device)
+{
+    vkw::PipelineCache cache{device};
+    vkw::PipelineCache srcCache0{device};
+    vkw::PipelineCache srcCache1{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(cache.initialized() && srcCache0.initialized() && srcCache1.initialized());
+
+    if(!cache.merge({})) { return false; }
+    if(!cache.merge({srcCache0, srcCache1})) { return false; }
+
+    const auto data = cache.getData();
+    return vkw::PipelineCache::compatible(device, data.data(), data.size());
+}
+
+bool testPipelineClear(const vkw::Device& device)
+{
+    vkw::PipelineLayout pipelineLayout{};
+    VKW_CHECK_BOOL_RETURN_FALSE(pipelineLayout.init(device));
+    VKW_CHECK_BOOL_RETURN_FALSE(pipelineLayout.create());
+
+    vkw::RayTracingPipeline pipeline{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.initialized());
+    pipeline.addDynamicState(VK_DYNAMIC_STATE_RAY_TRACING_PIPELINE_STACK_SIZE_KHR);
+    VKW_CHECK_BOOL_RETURN_FALSE(addTestStages(pipeline));
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.createPipeline(pipelineLayout, 1));
+    if(pipeline.groupCount() != 3 || pipeline.dynamicStateInfo().dynamicStateCount != 1) { return false; }
+
+    // Dynamic states and shader groups of the previous pipeline must not be reused after clear()
+    pipeline.clear();
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.init(device));
+    if(pipeline.getHandle() != VK_NULL_HANDLE || pipeline.groupCount() != 0) { return false; }
+
+    VKW_CHECK_BOOL_RETURN_FALSE(addTestStages(pipeline));
+    pipeline.setLibraryInterface(maxPayloadSize, maxHitAttributeSize);
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.createLibrary(pipelineLayout, 1));
+    if(!pipeline.isLibrary() || pipeline.groupCount() != 3) { return false; }
+    if(pipeline.dynamicStateInfo().dynamicStateCount != 0) { return false; }
+
+    // Same for the library state
+    pipeline.clear();
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.init(device));
+    if(pipeline.isLibrary() || pipeline.groupCount() != 0) { return false; }
+
+    VKW_CHECK_BOOL_RETURN_FALSE(addTestStages(pipeline));
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.createPipeline(pipelineLayout, 1));
+
+    return !pipeline.isLibrary() && pipeline.groupCount() == 3;
+}
+
+bool testPipelineLibraries(const vkw::Device& device)
+{
+    vkw::PipelineLayout pipelineLayout{};
+    VKW_CHECK_BOOL_RETURN_FALSE(pipelineLayout.init(device));
+    VKW_CHECK_BOOL_RETURN_FALSE(pipelineLayout.create());
+
+    // Libraries require an interface
+    vkw::RayTracingPipeline invalidLibrary{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(addTestStages(invalidLibrary));
+    if(invalidLibrary.createLibrary(pipelineLayout, 1)) { return false; }
+
+    // Miss and hit groups in a library
+    vkw::RayTracingPipeline hitLibrary{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(hitLibrary.addShaderStage(
+        VK_SHADER_STAGE_MISS_BIT_KHR, reinterpret_cast<const char*>(missShader), sizeof(missShader)));
+    VKW_CHECK_BOOL_RETURN_FALSE(hitLibrary.addShaderStage(
+        VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR, reinterpret_cast<const char*>(closestHitShader),
+        sizeof(closestHitShader)));
+    hitLibrary.addGeneralShaderGroup(0);
+    hitLibrary.addTriangleHitShaderGroup(1, VK_SHADER_UNUSED_KHR, VK_SHADER_UNUSED_KHR);
+    hitLibrary.setLibraryInterface(maxPayloadSize, maxHitAttributeSize);
+    VKW_CHECK_BOOL_RETURN_FALSE(hitLibrary.createLibrary(pipelineLayout, 1));
+    if(!hitLibrary.isLibrary() || hitLibrary.groupCount() != 2) { return false; }
+
+    // The library groups are numbered after the ray generation group of the pipeline
+    vkw::RayTracingPipeline pipeline{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.addShaderStage(
+        VK_SHADER_STAGE_RAYGEN_BIT_KHR, reinterpret_cast<const char*>(rayGenShader), sizeof(rayGenShader)));
+    pipeline.addGeneralShaderGroup(0);
+    pipeline.setLibraryInterface(maxPayloadSize, maxHitAttributeSize);
+    pipeline.addLibrary(hitLibrary);
+    if(pipeline.groupCount() != 3) { return false; }
+
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.createPipeline(pipelineLayout, 1));
+    if(pipeline.isLibrary()) { return false; }
+
+    const uint32_t handleSize = device.rayTracingPipelineProperties().shaderGroupHandleSize;
+    std::vector<uint8_t> handles(pipeline.groupCount() * handleSize);
+    return device.vk().vkGetRayTracingShaderGroupHandlesKHR(
+               device.getHandle(), pipeline.getHandle(), 0, pipeline.groupCount(), handles.size(),
+               handles.data())
+           == VK_SUCCESS;
+}
+
+bool testCachedPipeline(const vkw::Device& device)
+{
+    vkw::PipelineLayout pipelineLayout{};
+    VKW_CHECK_BOOL_RETURN_FALSE(pipelineLayout.init(device));
+    VKW_CHECK_BOOL_RETURN_FALSE(pipelineLayout.create());
+
+    vkw::PipelineCache cache{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(cache.initialized());
+
+    vkw::RayTracingPipeline pipeline{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(addTestStages(pipeline));
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.createPipeline(pipelineLayout, 1, {}, cache.getHandle()));
+
+    const std::string filename = "CachedPipelineTest.bin";
+    VKW_CHECK_BOOL_RETURN_FALSE(cache.save(filename));
+
+    // Same pipeline created again from the saved cache
+    bool ret = true;
+    {
+        vkw::MappedFile file{filename};
+        vkw::PipelineCache reloaded{};
+        ret = file.initialized() && reloaded.init(device, file);
+
+        vkw::RayTracingPipeline cachedPipeline{device};
+        ret = ret && addTestStages(cachedPipeline)
+              && cachedPipeline.createPipeline(pipelineLayout, 1, {}, reloaded.getHandle());
+    }
+
+    remove(filename.c_str());
+    return ret;
+}
+
+bool addTestStages(vkw::RayTracingPipeline& pipeline)
+{
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.addShaderStage(
+        VK_SHADER_STAGE_RAYGEN_BIT_KHR, reinterpret_cast<const char*>(rayGenShader), sizeof(rayGenShader)));
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.addShaderStage(
+        VK_SHADER_STAGE_MISS_BIT_KHR, reinterpret_cast<const char*>(missShader), sizeof(missShader)));
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.addShaderStage(
+        VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR, reinterpret_cast<const char*>(closestHitShader),
+        sizeof(closestHitShader)));
+
+    pipeline.addGeneralShaderGroup(0);
+    pipeline.addGeneralShaderGroup(1);
+    pipeline.addTriangleHitShaderGroup(2, VK_SHADER_UNUSED_KHR, VK_SHADER_UNUSED_KHR);
+
+    return true;
+}
+
+bool sameHeader(const std::vector<uint8_t>& data, const uint8_t* other, const size_t size)
+{
+    static constexpr size_t headerSize = sizeof(VkPipelineCacheHeaderVersionOne);
+    return data.size() >= headerSize && size >= headerSize && memcmp(data.data(), other, headerSize) == 0;
+}
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "RingBuffersTest";
+
+static bool testRingAllocatorWrapAround(const vkw::Device& device);
+
+static bool testRingAllocatorFull(const vkw::Device& device);
+
+static bool testReadbackRing(const vkw::Device& device, const size_t count, const uint32_t frameCount);
+
+static bool testStagingRing(const vkw::Device& device, const size_t count, const uint32_t frameCount);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchRingBuffersTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures = {};
+    timelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+    timelineFeatures.pNext = nullptr;
+
+    VkPhysicalDeviceFeatures2 availablePhysicalDeviceFeatures = {};
+    availablePhysicalDeviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    availablePhysicalDeviceFeatures.pNext = &timelineFeatures;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &availablePhysicalDeviceFeatures);
+
+    if(timelineFeatures.timelineSemaphore == VK_FALSE)
+    {
+        vkw::utils::Log::Info(testName, "Timeline semaphores not available, skipping");
+        return true;
+    }
+
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(device.init(instance, physicalDevice, {}, {}, &timelineFeatures));
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    vkw::utils::Log::Info(testName, "Checking ring allocator wrap around...");
+    if(!testRingAllocatorWrapAround(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Wrap around - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking ring allocator full ring...");
+    if(!testRingAllocatorFull(device))
+    {
+        vkw::utils::Log::Warning(testName, "  Full ring - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking readback ring...");
+    for(size_t count = 1000; count <= 1000000; count *= 10)
+    {
+        if(!testReadbackRing(device, count, 16))
+        {
+            vkw::utils::Log::Warning(testName, "  Count %zu - FAILED", count);
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    vkw::utils::Log::Info(testName, "Checking staging ring...");
+    for(size_t count = 1000; count <= 1000000; count *= 10)
+    {
+        if(!testStagingRing(device, count, 16))
+        {
+            vkw::utils::Log::Warning(testName, "  Count %zu - FAILED", count);
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testRingAllocatorWrapAround(const vkw::Device& device)
+{
+    vkw::TimelineSemaphore timeline{device, 0};
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.initialized());
+
+    vkw::RingAllocator allocator{};
+    VKW_CHECK_BOOL_RETURN_FALSE(allocator.init(timeline, 1024, testName));
+
+    const auto r1 = allocator.allocate(400, 1, 1);
+    const auto r2 = allocator.allocate(400, 1, 2);
+    if(r1.id == 0 || r1.offset != 0 || r2.id == 0 || r2.offset != 400) { return false; }
+
+    // No room at the end of the ring, the first region is reused once its value is reached
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.signal(1));
+    const auto r3 = allocator.allocate(400, 1, 3);
+    if(r3.id == 0 || r3.offset != 0 || allocator.regionCount() != 2) { return false; }
+
+    // Once r2 is done, the next region goes right after r3
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.signal(2));
+    const auto r4 = allocator.allocate(300, 256, 4);
+    if(r4.id == 0 || r4.offset != 512) { return false; }
+
+    // Everything completed, the ring restarts at the beginning
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.signal(4));
+    allocator.reclaim();
+    if(allocator.regionCount() != 0) { return false; }
+    const auto r5 = allocator.allocate(1024, 1, 5);
+    return r5.id != 0 && r5.offset == 0;
+}
+
+bool testRingAllocatorFull(const vkw::Device& device)
+{
+    vkw::TimelineSemaphore timeline{device, 0};
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.initialized());
+
+    vkw::RingAllocator allocator{};
+    VKW_CHECK_BOOL_RETURN_FALSE(allocator.init(timeline, 1024, testName));
+
+    // Larger than the ring
+    if(allocator.allocate(2048, 1, 1).id != 0) { return false; }
+
+    // The oldest region is not released, allocating must fail instead of waiting
+    const auto r1 = allocator.allocate(512, 1, 1, false);
+    const auto r2 = allocator.allocate(512, 1, 1);
+    if(r1.id == 0 || r2.id == 0) { return false; }
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.signal(1));
+    if(allocator.allocate(512, 1, 2).id != 0) { return false; }
+
+    // Released and completed regions are reused
+    allocator.release(r1.id);
+    const auto r3 = allocator.allocate(512, 1, 2);
+    if(r3.id == 0 || r3.offset != 0) { return false; }
+
+    // The oldest region is tagged with the value being allocated, waiting would never return
+    const auto r4 = allocator.allocate(512, 1, 2);
+    if(r4.id == 0 || r4.offset != 512) { return false; }
+    return allocator.allocate(512, 1, 2).id == 0;
+}
+
+bool testReadbackRing(const vkw::Device& device, const size_t count, const uint32_t frameCount)
+{
+    std::vector<uint32_t> data(count);
+    for(size_t i = 0; i < count; ++i)
+    {
+        data[i] = static_cast<uint32_t>(i);
+    }
+
+    vkw::DeviceBuffer<uint32_t> deviceBuffer{
+        device, count, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(deviceBuffer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer(device, data.data(), deviceBuffer, count));
+
+    vkw::TimelineSemaphore timeline{device, 0};
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.initialized());
+
+    // Room for a bit more than two readbacks in flight, the ring wraps around every other frame
+    const VkDeviceSize readbackSize = count * sizeof(uint32_t) / 2;
+    vkw::ReadbackRing ring{device, timeline, 5 * readbackSize / 2};
+    VKW_CHECK_BOOL_RETURN_FALSE(ring.initialized());
+
+    auto transferQueue = device.getQueues(vkw::QueueUsageBits::Transfer)[0];
+
+    vkw::CommandPool cmdPool{device, transferQueue};
+    VKW_CHECK_BOOL_RETURN_FALSE(cmdPool.initialized());
+
+    std::vector<vkw::ReadbackFuture<uint32_t>> futures{};
+    for(uint32_t frame = 1; frame <= frameCount; ++frame)
+    {
+        // Alternate between both halves of the buffer
+        const size_t offset = (frame % 2) * (count / 2);
+
+        auto cmdBuffer = cmdPool.createCommandBuffer();
+        cmdBuffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+        auto future = cmdBuffer.readback<uint32_t>(ring, deviceBuffer, offset, count / 2, frame);
+        cmdBuffer.end();
+        VKW_CHECK_BOOL_RETURN_FALSE(future.valid());
+
+        vkw::Fence fence{device};
+        VKW_CHECK_BOOL_RETURN_FALSE(fence.initialized());
+        VKW_CHECK_VK_RETURN_FALSE(transferQueue.submit(
+            cmdBuffer, timeline, VK_PIPELINE_STAGE_TRANSFER_BIT, frame - 1, frame, fence));
+        VKW_CHECK_BOOL_RETURN_FALSE(fence.wait());
+
+        // Keep the previous readback alive one more frame before checking it
+        futures.emplace_back(std::move(future));
+        if(futures.size() == 2)
+        {
+            auto& oldest = futures.front();
+            VKW_CHECK_BOOL_RETURN_FALSE(oldest.wait());
+
+            const size_t oldestOffset = ((frame - 1) % 2) * (count / 2);
+            const auto result = oldest.get();
+            if(memcmp(result.data(), data.data() + oldestOffset, result.size_bytes()) != 0) { return false; }
+
+            oldest.release();
+            futures.erase(futures.begin());
+        }
+    }
+
+    return true;
+}
+
+bool testStagingRing(const vkw::Device& device, const size_t count, const uint32_t frameCount)
+{
+    vkw::DeviceBuffer<uint32_t> deviceBuffer{
+        device, count, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(deviceBuffer.initialized());
+
+    vkw::TimelineSemaphore timeline{device, 0};
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.initialized());
+
+    // Uploads of 1/3 of the buffer in a ring holding a bit more than one of them: each frame wraps around
+    // and waits for the previous one
+    const size_t uploadCount = count / 3;
+    const VkDeviceSize uploadSize = uploadCount * sizeof(uint32_t);
+    vkw::StagingRing ring{device, timeline, 3 * uploadSize / 2};
+    VKW_CHECK_BOOL_RETURN_FALSE(ring.initialized());
+
+    auto transferQueue = device.getQueues(vkw::QueueUsageBits::Transfer)[0];
+
+    vkw::CommandPool cmdPool{device, transferQueue};
+    VKW_CHECK_BOOL_RETURN_FALSE(cmdPool.initialized());
+
+    std::vector<uint32_t> expected(count, 0);
+    std::vector<vkw::CommandBuffer> cmdBuffers{};
+    for(uint32_t frame = 1; frame <= frameCount; ++frame)
+    {
+        const size_t offset = (frame % 3) * uploadCount;
+
+        const auto allocation = ring.allocate(uploadSize, sizeof(uint32_t), frame);
+        VKW_CHECK_BOOL_RETURN_FALSE(allocation.valid());
+
+        auto* dst = reinterpret_cast<uint32_t*>(allocation.data);
+        for(size_t i = 0; i < uploadCount; ++i)
+        {
+            dst[i] = frame * 100000 + static_cast<uint32_t>(i);
+            expected[offset + i] = dst[i];
+        }
+        VKW_CHECK_BOOL_RETURN_FALSE(ring.flush(allocation));
+
+        VkBufferCopy region = {allocation.offset, offset * sizeof(uint32_t), uploadSize};
+
+        auto cmdBuffer = cmdPool.createCommandBuffer();
+        cmdBuffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+        cmdBuffer.copyBuffer(ring.buffer(), deviceBuffer, std::span<VkBufferCopy>{&region, 1});
+        cmdBuffer.end();
+
+        // No fence: the ring itself waits on the timeline when it needs the space back
+        VKW_CHECK_VK_RETURN_FALSE(
+            transferQueue.submit(cmdBuffer, timeline, VK_PIPELINE_STAGE_TRANSFER_BIT, frame - 1, frame));
+        cmdBuffers.emplace_back(std::move(cmdBuffer));
+    }
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.wait(frameCount));
+
+    std::vector<uint32_t> result(count);
+    VKW_CHECK_BOOL_RETURN_FALSE(downloadBuffer(device, deviceBuffer, result.data(), count));
+
+    return result == expected;
+}
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "ShaderBindingTableTest";
+
+static const uint32_t rayGenShader[] = {
+#include "spv/RayTracingTest.rgen.spv"
+};
+static const uint32_t missShader[] = {
+#include "spv/RayTracingTest.rmiss.spv"
+};
+static const uint32_t closestHitShader[] = {
+#include "spv/RayTracingTest.rchit.spv"
+};
+
+using Region = vkw::ShaderBindingTable::Region;
+
+// Groups of the test pipeline
+static constexpr uint32_t rayGenGroup = 0;
+static constexpr uint32_t missGroup = 1;
+static constexpr uint32_t hitGroup = 2;
+
+// Inline data size of each record, per region
+struct RecordLayout
+{
+    std::vector<uint32_t> rayGen;
+    std::vector<uint32_t> miss;
+    std::vector<uint32_t> hit;
+};
+
+static bool testLayout(
+    const vkw::Device& device, const vkw::RayTracingPipeline& pipeline, const RecordLayout& layout);
+
+static bool testIndirectCommand(const vkw::Device& device, const vkw::RayTracingPipeline& pipeline);
+
+static bool testDirtyRecords(const vkw::Device& device, const vkw::RayTracingPipeline& pipeline);
+
+static bool testInvalidTables(const vkw::Device& device, const vkw::RayTracingPipeline& pipeline);
+
+static bool testTraceRays(
+    const vkw::Device& device, const vkw::RayTracingPipeline& pipeline, const RecordLayout& layout);
+
+static bool createTable(
+    const vkw::Device& device, const vkw::RayTracingPipeline& pipeline, const RecordLayout& layout,
+    vkw::ShaderBindingTable& sbt);
+
+// Checks the region against the alignment rules and the records it holds
+static bool validRegion(
+    const vkw::Device& device, const VkStridedDeviceAddressRegionKHR& region, const VkDeviceSize alignment,
+    const std::vector<uint32_t>& dataSizes);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchShaderBindingTableTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    if(!rayTracingPipelineAvailable(physicalDevice))
+    {
+        vkw::utils::Log::Info(testName, "Ray tracing pipelines not available, skipping");
+        return true;
+    }
+
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(initRayTracingDevice(device, instance, physicalDevice));
+
+    vkw::PipelineLayout pipelineLayout{};
+    VKW_CHECK_BOOL_RETURN_FALSE(pipelineLayout.init(device));
+    VKW_CHECK_BOOL_RETURN_FALSE(pipelineLayout.create());
+
+    vkw::RayTracingPipeline pipeline{device};
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.addShaderStage(
+        VK_SHADER_STAGE_RAYGEN_BIT_KHR, reinterpret_cast<const char*>(rayGenShader), sizeof(rayGenShader)));
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.addShaderStage(
+        VK_SHADER_STAGE_MISS_BIT_KHR, reinterpret_cast<const char*>(missShader), sizeof(missShader)));
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.addShaderStage(
+        VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR, reinterpret_cast<const char*>(closestHitShader),
+        sizeof(closestHitShader)));
+    pipeline.addGeneralShaderGroup(0);
+    pipeline.addGeneralShaderGroup(1);
+    pipeline.addTriangleHitShaderGroup(2, VK_SHADER_UNUSED_KHR, VK_SHADER_UNUSED_KHR);
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.createPipeline(pipelineLayout, 1));
+
+    // Handles only, inline data smaller than the alignments and data spanning several alignment units
+    const uint32_t handleSize = device.rayTracingPipelineProperties().shaderGroupHandleSize;
+    const uint32_t baseAlignment = device.rayTracingPipelineProperties().shaderGroupBaseAlignment;
+    const RecordLayout layouts[] = {
+        {{0}, {0}, {0}},
+        {{0, 12}, {0, 4, 0}, {40}},
+        {{0, 0, 0}, {}, {1, handleSize, 3 * baseAlignment + 1, 0}},
+    };
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    vkw::utils::Log::Info(testName, "Checking record layout...");
+    for(uint32_t i = 0; i < sizeof(layouts) / sizeof(RecordLayout); ++i)
+    {
+        if(!testLayout(device, pipeline, layouts[i]))
+        {
+            vkw::utils::Log::Warning(testName, "  Layout %u - FAILED", i);
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    vkw::utils::Log::Info(testName, "Checking indirect command...");
+    if(!testIndirectCommand(device, pipeline))
+    {
+        vkw::utils::Log::Warning(testName, "  Indirect command - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking dirty records...");
+    if(!testDirtyRecords(device, pipeline))
+    {
+        vkw::utils::Log::Warning(testName, "  Dirty records - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking invalid tables...");
+    if(!testInvalidTables(device, pipeline))
+    {
+        vkw::utils::Log::Warning(testName, "  Invalid tables - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking trace rays...");
+    for(uint32_t i = 0; i < sizeof(layouts) / sizeof(RecordLayout); ++i)
+    {
+        if(!testTraceRays(device, pipeline, layouts[i]))
+        {
+            vkw::utils::Log::Warning(testName, "  Trace rays with layout %u - FAILED", i);
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testLayout(
+    const vkw::Device& device, const vkw::RayTracingPipeline& pipeline, const RecordLayout& layout)
+{
+    vkw::ShaderBindingTable sbt{};
+    VKW_CHECK_BOOL_RETURN_FALSE(createTable(device, pipeline, layout, sbt));
+
+    const auto& properties = device.rayTracingPipelineProperties();
+    const VkDeviceSize handleAlignment = properties.shaderGroupHandleAlignment;
+    const VkDeviceSize baseAlignment = properties.shaderGroupBaseAlignment;
+
+    if(sbt.recordCount(Region::RayGen) != layout.rayGen.size()) { return false; }
+    if(sbt.recordCount(Region::Miss) != layout.miss.size()) { return false; }
+    if(sbt.recordCount(Region::Hit) != layout.hit.size()) { return false; }
+    if(sbt.recordCount(Region::Callable) != 0) { return false; }
+
+    // Each ray generation record is a region of its own, aligned on the base alignment
+    VkDeviceAddress previousEnd = 0;
+    for(uint32_t i = 0; i < layout.rayGen.size(); ++i)
+    {
+        const auto region = sbt.deviceRegion(Region::RayGen, i);
+        if(!validRegion(device, region, baseAlignment, layout.rayGen)) { return false; }
+        if(region.size != region.stride) { return false; }
+        if(region.deviceAddress < previousEnd) { return false; }
+        previousEnd = region.deviceAddress + region.size;
+    }
+
+    // Other regions follow, their records are aligned on the handle alignment
+    const auto missRegion = sbt.deviceRegion(Region::Miss);
+    const auto hitRegion = sbt.deviceRegion(Region::Hit);
+    if(!validRegion(device, missRegion, handleAlignment, layout.miss)) { return false; }
+    if(!validRegion(device, hitRegion, handleAlignment, layout.hit)) { return false; }
+    if(!layout.miss.empty() && missRegion.deviceAddress < previousEnd) { return false; }
+    if(!layout.miss.empty()) { previousEnd = missRegion.deviceAddress + missRegion.size; }
+    if(hitRegion.deviceAddress < previousEnd) { return false; }
+
+    // Empty regions are null
+    const auto callableRegion = sbt.deviceRegion(Region::Callable);
+    if(callableRegion.deviceAddress != 0 || callableRegion.stride != 0 || callableRegion.size != 0)
+    {
+        return false;
+    }
+
+    // The table holds all the regions
+    const VkDeviceAddress tableEnd = sbt.buffer().deviceAddress() + sbt.sizeBytes();
+    return sbt.buffer().deviceAddress() % baseAlignment == 0
+           && hitRegion.deviceAddress + hitRegion.size <= tableEnd;
+}
+
+bool testIndirectCommand(const vkw::Device& device, const vkw::RayTracingPipeline& pipeline)
+{
+    vkw::ShaderBindingTable sbt{};
+    VKW_CHECK_BOOL_RETURN_FALSE(createTable(device, pipeline, {{0, 8}, {16}, {0, 0}}, sbt));
+
+    const auto command = sbt.indirectCommand(16, 8, 2, 1);
+    const auto rayGenRegion = sbt.deviceRegion(Region::RayGen, 1);
+    const auto missRegion = sbt.deviceRegion(Region::Miss);
+    const auto hitRegion = sbt.deviceRegion(Region::Hit);
+
+    if(command.width != 16 || command.height != 8 || command.depth != 2) { return false; }
+    if(command.raygenShaderRecordAddress != rayGenRegion.deviceAddress) { return false; }
+    if(command.raygenShaderRecordSize != rayGenRegion.size) { return false; }
+    if(command.missShaderBindingTableAddress != missRegion.deviceAddress) { return false; }
+    if(command.missShaderBindingTableSize != missRegion.size) { return false; }
+    if(command.missShaderBindingTableStride != missRegion.stride) { return false; }
+    if(command.hitShaderBindingTableAddress != hitRegion.deviceAddress) { return false; }
+    if(command.hitShaderBindingTableSize != hitRegion.size) { return false; }
+    if(command.hitShaderBindingTableStride != hitRegion.stride) { return false; }
+
+    return command.callableShaderBindingTableAddress == 0 && command.callableShaderBindingTableSize == 0
+           && command.callableShaderBindingTableStride == 0;
+}
+
+bool testDirtyRecords(const vkw::Device& device, const vkw::RayTracingPipeline& pipeline)
+{
+    vkw::ShaderBindingTable sbt{};
+    VKW_CHECK_BOOL_RETURN_FALSE(createTable(device, pipeline, {{0}, {4, 4, 4, 4}, {8}}, sbt));
+
+    // The whole table is uploaded after creation, one run of records per region
+    if(sbt.dirtyRecordCount() != 6) { return false; }
+
+    vkw::utils::CopyRegionStats stats{};
+    const auto uploadFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        cmdBuffer.uploadShaderBindingTable(sbt, &stats);
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, uploadFn));
+    if(sbt.hasDirtyRecords() || stats.inputCount != 3) { return false; }
+
+    // Setting the current group does not modify the record
+    sbt.setRecordGroup(Region::Miss, 1, missGroup);
+    if(sbt.hasDirtyRecords()) { return false; }
+
+    // Two separate runs of modified records
+    const uint32_t data = 0x12345678;
+    sbt.setRecordData(Region::Miss, 0, data);
+    sbt.setRecordData(Region::Miss, 0, data);
+    sbt.setRecordData(Region::Miss, 2, data);
+    sbt.setRecordGroup(Region::Miss, 3, hitGroup);
+    if(sbt.dirtyRecordCount() != 3) { return false; }
+
+    stats = {};
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, uploadFn));
+    if(sbt.hasDirtyRecords() || stats.inputCount != 2 || stats.outputCount != 2) { return false; }
+
+    // Nothing left to upload
+    stats = {};
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, uploadFn));
+    if(stats.inputCount != 0) { return false; }
+
+    sbt.markAllDirty();
+    return sbt.dirtyRecordCount() == 6;
+}
+
+bool testInvalidTables(const vkw::Device& device, const vkw::RayTracingPipeline& pipeline)
+{
+    // No ray generation record
+    vkw::ShaderBindingTable noRayGen{};
+    VKW_CHECK_BOOL_RETURN_FALSE(noRayGen.init(device));
+    noRayGen.addMissRecord(missGroup);
+    if(noRayGen.create(pipeline) || noRayGen.created()) { return false; }
+
+    // Group out of the pipeline
+    vkw::ShaderBindingTable invalidGroup{};
+    VKW_CHECK_BOOL_RETURN_FALSE(invalidGroup.init(device));
+    invalidGroup.addRayGenRecord(rayGenGroup).addHitRecord(pipeline.groupCount());
+    if(invalidGroup.create(pipeline) || invalidGroup.created()) { return false; }
+
+    // Record larger than maxShaderGroupStride
+    const uint32_t maxStride = device.rayTracingPipelineProperties().maxShaderGroupStride;
+    vkw::ShaderBindingTable largeRecord{};
+    VKW_CHECK_BOOL_RETURN_FALSE(largeRecord.init(device));
+    largeRecord.addRayGenRecord(rayGenGroup).addMissRecord(missGroup, maxStride);
+    if(largeRecord.create(pipeline) || largeRecord.created()) { return false; }
+
+    return true;
+}
+
+bool testTraceRays(
+    const vkw::Device& device, const vkw::RayTracingPipeline& pipeline, const RecordLayout& layout)
+{
+    vkw::ShaderBindingTable sbt{};
+    VKW_CHECK_BOOL_RETURN_FALSE(createTable(device, pipeline, layout, sbt));
+
+    // Every ray generation record is usable
+    const auto recordFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        cmdBuffer.uploadShaderBindingTable(sbt).bindRayTracingPipeline(pipeline);
+        for(uint32_t i = 0; i < layout.rayGen.size(); ++i)
+        {
+            cmdBuffer.traceRays(sbt, 8, 8, 1, i);
+        }
+        return true;
+    };
+    return runCommands(device, vkw::QueueUsageBits::Compute, recordFn);
+}
+
+bool createTable(
+    const vkw::Device& device, const vkw::RayTracingPipeline& pipeline, const RecordLayout& layout,
+    vkw::ShaderBindingTable& sbt)
+{
+    VKW_CHECK_BOOL_RETURN_FALSE(sbt.init(device));
+    for(const uint32_t dataSize : layout.rayGen)
+    {
+        sbt.addRayGenRecord(rayGenGroup, dataSize);
+    }
+    for(const uint32_t dataSize : layout.miss)
+    {
+        sbt.addMissRecord(missGroup, dataSize);
+    }
+    for(const uint32_t dataSize : layout.hit)
+    {
+        sbt.addHitRecord(hitGroup, dataSize);
+    }
+    VKW_CHECK_BOOL_RETURN_FALSE(sbt.create(pipeline));
+
+    return sbt.created();
+}
+
+bool validRegion(
+    const vkw::Device& device, const VkStridedDeviceAddressRegionKHR& region, const VkDeviceSize alignment,
+    const std::vector<uint32_t>& dataSizes)
+{
+    const auto& properties = device.rayTracingPipelineProperties();
+
+    if(dataSizes.empty()) { return region.deviceAddress == 0 && region.stride == 0 && region.size == 0; }
+
+    uint32_t maxDataSize = 0;
+    for(const uint32_t dataSize : dataSizes)
+    {
+        maxDataSize = std::max(maxDataSize, dataSize);
+    }
+
+    // The stride is the smallest aligned size holding the handle and the largest inline data
+    const VkDeviceSize recordSize = properties.shaderGroupHandleSize + maxDataSize;
+    const VkDeviceSize expectedStride = ((recordSize + alignment - 1) / alignment) * alignment;
+    if(region.stride != expectedStride || region.stride > properties.maxShaderGroupStride) { return false; }
+
+    return region.deviceAddress % properties.shaderGroupBaseAlignment == 0
+           && region.size >= region.stride && region.size % region.stride == 0;
+}
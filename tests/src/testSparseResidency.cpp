@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "SparseResidencyTest";
+
+static bool testBufferResidency(const vkw::Device& device, const vkw::Queue& sparseQueue);
+
+static bool testBufferContent(const vkw::Device& device, const vkw::Queue& sparseQueue);
+
+static bool testImageResidency(const vkw::Device& device, const vkw::Queue& sparseQueue);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchSparseResidencyTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures = {};
+    timelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+    timelineFeatures.pNext = nullptr;
+
+    VkPhysicalDeviceFeatures2 availablePhysicalDeviceFeatures = {};
+    availablePhysicalDeviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    availablePhysicalDeviceFeatures.pNext = &timelineFeatures;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &availablePhysicalDeviceFeatures);
+
+    const auto& availableFeatures = availablePhysicalDeviceFeatures.features;
+    if(timelineFeatures.timelineSemaphore == VK_FALSE || availableFeatures.sparseBinding == VK_FALSE
+       || availableFeatures.sparseResidencyBuffer == VK_FALSE)
+    {
+        vkw::utils::Log::Info(testName, "Sparse residency not available, skipping");
+        return true;
+    }
+
+    VkPhysicalDeviceFeatures enabledFeatures = {};
+    enabledFeatures.sparseBinding = VK_TRUE;
+    enabledFeatures.sparseResidencyBuffer = VK_TRUE;
+    enabledFeatures.sparseResidencyImage2D = availableFeatures.sparseResidencyImage2D;
+
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        device.init(instance, physicalDevice, {}, enabledFeatures, &timelineFeatures));
+
+    const auto sparseQueues = device.getQueues(vkw::QueueUsageBits::SparseBinding);
+    if(sparseQueues.empty())
+    {
+        vkw::utils::Log::Info(testName, "No sparse binding queue, skipping");
+        return true;
+    }
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    vkw::utils::Log::Info(testName, "Checking buffer residency...");
+    if(!testBufferResidency(device, sparseQueues[0]))
+    {
+        vkw::utils::Log::Warning(testName, "  Buffer residency - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "Checking buffer content...");
+    if(!testBufferContent(device, sparseQueues[0]))
+    {
+        vkw::utils::Log::Warning(testName, "  Buffer content - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    if(enabledFeatures.sparseResidencyImage2D == VK_TRUE)
+    {
+        vkw::utils::Log::Info(testName, "Checking image residency...");
+        if(!testImageResidency(device, sparseQueues[0]))
+        {
+            vkw::utils::Log::Warning(testName, "  Image residency - FAILED");
+            failedTests++;
+        }
+        totalTests++;
+    }
+    else
+    {
+        vkw::utils::Log::Info(testName, "Sparse residency images not available, skipping");
+    }
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testBufferResidency(const vkw::Device& device, const vkw::Queue& sparseQueue)
+{
+    vkw::TimelineSemaphore timeline{device, 0};
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.initialized());
+
+    vkw::SparseResidencyManager manager{device, sparseQueue, timeline};
+    VKW_CHECK_BOOL_RETURN_FALSE(manager.initialized());
+
+    vkw::SparseBuffer buffer{device, 16 * 1024 * 1024, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(buffer.initialized());
+    if(buffer.pageCount() < 8 || buffer.residentPageCount() != 0) { return false; }
+    if(buffer.pageIndex(buffer.pageSize()) != 1) { return false; }
+
+    // Overlapping requests only allocate the missing pages
+    VKW_CHECK_BOOL_RETURN_FALSE(manager.bindPages(buffer, 0, 4));
+    VKW_CHECK_BOOL_RETURN_FALSE(manager.bindPages(buffer, 2, 4));
+    if(buffer.residentPageCount() != 6 || !manager.hasPendingRequests()) { return false; }
+    if(buffer.resident(6) || !buffer.resident(5)) { return false; }
+    if(manager.allocatedBytes() < 6 * buffer.pageSize()) { return false; }
+
+    VKW_CHECK_BOOL_RETURN_FALSE(manager.flush(0, 1));
+    if(manager.hasPendingRequests()) { return false; }
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.wait(1));
+
+    // Binding resident pages again is a no-op
+    VKW_CHECK_BOOL_RETURN_FALSE(manager.bindPages(buffer, 0, 2));
+    if(manager.hasPendingRequests()) { return false; }
+
+    // The memory of unbound pages is kept until the flush unbinding them completed
+    manager.unbindPages(buffer, 1, 2);
+    manager.unbindPages(buffer, 7, 1);
+    if(buffer.residentPageCount() != 4 || buffer.resident(1) || !manager.hasPendingRequests())
+    {
+        return false;
+    }
+    if(manager.retiredPageCount() != 2) { return false; }
+
+    manager.collect();
+    if(manager.retiredPageCount() != 2) { return false; }
+
+    VKW_CHECK_BOOL_RETURN_FALSE(manager.flush(1, 2));
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.wait(2));
+    manager.collect();
+    if(manager.retiredPageCount() != 0) { return false; }
+
+    // The timeline is signaled even without pending requests
+    VKW_CHECK_BOOL_RETURN_FALSE(manager.flush(2, 3));
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.wait(3));
+
+    VKW_CHECK_VK_RETURN_FALSE(sparseQueue.waitIdle());
+    buffer.clear();
+
+    return true;
+}
+
+bool testBufferContent(const vkw::Device& device, const vkw::Queue& sparseQueue)
+{
+    vkw::TimelineSemaphore timeline{device, 0};
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.initialized());
+
+    vkw::SparseResidencyManager manager{device, sparseQueue, timeline};
+    VKW_CHECK_BOOL_RETURN_FALSE(manager.initialized());
+
+    vkw::SparseBuffer buffer{
+        device, 8 * 1024 * 1024, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(buffer.initialized());
+
+    // Two disjoint ranges, only the resident pages are accessed
+    const VkDeviceSize pageSize = buffer.pageSize();
+    VKW_CHECK_BOOL_RETURN_FALSE(manager.bindPages(buffer, 0, 2));
+    VKW_CHECK_BOOL_RETURN_FALSE(manager.bindPages(buffer, 4, 1));
+    VKW_CHECK_BOOL_RETURN_FALSE(manager.flush(0, 1));
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.wait(1));
+
+    const size_t count = static_cast<size_t>(3 * pageSize / sizeof(uint32_t));
+    std::vector<uint32_t> data(count);
+    for(size_t i = 0; i < count; ++i)
+    {
+        data[i] = static_cast<uint32_t>(11 * i + 5);
+    }
+
+    vkw::HostStagingBuffer<uint32_t> uploadBuffer{device, count, VK_BUFFER_USAGE_TRANSFER_SRC_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer.copyFromHost(data.data(), count));
+    vkw::HostStagingBuffer<uint32_t> readbackBuffer{device, count, VK_BUFFER_USAGE_TRANSFER_DST_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(readbackBuffer.initialized());
+
+    const auto recordFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        std::vector<VkBufferCopy> uploadRegions
+            = {{0, 0, 2 * pageSize}, {2 * pageSize, 4 * pageSize, pageSize}};
+        cmdBuffer.copyBuffer(uploadBuffer, buffer, std::span<VkBufferCopy>{uploadRegions});
+
+        cmdBuffer.memoryBarrier(
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            vkw::createMemoryBarrier(VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT));
+
+        std::vector<VkBufferCopy> readbackRegions
+            = {{0, 0, 2 * pageSize}, {4 * pageSize, 2 * pageSize, pageSize}};
+        cmdBuffer.copyBuffer(buffer, readbackBuffer, std::span<VkBufferCopy>{readbackRegions});
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Transfer, recordFn));
+
+    std::vector<uint32_t> result(count);
+    VKW_CHECK_BOOL_RETURN_FALSE(readbackBuffer.copyToHost(result.data(), count));
+
+    VKW_CHECK_VK_RETURN_FALSE(sparseQueue.waitIdle());
+    buffer.clear();
+
+    return result == data;
+}
+
+bool testImageResidency(const vkw::Device& device, const vkw::Queue& sparseQueue)
+{
+    vkw::TimelineSemaphore timeline{device, 0};
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.initialized());
+
+    vkw::SparseResidencyManager manager{device, sparseQueue, timeline};
+    VKW_CHECK_BOOL_RETURN_FALSE(manager.initialized());
+
+    vkw::SparseImage image{};
+    if(!image.init(
+           device, VK_IMAGE_TYPE_2D, VK_FORMAT_R8G8B8A8_UNORM, {1024, 1024, 1},
+           VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, 11, 2))
+    {
+        // The format is not guaranteed to support sparse residency
+        vkw::utils::Log::Info(testName, "  Sparse image format not supported, skipping");
+        return true;
+    }
+
+    const auto tileExtent = image.tileExtent();
+    const auto tileCount = image.tileCount(0);
+    if(tileCount.width < 2 || tileCount.height < 2 || image.residentPageCount() != 0) { return false; }
+
+    // A region one texel wider than a tile covers two tiles
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        manager.bindRegion(image, 0, 1, {0, 0, 0}, {tileExtent.width + 1, tileExtent.height, 1}));
+    if(image.residentPageCount() != 2) { return false; }
+    if(!image.tileResident(0, 1, {0, 0, 0}) || !image.tileResident(0, 1, {1, 0, 0})) { return false; }
+    if(image.tileResident(0, 0, {0, 0, 0}) || image.tileResident(0, 1, {0, 1, 0})) { return false; }
+
+    if(image.hasMipTail())
+    {
+        VKW_CHECK_BOOL_RETURN_FALSE(manager.bindMipTail(image, 1));
+        if(!image.mipTailResident(1)) { return false; }
+
+        // A single mip tail is shared by all the layers
+        if(image.mipTailResident(0) != image.singleMipTail()) { return false; }
+    }
+
+    // A mip tail may span several pages
+    const uint32_t mipTailPageCount = image.residentPageCount() - 2;
+
+    VKW_CHECK_BOOL_RETURN_FALSE(manager.flush(0, 1));
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.wait(1));
+
+    // Round trip through the first resident tile
+    const uint32_t w = tileExtent.width;
+    const uint32_t h = tileExtent.height;
+    std::vector<uint32_t> data(size_t(w) * h);
+    for(size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint32_t>(13 * i + 7);
+    }
+
+    vkw::HostStagingBuffer<uint32_t> uploadBuffer{device, data.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer.initialized());
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer.copyFromHost(data.data(), data.size()));
+    vkw::HostStagingBuffer<uint32_t> readbackBuffer{device, data.size(), VK_BUFFER_USAGE_TRANSFER_DST_BIT};
+    VKW_CHECK_BOOL_RETURN_FALSE(readbackBuffer.initialized());
+
+    const auto recordFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        VkBufferImageCopy region = {};
+        region.bufferOffset = 0;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 1};
+        region.imageOffset = {0, 0, 0};
+        region.imageExtent = {w, h, 1};
+
+        cmdBuffer.imageMemoryBarrier(
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            vkw::createImageMemoryBarrier(
+                image, 0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 1, 1));
+        cmdBuffer.copyBufferToImage(uploadBuffer, image, VK_IMAGE_LAYOUT_GENERAL, region);
+        cmdBuffer.memoryBarrier(
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            vkw::createMemoryBarrier(VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT));
+        cmdBuffer.copyImageToBuffer(image, VK_IMAGE_LAYOUT_GENERAL, readbackBuffer, region);
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Transfer, recordFn));
+
+    std::vector<uint32_t> result(data.size());
+    VKW_CHECK_BOOL_RETURN_FALSE(readbackBuffer.copyToHost(result.data(), result.size()));
+    if(result != data) { return false; }
+
+    // Unbinding evicts all the tiles touched by the region
+    manager.unbindRegion(image, 0, 1, {int32_t(w) - 1, 0, 0}, {2, 1, 1});
+    if(image.residentPageCount() != mipTailPageCount) { return false; }
+    if(manager.retiredPageCount() != 2) { return false; }
+
+    VKW_CHECK_BOOL_RETURN_FALSE(manager.flush(1, 2));
+    VKW_CHECK_BOOL_RETURN_FALSE(timeline.wait(2));
+    manager.collect();
+    if(manager.retiredPageCount() != 0) { return false; }
+
+    VKW_CHECK_VK_RETURN_FALSE(sparseQueue.waitIdle());
+    image.clear();
+
+    return true;
+}
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "StreamingDispatcherTest";
+
+static const uint32_t streamingDispatcherTestComp[] = {
+#include "spv/StreamingDispatcherTest.comp.spv"
+};
+
+static bool testRun(vkw::StreamingDispatcher& dispatcher, const size_t elementCount);
+
+static bool testAbort(vkw::StreamingDispatcher& dispatcher);
+
+static bool testMappedFile(vkw::StreamingDispatcher& dispatcher, const size_t elementCount);
+
+static std::vector<uint32_t> generateInput(const size_t elementCount);
+
+static vkw::StreamingDispatcher::OutputCallback checkOutput(
+    const std::vector<uint32_t>& input, const size_t tileElementCount, size_t& deliveredTiles, bool& valid);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchStreamingDispatcherTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    // The dispatcher binds the tiles with push descriptors, core in Vulkan 1.4
+    VkPhysicalDeviceProperties properties = {};
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    if(properties.apiVersion < VK_API_VERSION_1_4)
+    {
+        vkw::utils::Log::Info(testName, "Push descriptors not available, skipping");
+        return true;
+    }
+
+    VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures = {};
+    timelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+    timelineFeatures.pNext = nullptr;
+
+    VkPhysicalDeviceFeatures2 availablePhysicalDeviceFeatures = {};
+    availablePhysicalDeviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    availablePhysicalDeviceFeatures.pNext = &timelineFeatures;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &availablePhysicalDeviceFeatures);
+
+    if(timelineFeatures.timelineSemaphore == VK_FALSE)
+    {
+        vkw::utils::Log::Info(testName, "Timeline semaphores not available, skipping");
+        return true;
+    }
+
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(device.init(instance, physicalDevice, {}, {}, &timelineFeatures));
+
+    vkw::DescriptorSetLayout descriptorSetLayout{};
+    VKW_CHECK_BOOL_RETURN_FALSE(descriptorSetLayout.init(device));
+    descriptorSetLayout.addBinding<vkw::DescriptorType::StorageBuffer>(VK_SHADER_STAGE_COMPUTE_BIT, 0)
+        .addBinding<vkw::DescriptorType::StorageBuffer>(VK_SHADER_STAGE_COMPUTE_BIT, 1);
+    VKW_CHECK_BOOL_RETURN_FALSE(
+        descriptorSetLayout.create(VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR));
+
+    vkw::PipelineLayout pipelineLayout{};
+    VKW_CHECK_BOOL_RETURN_FALSE(pipelineLayout.init(device, descriptorSetLayout));
+    pipelineLayout.reservePushConstants<vkw::StreamingDispatcher::TileConstants>(vkw::ShaderStage::Compute);
+    VKW_CHECK_BOOL_RETURN_FALSE(pipelineLayout.create());
+
+    vkw::ComputePipeline pipeline{};
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.init(
+        device, reinterpret_cast<const char*>(streamingDispatcherTestComp),
+        sizeof(streamingDispatcherTestComp)));
+    VKW_CHECK_BOOL_RETURN_FALSE(pipeline.createPipeline(pipelineLayout));
+
+    const auto transferQueue = device.getQueues(vkw::QueueUsageBits::Transfer)[0];
+    const auto computeQueue = device.getQueues(vkw::QueueUsageBits::Compute)[0];
+
+    static constexpr size_t tileElementCount = 10000;
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    // A single slot serializes the tiles, more slots overlap them
+    for(const uint32_t slotCount : {1, 2, 3})
+    {
+        vkw::StreamingDispatcher dispatcher{};
+        VKW_CHECK_BOOL_RETURN_FALSE(dispatcher.init(
+            device, transferQueue, computeQueue, pipeline, pipelineLayout, sizeof(uint32_t),
+            2 * sizeof(uint32_t), tileElementCount, vkw::StreamingDispatcher::defaultGroupSize, slotCount));
+
+        // Empty dataset, fewer tiles than slots, exact tiles and a partial last tile
+        vkw::utils::Log::Info(testName, "Checking runs with %u slots...", slotCount);
+        const size_t elementCounts[] = {0, 1, 2 * tileElementCount, 7 * tileElementCount + 123};
+        for(const size_t elementCount : elementCounts)
+        {
+            if(!testRun(dispatcher, elementCount))
+            {
+                vkw::utils::Log::Warning(testName, "  Element count %zu - FAILED", elementCount);
+                failedTests++;
+            }
+            totalTests++;
+        }
+
+        vkw::utils::Log::Info(testName, "Checking aborted run with %u slots...", slotCount);
+        if(!testAbort(dispatcher))
+        {
+            vkw::utils::Log::Warning(testName, "  Abort - FAILED");
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    // Same queue for the transfers and the processing
+    {
+        vkw::StreamingDispatcher dispatcher{};
+        VKW_CHECK_BOOL_RETURN_FALSE(dispatcher.init(
+            device, computeQueue, computeQueue, pipeline, pipelineLayout, sizeof(uint32_t),
+            2 * sizeof(uint32_t), tileElementCount));
+
+        vkw::utils::Log::Info(testName, "Checking single queue run...");
+        if(!testRun(dispatcher, 5 * tileElementCount + 1))
+        {
+            vkw::utils::Log::Warning(testName, "  Single queue - FAILED");
+            failedTests++;
+        }
+        totalTests++;
+
+        vkw::utils::Log::Info(testName, "Checking mapped file run...");
+        if(!testMappedFile(dispatcher, 4 * tileElementCount + 17))
+        {
+            vkw::utils::Log::Warning(testName, "  Mapped file - FAILED");
+            failedTests++;
+        }
+        totalTests++;
+    }
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testRun(vkw::StreamingDispatcher& dispatcher, const size_t elementCount)
+{
+    const auto input = generateInput(elementCount);
+
+    // Runs twice, the second run starts from the timeline values left by the first one
+    for(uint32_t i = 0; i < 2; ++i)
+    {
+        size_t deliveredTiles = 0;
+        bool valid = true;
+        const auto output = checkOutput(input, dispatcher.tileElementCount(), deliveredTiles, valid);
+        VKW_CHECK_BOOL_RETURN_FALSE(dispatcher.run(input.data(), elementCount, output));
+        if(!valid || deliveredTiles != dispatcher.tileCount(elementCount)) { return false; }
+    }
+
+    return true;
+}
+
+bool testAbort(vkw::StreamingDispatcher& dispatcher)
+{
+    static constexpr size_t abortedTile = 2;
+
+    const size_t elementCount = 6 * dispatcher.tileElementCount();
+    const auto input = generateInput(elementCount);
+
+    size_t deliveredTiles = 0;
+    bool valid = true;
+    const auto source = [&](const size_t tileIndex, const size_t firstElement, const size_t count,
+                            void* dst) {
+        if(tileIndex == abortedTile) { return false; }
+        std::copy_n(input.data() + firstElement, count, reinterpret_cast<uint32_t*>(dst));
+        return true;
+    };
+    const auto output = checkOutput(input, dispatcher.tileElementCount(), deliveredTiles, valid);
+
+    // The run fails, the tiles before the aborted one may have been delivered
+    if(dispatcher.run(elementCount, source, output)) { return false; }
+    if(!valid || deliveredTiles > abortedTile) { return false; }
+
+    // The next run is not affected
+    return testRun(dispatcher, elementCount);
+}
+
+bool testMappedFile(vkw::StreamingDispatcher& dispatcher, const size_t elementCount)
+{
+    const auto input = generateInput(elementCount);
+
+    const std::string filename = "StreamingDispatcherTest.bin";
+    FILE* fp = fopen(filename.c_str(), "wb");
+    VKW_CHECK_BOOL_RETURN_FALSE(fp != nullptr);
+    fwrite(input.data(), sizeof(uint32_t), input.size(), fp);
+    fclose(fp);
+
+    bool ret = true;
+    {
+        vkw::MappedFile file{};
+        size_t deliveredTiles = 0;
+        bool valid = true;
+        const auto output = checkOutput(input, dispatcher.tileElementCount(), deliveredTiles, valid);
+        ret = file.init(filename) && dispatcher.run(file, output) && valid
+              && deliveredTiles == dispatcher.tileCount(elementCount);
+    }
+
+    remove(filename.c_str());
+    return ret;
+}
+
+std::vector<uint32_t> generateInput(const size_t elementCount)
+{
+    std::vector<uint32_t> ret(elementCount);
+    for(size_t i = 0; i < elementCount; ++i)
+    {
+        ret[i] = static_cast<uint32_t>(7 * i + 3);
+    }
+    return ret;
+}
+
+vkw::StreamingDispatcher::OutputCallback checkOutput(
+    const std::vector<uint32_t>& input, const size_t tileElementCount, size_t& deliveredTiles, bool& valid)
+{
+    // Tiles are delivered in order, each output element holds 3 * input + 1 and its index in the dataset
+    return [&input, tileElementCount, &deliveredTiles, &valid](
+               const size_t tileIndex, const size_t firstElement, const size_t elementCount,
+               const void* data) {
+        const size_t expectedCount = std::min(tileElementCount, input.size() - firstElement);
+        if(tileIndex != deliveredTiles || firstElement != tileIndex * tileElementCount
+           || elementCount != expectedCount)
+        {
+            valid = false;
+        }
+
+        const auto* values = reinterpret_cast<const uint32_t*>(data);
+        for(size_t i = 0; i < elementCount && valid; ++i)
+        {
+            const size_t element = firstElement + i;
+            if(values[2 * i] != 3 * input[element] + 1 || values[2 * i + 1] != static_cast<uint32_t>(element))
+            {
+                valid = false;
+            }
+        }
+        deliveredTiles++;
+    };
+}
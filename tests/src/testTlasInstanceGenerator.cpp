@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2026 Adrien ARNAUD
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <vkw/vkw.hpp>
+
+static const char* testName = "TlasInstanceGeneratorTest";
+
+static const float quadPositions[] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+static const uint32_t quadIndices[] = {0, 1, 2, 0, 2, 3};
+
+using InstanceDescriptor = vkw::TlasInstanceGenerator::InstanceDescriptor;
+
+static const VkBufferUsageFlags storageUsage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+                                               | VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+                                               | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+// Instances are read by acceleration structure builds
+static const VkBufferUsageFlags instanceUsage
+    = storageUsage | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR
+      | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+
+static bool testGeneration(
+    const vkw::Device& device, const vkw::TlasInstanceGenerator& generator, const uint32_t instanceCount,
+    const uint32_t blasCount);
+
+static bool testTlasBuild(const vkw::Device& device, const vkw::TlasInstanceGenerator& generator);
+
+static VkTransformMatrixKHR generateTransform(const uint32_t index);
+
+static InstanceDescriptor generateDescriptor(const uint32_t index, const uint32_t blasCount);
+
+// Instance expected from the generation kernel
+static VkAccelerationStructureInstanceKHR expectedInstance(
+    const VkTransformMatrixKHR& transform, const InstanceDescriptor& descriptor,
+    const std::vector<VkDeviceAddress>& blasAddresses);
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool launchTlasInstanceGeneratorTest(const vkw::Instance& instance, const VkPhysicalDevice physicalDevice)
+{
+    if(!accelerationStructuresAvailable(physicalDevice))
+    {
+        vkw::utils::Log::Info(testName, "Acceleration structures not available, skipping");
+        return true;
+    }
+
+    // The generator binds its buffers with push descriptors, core in Vulkan 1.4
+    VkPhysicalDeviceProperties properties = {};
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    if(properties.apiVersion < VK_API_VERSION_1_4)
+    {
+        vkw::utils::Log::Info(testName, "Push descriptors not available, skipping");
+        return true;
+    }
+
+    vkw::Device device{};
+    VKW_CHECK_BOOL_RETURN_FALSE(initAccelerationStructureDevice(device, instance, physicalDevice));
+
+    vkw::TlasInstanceGenerator generator{};
+    VKW_CHECK_BOOL_RETURN_FALSE(generator.init(device));
+
+    uint32_t totalTests = 0;
+    uint32_t failedTests = 0;
+
+    // Counts around the group size and large enough to need several dispatch rows on some devices
+    vkw::utils::Log::Info(testName, "Checking instance generation...");
+    for(const uint32_t instanceCount : {0, 1, 255, 256, 257, 100000})
+    {
+        for(const uint32_t blasCount : {1, 7})
+        {
+            if(!testGeneration(device, generator, instanceCount, blasCount))
+            {
+                vkw::utils::Log::Warning(
+                    testName, "  %u instances over %u BLAS - FAILED", instanceCount, blasCount);
+                failedTests++;
+            }
+            totalTests++;
+        }
+    }
+
+    vkw::utils::Log::Info(testName, "Checking TLAS build from generated instances...");
+    if(!testTlasBuild(device, generator))
+    {
+        vkw::utils::Log::Warning(testName, "  TLAS build - FAILED");
+        failedTests++;
+    }
+    totalTests++;
+
+    vkw::utils::Log::Info(testName, "%u tests failed over %u", failedTests, totalTests);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------------------
+
+bool testGeneration(
+    const vkw::Device& device, const vkw::TlasInstanceGenerator& generator, const uint32_t instanceCount,
+    const uint32_t blasCount)
+{
+    std::vector<VkTransformMatrixKHR> transforms{};
+    std::vector<InstanceDescriptor> descriptors{};
+    for(uint32_t i = 0; i < instanceCount; ++i)
+    {
+        transforms.push_back(generateTransform(i));
+        descriptors.push_back(generateDescriptor(i, blasCount));
+    }
+
+    // Fake addresses using both words
+    std::vector<VkDeviceAddress> blasAddresses{};
+    for(uint32_t i = 0; i < blasCount; ++i)
+    {
+        blasAddresses.push_back((VkDeviceAddress(0x1234 + i) << 32) | (0x100u * (i + 1)));
+    }
+
+    // One more instance than generated, it must be left untouched
+    VkAccelerationStructureInstanceKHR guard = {};
+    memset(&guard, 0xA5, sizeof(VkAccelerationStructureInstanceKHR));
+    std::vector<VkAccelerationStructureInstanceKHR> instances(instanceCount + 1, guard);
+
+    const size_t inputCount = std::max(instanceCount, 1u);
+    vkw::DeviceBuffer<VkTransformMatrixKHR> transformBuffer{device, inputCount, storageUsage};
+    vkw::DeviceBuffer<InstanceDescriptor> descriptorBuffer{device, inputCount, storageUsage};
+    vkw::DeviceBuffer<VkDeviceAddress> blasAddressBuffer{device, blasCount, storageUsage};
+    vkw::DeviceBuffer<VkAccelerationStructureInstanceKHR> instanceBuffer{
+        device, instances.size(), instanceUsage};
+
+    if(instanceCount > 0)
+    {
+        VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer(device, transforms.data(), transformBuffer, instanceCount));
+        VKW_CHECK_BOOL_RETURN_FALSE(
+            uploadBuffer(device, descriptors.data(), descriptorBuffer, instanceCount));
+    }
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer(device, blasAddresses.data(), blasAddressBuffer, blasCount));
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer(device, instances.data(), instanceBuffer, instances.size()));
+
+    const auto recordFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        cmdBuffer.generateInstances(
+            generator, transformBuffer, descriptorBuffer, blasAddressBuffer, instanceBuffer, instanceCount,
+            blasCount);
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, recordFn));
+
+    std::vector<VkAccelerationStructureInstanceKHR> result(instances.size());
+    VKW_CHECK_BOOL_RETURN_FALSE(downloadBuffer(device, instanceBuffer, result.data(), result.size()));
+
+    for(uint32_t i = 0; i < instanceCount; ++i)
+    {
+        const auto expected = expectedInstance(transforms[i], descriptors[i], blasAddresses);
+        if(memcmp(&result[i], &expected, sizeof(VkAccelerationStructureInstanceKHR)) != 0) { return false; }
+    }
+
+    return memcmp(&result[instanceCount], &guard, sizeof(VkAccelerationStructureInstanceKHR)) == 0;
+}
+
+bool testTlasBuild(const vkw::Device& device, const vkw::TlasInstanceGenerator& generator)
+{
+    static constexpr uint32_t instanceCount = 64;
+    static constexpr uint32_t blasCount = 4;
+
+    vkw::BlasBatcher batcher{device};
+    batcher.setTargetPrimitiveCount(2);
+    for(uint32_t i = 0; i < blasCount; ++i)
+    {
+        vkw::BlasBatcher::MeshDesc mesh{};
+        mesh.positions = quadPositions;
+        mesh.vertexCount = 4;
+        mesh.indices = quadIndices;
+        mesh.indexCount = 6;
+        mesh.transform.matrix[2][3] = 10.0f * float(i);
+        batcher.addMesh(mesh);
+    }
+    VKW_CHECK_BOOL_RETURN_FALSE(batcher.create());
+    if(batcher.blasCount() != blasCount) { return false; }
+
+    auto blasList = batcher.blasList();
+
+    std::vector<VkTransformMatrixKHR> transforms{};
+    std::vector<InstanceDescriptor> descriptors{};
+    for(uint32_t i = 0; i < instanceCount; ++i)
+    {
+        transforms.push_back(generateTransform(i));
+        descriptors.push_back(generateDescriptor(i, blasCount));
+    }
+
+    std::vector<VkDeviceAddress> blasAddresses{};
+    for(const auto& blas : blasList)
+    {
+        blasAddresses.push_back(blas.get().getDeviceAddress());
+    }
+
+    vkw::DeviceBuffer<VkTransformMatrixKHR> transformBuffer{device, instanceCount, storageUsage};
+    vkw::DeviceBuffer<InstanceDescriptor> descriptorBuffer{device, instanceCount, storageUsage};
+    vkw::DeviceBuffer<VkDeviceAddress> blasAddressBuffer{device, blasCount, storageUsage};
+    vkw::DeviceBuffer<VkAccelerationStructureInstanceKHR> instanceBuffer{
+        device, instanceCount, instanceUsage};
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer(device, transforms.data(), transformBuffer, instanceCount));
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer(device, descriptors.data(), descriptorBuffer, instanceCount));
+    VKW_CHECK_BOOL_RETURN_FALSE(uploadBuffer(device, blasAddresses.data(), blasAddressBuffer, blasCount));
+
+    vkw::TopLevelAccelerationStructure tlas{};
+    VKW_CHECK_BOOL_RETURN_FALSE(tlas.init(device));
+    tlas.create(instanceBuffer, instanceCount);
+    if(!tlas.externalInstances() || tlas.instanceCount() != instanceCount) { return false; }
+
+    vkw::AccelerationStructureScratchPool blasScratchPool{};
+    VKW_CHECK_BOOL_RETURN_FALSE(blasScratchPool.init(device, blasScratchPool.requiredSize(blasList)));
+    vkw::AccelerationStructureScratchPool tlasScratchPool{};
+    VKW_CHECK_BOOL_RETURN_FALSE(tlasScratchPool.init(device, tlas.buildScratchSize()));
+
+    // The BLAS, the instances and the TLAS in a single submission
+    vkw::DeferredDeletionQueue deletionQueue{};
+    const auto recordFn = [&](const vkw::CommandBuffer& cmdBuffer) {
+        if(batcher.needsUpload()) { batcher.recordUpload(cmdBuffer, deletionQueue, 1); }
+        cmdBuffer.buildAccelerationStructures(blasList, blasScratchPool);
+        cmdBuffer.memoryBarrier(
+            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            vkw::createMemoryBarrier(
+                VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+                VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR));
+        VKW_CHECK_BOOL_RETURN_FALSE(generator.recordGeneration(
+            cmdBuffer, transformBuffer, descriptorBuffer, blasAddressBuffer, instanceBuffer, instanceCount,
+            blasCount));
+        cmdBuffer.buildAccelerationStructure(tlas, tlasScratchPool.buffer());
+        return true;
+    };
+    VKW_CHECK_BOOL_RETURN_FALSE(runCommands(device, vkw::QueueUsageBits::Compute, recordFn));
+    deletionQueue.collect(1);
+
+    std::vector<VkAccelerationStructureInstanceKHR> result(instanceCount);
+    VKW_CHECK_BOOL_RETURN_FALSE(downloadBuffer(device, instanceBuffer, result.data(), instanceCount));
+
+    // Generated instances reference the built structures
+    for(uint32_t i = 0; i < instanceCount; ++i)
+    {
+        const auto expected = expectedInstance(transforms[i], descriptors[i], blasAddresses);
+        if(memcmp(&result[i], &expected, sizeof(VkAccelerationStructureInstanceKHR)) != 0) { return false; }
+    }
+
+    return tlas.getDeviceAddress() != 0;
+}
+
+VkTransformMatrixKHR generateTransform(const uint32_t index)
+{
+    VkTransformMatrixKHR ret = {};
+    for(uint32_t row = 0; row < 3; ++row)
+    {
+        for(uint32_t col = 0; col < 4; ++col)
+        {
+            ret.matrix[row][col] = (row == col) ? 1.0f : 0.0f;
+        }
+    }
+    ret.matrix[0][3] = float(index % 16);
+    ret.matrix[1][3] = float(index / 16);
+    ret.matrix[2][3] = 0.5f * float(index % 3);
+    return ret;
+}
+
+InstanceDescriptor generateDescriptor(const uint32_t index, const uint32_t blasCount)
+{
+    // Every 5th instance references a BLAS out of the table, indices exceed the 24 bits kept
+    InstanceDescriptor ret = {};
+    ret.blasIndex = (index % 5 == 4) ? blasCount + index : index % blasCount;
+    ret.customIndex = 0x01000000u * (index % 3) + index;
+    ret.hitBindingIndex = 0x03000000u + 2 * index;
+    ret.maskAndFlags = InstanceDescriptor::packMaskAndFlags(
+        0xF0u | (index & 0xFu),
+        (index % 2 == 0) ? VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR
+                         : VK_GEOMETRY_INSTANCE_FORCE_OPAQUE_BIT_KHR);
+    return ret;
+}
+
+VkAccelerationStructureInstanceKHR expectedInstance(
+    const VkTransformMatrixKHR& transform, const InstanceDescriptor& descriptor,
+    const std::vector<VkDeviceAddress>& blasAddresses)
+{
+    VkAccelerationStructureInstanceKHR ret = {};
+    ret.transform = transform;
+    ret.instanceCustomIndex = descriptor.customIndex & 0xFFFFFFu;
+    ret.mask = descriptor.maskAndFlags & 0xFFu;
+    ret.instanceShaderBindingTableRecordOffset = descriptor.hitBindingIndex & 0xFFFFFFu;
+    ret.flags = (descriptor.maskAndFlags >> 8) & 0xFFu;
+    ret.accelerationStructureReference
+        = (descriptor.blasIndex < blasAddresses.size()) ? blasAddresses[descriptor.blasIndex] : 0;
+    return ret;
+}
@@ -20,7 +20,28 @@
  * SOFTWARE.
  */
 
+#include "ASCompactor.hpp"
+#include "ASScratchPool.hpp"
+#include "ASSerializer.hpp"
+#include "BlasBatcher.hpp"
+#include "BlasRefit.hpp"
+#include "BufferCopyKernels.hpp"
+#include "ChunkedBuffer.hpp"
 #include "DescriptorIndexing.hpp"
+#include "DeviceVector.hpp"
+#include "ExternalMemoryHost.hpp"
+#include "HostImageCopy.hpp"
+#include "ImageLayoutTracker.hpp"
+#include "ImagePool.hpp"
+#include "MemoryBudgetMonitor.hpp"
+#include "Mipmaps.hpp"
+#include "ParallelHostCopy.hpp"
+#include "RayTracingPipeline.hpp"
+#include "RingBuffers.hpp"
+#include "ShaderBindingTable.hpp"
+#include "SparseResidency.hpp"
+#include "StreamingDispatcher.hpp"
+#include "TlasInstanceGenerator.hpp"
 
 #include <cstdio>
 #include <cstdlib>
@@ -44,9 +65,11 @@ int main(int /*argc*/, char** /*argv*/)
         VkPhysicalDeviceProperties deviceProperties = {};
         vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
 
-        /// @note: At some point we would probably like to filter the devices to test. For now, use real GPUs.
+        /// @note: At some point we would probably like to filter the devices to test. For now, use real GPUs
+        ///        and CPU implementations such as lavapipe, which allow running the tests without a GPU.
         if((deviceProperties.deviceType != VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU)
-           && (deviceProperties.deviceType != VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU))
+           && (deviceProperties.deviceType != VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU)
+           && (deviceProperties.deviceType != VK_PHYSICAL_DEVICE_TYPE_CPU))
         {
             continue;
         }
@@ -57,6 +80,111 @@ int main(int /*argc*/, char** /*argv*/)
         {
             vkw::utils::Log::Warning("TESTS", "Descriptor indexing test FAILED");
         }
+
+        if(!launchExternalMemoryHostTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "External memory host test FAILED");
+        }
+
+        if(!launchHostImageCopyTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "Host image copy test FAILED");
+        }
+
+        if(!launchRingBuffersTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "Ring buffers test FAILED");
+        }
+
+        if(!launchBufferCopyKernelsTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "Buffer copy kernels test FAILED");
+        }
+
+        if(!launchBlasBatcherTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "BLAS batcher test FAILED");
+        }
+
+        if(!launchASSerializerTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "Acceleration structure serializer test FAILED");
+        }
+
+        if(!launchChunkedBufferTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "Chunked buffer test FAILED");
+        }
+
+        if(!launchMemoryBudgetMonitorTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "Memory budget monitor test FAILED");
+        }
+
+        if(!launchRayTracingPipelineTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "Ray tracing pipeline test FAILED");
+        }
+
+        if(!launchParallelHostCopyTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "Parallel host copy test FAILED");
+        }
+
+        if(!launchDeviceVectorTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "Device vector test FAILED");
+        }
+
+        if(!launchMipmapsTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "Mipmaps test FAILED");
+        }
+
+        if(!launchImageLayoutTrackerTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "Image layout tracker test FAILED");
+        }
+
+        if(!launchImagePoolTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "Image pool test FAILED");
+        }
+
+        if(!launchSparseResidencyTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "Sparse residency test FAILED");
+        }
+
+        if(!launchStreamingDispatcherTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "Streaming dispatcher test FAILED");
+        }
+
+        if(!launchASScratchPoolTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "AS scratch pool test FAILED");
+        }
+
+        if(!launchASCompactorTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "AS compactor test FAILED");
+        }
+
+        if(!launchBlasRefitTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "BLAS refit test FAILED");
+        }
+
+        if(!launchTlasInstanceGeneratorTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "TLAS instance generator test FAILED");
+        }
+
+        if(!launchShaderBindingTableTest(instance, physicalDevice))
+        {
+            vkw::utils::Log::Warning("TESTS", "Shader binding table test FAILED");
+        }
     }
 
     return EXIT_SUCCESS;